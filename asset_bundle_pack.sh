@@ -0,0 +1,126 @@
+#!/usr/bin/env bash
+
+# Packs every file under ASSETS_PATH into BUNDLE_PATH (see include/AssetBundle.hpp)
+
+if [[ -z ${ASSETS_PATH} || -z ${BUNDLE_PATH} ]]; then
+  echo "ASSETS_PATH and BUNDLE_PATH Variables should be set!"
+  return 1
+fi
+
+if command -v sha256sum >/dev/null 2>&1; then
+  sha256_cmd="sha256sum"
+else
+  sha256_cmd="shasum -a 256"
+fi
+
+BUNDLE_VERSION=1
+BUNDLE_ALIGNMENT=16
+BUNDLE_HASH_SIZE=8
+HEADER_SIZE=32
+ENTRY_SIZE=32
+
+# little endian unsigned integer, i.e. write_uint <value> <byte size>
+write_uint() {
+  local bytes= i
+  for (( i = 0; i < $2; i++ )); do
+    bytes+=$(printf '\\x%02x' $(( ($1 >> (8 * i)) & 0xff )))
+  done
+  printf "${bytes}"
+}
+
+# leading bytes of a hex digest, i.e. write_hash <hex>
+write_hash() {
+  local bytes= i
+  for (( i = 0; i < BUNDLE_HASH_SIZE; i++ )); do
+    bytes+="\\x${1:$(( 2 * i )):2}"
+  done
+  printf "${bytes}"
+}
+
+align() {
+  echo $(( ($1 + BUNDLE_ALIGNMENT - 1) / BUNDLE_ALIGNMENT * BUNDLE_ALIGNMENT ))
+}
+
+pack_assets() {
+  # byte-wise path order/sizes, the bundle is binary searched by memcmp
+  local LC_ALL=C
+
+  local files=()
+  while IFS= read -r file; do
+    files+=("${file#./}")
+  done < <(find "${ASSETS_PATH%/}" -type f | sort)
+
+  local entry_count=${#files[@]}
+  local index_offset=${HEADER_SIZE}
+  local paths_offset=$(( index_offset + entry_count * ENTRY_SIZE ))
+
+  local paths_size=0
+  for file in "${files[@]}"; do
+    paths_size=$(( paths_size + ${#file} ))
+  done
+
+  # data layout, identical contents are stored once
+  local -A hash_offsets=()
+  local data_files=()
+  local sizes=() hashes=() offsets=()
+  local data_end=$(( paths_offset + paths_size ))
+
+  for file in "${files[@]}"; do
+    local size=$(( $(wc -c < "${file}") ))
+    local hash=$(${sha256_cmd} "${file}" | cut -c1-64)
+
+    if [[ -z ${hash_offsets[${hash}]} ]]; then
+      data_end=$(align ${data_end})
+      hash_offsets[${hash}]=${data_end}
+      data_files+=("${file}")
+      data_end=$(( data_end + size ))
+    fi
+
+    sizes+=(${size})
+    hashes+=(${hash})
+    offsets+=(${hash_offsets[${hash}]})
+  done
+
+  local tmp_file="${BUNDLE_PATH}.tmp"
+
+  {
+    # Header
+    printf 'SRAB'
+    write_uint ${BUNDLE_VERSION} 4
+    write_uint ${entry_count} 4
+    write_uint ${BUNDLE_ALIGNMENT} 4
+    write_uint ${index_offset} 8
+    write_uint ${paths_offset} 8
+
+    # Entries
+    local path_offset=0 i
+    for (( i = 0; i < entry_count; i++ )); do
+      write_uint ${path_offset} 4
+      write_uint ${#files[i]} 4
+      write_uint ${offsets[i]} 8
+      write_uint ${sizes[i]} 8
+      write_hash ${hashes[i]}
+      path_offset=$(( path_offset + ${#files[i]} ))
+    done
+
+    # Paths
+    printf '%s' "${files[@]}"
+
+    # Data
+    local position=$(( paths_offset + paths_size ))
+    for file in "${data_files[@]}"; do
+      local aligned=$(align ${position})
+      head -c $(( aligned - position )) /dev/zero
+      cat "${file}"
+      position=$(( aligned + $(wc -c < "${file}") ))
+    done
+  } > "${tmp_file}" || return 1
+
+  mv "${tmp_file}" "${BUNDLE_PATH}" || return 1
+
+  echo -ne "${BUNDLE_PATH} was successfully created! (${entry_count} entries, ${#data_files[@]} unique)\n\r"
+}
+
+pack_assets || return 1
+
+return 0
@@ -1,7 +1,7 @@
 #version 450
 
-layout(location = 0) in vec4 position;
-layout(location = 1) in vec3 normal;
+layout(location = 0) in vec4 position; // quantized, see MeshOptimizer
+layout(location = 1) in vec2 normal; // octahedral
 //layout(location = 2) in vec2 texCoord;
 
 out gl_PerVertex {
@@ -18,9 +18,18 @@ layout(std140, binding = 0) uniform buf {
   mat3 modelNormal;
 } ubuf;
 
+vec3 decodeNormal(vec2 e)
+{
+  vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+  float t = max(-n.z, 0.0);
+  n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+
+  return normalize(n);
+}
+
 void main()
 {
-  vECVertNormal = normalize(ubuf.modelNormal * normal);
+  vECVertNormal = normalize(ubuf.modelNormal * decodeNormal(normal));
   mat4 t = mat4(
     1, 0, 0, 0,
     0, 1, 0, 0,
@@ -1,7 +1,7 @@
 #version 450
 
-layout(location = 0) in vec4 position;
-layout(location = 1) in vec3 normal;
+layout(location = 0) in vec4 position; // quantized, see MeshOptimizer
+layout(location = 1) in vec2 normal; // octahedral
 
 out gl_PerVertex
 {
@@ -45,6 +45,48 @@ float sdBox( vec3 p, vec3 b )
     return min(max(d.x,max(d.y,d.z)),0.0) + length(max(d,0.0));
 }
 
+/**
+ * Ray Intersections (closed-form, see CodeGen::generateCastAnalytic)
+ * -------------------------------------------------
+ * nearest hit distance within [tmin, tmax] of the ray (rd normalized)
+ * against the surface of their distance function counterpart,
+ * tmin if the ray starts inside, -1.0 if none
+ */
+
+float iPlane( vec3 ro, vec3 rd, float tmin, float tmax )
+{
+    if( ro.y + rd.y*tmin<=0.0 ) return tmin;
+    float t = -ro.y/rd.y;
+    return ( t>=tmin && t<=tmax ) ? t : -1.0;
+}
+
+float iSphere( vec3 ro, vec3 rd, float tmin, float tmax, vec3 s )
+{
+    float b = dot( ro, rd );
+    float h = b*b - dot( ro, ro ) + s.x*s.x;
+    if( h<0.0 ) return -1.0;
+    h = sqrt( h );
+    if( -b+h<tmin || -b-h>tmax ) return -1.0;
+    return max( -b-h, tmin );
+}
+
+float iBox( vec3 ro, vec3 rd, float tmin, float tmax, vec3 b )
+{
+    vec3 m  = 1.0/rd;
+    vec3 n  = m*ro;
+    vec3 k  = abs(m)*b;
+    float tN = max( max( -n.x-k.x, -n.y-k.y ), -n.z-k.z );
+    float tF = min( min( -n.x+k.x, -n.y+k.y ), -n.z+k.z );
+    if( tN>tF || tF<tmin || tN>tmax ) return -1.0;
+    return max( tN, tmin );
+}
+
+/**
+ *
+ * -------------------------------------------------
+ *
+ */
+
 float sdEllipsoid( in vec3 p, in vec3 r )
 {
     return (length( p/r ) - 1.0) * min(min(r.x,r.y),r.z);
@@ -0,0 +1,62 @@
+/*****************************************************
+ * Partial Shader: Fragment
+ * Distance Function Gradients (Dual Numbers)
+ * Modified from Inigo Quilez
+ *
+ * Each function returns the dual number
+ * vec4(distance, d(distance)/dp) of its counterpart
+ * in distance_functions, used by the generated mapGrad
+ *****************************************************/
+
+#version 450
+
+vec4 sdPlaneGrad( vec3 p )
+{
+    return vec4( p.y, 0.0, 1.0, 0.0 );
+}
+
+vec4 sdSphereGrad( vec3 p, vec3 s )
+{
+    float l = length(p);
+    return vec4( l-s.x, p/max(l,1e-6) );
+}
+
+vec4 sdBoxGrad( vec3 p, vec3 b )
+{
+    vec3 w = abs(p) - b;
+    vec3 s = vec3( p.x<0.0 ? -1.0 : 1.0,
+                   p.y<0.0 ? -1.0 : 1.0,
+                   p.z<0.0 ? -1.0 : 1.0 );
+    float g = max(w.x,max(w.y,w.z));
+    vec3  q = max(w,0.0);
+    float l = length(q);
+    return vec4( (g>0.0) ? l : g,
+                 s*( (g>0.0) ? q/l :
+                     ((w.x>w.y && w.x>w.z) ? vec3(1.0,0.0,0.0) :
+                     ((w.y>w.z)            ? vec3(0.0,1.0,0.0) :
+                                             vec3(0.0,0.0,1.0)))) );
+}
+
+vec4 sdTorusGrad( vec3 p, vec2 t )
+{
+    float h = max(length(p.xz),1e-6);
+    vec2  q = vec2(h-t.x,p.y);
+    float l = max(length(q),1e-6);
+    return vec4( l-t.y, vec3(p.x*q.x/h, q.y, p.z*q.x/h)/l );
+}
+
+/**
+ *
+ * -------------------------------------------------
+ *
+ */
+
+vec4 opUnionGrad( vec4 d1, vec4 d2 )
+{
+    return (d1.x<d2.x) ? d1 : d2;
+}
+
+vec4 opSubtractionGrad( vec4 d1, vec4 d2 )
+{
+    return (-d2.x>d1.x) ? vec4(-d2.x,-d2.yzw) : d1;
+}
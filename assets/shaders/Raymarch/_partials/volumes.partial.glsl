@@ -0,0 +1,208 @@
+/*****************************************************
+ * Partial Shader: Fragment
+ * Distance Volumes (Sparse Brick Map, Mesh Volume)
+ *
+ * Static SDF Graph primitives baked on the CPU
+ * (see BrickMap) into a coarse grid of cells where
+ * cells near the surface point to a brick of
+ * BRICK_SIZE^3 samples (distance, material).
+ *
+ * data[] layout:
+ * - cells: brick index or BRICK_EMPTY_* flag per cell
+ * - bricks: packHalf2x16(distance, material) samples
+ *
+ * Dense signed distance volume of a mesh (see MeshSDF),
+ * in normalized mesh space, sampled by the Mesh node.
+ *
+ * data[] layout:
+ * - packHalf2x16 pairs of consecutive (x-major) samples
+ *****************************************************/
+
+#version 450
+
+#define BRICK_SIZE 8
+#define BRICK_SAMPLES 512u
+#define BRICK_EMPTY_INSIDE 0xFFFFFFFEu
+
+layout(std430, binding = 2) readonly buffer BrickMap
+{
+    vec4  origin;   // xyz: grid origin, w: cell size
+    uvec4 dims;     // xyz: cells per axis, w: brick slots
+    uint  data[];
+} u_brickMap;
+
+/**
+ * @note returns the trilinear sample (x) and its gradient (yzw)
+ * in brick sample space, material of the nearest sample is set to mat
+ */
+vec4 sampleBrick( uint brick, vec3 s, out float mat )
+{
+    uvec3 dims = u_brickMap.dims.xyz;
+    uint offset = dims.x*dims.y*dims.z + brick*BRICK_SAMPLES;
+
+    s = clamp( s, vec3(0.0), vec3(float(BRICK_SIZE-1)) );
+    uvec3 i = min( uvec3(s), uvec3(BRICK_SIZE-2) );
+    vec3  f = s - vec3(i);
+
+    uint base = offset + i.x + uint(BRICK_SIZE)*( i.y + uint(BRICK_SIZE)*i.z );
+    const uint dy = uint(BRICK_SIZE);
+    const uint dz = uint(BRICK_SIZE*BRICK_SIZE);
+
+    vec2 c000 = unpackHalf2x16( u_brickMap.data[base] );
+    vec2 c100 = unpackHalf2x16( u_brickMap.data[base + 1u] );
+    vec2 c010 = unpackHalf2x16( u_brickMap.data[base + dy] );
+    vec2 c110 = unpackHalf2x16( u_brickMap.data[base + dy + 1u] );
+    vec2 c001 = unpackHalf2x16( u_brickMap.data[base + dz] );
+    vec2 c101 = unpackHalf2x16( u_brickMap.data[base + dz + 1u] );
+    vec2 c011 = unpackHalf2x16( u_brickMap.data[base + dz + dy] );
+    vec2 c111 = unpackHalf2x16( u_brickMap.data[base + dz + dy + 1u] );
+
+    float x00 = mix( c000.x, c100.x, f.x );
+    float x10 = mix( c010.x, c110.x, f.x );
+    float x01 = mix( c001.x, c101.x, f.x );
+    float x11 = mix( c011.x, c111.x, f.x );
+    float y0  = mix( x00, x10, f.y );
+    float y1  = mix( x01, x11, f.y );
+
+    vec3 g = vec3(
+        mix( mix( c100.x-c000.x, c110.x-c010.x, f.y ),
+             mix( c101.x-c001.x, c111.x-c011.x, f.y ), f.z ),
+        mix( x10-x00, x11-x01, f.z ),
+        y1-y0 );
+
+    bvec3 n = greaterThan( f, vec3(0.5) );
+    mat = n.z ? ( n.y ? ( n.x ? c111.y : c011.y ) : ( n.x ? c101.y : c001.y ) )
+                    : ( n.y ? ( n.x ? c110.y : c010.y ) : ( n.x ? c100.y : c000.y ) );
+
+    return vec4( mix( y0, y1, f.z ), g );
+}
+
+/**
+ * @note outside of the grid and in empty cells the returned
+ * distance is a conservative bound (at least half a cell away)
+ */
+vec4 sdBrickMapGrad( vec3 pos, out float mat )
+{
+    float cellSize = u_brickMap.origin.w;
+    vec3  halfSize = 0.5*vec3(u_brickMap.dims.xyz)*cellSize;
+    vec3  p        = pos - u_brickMap.origin.xyz;
+
+    mat = 0.0;
+
+    vec4 bounds = sdBoxGrad( p - halfSize, halfSize );
+    if( bounds.x > 0.0 ) return vec4( bounds.x + 0.5*cellSize, bounds.yzw );
+
+    vec3  cellCoord = p/cellSize;
+    uvec3 cell = uvec3( clamp( ivec3(floor(cellCoord)), ivec3(0), ivec3(u_brickMap.dims.xyz) - 1 ) );
+    uint  brick = u_brickMap.data[ cell.x + u_brickMap.dims.x*( cell.y + u_brickMap.dims.y*cell.z ) ];
+
+    if( brick >= BRICK_EMPTY_INSIDE )
+    {
+        return vec4( brick == BRICK_EMPTY_INSIDE ? -0.5*cellSize : 0.5*cellSize, vec3(0.0) );
+    }
+
+    float scale = float(BRICK_SIZE-1);
+    vec4  res = sampleBrick( brick, (cellCoord - vec3(cell))*scale, mat );
+
+    return vec4( res.x, res.yzw*scale/cellSize );
+}
+
+vec2 sdBrickMap( vec3 pos )
+{
+    float material;
+    float d = sdBrickMapGrad( pos, material ).x;
+    return vec2( d, material );
+}
+
+vec4 sdBrickMapGrad( vec3 pos )
+{
+    float material;
+    return sdBrickMapGrad( pos, material );
+}
+
+layout(std430, binding = 3) readonly buffer MeshVolume
+{
+    vec4  origin;   // xyz: grid origin, w: sample spacing
+    uvec4 dims;     // xyz: samples per axis
+    uint  data[];
+} u_meshVolume;
+
+float fetchMeshVolume( uint i )
+{
+    vec2 pair = unpackHalf2x16( u_meshVolume.data[i >> 1u] );
+    return (i & 1u) == 0u ? pair.x : pair.y;
+}
+
+/**
+ * @note returns the trilinear sample (x) and its gradient (yzw)
+ * in sample space
+ */
+vec4 sampleMeshVolume( vec3 s )
+{
+    uvec3 dims = u_meshVolume.dims.xyz;
+    uvec3 i = min( uvec3(s), dims - 2u );
+    vec3  f = s - vec3(i);
+
+    uint base = i.x + dims.x*( i.y + dims.y*i.z );
+    uint dy = dims.x;
+    uint dz = dims.x*dims.y;
+
+    float c000 = fetchMeshVolume( base );
+    float c100 = fetchMeshVolume( base + 1u );
+    float c010 = fetchMeshVolume( base + dy );
+    float c110 = fetchMeshVolume( base + dy + 1u );
+    float c001 = fetchMeshVolume( base + dz );
+    float c101 = fetchMeshVolume( base + dz + 1u );
+    float c011 = fetchMeshVolume( base + dz + dy );
+    float c111 = fetchMeshVolume( base + dz + dy + 1u );
+
+    float x00 = mix( c000, c100, f.x );
+    float x10 = mix( c010, c110, f.x );
+    float x01 = mix( c001, c101, f.x );
+    float x11 = mix( c011, c111, f.x );
+    float y0  = mix( x00, x10, f.y );
+    float y1  = mix( x01, x11, f.y );
+
+    vec3 g = vec3(
+        mix( mix( c100-c000, c110-c010, f.y ),
+             mix( c101-c001, c111-c011, f.y ), f.z ),
+        mix( x10-x00, x11-x01, f.z ),
+        y1-y0 );
+
+    return vec4( mix( y0, y1, f.z ), g );
+}
+
+/**
+ * @note uniform scale s keeps it a distance: s*d(p/s), the gradient is unscaled
+ *
+ * @note outside of the grid the box distance is combined with the sample
+ * at the closest grid point, a lower bound as the surface is inside
+ * (see Evaluator::distance)
+ */
+vec4 sdMeshVolumeGrad( vec3 pos, float scale )
+{
+    if( any( lessThan( u_meshVolume.dims.xyz, uvec3(2u) ) ) ) return vec4( 1e10, vec3(0.0) );
+
+    float s        = max( scale, 1e-4 );
+    float spacing  = u_meshVolume.origin.w;
+    vec3  halfSize = 0.5*vec3(u_meshVolume.dims.xyz - 1u)*spacing;
+    vec3  p        = pos/s - u_meshVolume.origin.xyz;
+
+    vec4 bounds = sdBoxGrad( p - halfSize, halfSize );
+    vec4 res    = sampleMeshVolume( clamp( p, vec3(0.0), 2.0*halfSize )/spacing );
+    res.yzw /= spacing;
+
+    if( bounds.x > 0.0 )
+    {
+        float d = max( res.x, 0.0 );
+        float l = length( vec2( bounds.x, d ) );
+        return vec4( s*l, ( bounds.x*bounds.yzw + d*res.yzw )/max( l, 1e-6 ) );
+    }
+
+    return vec4( s*res.x, res.yzw );
+}
+
+float sdMeshVolume( vec3 pos, float scale )
+{
+    return sdMeshVolumeGrad( pos, scale ).x;
+}
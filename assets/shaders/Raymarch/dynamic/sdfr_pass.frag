@@ -6,6 +6,7 @@ layout(location = 1) in vec3 normal;
 layout(location = 2) in vec2 vECTexCoords;
 
 layout(binding = 0) uniform sampler2D depthTexture;
+layout(binding = 1) uniform sampler2D lightingTexture; // reduced resolution (shadow dif, shadow dom, occ, t)
 
 layout(location = 0) out vec4 outColor;
 
@@ -16,49 +17,244 @@ layout(push_constant) uniform FSConst
   float nearPlane;
   float farPlane;
 
+  float lightingScale; // 1.0: full resolution (in this pass), 0.5: half, 0.25: quarter
+  float passMode; // 0.0: main pass, 1.0: (reduced resolution) lighting pass
+
   vec2 mouse;
   float time;
 } u_input;
 
-#define AA 1   // make this 1 is your machine is too slow
+/**
+ * raymarch quality (see RaymarchQuality), specialization constants so
+ * a quality preset only recreates the pipeline from the same SPIR-V
+ */
+layout(constant_id = 0) const int AA = 1;             // samples per pixel side, make this 1 if your machine is too slow
+layout(constant_id = 1) const int MARCH_STEPS = 64;   // castRay iterations
+layout(constant_id = 2) const int SHADOW_STEPS = 16;  // softshadow iterations
+layout(constant_id = 3) const int AO_TAPS = 5;        // calcAO samples
+layout(constant_id = 4) const float PRECISION = 0.0005; // hit threshold, per unit of distance
+layout(constant_id = 5) const float TMAX = 20.0;      // castRay max distance
+layout(constant_id = 6) const float RELAXATION = 1.6; // castRay over-relaxation, [1, 2), 1 is plain sphere tracing
+
+#define LIGHTING_DEPTH_SIGMA 0.05 // relative hit distance tolerance of the upsampling
 
 //------------------------------------------------------------------
 
+#define TILE_SIZE   16u         // see constants::binning::tileSize
+#define BIN_SIZE    32u         // count + node indices, see constants::binning::binSize
+#define MAX_TILES   65536u      // see constants::binning::maxTiles
+#define BIN_ALL     0xffffffffu // every node is marched (not binned/overflowed)
+
+/**
+ * scene nodes whose bounds overlap the frustum of a 16x16 pixel tile,
+ * sorted in scene order (see sdfr_binning.comp)
+ */
+layout(std430, binding = 5) readonly buffer TileBins
+{
+  uint bins[]; // per tile: node count, node indices
+} u_bins;
+
+/**
+ * @struct BinCursor
+ * @brief walks the sorted node list of the tile along the scene's nodes
+ */
+struct BinCursor
+{
+  uint offset; // of the tile's list, BIN_ALL: no tile
+  uint count; // BIN_ALL: every node
+  uint index;
+  uint next; // node at index, BIN_ALL: past the end
+};
+
+uint g_tileBin = BIN_ALL; // of the ray's tile, see setupRay
+
+/**
+ * primary rays stay within the frustum of their pixel's tile, so the march
+ * (mapMarch) only evaluates the nodes binned to it. Secondary rays (shadows,
+ * AO) and normals leave the tile and evaluate the whole scene (map).
+ */
+void setTile( in vec2 fragCoord )
+{
+  uvec2 tileCount = ( uvec2( u_input.resolution ) + TILE_SIZE-1u )/TILE_SIZE;
+  uvec2 tile = uvec2( max( fragCoord, vec2(0.0) ) )/TILE_SIZE;
+  uint index = tile.y*tileCount.x + tile.x;
+
+  g_tileBin = all( lessThan( tile, tileCount ) ) && index<MAX_TILES ? index*BIN_SIZE : BIN_ALL;
+}
+
+BinCursor getBinCursor( )
+{
+  BinCursor bin = BinCursor( g_tileBin, BIN_ALL, 0u, BIN_ALL );
+
+  if( g_tileBin==BIN_ALL ) return bin;
+
+  bin.count = u_bins.bins[g_tileBin];
+
+  if( bin.count!=BIN_ALL && bin.count>0u ) bin.next = u_bins.bins[g_tileBin+1u];
+
+  return bin;
+}
+
+/**
+ * whether the node is binned to the tile, the nodes
+ * are queried in scene order (some may be skipped)
+ */
+bool nextBin( inout BinCursor bin, uint node )
+{
+  if( bin.count==BIN_ALL ) return true;
+
+  while( bin.next<node )
+  {
+    bin.index++;
+    bin.next = bin.index<bin.count ? u_bins.bins[bin.offset+1u+bin.index] : BIN_ALL;
+  }
+
+  return bin.next==node;
+}
+
+//------------------------------------------------------------------
+
+/**
+ * map (distance, material), mapGrad (distance, gradient) and mapMarch (map
+ * of the tile's binned nodes, see getBinCursor) are generated from the
+ * SDF Graph into the placeholder below, which also defines SDF_GRAPH_MAP.
+ * Otherwise, the defaults interpret the scene tape, i.e. the SDF Graph's
+ * bytecode (see Tape), until its shader is compiled. Once disabled, they
+ * don't keep the functions they call (see Shader::getUsedFragments).
+ *
+ * If SDF_GRAPH_ANALYTIC is defined as well, castRay intersects the scene's
+ * top-level planes/spheres/boxes in closed form (castAnalytic) and only
+ * marches the remaining terms (mapMarch), see CodeGen.
+ */
+/* ------ PLACEHOLDER (DO NOT CHANGE) ------ */
+
+#ifndef SDF_GRAPH_MAP
+#define TAPE_STACK_SIZE 8 // see constants::tape::stackSize
+
+#define OP_TRANSLATE    0u
+#define OP_PLANE        1u
+#define OP_SPHERE       2u
+#define OP_BOX          3u
+#define OP_TORUS        4u
+#define OP_MESH         5u
+#define OP_BRICK_MAP    6u
+#define OP_UNION        7u
+#define OP_SUBTRACTION  8u
+
+#define NODE_SIZE 3u // uvec4 per node record, see constants::tape::nodeSize
+
+layout(std430, binding = 4) readonly buffer SceneTape
+{
+  uvec4 header; // x: instruction count, y: stack depth, z: node count
+  uvec4 code[]; // per instruction: (opcode, material bits), operand bits (xyz), then the node records
+} u_tape;
+
+/**
+ * an empty tape (e.g. before the SDF Graph is opened) is the ground plane only
+ */
+uint getTapeLength( )
+{
+  return min( u_tape.header.x, uint( u_tape.code.length() )/2u );
+}
+
+/**
+ * runs the base's instructions (up to the first node's) and then the
+ * instruction ranges of the binned nodes, or the whole tape if every
+ * node is marched (the tape has no node table)
+ */
+vec2 runTape( in vec3 pos, in BinCursor bin )
+{
+  vec2 stack[TAPE_STACK_SIZE];
+  int sp = 0;
+  vec3 p = pos;
+
+  uint count = getTapeLength();
+  uint nodes = 2u*count; // node table
+  bool isBinned = bin.count!=BIN_ALL && u_tape.header.z>0u;
+  uint segmentCount = isBinned ? bin.count+1u : 1u;
+
+  for( uint s=0u; s<segmentCount; s++ )
+  {
+    uvec2 range = uvec2( 0u, count );
+
+    if( isBinned )
+    {
+      uint node = s>0u ? u_bins.bins[bin.offset+s] : 0u;
+      uint record = nodes + NODE_SIZE*node;
+
+      range = s>0u ? u_tape.code[record].xy : uvec2( 0u, u_tape.code[record].x );
+      p = s>0u ? pos - uintBitsToFloat( u_tape.code[record+1u].xyz ) : pos;
+    }
+
+    for( uint i=range.x; i<range.y; i++ )
+    {
+      uvec4 head = u_tape.code[2u*i];
+      vec3 arg = uintBitsToFloat( u_tape.code[2u*i+1u].xyz );
+      float mat = uintBitsToFloat( head.y );
+
+      switch( head.x )
+      {
+        case OP_TRANSLATE:    p = pos - arg; break;
+        case OP_PLANE:        stack[sp++] = vec2( sdPlane( p ), mat ); break;
+        case OP_SPHERE:       stack[sp++] = vec2( sdSphere( p, arg ), mat ); break;
+        case OP_BOX:          stack[sp++] = vec2( sdBox( p, arg ), mat ); break;
+        case OP_TORUS:        stack[sp++] = vec2( sdTorus( p, arg.xy ), mat ); break;
+        case OP_MESH:         stack[sp++] = vec2( sdMeshVolume( p, arg.x )*arg.y, mat ); break; // arg.y: 1/lipschitz
+        case OP_BRICK_MAP:    stack[sp++] = sdBrickMap( pos ); break;
+        case OP_UNION:        sp--; stack[sp-1] = opUnion( stack[sp-1], stack[sp] ); break;
+        case OP_SUBTRACTION:  sp--; stack[sp-1].x = opSubtraction( stack[sp-1].x, stack[sp].x ); break;
+      }
+    }
+  }
+
+  return sp>0 ? stack[0] : vec2( sdPlane( pos ), 1.0 );
+}
+
 vec2 map( in vec3 pos )
 {
-  vec2 res = vec2(sdPlane(pos), 1.0);
-
-  /* ------ PLACEHOLDER (DO NOT CHANGE) ------ */
-
-//  res = opU( res, vec2(sdSphere(     pos-vec3( 0.0,0.25, 0.0), 0.25 ), 46.9));
-//  res = opU( res, vec2( sdBox(       pos-vec3( 1.0,0.25, 0.0), vec3(0.25) ), 3.0 ) );
-//  res = opU( res, vec2( udRoundBox(  pos-vec3( 1.0,0.25, 1.0), vec3(0.15), 0.1 ), 41.0 ) );
-//  res = opU( res, vec2( sdTorus(     pos-vec3( 0.0,0.25, 1.0), vec2(0.20,0.05) ), 25.0 ) );
-//  res = opU( res, vec2( sdCapsule(   pos,vec3(-1.3,0.10,-0.1), vec3(-0.8,0.50,0.2), 0.1  ), 31.9 ) );
-//  res = opU( res, vec2( sdTriPrism(  pos-vec3(-1.0,0.25,-1.0), vec2(0.25,0.05) ),43.5 ) );
-//  res = opU( res, vec2( sdCylinder(  pos-vec3( 1.0,0.30,-1.0), vec2(0.1,0.2) ), 8.0 ) );
-//  res = opU( res, vec2( sdCone(      pos-vec3( 0.0,0.50,-1.0), vec3(0.8,0.6,0.3) ), 55.0 ) );
-//  res = opU( res, vec2( sdTorus82(   pos-vec3( 0.0,0.25, 2.0), vec2(0.20,0.05) ),50.0 ) );
-//  res = opU( res, vec2( sdTorus88(   pos-vec3(-1.0,0.25, 2.0), vec2(0.20,0.05) ),43.0 ) );
-//  res = opU( res, vec2( sdCylinder6( pos-vec3( 1.0,0.30, 2.0), vec2(0.1,0.2) ), 12.0 ) );
-//  res = opU( res, vec2( sdHexPrism(  pos-vec3(-1.0,0.20, 1.0), vec2(0.25,0.05) ),17.0 ) );
-//  res = opU( res, vec2( sdPryamid4(  pos-vec3(-1.0,0.15,-2.0), vec3(0.8,0.6,0.25) ),37.0 ) );
-//  res = opU( res, vec2( opS( udRoundBox(  pos-vec3(-2.0,0.2, 1.0), vec3(0.15),0.05),
-//  sdSphere(    pos-vec3(-2.0,0.2, 1.0), 0.25)), 13.0 ) );
-//  res = opU( res, vec2( opS( sdTorus82(  pos-vec3(-2.0,0.2, 0.0), vec2(0.20,0.1)),
-//  sdCylinder(  opRep( vec3(atan(pos.x+2.0,pos.z)/6.2831, pos.y, 0.02+0.5*length(pos-vec3(-2.0,0.2, 0.0))), vec3(0.05,1.0,0.05)), vec2(0.02,0.6))), 51.0 ) );
-//  res = opU( res, vec2( 0.5*sdSphere(    pos-vec3(-2.0,0.25,-1.0), 0.2 ) + 0.03*sin(50.0*pos.x)*sin(50.0*pos.y)*sin(50.0*pos.z), 65.0 ) );
-//  res = opU( res, vec2( 0.5*sdTorus( opTwist(pos-vec3(-2.0,0.25, 2.0)),vec2(0.20,0.05)), 46.7 ) );
-//  res = opU( res, vec2( sdConeSection( pos-vec3( 0.0,0.35,-2.0), 0.15, 0.2, 0.1 ), 13.67 ) );
-//  res = opU( res, vec2( sdEllipsoid( pos-vec3( 1.0,0.35,-2.0), vec3(0.15, 0.2, 0.05) ), 43.17 ) );
-
-  return res;
+  return runTape( pos, BinCursor( BIN_ALL, BIN_ALL, 0u, BIN_ALL ) );
+}
+
+vec2 mapMarch( in vec3 pos )
+{
+  return runTape( pos, getBinCursor() );
+}
+
+vec4 mapGrad( in vec3 pos )
+{
+  vec4 stack[TAPE_STACK_SIZE];
+  int sp = 0;
+  vec3 p = pos;
+
+  uint count = getTapeLength();
+
+  for( uint i=0u; i<count; i++ )
+  {
+    uint op = u_tape.code[2u*i].x;
+    vec3 arg = uintBitsToFloat( u_tape.code[2u*i+1u].xyz );
+
+    switch( op )
+    {
+      case OP_TRANSLATE:    p = pos - arg; break;
+      case OP_PLANE:        stack[sp++] = sdPlaneGrad( p ); break;
+      case OP_SPHERE:       stack[sp++] = sdSphereGrad( p, arg ); break;
+      case OP_BOX:          stack[sp++] = sdBoxGrad( p, arg ); break;
+      case OP_TORUS:        stack[sp++] = sdTorusGrad( p, arg.xy ); break;
+      case OP_MESH:         stack[sp++] = sdMeshVolumeGrad( p, arg.x )*arg.y; break; // arg.y: 1/lipschitz
+      case OP_BRICK_MAP:    stack[sp++] = sdBrickMapGrad( pos ); break;
+      case OP_UNION:        sp--; stack[sp-1] = opUnionGrad( stack[sp-1], stack[sp] ); break;
+      case OP_SUBTRACTION:  sp--; stack[sp-1] = opSubtractionGrad( stack[sp-1], stack[sp] ); break;
+    }
+  }
+
+  return sp>0 ? stack[0] : sdPlaneGrad( pos );
 }
+#endif
 
 vec2 castRay( in vec3 ro, in vec3 rd, in float depth )
 {
   float tmin = 1.0;
-  float tmax = 20.0;
+  float tmax = TMAX;
 
   #if 1
     // bounding volume
@@ -76,18 +272,53 @@ vec2 castRay( in vec3 ro, in vec3 rd, in float depth )
     }
   #endif
 
+  #ifdef SDF_GRAPH_ANALYTIC
+    // the march only has to find a hit nearer than the analytic one
+    vec2 hit = castAnalytic( ro, rd, tmin, tmax );
+    tmax = hit.x;
+  #endif
+
   float t = tmin;//depth;
   float m = -1.0;
-  for( int i=0; i<64; i++ )
+
+  /**
+   * over-relaxed sphere tracing (Keinert et al. 2014): steps of RELAXATION
+   * times the distance, as long as the unbounding spheres of two steps
+   * overlap. Otherwise it steps back and continues with plain sphere
+   * tracing, which relies on map() being 1-Lipschitz (see CodeGen)
+   */
+  float omega      = RELAXATION;
+  float prevRadius = 0.0;
+  float stepLength = 0.0;
+
+  for( int i=0; i<MARCH_STEPS; i++ )
   {
-    float precis = 0.0005*t;
-    vec2 res = map( ro+rd*t );
-    if( res.x<precis || t>tmax ) break;
-    t += res.x;
-    m = res.y;
+    float precis = PRECISION*t;
+    vec2 res = mapMarch( ro+rd*t );
+    bool sorFail = omega>1.0 && res.x+prevRadius<stepLength;
+
+    if( sorFail )
+    {
+      stepLength = prevRadius - stepLength;
+      omega = 1.0;
+    }
+    else
+    {
+      if( res.x<precis || t>tmax ) break;
+      stepLength = omega*res.x;
+      prevRadius = res.x;
+      m = res.y;
+    }
+
+    t += stepLength;
   }
 
   if( t>tmax ) m=-1.0;
+
+  #ifdef SDF_GRAPH_ANALYTIC
+    if( m<-0.5 && hit.y>-0.5 ) return hit;
+  #endif
+
   return vec2( t, m );
 }
 
@@ -95,7 +326,7 @@ float softshadow( in vec3 ro, in vec3 rd, in float mint, in float tmax )
 {
   float res = 1.0;
   float t = mint;
-  for( int i=0; i<16; i++ )
+  for( int i=0; i<SHADOW_STEPS; i++ )
   {
     float h = map( ro + rd*t ).x;
     res = min( res, 8.0*h/t );
@@ -107,14 +338,16 @@ float softshadow( in vec3 ro, in vec3 rd, in float mint, in float tmax )
 
 vec3 calcNormal( in vec3 pos )
 {
-  vec2 e = vec2(1.0,-1.0)*0.5773*0.0005;
-  return normalize(
+  // analytic gradient, single (forward-mode AD) evaluation of the scene
+  return normalize( mapGrad( pos ).yzw );
+  /*
+vec2 e = vec2(1.0,-1.0)*0.5773*0.0005;
+return normalize(
     e.xyy*map( pos + e.xyy ).x +
     e.yyx*map( pos + e.yyx ).x +
     e.yxy*map( pos + e.yxy ).x +
-    e.xxx*map( pos + e.xxx ).x
-  );
-  /*
+    e.xxx*map( pos + e.xxx ).x );
+
 vec3 eps = vec3( 0.0005, 0.0, 0.0 );
 vec3 nor = vec3(
     map(pos+eps.xyy).x - map(pos-eps.xyy).x,
@@ -128,9 +361,9 @@ float calcAO( in vec3 pos, in vec3 nor )
 {
   float occ = 0.0;
   float sca = 1.0;
-  for( int i=0; i<5; i++ )
+  for( int i=0; i<AO_TAPS; i++ )
   {
-    float hr = 0.01 + 0.12*float(i)/4.0;
+    float hr = 0.01 + 0.12*float(i)/float(max(AO_TAPS-1, 1));
     vec3 aopos =  nor * hr + pos;
     float dd = map( aopos ).x;
     occ += -(dd-hr)*sca;
@@ -139,6 +372,58 @@ float calcAO( in vec3 pos, in vec3 nor )
   return clamp( 1.0 - 3.0*occ, 0.0, 1.0 );
 }
 
+/**
+ * soft shadows (key light, reflection) and AO, i.e. all the secondary
+ * map() evaluations of a hit, (vec4(dif shadow, dom shadow, occ, t))
+ */
+vec4 calcLighting( in vec3 pos, in vec3 nor, in vec3 ref, in float t )
+{
+  vec3 lig = normalize( vec3(-0.4, 0.7, -0.6) );
+
+  return vec4(
+    softshadow( pos, lig, 0.02, 2.5 ),
+    softshadow( pos, ref, 0.02, 2.5 ),
+    calcAO( pos, nor ),
+    t
+  );
+}
+
+/**
+ * joint bilateral upsampling of the reduced resolution lighting:
+ * bilinear weights of the 4 nearest texels, each weighted by how close
+ * its hit distance is to this pixel's hit distance, so shadows/AO don't
+ * bleed across silhouettes. Returns w < 0 if no texel lies on the same
+ * surface (e.g. thin features), then the lighting is computed in place.
+ */
+vec4 upsampleLighting( in float t )
+{
+  vec2 coord = gl_FragCoord.xy*u_input.lightingScale - 0.5;
+  vec2 f = fract( coord );
+  ivec2 base = ivec2( floor( coord ) );
+  ivec2 maxTexel = min(
+    ivec2( ceil( u_input.resolution*u_input.lightingScale ) ),
+    textureSize( lightingTexture, 0 )
+  ) - 1;
+
+  vec4 sum = vec4(0.0);
+  float weightSum = 0.0;
+
+  for( int i=0; i<4; i++ )
+  {
+    ivec2 offset = ivec2( i&1, i>>1 );
+    vec4 texel = texelFetch( lightingTexture, clamp( base+offset, ivec2(0), maxTexel ), 0 );
+
+    vec2 bilinear = mix( 1.0-f, f, vec2(offset) );
+    float depthWeight = texel.w<0.0 ? 0.0 : exp( -abs( texel.w-t )/( LIGHTING_DEPTH_SIGMA*t ) );
+    float weight = bilinear.x*bilinear.y*depthWeight;
+
+    sum += texel*weight;
+    weightSum += weight;
+  }
+
+  return weightSum>1e-3 ? sum/weightSum : vec4(-1.0);
+}
+
 vec3 render( in vec3 ro, in vec3 rd, in float depth )
 {
   vec3 col = vec3(0.7, 0.9, 1.0) +rd.y*0.8;
@@ -151,6 +436,11 @@ vec3 render( in vec3 ro, in vec3 rd, in float depth )
     vec3 nor = calcNormal( pos );
     vec3 ref = reflect( rd, nor );
 
+    vec4 lighting = u_input.lightingScale<1.0 ? upsampleLighting( t ) : vec4(-1.0);
+
+    if( lighting.w<0.0 )
+    lighting = calcLighting( pos, nor, ref, t );
+
     // material
     col = 0.45 + 0.35*sin( vec3(0.05,0.08,0.10)*(m-1.0) );
     if( m<1.5 )
@@ -161,7 +451,7 @@ vec3 render( in vec3 ro, in vec3 rd, in float depth )
     }
 
     // lighitng
-    float occ = calcAO( pos, nor );
+    float occ = lighting.z;
     vec3  lig = normalize( vec3(-0.4, 0.7, -0.6) );
     float amb = clamp( 0.5+0.5*nor.y, 0.0, 1.0 );
     float dif = clamp( dot( nor, lig ), 0.0, 1.0 );
@@ -170,8 +460,8 @@ vec3 render( in vec3 ro, in vec3 rd, in float depth )
     float fre = pow( clamp(1.0+dot(nor,rd),0.0,1.0), 2.0 );
     float spe = pow(clamp( dot( ref, lig ), 0.0, 1.0 ),16.0);
 
-    dif *= softshadow( pos, lig, 0.02, 2.5 );
-    dom *= softshadow( pos, ref, 0.02, 2.5 );
+    dif *= lighting.x;
+    dom *= lighting.y;
 
     vec3 lin = vec3(0.0);
     lin += 1.30*dif*vec3(1.00,0.80,0.55);
@@ -206,31 +496,65 @@ float LinearizeDepth(float depth)
   return (2.0 * near * far) / (far + near - z * (far - near));
 }
 
-void main( )
+/**
+ * camera ray of a (full resolution) fragment coordinate
+ */
+void setupRay( in vec2 fragCoord, out vec3 ro, out vec3 rd )
 {
   vec2 mo = u_input.mouse/u_input.resolution;
   float time = 15.0 + u_input.time;
 
+  vec2 p = (-u_input.resolution + 2.0*fragCoord)/u_input.resolution.y;
+  p.y = -p.y;
+
+  // camera
+  ro = vec3( -0.5+3.5*cos(0.1*time + 6.0*mo.x), 1.0 + 6.0*mo.y, 0.5 + 4.0*sin(0.1*time + 6.0*mo.x) );
+  vec3 ta = vec3( -0.5, -0.4, 0.5 );
+  // camera-to-world transformation
+  mat3 ca = setCamera( ro, ta, 0.0 );
+  // ray direction
+  rd = ca * normalize( vec3(p.xy,2.0) );
+
+  setTile( fragCoord );
+}
+
+/**
+ * reduced resolution lighting pass: each texel covers
+ * 1/lightingScale^2 pixels and is shaded at their center
+ */
+vec4 lightingPass( )
+{
+  vec3 ro, rd;
+  setupRay( gl_FragCoord.xy/u_input.lightingScale, ro, rd );
+
+  vec2 res = castRay( ro, rd, 0.0 );
+
+  if( res.y<-0.5 ) return vec4( 1.0, 1.0, 1.0, -1.0 ); // miss
+
+  vec3 pos = ro + res.x*rd;
+  vec3 nor = calcNormal( pos );
+
+  return calcLighting( pos, nor, reflect( rd, nor ), res.x );
+}
+
+void main( )
+{
+  if( u_input.passMode>0.5 )
+  {
+    outColor = lightingPass();
+    return;
+  }
+
   vec3 tot = vec3(0.0);
-  #if AA>1
   for( int m=0; m<AA; m++ )
   for( int n=0; n<AA; n++ )
   {
-    // pixel coordinates
-    vec2 o = vec2(float(m),float(n)) / float(AA) - 0.5;
-    vec2 p = (-u_input.resolution + 2.0*(gl_FragCoord.xy+o))/u_input.resolution.y;
-    #else
-    vec2 p = (-u_input.resolution + 2.0*gl_FragCoord.xy)/u_input.resolution.y;
-    #endif
-    p.y = -p.y;
-
-    // camera
-    vec3 ro = vec3( -0.5+3.5*cos(0.1*time + 6.0*mo.x), 1.0 + 6.0*mo.y, 0.5 + 4.0*sin(0.1*time + 6.0*mo.x) );
-    vec3 ta = vec3( -0.5, -0.4, 0.5 );
-    // camera-to-world transformation
-    mat3 ca = setCamera( ro, ta, 0.0 );
-    // ray direction
-    vec3 rd = ca * normalize( vec3(p.xy,2.0) );
+    // pixel coordinates (the pixel center without AA)
+    vec2 o = AA>1 ? vec2(float(m),float(n)) / float(AA) - 0.5 : vec2(0.0);
+    vec2 fragCoord = gl_FragCoord.xy+o;
+
+    vec3 ro, rd;
+    setupRay( fragCoord, ro, rd );
 
 //    vec2 texCoord = vec2(1, 1);
     float depth = LinearizeDepth(texture(depthTexture, vECTexCoords).r); // rasterized Depth
@@ -242,10 +566,8 @@ void main( )
     col = pow( col, vec3(0.4545) );
 
     tot += col;
-    #if AA>1
   }
   tot /= float(AA*AA);
-  #endif
 
   outColor = vec4( tot, 1.0 );
 }
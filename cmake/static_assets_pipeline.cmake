@@ -29,6 +29,8 @@ set(PARTS_SHADERS_PATH          ${SDFR_SHADERS_PATH}/_partials)
 
 set(SPV_COMPILE_SCRIPT          ./spirv_static_compile.sh)
 set(SPV_PARTS_COMPILE_SCRIPT    ./spirv_partials_compile.sh)
+set(BUNDLE_PACK_SCRIPT          ./asset_bundle_pack.sh)
+set(BUNDLE_PATH                 assets.bundle)
 
 find_program(SHELL bash HINTS /bin)
 
@@ -43,6 +45,11 @@ execute_process(
     ${SOURCE_DIR}/${SPV_PARTS_COMPILE_SCRIPT}
     ${BIN_DIR}
 
+    # Copy Asset Bundle Pack Script
+    COMMAND ${CMAKE_COMMAND} -E copy_if_different
+    ${SOURCE_DIR}/${BUNDLE_PACK_SCRIPT}
+    ${BIN_DIR}
+
     # Copy All Assets
     COMMAND ${CMAKE_COMMAND} -E copy_directory
     ${SOURCE_DIR}/${ASSETS_PATH}
@@ -82,3 +89,11 @@ execute_process(
     WORKING_DIRECTORY ${BIN_DIR}
     COMMAND_ERROR_IS_FATAL ANY
 )
+execute_process(
+    # Pack: Compiled Shaders, Partials & Meshes (see include/AssetBundle.hpp)
+    COMMAND ${CMAKE_COMMAND} -E env ${SHELL} -c
+    "ASSETS_PATH=${ASSETS_PATH} BUNDLE_PATH=${BUNDLE_PATH} . ${BUNDLE_PACK_SCRIPT}"
+
+    WORKING_DIRECTORY ${BIN_DIR}
+    COMMAND_ERROR_IS_FATAL ANY
+)
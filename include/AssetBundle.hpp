@@ -0,0 +1,86 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+#include "_constants.hpp"
+
+namespace sdfRay4d
+{
+  /**
+   * @class AssetBundle
+   * @brief read-only view of the packed static assets (shaders, partials,
+   * meshes), written by the static assets pipeline (asset_bundle_pack.sh)
+   *
+   * @note the bundle is memory-mapped once at startup (see open) and its
+   * entries are served as raw views into the mapping, so loading an asset
+   * neither opens a file nor copies it. Assets missing from the bundle, or
+   * all of them without a bundle, are read from their loose files instead.
+   *
+   * @note layout (little endian):
+   * - Header
+   * - Entry index, sorted by path (byte-wise)
+   * - Paths, relative to the working directory (e.g. assets/models/block.buf)
+   * - Data, each entry aligned to constants::bundle::alignment,
+   *   identical contents are stored once
+   */
+  class AssetBundle
+  {
+    public:
+      /**
+       * @struct Header
+       */
+      struct Header
+      {
+        char magic[4]         = { 'S', 'R', 'A', 'B' };
+        uint32_t version      = constants::bundle::version;
+        uint32_t entryCount   = 0;
+        uint32_t alignment    = constants::bundle::alignment;
+        uint64_t indexOffset  = 0;
+        uint64_t pathsOffset  = 0;
+      };
+
+      /**
+       * @struct Entry
+       */
+      struct Entry
+      {
+        uint32_t pathOffset = 0; // from Header::pathsOffset
+        uint32_t pathSize   = 0;
+        uint64_t dataOffset = 0;
+        uint64_t dataSize   = 0;
+        uint8_t hash[constants::bundle::hashSize] = {};
+      };
+
+      static_assert(sizeof(Header) == 32 && sizeof(Entry) == 32, "see asset_bundle_pack.sh");
+
+    /**
+     * @note open on the main thread before any asset is loaded,
+     * the lookups are read-only (thread-safe) afterwards
+     */
+    public:
+      static bool open(const QString &_filePath = constants::bundle::filePath);
+      static bool isOpen();
+
+      static QByteArray get(const QString &_assetPath);
+      static QByteArray read(const QString &_assetPath);
+
+    private:
+      AssetBundle() = default;
+      static AssetBundle &getInstance();
+
+      bool map(const QString &_filePath);
+      bool isValid() const;
+      bool isHashValid(const Entry &_entry) const;
+      const Entry *find(const QByteArray &_path) const;
+
+    private:
+      QFile m_file;
+
+      const uchar *m_data     = nullptr; // mapped until the process exits
+      qint64 m_size           = 0;
+      const Header *m_header  = nullptr;
+      const Entry *m_entries  = nullptr;
+  };
+}
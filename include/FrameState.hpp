@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QMatrix4x4>
+
+#include "Material.hpp"
+
+namespace sdfRay4d
+{
+  using namespace vk;
+
+  /**
+   * @struct FrameState
+   * @brief immutable snapshot of everything the frame worker needs
+   * to record a frame
+   *
+   * @note the renderer publishes a new snapshot whenever the editor side
+   * changes (camera, swapchain push constants, SDFR pipeline swap) and
+   * the frame worker picks up the latest one with an atomic load
+   * at the start of each frame, so frame building never blocks on
+   * the editor. Pipeline handles and push constants are copied, as
+   * the materials themselves are mutated in-place by pipeline swaps.
+   */
+  struct FrameState
+  {
+    using MaterialPtr       = std::shared_ptr<Material<>>;
+    using PushConstantList  = Material<>::PushConstantList;
+
+    /**
+     * @struct Pass
+     * @brief a material draw with its pipeline state at publish time
+     */
+    struct Pass
+    {
+      MaterialPtr         material; // keeps buffers/descriptors alive
+      pipeline::Pipeline  pipeline        = VK_NULL_HANDLE;
+      pipeline::Layout    pipelineLayout  = VK_NULL_HANDLE;
+      PushConstantList    pushConstants;
+      std::string         name; // profiler label
+      uint32_t            vertexCount     = 0; // e.g. the actor mesh is replaced at runtime
+      buffer::Buffer      vertexBuffer    = VK_NULL_HANDLE; // e.g. the depth pass draws the actor mesh
+      uint32_t            indexCount      = 0; // indexed draw if any
+      device::Size        indexOffset     = 0; // of the (uint32) indices in vertexBuffer
+      device::Size        vertexOffset    = 0; // of the vertices in vertexBuffer
+      uint32_t            groupCount      = 0; // compute dispatch (x), e.g. per tile
+      std::vector<uint32_t> dynamicOffsets;     // of the dynamic storage buffers (binding order), e.g. SDFR storage slots
+    };
+
+    using PassList = std::vector<Pass>;
+
+    PassList      computePasses;    // dispatched in order, before any RenderPass (e.g. SDFR tile binning)
+    PassList      depthPasses;      // custom RenderPass (depth attachment only)
+    PassList      offscreenPasses;  // material's offscreen RenderPass (reduced resolution)
+    PassList      mainPasses;       // default Qt Vulkan RenderPass
+    MaterialPtr   barrierMaterial;
+    MaterialPtr   offscreenMaterial; // owner of the offscreen target
+    MaterialPtr   computeMaterial;  // owner of the (per frame cleared) compute target, e.g. tile bins
+    device::Size  computeClearSize = 0; // bytes of the compute target cleared per frame, e.g. the binned tiles'
+
+    uint32_t      offscreenWidth  = 0; // offscreen target extent
+    uint32_t      offscreenHeight = 0;
+    float         lightingScale   = 1.0f; // of the swapchain extent, 1.0: in the main SDFR pass
+
+    QMatrix4x4    view;
+    QMatrix4x4    proj;
+    QMatrix4x4    actorDequantization; // of the actor's vertices (see MeshOptimizer)
+
+    uint64_t      version = 0;
+  };
+
+  using FrameStatePtr = std::shared_ptr<const FrameState>;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "Types.hpp"
+#include "SPSCQueue.hpp"
+
+namespace sdfRay4d
+{
+  using namespace vk;
+
+  /**
+   * @struct FrameJob
+   * @brief per-frame state captured on the GUI thread (startNextFrame),
+   * as Qt Vulkan's current frame accessors are only valid there
+   */
+  struct FrameJob
+  {
+    command::CmdBuffer        cmdBuffer   = VK_NULL_HANDLE;
+    framebuffer::Framebuffer  framebuffer = VK_NULL_HANDLE;
+    int                       frameId     = 0;
+    uint32_t                  width       = 0;
+    uint32_t                  height      = 0;
+  };
+
+  /**
+   * @class FrameWorker
+   * @brief persistent (optionally core-pinned) render thread
+   * fed by a lock-free single-producer/single-consumer frame job queue
+   *
+   * @note the producer (GUI thread) never takes a lock on the hot path.
+   * The worker polls the queue only briefly after each job (e.g. jobs
+   * queued back to back) and then parks on a condition variable until
+   * the producer wakes it up after pushing the next (frame's) job, so it
+   * doesn't keep a core busy between frames.
+   */
+  class FrameWorker
+  {
+    public:
+      using Callback = std::function<void(const FrameJob &_job)>;
+
+    public:
+      FrameWorker() = default;
+      FrameWorker(const FrameWorker&) = delete;
+      ~FrameWorker();
+
+    public:
+      void start(
+        const Callback &_callback,
+        int _pinnedCore = constants::frameWorker::pinnedCore
+      );
+      void stop();
+
+      bool submit(const FrameJob &_job) noexcept;
+      void waitForIdle() const noexcept;
+
+      [[nodiscard]] bool isRunning() const noexcept { return m_isRunning.load(std::memory_order_acquire); }
+
+    private:
+      void run();
+      void pin(int _core) noexcept;
+
+    private:
+      Callback                  m_callback;
+      std::thread               m_thread;
+
+      SPSCQueue<FrameJob, constants::frameWorker::jobCapacity> m_jobs;
+
+      std::atomic<bool>         m_isRunning       { false };
+      std::atomic<bool>         m_isParked        { false };
+      std::atomic<uint64_t>     m_submittedCount  { 0 };
+      std::atomic<uint64_t>     m_completedCount  { 0 };
+
+      /**
+       * @note parking only (slow path)
+       */
+      std::mutex                m_parkMutex;
+      std::condition_variable   m_parkCondition;
+  };
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstring>
+
 #include "Shader.hpp"
 #include "Texture.hpp"
 #include "VKHelpers/PSO.hpp"
@@ -29,6 +31,7 @@ namespace sdfRay4d
   struct Material
   {
     using ShaderStageInfoList = std::vector<pipeline::ShaderStageInfo>;
+    using SpecEntryList       = std::vector<pipeline::SpecializationEntry>;
     using DescPoolSizeList    = std::vector<descriptor::PoolSize>;
     using LayoutBindingList   = std::vector<descriptor::LayoutBinding>;
     using DescLayoutList      = std::vector<descriptor::Layout>;
@@ -51,9 +54,16 @@ namespace sdfRay4d
     device::Size                vertUniSize             = 0;
     device::Size                fragUniSize             = 0;
     device::Size                uniMemStartOffset       = 0;
+    device::Size                bufferMemOffset         = 0; // of buffer in the shared allocation
     memory::Reqs                memReq                  = {};
     memory::Reqs                dynamicUniformMemReq    = {};
 
+    // Storage Buffer (e.g. SDFR brick map, mesh volume)
+    buffer::Buffer              storageBuffer           = VK_NULL_HANDLE;
+    device::Size                storageSize             = 0;
+    device::Size                storageMemOffset        = 0;
+    memory::Reqs                storageMemReq           = {};
+
     // Descriptor
     descriptor::Pool            descPool                = VK_NULL_HANDLE;
     DescPoolSizeList            descPoolSizes;
@@ -71,18 +81,34 @@ namespace sdfRay4d
     // PSO
     PSO                         pso;
 
+    // Specialization Constants (fragment stage, see PipelineHelper::initShaderStages)
+    SpecEntryList               specEntries;
+    std::vector<uint8_t>        specData;
+    pipeline::SpecializationInfo specInfo               = {};
+
     // Pipeline
     ShaderStageInfoList         shaderStages;
     pipeline::StageFlags        sourceStage             = {};
     pipeline::StageFlags        destinationStage        = {};
     pipeline::Layout            pipelineLayout          = VK_NULL_HANDLE;
     pipeline::Pipeline          pipeline                = VK_NULL_HANDLE;
+    pipeline::Pipeline          offscreenPipeline       = VK_NULL_HANDLE; // same shaders/layout, offscreenRenderPass
 
     // RenderPass
     renderpass::RenderPass      renderPass              = VK_NULL_HANDLE;
     framebuffer::Framebuffer    framebuffer             = VK_NULL_HANDLE;
 
+    // Offscreen RenderPass (e.g. reduced resolution SDFR lighting target)
+    renderpass::RenderPass      offscreenRenderPass     = VK_NULL_HANDLE;
+    framebuffer::Framebuffer    offscreenFramebuffer    = VK_NULL_HANDLE;
+
     uint32_t                    vertexCount             = 0;
+    uint32_t                    indexCount              = 0; // indexed draw if any
+    device::Size                vertexOffset            = 0; // of the drawn vertices in buffer (e.g. actor slot)
+    device::Size                indexOffset             = 0; // of the (uint32) indices, from vertexOffset
+
+    // Debug (e.g. GPU profiler pass label)
+    std::string                 name;
 
     bool                        isHotSwappable          = false;
     bool                        isDefault               = true;
@@ -132,5 +158,23 @@ namespace sdfRay4d
       pushConstantRange.offset      = _offset;
       pushConstantRange.size        = _size;
     }
+
+    /**
+     * @brief sets the fragment shader's specialization constants,
+     * applied on the next pipeline creation
+     *
+     * @param[in] _data (trivially copyable) constant values
+     * @param[in] _entries constant ids with their offsets in _data
+     */
+    template<typename TData>
+    void setSpecialization(
+      const TData &_data,
+      const SpecEntryList &_entries
+    )
+    {
+      specEntries = _entries;
+      specData.resize(sizeof(TData));
+      std::memcpy(specData.data(), &_data, sizeof(TData));
+    }
   };
 }
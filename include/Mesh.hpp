@@ -1,6 +1,9 @@
 #pragma once
 
+#include <memory>
+
 #include <QString>
+#include <QFile>
 #include <QFuture>
 
 #include "Types.hpp"
@@ -20,10 +23,14 @@ namespace sdfRay4d
         int vertexCount = 0;
         float aabb[6];
         QByteArray geom; // x, y, z, u, v, nx, ny, nz
+        std::shared_ptr<const QFile> file; // memory-mapped, geom is a raw view into it (see load), null if bundled
       };
 
+      using DataPtr = std::shared_ptr<const Data>;
+
     public:
       void load(const QString &_fileName);
+      void set(const Data &_data);
       Data *data();
       bool isValid() { return data()->isValid(); }
       void reset();
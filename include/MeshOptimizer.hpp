@@ -0,0 +1,89 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "_constants.hpp"
+#include "Mesh.hpp"
+
+namespace sdfRay4d
+{
+  /**
+   * @class MeshOptimizer
+   * @brief converts a triangle soup (Mesh::Data, 8 floats per vertex)
+   * into the compact, indexed vertex format drawn by the actor/depth passes
+   *
+   * @note import-time steps:
+   * - quantization: positions to 16 bit unorm within the mesh bounds,
+   *   normals to octahedral 16 bit snorm, texture coordinates to half floats
+   * - deduplication of the quantized vertices, degenerate triangles dropped
+   * - post-transform vertex cache optimization of the triangle order (Tipsify)
+   * - vertex fetch optimization, vertices in order of first use
+   */
+  class MeshOptimizer
+  {
+    public:
+      /**
+       * @struct Vertex
+       * @brief 16 bytes, see setVertexInputState
+       *
+       * @note position.w is 65535 (unorm 1.0) so it's read as a point
+       */
+      struct Vertex
+      {
+        uint16_t position[4]  = {}; // R16G16B16A16_UNORM, [0, 1] within the bounds
+        int16_t normal[2]     = {}; // R16G16_SNORM, octahedral encoding
+        uint16_t texCoord[2]  = {}; // R16G16_SFLOAT
+      };
+
+      /**
+       * @struct Data
+       * @note vertices are dequantized with: min + position * extent
+       */
+      struct Data
+      {
+        [[nodiscard]] bool isValid() const { return !indices.empty(); }
+
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        float min[3]    = {};
+        float extent[3] = {};
+      };
+
+      using DataPtr = std::shared_ptr<const Data>;
+
+      /**
+       * @struct Stats
+       */
+      struct Stats
+      {
+        int sourceVertexCount = 0;
+        uint64_t sourceBytes  = 0;
+        uint64_t packedBytes  = 0; // vertices + indices
+        float sourceACMR      = 0.0f; // average cache miss ratio (transformed vertices per triangle)
+        float packedACMR      = 0.0f;
+      };
+
+    public:
+      static DataPtr optimize(
+        const Mesh::Data &_mesh,
+        Stats *_stats = nullptr
+      );
+
+    private:
+      static Data quantize(const Mesh::Data &_mesh);
+
+    /**
+     * Vertex Cache Helpers
+     * -------------------------------------------------
+     *
+     */
+    private:
+      static void optimizeVertexCache(Data &_data);
+      static void optimizeVertexFetch(Data &_data);
+      static float getACMR(
+        const std::vector<uint32_t> &_indices,
+        size_t _vertexCount
+      );
+  };
+}
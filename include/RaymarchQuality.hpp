@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "Types.hpp"
+
+namespace sdfRay4d
+{
+  using namespace vk;
+
+  /**
+   * @struct RaymarchQuality
+   * @brief SDFR fragment shader's quality knobs, bound as specialization
+   * constants in declaration (constant_id) order, see sdfr_pass.frag
+   *
+   * @note changing them only recreates the SDFR pipeline from the
+   * already compiled SPIR-V (see Renderer::applyRaymarchQuality)
+   */
+  struct RaymarchQuality
+  {
+    int32_t antialiasing  = 1;        // AA, samples per pixel side
+    int32_t marchSteps    = 64;       // castRay iterations
+    int32_t shadowSteps   = 16;       // softshadow iterations
+    int32_t aoTaps        = 5;        // calcAO samples
+    float precision       = 0.0005f;  // hit threshold, per unit of distance
+    float maxDistance     = 20.0f;    // castRay tmax
+    float relaxation      = 1.6f;     // castRay over-relaxation, [1, 2), 1: plain sphere tracing
+
+    [[nodiscard]] bool operator==(const RaymarchQuality &_quality) const
+    {
+      return
+        antialiasing  == _quality.antialiasing &&
+        marchSteps    == _quality.marchSteps &&
+        shadowSteps   == _quality.shadowSteps &&
+        aoTaps        == _quality.aoTaps &&
+        precision     == _quality.precision &&
+        maxDistance   == _quality.maxDistance &&
+        relaxation    == _quality.relaxation;
+    }
+
+    enum class Preset : uint8_t
+    {
+      LOW,
+      MEDIUM, // shader defaults
+      HIGH,
+      ULTRA
+    };
+
+    [[nodiscard]] static RaymarchQuality get(Preset _preset)
+    {
+      static constexpr const std::array<RaymarchQuality, 4> presets = {{
+        { 1,  32,  8, 3, 0.002f,   12.0f, 1.8f },
+        { 1,  64, 16, 5, 0.0005f,  20.0f, 1.6f },
+        { 2,  96, 24, 5, 0.00025f, 30.0f, 1.5f },
+        { 3, 128, 32, 8, 0.0001f,  40.0f, 1.4f }
+      }};
+
+      return presets[(size_t) _preset];
+    }
+
+    /**
+     * @return one map entry per member, constant_id = member index
+     */
+    [[nodiscard]] static std::vector<pipeline::SpecializationEntry> getMapEntries()
+    {
+      return {
+        { 0, offsetof(RaymarchQuality, antialiasing), sizeof(int32_t) },
+        { 1, offsetof(RaymarchQuality, marchSteps),   sizeof(int32_t) },
+        { 2, offsetof(RaymarchQuality, shadowSteps),  sizeof(int32_t) },
+        { 3, offsetof(RaymarchQuality, aoTaps),       sizeof(int32_t) },
+        { 4, offsetof(RaymarchQuality, precision),    sizeof(float) },
+        { 5, offsetof(RaymarchQuality, maxDistance),  sizeof(float) },
+        { 6, offsetof(RaymarchQuality, relaxation),   sizeof(float) }
+      };
+    }
+  };
+}
@@ -1,12 +1,21 @@
 #pragma once
 
-#include <QFutureWatcher>
+#include <QFuture>
+
+#include <list>
 
 #include "VKHelpers/Pipeline.hpp"
 #include "Window/VulkanWindow.hpp"
 #include "Mesh.hpp"
+#include "MeshOptimizer.hpp"
 #include "Camera.hpp"
 #include "SDFGraph.hpp"
+#include "SDFGraph/BrickMap.hpp"
+#include "SDFGraph/MeshSDF.hpp"
+#include "SDFGraph/Tape.hpp"
+#include "FrameWorker.hpp"
+#include "FrameState.hpp"
+#include "RaymarchQuality.hpp"
 
 namespace sdfRay4d
 {
@@ -57,9 +66,51 @@ namespace sdfRay4d
      */
     public:
       MaterialPtr &getSDFRMaterial(bool _isNew = false);
-      void createSDFRPipeline();
+      void createSDFRPipeline(
+        uint64_t _graphKey = 0,
+        const sdfGraph::Tape::DataPtr &_tape = nullptr
+      );
+      bool useCachedSDFRPipeline(uint64_t _graphKey);
       void swapSDFRPipelines();
 
+    /**
+     * GPU Profiler (per pass timestamps/statistics)
+     * -------------------------------------------------
+     */
+    public:
+      vkHelpers::ProfilerHelper &getProfiler() { return m_pipelineHelper.getProfilerHelper(); }
+
+    /**
+     * SDFR Lighting (soft shadows/AO) resolution
+     * -------------------------------------------------
+     */
+    public:
+      void setLightingScale(float _scale);
+
+    /**
+     * SDFR Raymarch Quality (specialization constants)
+     * -------------------------------------------------
+     */
+    public:
+      bool setRaymarchQuality(const RaymarchQuality &_quality);
+      bool applyRaymarchQuality();
+
+    /**
+     * SDF Graph Brick Map (baked static primitives)
+     * -------------------------------------------------
+     */
+    public:
+      void setBrickMap(const sdfGraph::BrickMap::DataPtr &_data);
+      void setMeshVolume(const sdfGraph::MeshSDF::DataPtr &_data);
+      bool setSceneTape(const sdfGraph::Tape::DataPtr &_data);
+
+    /**
+     * Actor Mesh (e.g. extracted from the SDF Graph)
+     * -------------------------------------------------
+     */
+    public:
+      void setActorMesh(const Mesh::DataPtr &_data);
+
     /**
      * Frame - User Input Helpers/Handlers
      * -------------------------------------------------
@@ -77,6 +128,7 @@ namespace sdfRay4d
      */
     private:
       void initVkFunctions();
+      vkHelpers::UploadHelper::Queue getTransferQueue();
 
     /**
      * Resources: Init Materials Helpers
@@ -89,6 +141,7 @@ namespace sdfRay4d
       void initActorMaterial();
       void initSDFRMaterial();
       void initSDFRMaterial(const MaterialPtr &_material);
+      void initBinningMaterial();
 
     /**
      * Resources: Init Shaders Helpers
@@ -100,6 +153,52 @@ namespace sdfRay4d
       void initDepthShaders();
       void initActorShaders();
       void initSDFRShaders();
+      void initBinningShaders();
+
+    /**
+     * SDFR Pipeline Cache Helpers
+     * -------------------------------------------------
+     * - GUI thread/swap worker (m_guiMutex)
+     */
+    private:
+      /**
+       * @struct SDFRPipeline
+       * @brief built SDFR pipeline of an SDF Graph revision, shared by the
+       * SDFR material (current) and the cache, retired (see RetiredPipeline)
+       * once neither refers to it anymore
+       *
+       * @note the descriptor sets are the SDFR material's, every
+       * revision's layout is created from the same set layouts
+       *
+       * @note a compiled revision's mapMarch culls its nodes by the tape's
+       * node table (see Tape), so its tape is uploaded along with it
+       */
+      struct SDFRPipeline
+      {
+        pipeline::Pipeline pipeline = VK_NULL_HANDLE;
+        pipeline::Layout layout = VK_NULL_HANDLE;
+        pipeline::Pipeline offscreenPipeline = VK_NULL_HANDLE;
+        uint64_t graphKey = 0; // see SDFGraph::getPipelineKey, 0: tape interpreter (initial)
+        RaymarchQuality quality;
+        std::vector<uint32_t> spvBytes; // fragment shader, see applyRaymarchQuality
+        sdfGraph::Tape::DataPtr tape; // of the revision (node table), nullptr: tape interpreter's/none
+      };
+
+      using SDFRPipelinePtr = std::shared_ptr<SDFRPipeline>;
+
+    private:
+      SDFRPipelinePtr createSDFRPipelinePtr(
+        const MaterialPtr &_material,
+        uint64_t _graphKey,
+        const RaymarchQuality &_quality,
+        const std::vector<uint32_t> &_spvBytes,
+        const sdfGraph::Tape::DataPtr &_tape
+      );
+      const SDFRPipelinePtr &getSDFRPipeline();
+      SDFRPipelinePtr findSDFRPipeline(uint64_t _graphKey);
+      void cacheSDFRPipeline(const SDFRPipelinePtr &_pipeline);
+      void setSDFRPipeline(const SDFRPipelinePtr &_pipeline);
+      void releaseSDFRPipelines();
 
     /**
      * Swapchain Resource Helpers
@@ -108,25 +207,65 @@ namespace sdfRay4d
      */
     private:
       void createDepthView();
+      void createLightingView();
 
     private:
       void markViewProjDirty();
 
     /**
-     * Frame Helpers (on Worker Thread)
+     * Frame Helpers (on Frame Worker Thread)
      * -------------------------------------------------
      * - Buffers
      * - Update Descriptor Sets
      * - Commands
      */
     private:
-      void buildFrame();
+      void buildFrame(const FrameJob &_job);
       void createBuffers();
       void updateDescriptorSets();
-      void executeCommands();
+      void updateActorUniforms(
+        const FrameJob &_job,
+        const FrameState &_frameState
+      );
+      void executeCommands(
+        const FrameJob &_job,
+        const FrameState &_frameState
+      );
+
+    /**
+     * Frame State Snapshot Helpers
+     * -------------------------------------------------
+     * - published by GUI thread/swap worker (m_guiMutex)
+     * - consumed by the frame worker (lock-free)
+     */
+    private:
+      void initFrameState();
+      uint64_t publishFrameState(bool _isInitial = false);
+      FrameState::Pass createPass(const MaterialPtr &_material) const;
+      FrameState::PassList createBinningPasses(const FrameState::Pass &_sdfrPass) const;
+      uint32_t getBinningTileCount() const;
+      void destroyRetiredSDFRPipelines(bool _isForced = false);
+      bool uploadStorage();
+      bool uploadBrickMap();
+      bool uploadMeshVolume();
+      bool uploadSceneTape();
+      void setPendingSceneTape(uint64_t _graphKey, const sdfGraph::Tape::DataPtr &_tape);
+      void publishStorageSlots();
+      void uploadActorMesh();
+      void swapActorMesh();
+      bool uploadVertices();
+      bool streamUpload(
+        const buffer::Buffer &_dstBuffer,
+        device::Size _dstOffset,
+        const void *_data,
+        size_t _byteSize,
+        size_t &_uploadedSize
+      );
+      static MeshOptimizer::DataPtr optimizeActorMesh(const Mesh::Data &_data);
 
     private:
       const PhysicalDeviceLimits *getDeviceLimits() const;
+      uint32_t getTimestampValidBits() const;
       device::Size setDynamicOffsetAlignment(
         device::Size _offset
       );
@@ -135,11 +274,14 @@ namespace sdfRay4d
       bool m_isMSAA = false;
       bool m_isFramePending = false;
       bool m_isNewWorker = false;
+      bool m_isRaymarchQualityPending = false; // m_guiMutex, see applyRaymarchQuality
 
       float m_rotation = 0.0f;
       float m_verticalAngle = 45.0f;
       float m_nearPlane = 0.01f;
       float m_farPlane = 1000.0f;
+      float m_lightingScale = constants::lighting::defaultScale;
+      RaymarchQuality m_raymarchQuality; // m_guiMutex, next SDFR pipelines' specialization
       int m_concurrentFrameCount = 0;
 
       Mesh m_actorMesh;
@@ -171,16 +313,25 @@ namespace sdfRay4d
     private:
       QVector3D m_lightPos;
       QMatrix4x4 m_proj;
+      QMatrix4x4 m_actorDequantization; // m_guiMutex, see MeshOptimizer
       QSize m_windowSize;
+      QSize m_lightingExtent; // offscreen lighting target
 
     /**
      * Qt Members - Multi-threading
      */
     private:
-      QFutureWatcher<void> m_frameWatcher;
+      FrameWorker m_frameWorker;
       QFuture<void> m_swapWorker;
-      QFuture<void> m_destroyWorker;
-      QMutex m_guiMutex;
+      QMutex m_guiMutex; // editor side writers only, never taken by the frame worker
+
+    /**
+     * Frame State Snapshots
+     */
+    private:
+      FrameStatePtr m_frameState; // std::atomic_load/atomic_store only
+      uint64_t m_frameStateVersion = 0;
+      std::atomic<uint64_t> m_builtFrameCount { 0 };
 
     /**
      * Materials
@@ -190,13 +341,83 @@ namespace sdfRay4d
       MaterialPtr m_actorMaterial   = VK_NULL_HANDLE;
       MaterialPtr m_sdfrMaterial    = VK_NULL_HANDLE;
       MaterialPtr m_newSDFRMaterial = VK_NULL_HANDLE;
+      MaterialPtr m_binningMaterial = VK_NULL_HANDLE; // SDFR tile binning (compute)
 
       std::vector<MaterialPtr> m_materials;
 
-      struct
+      /**
+       * @struct RetiredPipeline
+       * @brief swapped out SDFR pipeline, destroyed once no frame
+       * in flight records with it, same as the actor slots (see swapActorMesh)
+       */
+      struct RetiredPipeline
+      {
+        pipeline::Pipeline pipeline = VK_NULL_HANDLE;
+        pipeline::Layout layout = VK_NULL_HANDLE;
+        uint64_t freeFrame = 0; // built frame count from which it isn't used
+        pipeline::Pipeline offscreenPipeline = VK_NULL_HANDLE;
+      };
+
+      std::vector<RetiredPipeline> m_retiredPipelines; // m_guiMutex
+
+      SDFRPipelinePtr m_sdfrPipeline; // current (m_sdfrMaterial's), m_guiMutex
+      SDFRPipelinePtr m_pendingSDFRPipeline; // cached, to be swapped in, m_guiMutex
+      std::list<SDFRPipelinePtr> m_sdfrPipelineCache; // most recently used first, m_guiMutex
+      std::atomic<bool> m_isSDFRPipelinePending { false }; // wakes up the swap worker
+      uint64_t m_newSDFRGraphKey = 0; // of the pipeline being created
+      bool m_isNewSDFRStale = false; // edited (interpreted) since, cached only once created
+      RaymarchQuality m_newSDFRQuality; // of the pipeline being created
+      sdfGraph::Tape::DataPtr m_newSDFRTape; // of the pipeline being created
+
+      sdfGraph::BrickMap::DataPtr m_pendingBrickMap; // m_guiMutex
+      sdfGraph::MeshSDF::DataPtr m_pendingMeshVolume; // m_guiMutex
+      sdfGraph::Tape::DataPtr m_pendingSceneTape; // m_guiMutex
+      MeshOptimizer::DataPtr m_pendingActorMesh; // m_guiMutex
+      std::atomic<bool> m_isActorMeshPending { false }; // wakes up the swap worker (pending/uploading)
+
+      /**
+       * @struct ActorUpload
+       * @brief actor mesh being uploaded into the spare buffer slot,
+       * swapped in once its token completed
+       */
+      struct ActorUpload
       {
-        pipeline::Pipeline pipeline;
-        pipeline::Layout layout;
-      } m_oldPipeline = {};
+        vkHelpers::UploadHelper::Token token = 0; // once every byte is uploaded
+        MeshOptimizer::DataPtr data;
+        uint32_t slot = 0;
+        size_t uploadedSize = 0; // vertices, then indices (see uploadVertices)
+      };
+
+      ActorUpload m_actorUpload; // m_guiMutex
+      uint32_t m_actorSlot = 0; // drawn, m_guiMutex
+      uint64_t m_actorSlotFreeFrame = 0; // built frame count from which the spare slot isn't read, m_guiMutex
+
+      /**
+       * @struct StorageRange
+       * @brief double buffered range of the SDFR storage buffer (brick map,
+       * mesh volume, scene tape), its spare slot is uploaded into once no frame
+       * in flight reads it, same as the actor slots (see uploadStorage)
+       */
+      struct StorageRange
+      {
+        using DataPtr = std::shared_ptr<const std::vector<uint32_t>>;
+
+        device::Size offset   = 0; // of slot 0 in the storage buffer
+        device::Size slotSize = 0; // aligned to minStorageBufferOffsetAlignment (dynamic offset)
+        uint32_t slot          = 0; // last written
+        uint32_t publishedSlot = 0; // drawn by the last published snapshot
+        uint64_t freeFrame     = 0; // built frame count from which the spare slot isn't read
+
+        DataPtr upload; // being uploaded into the spare slot
+        size_t uploadedSize = 0;
+        vkHelpers::UploadHelper::Token token = 0; // once every byte is uploaded
+      };
+
+      bool isStorageBusy(const StorageRange &_range) const;
+      bool uploadStorage(StorageRange &_range, const StorageRange::DataPtr &_data);
+
+      StorageRange m_brickMapRange; // m_guiMutex
+      StorageRange m_meshVolumeRange; // m_guiMutex
+      StorageRange m_tapeRange; // m_guiMutex
   };
 }
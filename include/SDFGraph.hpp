@@ -6,9 +6,14 @@
 #include <nodes/DataModelRegistry>
 #include <nodes/ConnectionStyle>
 
+#include <QTimer>
+
 #include "Window/VulkanWindow.hpp"
 
 #include "SDFGraph/DataModels/MapDataModel.hpp"
+#include "SDFGraph/BrickMap.hpp"
+#include "SDFGraph/MeshSDF.hpp"
+#include "SDFGraph/Tape.hpp"
 
 namespace sdfRay4d
 {
@@ -33,17 +38,27 @@ namespace sdfRay4d
       FlowView *getView() { return m_graphView; }
       void setAutoCompile(bool _isAutoCompile = false);
       void terminateAutoCompile() { m_isAutoCompile = false; }
+      void setOptimization(SPIRVCompiler::Optimization _optimization);
 
     public slots:
       void compile(bool _isAutoCompile = false);
+      void extractMesh();
       void removeMapNode(const sdfGraph::Connection &_connection);
 
     private:
       static DataModelRegistryPtr registerModels();
       static void setStyle();
 
+    private slots:
+      void specialize();
+      void optimize();
+
     private:
       void autoCompile();
+      void printShaderStats(bool _isOptimized) const;
+      [[nodiscard]] uint64_t getPipelineKey(bool _isFastOptimization) const;
+      sdfGraph::ir::Scene createScene() const;
+      void setMeshVolume(sdfGraph::ir::Scene &_scene);
       const NodePtrMap &getNodes() { return m_graphScene->nodes(); }
       void setMapNodes();
       void setMapNodeConnections(sdfGraph::MapDataModel *_mapDataModel) const;
@@ -68,10 +83,21 @@ namespace sdfRay4d
     private:
       MaterialPtr m_sdfrMaterial = VK_NULL_HANDLE;
       MapDataModelPtrSet m_mapNodes;
+      sdfGraph::BrickMap m_brickMap;
+      sdfGraph::ir::VolumePtr m_meshVolume = nullptr; // last uploaded
 
       bool m_isAutoCompile = false;
       bool m_isMapNodeRemoved = false;
 
+      SPIRVCompiler::Optimization m_optimization = SPIRVCompiler::isOptimizerAvailable()
+        ? SPIRVCompiler::Optimization::PERFORMANCE
+        : SPIRVCompiler::Optimization::OFF;
+      QTimer *m_specializeTimer = nullptr; // idle-time compile of the interpreted scene (restarted per edit)
+      QTimer *m_optimizeTimer = nullptr; // idle-time full optimization (restarted per compile)
+      std::string m_shaderData; // last compiled map()
+      sdfGraph::Tape::DataPtr m_sceneTape; // of the last compiled map() (node table), nullptr: none
+
       QFuture<void> m_worker;
+      QFuture<void> m_meshWorker;
   };
 }
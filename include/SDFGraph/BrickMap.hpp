@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "SDFGraph/Evaluator.hpp"
+
+namespace sdfRay4d::sdfGraph
+{
+  /**
+   * @class BrickMap
+   * @brief sparse distance volume of the graph's static primitives
+   *
+   * @note a coarse grid of cells covers the (padded) bounds of the
+   * static primitives. Cells close to the surface point to a brick of
+   * brickSize^3 (distance, material) samples, all the others are empty
+   * and only store whether they are inside or outside of the surface.
+   * The map is sampled trilinearly in the SDFR fragment shader
+   * (see volumes.partial.glsl for the GPU data layout).
+   *
+   * @note only the cells around primitives that changed since the last
+   * bake are re-baked, the grid is only rebuilt if it needs to grow
+   */
+  class BrickMap
+  {
+    public:
+      using Data    = std::vector<uint32_t>;
+      using DataPtr = std::shared_ptr<const Data>;
+
+    public:
+      bool bake(ir::Scene &_scene);
+      void clear() noexcept;
+
+      DataPtr getData() noexcept;
+
+      [[nodiscard]] bool isDirty() const noexcept { return m_isDirty; }
+
+    private:
+      using Index3 = std::array<int, 3>;
+      using Bounds = Evaluator::Bounds;
+
+    private:
+      static bool isBakeable(const ir::Primitive &_primitive) noexcept;
+
+    private:
+      bool resize(const Bounds &_bounds) noexcept;
+      [[nodiscard]] bool contains(const Bounds &_bounds) const noexcept;
+      bool bakeCells(const Bounds &_bounds) noexcept;
+      bool bakeCell(const Index3 &_cell) noexcept;
+      void bakeBrick(uint32_t _brick, const Index3 &_cell) noexcept;
+      void releaseBrick(uint32_t _cellIndex) noexcept;
+
+    private:
+      std::vector<ir::Primitive>  m_primitives; // baked primitives
+
+      ir::Vec3                    m_origin    = {};
+      Index3                      m_dims      = {};
+
+      std::vector<uint32_t>       m_cells;        // brick index or empty (inside/outside) flag
+      std::vector<uint32_t>       m_bricks;       // packHalf2x16(distance, material) samples
+      std::vector<uint32_t>       m_freeBricks;   // released brick slots
+
+      bool                        m_isDirty   = false;
+  };
+}
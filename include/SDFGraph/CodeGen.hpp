@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+
+#include "SDFGraph/IR.hpp"
+
+namespace sdfRay4d::sdfGraph
+{
+  /**
+   * @class CodeGen
+   * @brief generates the SDFR fragment shader's scene functions from the IR
+   *
+   * @note emits (into the sdfr_pass.frag placeholder):
+   * - map(): distance and material id
+   * - mapGrad(): distance and gradient in a single evaluation, by
+   *   forward-mode automatic differentiation of the scene expression.
+   *   Every node value is a dual number vec4(d, dd/dpos). Primitives use
+   *   their analytic dual counterparts (gradients.partial.glsl), translation
+   *   has an identity jacobian and union/subtraction select/negate the duals.
+   *
+   * @note the top-level planes, spheres and boxes (unioned, not subtracted
+   * from) are intersected analytically (castAnalytic), the march (mapMarch)
+   * only covers the remaining terms and both are merged by nearest hit
+   *
+   * @note the march only evaluates the nodes binned to the ray's screen
+   * tile (see Tape, sdfr_binning.comp), i.e. the nodes' order has to match
+   * the scene tape's node table
+   *
+   * @note every term is at most 1-Lipschitz (see toBounded), so the
+   * raymarcher's over-relaxed steps stay safe
+   *
+   * @note baked (static) primitives are replaced by a single brick map
+   * lookup (volumes.partial.glsl), see BrickMap
+   */
+  class CodeGen
+  {
+    public:
+      static std::string generate(const ir::Scene &_scene);
+
+      static std::string generateMap(const ir::Scene &_scene);
+      static std::string generateMapGrad(const ir::Scene &_scene);
+
+    private:
+      static std::string generateMap(const ir::Scene &_scene, bool _isMarchOnly);
+      static std::string generateCastAnalytic(const ir::Scene &_scene);
+
+      static size_t getTopLevelStart(const ir::Scene &_scene);
+      static bool isAnalytic(const ir::Primitive &_primitive);
+      static bool hasAnalytic(const ir::Scene &_scene);
+
+      static std::string toDistance(const ir::Primitive &_primitive);
+      static std::string toDual(const ir::Primitive &_primitive);
+      static std::string toArguments(const ir::Primitive &_primitive);
+      static std::string toIntersection(const ir::Primitive &_primitive);
+      static std::string toBounded(const ir::Primitive &_primitive, const std::string &_call);
+
+      static std::string toFloat(float _value);
+      static std::string toVec2(const ir::Vec3 &_value);
+      static std::string toVec3(const ir::Vec3 &_value);
+  };
+}
@@ -21,6 +21,7 @@ namespace sdfRay4d::sdfGraph
       void setInData(NodeDataPtr _data, PortIndex _portIndex) override;
 
       QString getData() override;
+      [[nodiscard]] const ir::Node *getNode() const;
 
     private:
       std::shared_ptr<MapData> m_mapData = nullptr;
@@ -2,6 +2,7 @@
 
 #include <QSlider>
 #include <QLabel>
+#include <QCheckBox>
 #include <QGridLayout>
 
 #include "SDFGraph/DataModels/BaseDataModel.hpp"
@@ -13,6 +14,9 @@ namespace sdfRay4d::sdfGraph
     public:
       ShapeDataModel();
 
+    public:
+      virtual ir::Primitive getPrimitive() = 0;
+
     /**
      * Abstract Class & Interface Implementations/Overrides
      * -------------------------------------------------
@@ -28,14 +32,17 @@ namespace sdfRay4d::sdfGraph
 
     private:
       void createConnections();
+      ir::Primitive createPrimitive();
 
     private slots:
       virtual void onScale(float _value);
       virtual void onTransform(float _value);
+      void onStatic(bool _isStatic);
 
     private:
       QSlider *m_scale;
       QSlider *m_transform;
+      QCheckBox *m_static;
       QGridLayout *m_layout;
       QLabel *m_scaleLabel;
       QLabel *m_transLabel;
@@ -12,5 +12,6 @@ namespace sdfRay4d::sdfGraph
       [[nodiscard]] QString caption() const override { return { "Cube" }; }
       [[nodiscard]] QString name() const override { return { "Cube" }; }
       QString getData() override;
+      ir::Primitive getPrimitive() override;
   };
 }
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QFutureWatcher>
+
+#include "SDFGraph/DataModels/ShapeDataModel.hpp"
+#include "SDFGraph/MeshSDF.hpp"
+
+namespace sdfRay4d::sdfGraph
+{
+  /**
+   * @class MeshDataModel
+   * @brief samples the signed distance volume of the actor mesh (see MeshSDF)
+   *
+   * @note the conversion runs on a worker, the shape is left out
+   * of the scene until its volume is ready
+   */
+  class MeshDataModel : public ShapeDataModel
+  {
+    public:
+      MeshDataModel();
+
+      [[nodiscard]] QString caption() const override { return { "Mesh" }; }
+      [[nodiscard]] QString name() const override { return { "Mesh" }; }
+      QString getData() override;
+      ir::Primitive getPrimitive() override;
+
+    private:
+      void onConverted();
+
+    private:
+      QFutureWatcher<ir::VolumePtr> m_converter;
+      ir::VolumePtr m_volume = nullptr;
+  };
+}
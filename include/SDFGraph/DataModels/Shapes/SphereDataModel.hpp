@@ -12,5 +12,6 @@ namespace sdfRay4d::sdfGraph
       [[nodiscard]] QString caption() const override { return { "Sphere" }; }
       [[nodiscard]] QString name() const override { return { "Sphere" }; }
       QString getData() override;
+      ir::Primitive getPrimitive() override;
   };
 }
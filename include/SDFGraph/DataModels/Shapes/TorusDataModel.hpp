@@ -12,5 +12,6 @@ namespace sdfRay4d::sdfGraph
       [[nodiscard]] QString caption() const override { return { "Torus" }; }
       [[nodiscard]] QString name() const override { return { "Torus" }; }
       QString getData() override;
+      ir::Primitive getPrimitive() override;
   };
 }
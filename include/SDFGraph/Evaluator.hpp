@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "SDFGraph/IR.hpp"
+
+namespace sdfRay4d::sdfGraph
+{
+  /**
+   * @class Evaluator
+   * @brief CPU evaluation of the scene IR's distance functions
+   *
+   * @note mirrors distance_functions.partial.glsl, operations.partial.glsl
+   * (and the expression emitted by CodeGen), so that values evaluated on
+   * the CPU (baking, picking, collision, bounds) match the SDFR shader
+   *
+   * @note batches are evaluated in structure-of-arrays form by SIMD kernels
+   * (AVX2: 8, SSE2: 4 points at a time, scalar otherwise) and large batches
+   * are split across the global thread pool
+   *
+   * @note covers the whole scene IR (every primitive/operation type), but
+   * the brick map is not sampled: evaluate the scene before it's baked.
+   * Scenes it can't evaluate (baked, or mesh shapes without a volume yet)
+   * are rejected by its consumers, see isSupported
+   */
+  class Evaluator
+  {
+    public:
+      /**
+       * @struct Points
+       * @brief structure-of-arrays query positions
+       */
+      struct Points
+      {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+
+        void reserve(size_t _count);
+        void clear() noexcept;
+        void push_back(const ir::Vec3 &_pos);
+
+        [[nodiscard]] size_t size() const noexcept { return x.size(); }
+      };
+
+      /**
+       * @struct Bounds
+       * @brief axis aligned bounding box
+       */
+      struct Bounds
+      {
+        ir::Vec3 min = {};
+        ir::Vec3 max = {};
+      };
+
+      /**
+       * @struct Interval
+       * @brief range of a distance within bounds
+       */
+      struct Interval
+      {
+        float min = 0.0f;
+        float max = 0.0f;
+      };
+
+    public:
+      static bool isSupported(const ir::Primitive &_primitive) noexcept;
+      static bool isSupported(const ir::Scene &_scene) noexcept;
+
+    public:
+      static Bounds getBounds(
+        const ir::Primitive &_primitive,
+        float _padding = 0.0f
+      ) noexcept;
+
+    public:
+      static float distance(
+        const ir::Primitive &_primitive,
+        const ir::Vec3 &_pos
+      ) noexcept;
+      static float distance(
+        const ir::Volume &_volume,
+        const ir::Vec3 &_pos
+      ) noexcept;
+      static float distance(
+        const std::vector<ir::Primitive> &_primitives,
+        const ir::Vec3 &_pos,
+        float *_material = nullptr
+      ) noexcept;
+      static float distance(
+        const ir::Scene &_scene,
+        const ir::Vec3 &_pos,
+        float *_material = nullptr
+      ) noexcept;
+
+    public:
+      static void distances(
+        const std::vector<ir::Primitive> &_primitives,
+        const Points &_points,
+        std::vector<float> &_distances,
+        std::vector<float> *_materials = nullptr
+      );
+      static void distances(
+        const std::vector<ir::Node> &_nodes,
+        const Points &_points,
+        std::vector<float> &_distances,
+        std::vector<float> *_materials = nullptr
+      );
+      static void distances(
+        const ir::Scene &_scene,
+        const Points &_points,
+        std::vector<float> &_distances,
+        std::vector<float> *_materials = nullptr
+      );
+
+    /**
+     * Interval Arithmetic Helpers
+     * -------------------------------------------------
+     *
+     */
+    public:
+      static Interval getRange(
+        const ir::Primitive &_primitive,
+        const Bounds &_bounds
+      ) noexcept;
+      static ir::Scene specialize(
+        const ir::Scene &_scene,
+        const Bounds &_bounds
+      );
+
+    /**
+     * Batch Kernels (SIMD)
+     * -------------------------------------------------
+     *
+     */
+    private:
+      /**
+       * @struct Batch
+       * @brief a (sub) range of a batch query
+       */
+      struct Batch
+      {
+        const ir::Primitive *base = nullptr; // nullptr: empty (union of the nodes only)
+        const ir::Node *nodes     = nullptr;
+        size_t nodeCount          = 0;
+
+        const float *x            = nullptr;
+        const float *y            = nullptr;
+        const float *z            = nullptr;
+        float *distances          = nullptr;
+        float *materials          = nullptr; // optional
+        size_t count              = 0;
+      };
+
+    private:
+      static void evaluate(const Batch &_batch);
+      static void evaluateKernel(const Batch &_batch) noexcept;
+  };
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace sdfRay4d::sdfGraph::ir
+{
+  /**
+   * @enum PrimitiveType
+   * @brief distance functions known to the code generator
+   * (see distance_functions.partial.glsl)
+   */
+  enum class PrimitiveType : uint8_t
+  {
+    Plane,
+    Sphere,
+    Box,
+    Torus,
+    Mesh
+  };
+
+  /**
+   * @enum OperationType
+   * @brief boolean operations folding a primitive into the scene
+   * (see operations.partial.glsl)
+   */
+  enum class OperationType : uint8_t
+  {
+    Union,
+    Subtraction
+  };
+
+  using Vec3 = std::array<float, 3>;
+
+  /**
+   * @struct Volume
+   * @brief dense grid of signed distance samples (e.g. of a mesh, see MeshSDF)
+   *
+   * @note sample (x, y, z) is at origin + (x, y, z) * spacing and
+   * stored x-major: distances[x + dims[0] * (y + dims[1] * z)]
+   */
+  struct Volume
+  {
+    Vec3 origin                 = {};
+    float spacing               = 0.0f;
+    std::array<int, 3> dims     = {};
+    std::vector<float> distances;
+    float lipschitz             = 1.0f; // >= 1, bound of the samples' gradient (see MeshSDF::getLipschitz)
+  };
+
+  using VolumePtr = std::shared_ptr<const Volume>;
+
+  /**
+   * @struct Primitive
+   * @brief translated distance function with its parameters
+   *
+   * @note dimensions per type:
+   * - Sphere: radius (x)
+   * - Box: half extents (xyz)
+   * - Torus: major/minor radius (xy)
+   * - Mesh: uniform scale (x) of its volume (normalized mesh space)
+   *
+   * @note static primitives are baked into the brick map (see BrickMap)
+   */
+  struct Primitive
+  {
+    PrimitiveType type  = PrimitiveType::Plane;
+    Vec3 position       = {};
+    Vec3 dimensions     = {};
+    float material      = 1.0f;
+    bool isStatic       = false;
+    VolumePtr volume    = nullptr; // Mesh only, immutable once shared
+
+    [[nodiscard]] bool operator==(const Primitive &_other) const noexcept
+    {
+      return
+        type        == _other.type &&
+        position    == _other.position &&
+        dimensions  == _other.dimensions &&
+        material    == _other.material &&
+        isStatic    == _other.isStatic &&
+        volume      == _other.volume;
+    }
+    [[nodiscard]] bool operator!=(const Primitive &_other) const noexcept { return !(*this == _other); }
+  };
+
+  /**
+   * @struct Node
+   * @brief one map node: res = operation(res, primitive)
+   */
+  struct Node
+  {
+    OperationType operation = OperationType::Union;
+    Primitive primitive;
+  };
+
+  /**
+   * @struct Scene
+   * @brief SDF scene expression as emitted by the graph's map nodes
+   *
+   * @note the expression is linear, the base (ground plane) is folded
+   * with each node in order: op_n( ... op_1(base, p_1) ..., p_n )
+   *
+   * @note if hasBrickMap is set, the baked (static) union nodes were
+   * removed from nodes and are folded right after the base instead:
+   * op_n( ... op_1(opUnion(base, brickMap), p_1) ..., p_n )
+   */
+  struct Scene
+  {
+    Primitive base;
+    std::vector<Node> nodes;
+    bool hasBrickMap = false;
+
+    [[nodiscard]] bool isEmpty() const noexcept { return nodes.empty() && !hasBrickMap; }
+  };
+}
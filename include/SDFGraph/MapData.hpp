@@ -1,6 +1,7 @@
 #pragma once
 
 #include "SDFGraph/Interfaces/IData.hpp"
+#include "SDFGraph/IR.hpp"
 
 namespace sdfRay4d::sdfGraph
 {
@@ -10,9 +11,13 @@ namespace sdfRay4d::sdfGraph
   struct MapData : public NodeData, public IData
   {
     QString shaderData;
+    ir::Node node;
 
     MapData() = default;
     explicit MapData(QString &_shaderData) : shaderData(_shaderData) {}
+    MapData(QString &_shaderData, const ir::Node &_node) :
+      shaderData(_shaderData),
+      node(_node) {}
 
     [[nodiscard]] NodeDataType type() const override
     {
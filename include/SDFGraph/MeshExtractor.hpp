@@ -0,0 +1,129 @@
+#pragma once
+
+#include "_constants.hpp"
+#include "Mesh.hpp"
+#include "SDFGraph/Evaluator.hpp"
+
+namespace sdfRay4d::sdfGraph
+{
+  /**
+   * @class MeshExtractor
+   * @brief polygonizes the scene IR into a triangle mesh
+   * (e.g. export to mesh-based tools/physics, actor mesh)
+   *
+   * @note dual contouring (surface nets): one vertex per cell crossed by
+   * the surface, placed at the mass point of its edge crossings and
+   * projected onto the surface, and one quad per crossed grid edge
+   * connecting the vertices of the four cells around it
+   *
+   * @note the grid is split into chunks processed in parallel. Within a
+   * chunk, an octree is refined only where blocks can touch the surface
+   * (|distance(center)| <= half diagonal), so only the corners of leaf
+   * blocks close to the surface are sampled (batched SIMD queries).
+   *
+   * @note the base (ground plane) is unbounded and therefore not extracted
+   */
+  class MeshExtractor
+  {
+    public:
+      using Data = Mesh::Data;
+
+      /**
+       * @struct Settings
+       */
+      struct Settings
+      {
+        int resolution  = constants::meshExtractor::resolution; // cells along the longest axis
+        float padding   = 0.0f; // world units around the scene bounds (in addition to 2 cells)
+      };
+
+      /**
+       * @struct Stats
+       * @brief timing is reported per million (grid) cells
+       */
+      struct Stats
+      {
+        double seconds          = 0.0;
+        uint64_t cellCount      = 0; // of the whole grid
+        uint64_t sampleCount    = 0; // distance queries (incl. octree/vertex refinement)
+        uint64_t triangleCount  = 0;
+        int chunkCount          = 0;
+        int activeChunkCount    = 0; // chunks close to the surface
+
+        [[nodiscard]] double secondsPerMillionCells() const noexcept;
+      };
+
+    public:
+      static Data extract(
+        const ir::Scene &_scene,
+        const Settings &_settings,
+        Stats *_stats = nullptr
+      );
+
+    private:
+      using Index3 = std::array<int, 3>;
+
+      /**
+       * @struct Grid
+       * @brief corners of cell (x, y, z) are at origin + (x..x+1, ...) * cellSize
+       */
+      struct Grid
+      {
+        ir::Vec3 origin = {};
+        float cellSize  = 0.0f;
+        Index3 dims     = {}; // cells
+        Index3 chunks   = {}; // chunks (of chunkSize^3 cells)
+      };
+
+      /**
+       * @struct Chunk
+       * @brief sampled corners and surface vertices of chunkSize^3 cells
+       *
+       * @note corners (chunkSize + 1)^3 are shared with the next chunks,
+       * far corners only hold the (correctly signed) distance of their
+       * octree block center
+       */
+      struct Chunk
+      {
+        Index3 cell = {}; // first cell (grid)
+
+        std::vector<float>    corners;
+        std::vector<int32_t>  cellVertices; // index into vertices, -1: none
+        std::vector<ir::Vec3> vertices;
+        std::vector<ir::Vec3> normals;
+
+        QByteArray            geom; // x, y, z, u, v, nx, ny, nz (owned quads)
+        uint64_t              sampleCount = 0;
+        bool                  isActive = false;
+      };
+
+    private:
+      static Grid createGrid(
+        const ir::Scene &_scene,
+        const Settings &_settings,
+        bool &_isEmpty
+      ) noexcept;
+
+    /**
+     * Chunk Helpers (Thread Pool)
+     * -------------------------------------------------
+     *
+     */
+    private:
+      static void sampleChunk(
+        const std::vector<ir::Node> &_nodes,
+        const Grid &_grid,
+        Chunk &_chunk
+      );
+      static void createVertices(
+        const std::vector<ir::Node> &_nodes,
+        const Grid &_grid,
+        Chunk &_chunk
+      );
+      static void createQuads(
+        const Grid &_grid,
+        const std::vector<Chunk> &_chunks,
+        Chunk &_chunk
+      );
+  };
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <QString>
+
+#include "_constants.hpp"
+#include "Mesh.hpp"
+#include "SDFGraph/IR.hpp"
+
+namespace sdfRay4d::sdfGraph
+{
+  /**
+   * @class MeshSDF
+   * @brief converts a triangle soup (Mesh::Data) into a signed
+   * distance volume, sampled by the SDF Graph's mesh shape node
+   *
+   * @note unsigned distances are computed by parallel jump flooding (1+JFA):
+   * samples within a cell of a triangle are seeded with their closest point
+   * on it, which is then propagated to the 26 neighbours at halving steps
+   * (N/2 ... 1, then 1 again), so every sample ends up with (approximately)
+   * the closest seed point after log2(N) + 1 passes over the grid
+   *
+   * @note signs are resolved by ray parity along x per grid row, so no
+   * connectivity is needed but the soup is expected to be closed
+   *
+   * @note the mesh is normalized into [-1, 1] along its longest axis,
+   * the node's position/scale are applied when the volume is sampled
+   *
+   * @note converted volumes are cached on disk, keyed by a hash of
+   * the mesh and the resolution (see constants::meshSDF::cachePath)
+   */
+  class MeshSDF
+  {
+    public:
+      using Data    = std::vector<uint32_t>;
+      using DataPtr = std::shared_ptr<const Data>;
+
+      /**
+       * @struct Settings
+       */
+      struct Settings
+      {
+        int resolution  = constants::meshSDF::resolution; // samples along the longest axis
+        bool isCached   = true; // read/write the disk cache
+      };
+
+      /**
+       * @struct Stats
+       */
+      struct Stats
+      {
+        double seconds          = 0.0;
+        uint64_t sampleCount    = 0;
+        uint64_t seedCount      = 0; // samples within a cell of the surface
+        int triangleCount       = 0;
+        int passCount           = 0; // jump flooding passes
+        bool isCacheHit         = false;
+      };
+
+    public:
+      static ir::VolumePtr load(
+        const QString &_fileName,
+        const Settings &_settings,
+        Stats *_stats = nullptr
+      );
+      static ir::VolumePtr convert(
+        const Mesh::Data &_mesh,
+        const Settings &_settings,
+        Stats *_stats = nullptr
+      );
+
+      static DataPtr getData(const ir::Volume &_volume);
+
+    private:
+      using Index3 = std::array<int, 3>;
+
+      /**
+       * @struct Triangle
+       * @brief normalized mesh space
+       */
+      struct Triangle
+      {
+        ir::Vec3 a = {};
+        ir::Vec3 b = {};
+        ir::Vec3 c = {};
+      };
+
+      /**
+       * @struct Flood
+       * @brief jump flooding state of the whole grid
+       *
+       * @note seeds[i] is the closest point found so far for sample i
+       * (index into points, -1: none), ping-ponged between the passes
+       */
+      struct Flood
+      {
+        std::vector<ir::Vec3> points;
+        std::vector<int32_t>  seeds;
+        std::vector<int32_t>  nextSeeds;
+      };
+
+    private:
+      static std::vector<Triangle> createTriangles(
+        const Mesh::Data &_mesh,
+        ir::Vec3 &_halfExtents
+      );
+      static ir::Volume createGrid(
+        const ir::Vec3 &_halfExtents,
+        int _resolution
+      );
+      static float getLipschitz(const ir::Volume &_volume) noexcept;
+
+    /**
+     * Jump Flooding Helpers (Thread Pool)
+     * -------------------------------------------------
+     *
+     */
+    private:
+      static void seed(
+        const std::vector<Triangle> &_triangles,
+        const ir::Volume &_volume,
+        Flood &_flood
+      );
+      static int flood(
+        const ir::Volume &_volume,
+        Flood &_flood
+      );
+      static void resolveSigns(
+        const std::vector<Triangle> &_triangles,
+        const Flood &_flood,
+        ir::Volume &_volume
+      );
+
+    /**
+     * Cache Helpers
+     * -------------------------------------------------
+     *
+     */
+    private:
+      static QString getCachePath(
+        const Mesh::Data &_mesh,
+        const Settings &_settings
+      );
+      static ir::VolumePtr readCache(const QString &_filePath);
+      static void writeCache(
+        const QString &_filePath,
+        const ir::Volume &_volume
+      );
+  };
+}
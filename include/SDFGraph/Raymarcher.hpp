@@ -0,0 +1,158 @@
+#pragma once
+
+#include <QImage>
+#include <QVector3D>
+
+#include "SDFGraph/Evaluator.hpp"
+
+namespace sdfRay4d::sdfGraph
+{
+  /**
+   * @class Raymarcher
+   * @brief CPU reference renderer of the scene IR
+   *
+   * @note runs the camera (setupRay) and shading model (render, with full
+   * resolution lighting and AA 1) of sdfr_pass.frag, so that previews and
+   * golden images can be rendered without a usable GPU (e.g. headless CI).
+   * Normals use tetrahedral differences instead of the analytic mapGrad.
+   *
+   * @note the image is split into tiles, distributed over worker threads
+   * by a work stealing scheduler. Each tile is marched as one ray packet:
+   * every step of its active rays is a single batched (SIMD) Evaluator query
+   * of the scene specialized to the tile (interval arithmetic pruning).
+   */
+  class Raymarcher
+  {
+    public:
+      /**
+       * @struct Settings
+       * @note time and mouse defaults match the SDFR pass push constants
+       */
+      struct Settings
+      {
+        int width         = 1280;
+        int height        = 720;
+        int threadCount   = 0; // 0: ideal thread count
+
+        float time        = 1.0f;
+        float mouseX      = 1.0f;
+        float mouseY      = 1.0f;
+
+        float relaxation  = 1.6f; // castRay over-relaxation (see RaymarchQuality)
+        bool isSpecialized = true; // primary rays march the scene specialized per tile
+      };
+
+      /**
+       * @struct Stats
+       * @brief throughput of a render (primary and soft shadow rays)
+       */
+      struct Stats
+      {
+        double seconds        = 0.0;
+        uint64_t primaryRays  = 0;
+        uint64_t shadowRays   = 0;
+        uint64_t marchSteps   = 0; // of the primary rays
+        uint64_t termSteps    = 0; // primitives evaluated by the march steps
+        int threadCount       = 0;
+
+        [[nodiscard]] double raysPerSecond() const noexcept;
+        [[nodiscard]] double raysPerSecondPerCore() const noexcept;
+      };
+
+    public:
+      static QImage render(
+        const ir::Scene &_scene,
+        const Settings &_settings,
+        Stats *_stats = nullptr
+      );
+      static ir::Scene createReferenceScene();
+      static bool loadScene(const QString &_filePath, ir::Scene &_scene);
+
+    private:
+      /**
+       * @struct Packet
+       * @brief rays of a tile and the scratch buffers of their batched queries
+       */
+      struct Packet
+      {
+        std::vector<QVector3D>  origins;
+        std::vector<QVector3D>  directions;
+        std::vector<float>      t;
+        std::vector<float>      tMax;
+        std::vector<float>      materials;
+        std::vector<float>      omega;      // over-relaxation
+        std::vector<float>      prevRadius;
+        std::vector<float>      stepLength;
+
+        std::vector<uint32_t>   hits;       // ray indices
+        std::vector<QVector3D>  positions;  // per hit
+        std::vector<QVector3D>  normals;    // per hit
+        std::vector<QVector3D>  reflections; // per hit
+        std::vector<float>      shadowDif;  // per hit
+        std::vector<float>      shadowDom;  // per hit
+        std::vector<float>      occlusion;  // per hit
+        std::vector<float>      shadowT;    // per hit
+
+        std::vector<uint32_t>   active;
+        Evaluator::Points       points;
+        std::vector<float>      distances;
+        std::vector<float>      sampleMaterials;
+
+        uint64_t                shadowRays = 0;
+        uint64_t                marchSteps = 0;
+        uint64_t                termSteps  = 0;
+
+        ir::Scene               scene;      // specialized to the tile (see castRays)
+      };
+
+    /**
+     * Workers & Tile Scheduler
+     * -------------------------------------------------
+     *
+     */
+    private:
+      static void renderTile(
+        const ir::Scene &_scene,
+        const Settings &_settings,
+        int _tileX,
+        int _tileY,
+        Packet &_packet,
+        uchar *_bits,
+        int _bytesPerLine
+      );
+
+    /**
+     * Packet Helpers (render() of sdfr_pass.frag)
+     * -------------------------------------------------
+     *
+     */
+    private:
+      static void setupRay(
+        const Settings &_settings,
+        float _fragX,
+        float _fragY,
+        QVector3D &_origin,
+        QVector3D &_direction
+      );
+      static void castRays(
+        const ir::Scene &_scene,
+        const Settings &_settings,
+        Packet &_packet
+      );
+      static void specialize(
+        const ir::Scene &_scene,
+        const Settings &_settings,
+        Packet &_packet
+      );
+      static void calcNormals(const ir::Scene &_scene, Packet &_packet);
+      static void calcSoftShadows(
+        const ir::Scene &_scene,
+        Packet &_packet,
+        bool _isKeyLight,
+        std::vector<float> &_shadows
+      );
+      static void calcAO(const ir::Scene &_scene, Packet &_packet);
+      static QVector3D shade(const Packet &_packet, uint32_t _ray, int _hit);
+      static void evaluate(const ir::Scene &_scene, Packet &_packet);
+  };
+}
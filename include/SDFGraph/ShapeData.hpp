@@ -1,6 +1,7 @@
 #pragma once
 
 #include "SDFGraph/Interfaces/IData.hpp"
+#include "SDFGraph/IR.hpp"
 
 namespace sdfRay4d::sdfGraph
 {
@@ -10,9 +11,13 @@ namespace sdfRay4d::sdfGraph
   struct ShapeData : public NodeData, public IData
   {
     QString shaderData;
+    ir::Primitive primitive;
 
     ShapeData() = default;
     explicit ShapeData(QString &_shaderData) : shaderData(_shaderData) {}
+    ShapeData(QString &_shaderData, const ir::Primitive &_primitive) :
+      shaderData(_shaderData),
+      primitive(_primitive) {}
 
     [[nodiscard]] NodeDataType type() const override
     {
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "SDFGraph/IR.hpp"
+
+namespace sdfRay4d::sdfGraph
+{
+  /**
+   * @class Tape
+   * @brief bytecode of the scene expression, interpreted by the
+   * SDFR fragment shader's default map()/mapGrad() (see sdfr_pass.frag)
+   *
+   * @note a structural edit only rewrites the tape (storage buffer) and
+   * shows up with the next frame, while the specialized shader is being
+   * generated/compiled (see CodeGen, SDFGraph::specialize)
+   *
+   * @note GPU data layout (uvec4 words):
+   * - header: instruction count, stack depth, node count
+   * - per instruction: (opcode, material bits), operand bits (xyz)
+   * - per scene node (after the instructions): its instruction range,
+   *   translation bits (xyz) and bounding sphere bits (xyz, radius < 0: unbounded)
+   *
+   * @note the node table lets the SDFR tile binning (see sdfr_binning.comp)
+   * cull nodes per screen tile, castRay then only runs the base's instructions
+   * and the ranges of the nodes binned to the pixel's tile
+   *
+   * @note postfix order on a fixed size stack: primitives push their
+   * (distance, material) at the translated position, operations pop
+   * two values and push the result
+   */
+  class Tape
+  {
+    public:
+      using Data    = std::vector<uint32_t>;
+      using DataPtr = std::shared_ptr<const Data>;
+
+      /**
+       * @enum Opcode
+       * @note see OP_* in sdfr_pass.frag
+       */
+      enum class Opcode : uint32_t
+      {
+        Translate,  // position of the following primitives: pos - operand
+        Plane,
+        Sphere,     // operand: radius (x)
+        Box,        // operand: half extents
+        Torus,      // operand: major/minor radius (xy)
+        Mesh,       // operand: uniform scale (x), 1 / Lipschitz bound (y)
+        BrickMap,   // baked static primitives (world space)
+        Union,
+        Subtraction
+      };
+
+    public:
+      static DataPtr generate(const ir::Scene &_scene);
+
+    private:
+      static void appendNode(
+        Data &_nodes,
+        const ir::Primitive &_primitive,
+        uint32_t _first,
+        uint32_t _end
+      );
+      static void appendPrimitive(
+        Data &_data,
+        const ir::Primitive &_primitive,
+        ir::Vec3 &_position
+      );
+      static void append(
+        Data &_data,
+        Opcode _opcode,
+        float _material = 0.0f,
+        const ir::Vec3 &_operand = {}
+      );
+  };
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "SDFGraph/IR.hpp"
+
 namespace sdfRay4d::sdfGraph
 {
   struct vec4
@@ -19,5 +21,10 @@ namespace sdfRay4d::sdfGraph
     y(std::to_string(_y)),
     z(std::to_string(_z)),
     w(std::to_string(_w)) {}
+
+    [[nodiscard]] ir::Vec3 xyz() const
+    {
+      return { std::stof(x), std::stof(y), std::stof(z) };
+    }
   };
 }
@@ -16,6 +16,60 @@ namespace sdfRay4d
 
   class SPIRVCompiler
   {
+    public:
+      /**
+       * @struct Library
+       * @brief shared GLSL functions (e.g. distance functions), parsed once
+       * and linked into every shader compiled against it (see createLibrary)
+       *
+       * @note the library keeps the glslang process (and its built-in symbol
+       * tables) initialized for as long as it's alive
+       */
+      struct Library
+      {
+        ~Library();
+
+        EShLanguage language = EShLangVertex;
+        std::string source; // parsed unit refers to it
+        std::unique_ptr<glslang::TShader> shader;
+        QByteArray declarations; // function prototypes, prepended to the linked units
+      };
+
+      using LibraryPtr = std::shared_ptr<Library>;
+
+      /**
+       * @enum Optimization
+       * @brief spirv-opt levels, applied after GLSL to SPIR-V (see optimize)
+       */
+      enum class Optimization : uint8_t
+      {
+        OFF,
+        SIZE,
+        PERFORMANCE
+      };
+
+      /**
+       * @struct Options
+       */
+      struct Options
+      {
+        LibraryPtr library          = nullptr;
+        Optimization optimization   = Optimization::OFF;
+        bool isFast                 = false; // cheap passes only (e.g. interactive edits)
+        std::string entryPoint      = "main";
+      };
+
+      /**
+       * @struct Stats
+       */
+      struct Stats
+      {
+        double compileSeconds             = 0; // GLSL to SPIR-V
+        double optimizeSeconds            = 0;
+        size_t instructionCount           = 0; // before optimization
+        size_t optimizedInstructionCount  = 0;
+      };
+
     public:
       static bool compile(
         const shader::StageFlagBits &_stage,
@@ -24,8 +78,50 @@ namespace sdfRay4d
         std::string &_log,
         const std::string &_entryPoint = "main"
       ) noexcept;
+      static bool compile(
+        const shader::StageFlagBits &_stage,
+        const QByteArray &_glslSource,
+        const Options &_options,
+        std::vector<std::uint32_t> &_spvBytes,
+        std::string &_log,
+        Stats *_stats = nullptr
+      ) noexcept;
+
+      static LibraryPtr createLibrary(
+        const shader::StageFlagBits &_stage,
+        const QByteArray &_glslSource,
+        std::string &_log
+      ) noexcept;
+
+      static bool isOptimizerAvailable() noexcept;
 
     private:
       static EShLanguage getShaderLang(const shader::StageFlagBits &_stage) noexcept;
+      static EShMessages getMessages() noexcept;
+      static QByteArray getDeclarations(const std::string &_glslSource) noexcept;
+      static bool link(
+        EShLanguage _language,
+        const QByteArray &_glslSource,
+        glslang::TShader *_library,
+        std::vector<std::uint32_t> &_spvBytes,
+        std::string &_log,
+        const std::string &_entryPoint
+      ) noexcept;
+
+    /**
+     * Optimizer Helpers
+     * -------------------------------------------------
+     *
+     */
+    private:
+      static bool optimize(
+        const Options &_options,
+        std::vector<std::uint32_t> &_spvBytes,
+        std::string &_log
+      ) noexcept;
+      static size_t getInstructionCount(const std::vector<std::uint32_t> &_spvBytes) noexcept;
+
+    private:
+      inline static QMutex m_compileMutex; // glslang is initialized/used per process
   };
 }
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace sdfRay4d
+{
+  /**
+   * @class SPSCQueue
+   * @brief bounded, lock-free single-producer/single-consumer ring buffer
+   *
+   * @note head is only written by the consumer and tail only by the
+   * producer, each on its own cache line to avoid false sharing.
+   * Capacity has to be a power of two; one slot is kept free to
+   * tell a full queue apart from an empty one.
+   *
+   * @tparam T trivially copyable item type
+   * @tparam Capacity
+   */
+  template<typename T, size_t Capacity>
+  class SPSCQueue
+  {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+      "SPSCQueue capacity has to be a power of two");
+
+    static constexpr const size_t cacheLineSize = 64;
+    static constexpr const size_t mask          = Capacity - 1;
+
+    public:
+      SPSCQueue() = default;
+      SPSCQueue(const SPSCQueue&) = delete;
+      SPSCQueue &operator=(const SPSCQueue&) = delete;
+
+    public:
+      /**
+       * @note producer thread only
+       * @param[in] _item
+       * @return false if the queue is full
+       */
+      bool push(const T &_item) noexcept
+      {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        const auto nextTail = (tail + 1) & mask;
+
+        if(nextTail == m_head.load(std::memory_order_acquire)) return false;
+
+        m_items[tail] = _item;
+        m_tail.store(nextTail, std::memory_order_release);
+
+        return true;
+      }
+
+      /**
+       * @note consumer thread only
+       * @param[out] _item
+       * @return false if the queue is empty
+       */
+      bool pop(T &_item) noexcept
+      {
+        const auto head = m_head.load(std::memory_order_relaxed);
+
+        if(head == m_tail.load(std::memory_order_acquire)) return false;
+
+        _item = m_items[head];
+        m_head.store((head + 1) & mask, std::memory_order_release);
+
+        return true;
+      }
+
+      [[nodiscard]] bool isEmpty() const noexcept
+      {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+      }
+
+    private:
+      alignas(cacheLineSize) std::atomic<size_t> m_head { 0 }; // consumer
+      alignas(cacheLineSize) std::atomic<size_t> m_tail { 0 }; // producer
+      alignas(cacheLineSize) std::array<T, Capacity> m_items = {};
+  };
+}
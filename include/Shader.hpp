@@ -1,6 +1,9 @@
 #pragma once
 
 #include <QVulkanInstance>
+#include <QByteArrayList>
+#include <QSet>
+#include <QVector>
 #include <QFuture>
 
 #include "Types.hpp"
@@ -27,6 +30,19 @@ namespace sdfRay4d
         [[nodiscard]] bool isValid() const { return shaderModule != VK_NULL_HANDLE; }
       };
 
+      /**
+       * @struct AssemblyStats
+       * @brief last assembled (GLSL) source, see assemble
+       */
+      struct AssemblyStats
+      {
+        double seconds            = 0;
+        int byteCount             = 0;
+        int fragmentCount         = 0;
+        int functionCount         = 0; // strippable ones, see appendFragments
+        int strippedFunctionCount = 0; // not referenced by the body/shader
+      };
+
     /**
      * Load Function Overloads (Public)
      * -------------------------------------------------
@@ -38,13 +54,17 @@ namespace sdfRay4d
         const QStringList &_partialFilePaths = {}
       );
       void load(
-        const std::string &_shaderData
+        const std::string &_shaderData,
+        SPIRVCompiler::Optimization _optimization = SPIRVCompiler::Optimization::OFF,
+        bool _isFastOptimization = false
       );
+      void reload(const std::vector<uint32_t> &_spvBytes);
 
     public:
       void preload(
 //        const QString &_replaceItem,
-        const QStringList &_partialFilePaths
+        const QStringList &_partialFilePaths,
+        const QStringList &_libraryFilePaths = {}
       );
 
     /**
@@ -54,9 +74,13 @@ namespace sdfRay4d
      */
     public:
       Data *getData();
+      const std::vector<uint32_t> &getSPIRV();
       bool isValid();
       void reset();
 
+      [[nodiscard]] const AssemblyStats &getAssemblyStats() const { return m_assemblyStats; }
+      [[nodiscard]] const SPIRVCompiler::Stats &getCompileStats() const { return m_compileStats; }
+
     /**
      * Load Function Helpers
      * -------------------------------------------------
@@ -65,15 +89,69 @@ namespace sdfRay4d
     private:
       static QByteArray getFileBytes(const QString &_filePath);
 
-      static void serializeVersionDirective(
-        QByteArray &_rawBytes
-      ) ;
-      void serialize(
-        const QByteArray &_rawBytes
+    /**
+     * Source Assembler Helpers
+     * -------------------------------------------------
+     *
+     */
+    private:
+      /**
+       * @struct Source
+       * @brief preloaded shader files, assembled per compile
+       */
+      struct Source
+      {
+        QByteArrayList fragments; // without #version directives
+        QByteArrayList functionNames; // per fragment, the (strippable) function it defines/declares, if any
+        int bodyIndex = -1; // fragment following the placeholder
+      };
+
+      /**
+       * @struct Preprocessor
+       * @brief conditional state of the source scanned so far, only the
+       * #ifdef/#ifndef of the macros it #defines are evaluated (see getUsedFragments)
+       */
+      struct Preprocessor
+      {
+        struct Branch
+        {
+          bool isParentEnabled = true;
+          bool isEvaluated = false; // otherwise (e.g. #if expression), every branch is kept
+          bool isTaken = true;
+        };
+
+        QSet<QByteArray> macros;
+        QVector<Branch> branches;
+      };
+
+    private:
+      static void appendFragments(
+        Source &_source,
+        const QByteArray &_rawBytes,
+        bool _isStrippable = false
       );
-      void serialize(
-        const QStringList &_partialFilePaths,
-        QByteArray &_rawBytes
+      static void appendFragment(
+        Source &_source,
+        const QByteArray &_bytes,
+        bool _isStrippable
+      );
+      static void appendIdentifiers(
+        const QByteArray &_bytes,
+        QSet<QByteArray> &_identifiers
+      );
+      static void appendEnabledIdentifiers(
+        const QByteArray &_bytes,
+        Preprocessor &_preprocessor,
+        QSet<QByteArray> *_identifiers
+      );
+      static std::vector<bool> getUsedFragments(
+        const Source &_source,
+        const QByteArray &_body
+      );
+      static QByteArray stripVersionDirectives(const QByteArray &_rawBytes);
+      QByteArray assemble(
+        const Source &_source,
+        const QByteArray &_body = {}
       );
 
     /**
@@ -102,7 +180,11 @@ namespace sdfRay4d
 
       QFuture<Data> m_worker;
 
-      QByteArray m_rawBytes;
-      std::string m_template;
+      Source m_source; // see preload
+      SPIRVCompiler::LibraryPtr m_library; // linked into every load(_shaderData)
+      QByteArray m_rawBytes; // last assembled source
+      AssemblyStats m_assemblyStats;
+      SPIRVCompiler::Stats m_compileStats; // last load(_shaderData)
+      std::vector<uint32_t> m_spvBytes; // last loaded module's SPIR-V, see reload
   };
 }
@@ -26,7 +26,8 @@ namespace sdfRay4d
         uint32_t _height,
         image::Usage _usage =
           VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
-          VK_IMAGE_USAGE_STORAGE_BIT
+          VK_IMAGE_USAGE_STORAGE_BIT,
+        const Format &_format = VK_FORMAT_D16_UNORM
       );
       void createImageMemory(uint32_t _deviceMemIndex);
       void createImageMemoryBarrier(
@@ -68,6 +69,7 @@ namespace sdfRay4d
       image::View m_imageView = VK_NULL_HANDLE;
       image::Sampler m_sampler = VK_NULL_HANDLE;
       image::MemBarrier m_imageMemBarrier = {};
+      Format m_format = VK_FORMAT_D16_UNORM;
 
       device::Memory m_imageMem = VK_NULL_HANDLE;
   };
@@ -48,6 +48,7 @@ namespace sdfRay4d
       using BeginInfo       = VkRenderPassBeginInfo;
 
       using SubpassDesc     = VkSubpassDescription;
+      using SubpassDep      = VkSubpassDependency;
 
       using AttachmentDesc  = VkAttachmentDescription;
       using AttachmentRef   = VkAttachmentReference;
@@ -138,6 +139,18 @@ namespace sdfRay4d
       };
     }
 
+    namespace query
+    {
+      using Pool          = VkQueryPool;
+      using PoolInfo      = VkQueryPoolCreateInfo;
+
+      // Query StructureType
+      struct StructureType : NOP
+      {
+        static constexpr const VkStructureType POOL_INFO = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+      };
+    }
+
     namespace device
     {
       using Device  = VkDevice;
@@ -218,6 +231,9 @@ namespace sdfRay4d
 
       using ShaderStageInfo       = VkPipelineShaderStageCreateInfo;
 
+      using SpecializationInfo    = VkSpecializationInfo;
+      using SpecializationEntry   = VkSpecializationMapEntry;
+
       // PSOs
       using VertexInputInfo       = VkPipelineVertexInputStateCreateInfo;
       using InputAssemblyInfo     = VkPipelineInputAssemblyStateCreateInfo;
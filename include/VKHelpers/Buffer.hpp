@@ -45,7 +45,22 @@ namespace sdfRay4d::vkHelpers
         const buffer::Buffer &_buffer,
         const device::Size &_memOffset
       ) noexcept;
-      void mapMemory(size_t _byteSize) noexcept;
+      void mapMemory() noexcept;
+      void copyToMemory(
+        const device::Size &_memOffset,
+        const void *_data,
+        size_t _byteSize
+      ) noexcept;
+
+    public:
+      void allocateDeviceMemory(
+        const device::Size &_size,
+        uint32_t _typeIndex
+      ) noexcept;
+      void bindBufferDeviceMemory(
+        const buffer::Buffer &_buffer,
+        const device::Size &_memOffset
+      ) noexcept;
 
     private:
       void destroyBuffer(buffer::Buffer &_buffer) noexcept;
@@ -57,5 +72,8 @@ namespace sdfRay4d::vkHelpers
 
 //      std::vector<Buffer> m_buffers;
       device::Memory m_bufferMemory = VK_NULL_HANDLE;
+      quint8 *m_mappedMemory = nullptr; // persistently mapped (see mapMemory)
+
+      device::Memory m_deviceMemory = VK_NULL_HANDLE; // device local, filled by UploadHelper
   };
 }
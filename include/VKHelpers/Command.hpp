@@ -2,6 +2,8 @@
 
 #include "BaseHelper.hpp"
 #include "RenderPass.hpp"
+#include "Profiler.hpp"
+#include "FrameState.hpp"
 
 namespace sdfRay4d::vkHelpers
 {
@@ -16,6 +18,9 @@ namespace sdfRay4d::vkHelpers
   {
     friend class PipelineHelper;
 
+    using Pass      = FrameState::Pass;
+    using PassList  = FrameState::PassList;
+
     public:
       CommandHelper(
         const device::Device &_device,
@@ -44,8 +49,26 @@ namespace sdfRay4d::vkHelpers
      *
      */
     public:
-      void executeRenderPass(const std::vector<MaterialPtr> &_materials) noexcept;
+      void executeRenderPass(const PassList &_passes) noexcept;
+      void executeOffscreenPass(
+        const MaterialPtr &_material,
+        const PassList &_passes,
+        uint32_t _targetWidth,
+        uint32_t _targetHeight,
+        uint32_t _extentWidth,
+        uint32_t _extentHeight
+      ) noexcept;
       void executePipelineBarrier(const MaterialPtr &_material) noexcept;
+      void executeComputePasses(
+        const MaterialPtr &_material,
+        const PassList &_passes,
+        device::Size _clearSize
+      ) noexcept;
+      void executeFillBuffer(
+        const buffer::Buffer &_buffer,
+        device::Size _offset,
+        device::Size _size
+      ) noexcept;
 
     /**
      * Command Execution Functions (PRIVATE)
@@ -55,12 +78,22 @@ namespace sdfRay4d::vkHelpers
     private:
       void executeCmdSetViewport    (uint32_t _extentWidth, uint32_t _extentHeight) noexcept;
       void executeCmdSetScissor     (uint32_t _extentWidth, uint32_t _extentHeight) noexcept;
-      void executeCmdBind           (const MaterialPtr &_material) noexcept;
-      void executeCmdPushConstants  (const MaterialPtr &_material) noexcept;
-      void executeCmdDraw           (const MaterialPtr &_material) noexcept;
+      void executeCmdBind           (const Pass &_pass) noexcept;
+      void executeCmdBindCompute    (const Pass &_pass) noexcept;
+      void executeCmdBufferBarrier(
+        const buffer::Buffer &_buffer,
+        pipeline::StageFlags _sourceStage,
+        pipeline::StageFlags _destinationStage,
+        memory::AccessFlags _sourceAccess,
+        memory::AccessFlags _destinationAccess
+      ) noexcept;
+      void executeCmdPushConstants  (const Pass &_pass) noexcept;
+      void executeCmdDraw           (const Pass &_pass) noexcept;
+      void executeCmdDraws          (const PassList &_passes) noexcept;
 
     private:
       void setRenderPassHelper(const RenderPassHelper &_renderPassHelper) noexcept;
+      void setProfilerHelper(ProfilerHelper *_profilerHelper) noexcept;
 
     private:
       device::Device m_device = VK_NULL_HANDLE;
@@ -69,7 +102,10 @@ namespace sdfRay4d::vkHelpers
       command::CmdBuffer m_cmdBuffer = VK_NULL_HANDLE;
 
       RenderPassHelper m_renderPassHelper;
+      ProfilerHelper *m_profilerHelper = nullptr; // owned by PipelineHelper
 
       int m_frameId = 0;
+      uint32_t m_extentWidth = 0;
+      uint32_t m_extentHeight = 0;
   };
 }
@@ -33,6 +33,13 @@ namespace sdfRay4d::vkHelpers
 
     private:
       void createFramebuffer(const renderpass::RenderPass &_renderPass) noexcept;
+      void createFramebuffer(
+        const renderpass::RenderPass &_renderPass,
+        const ImageViewList &_attachments,
+        uint32_t _extentWidth,
+        uint32_t _extentHeight,
+        framebuffer::Framebuffer &_framebuffer
+      ) noexcept;
       void setAttachments(const ImageViewList &_attachments) noexcept;
       void setSize(uint32_t _extentWidth, uint32_t _extentHeight) noexcept;
       void setDefaultFramebuffer(const framebuffer::Framebuffer &_framebuffer) noexcept;
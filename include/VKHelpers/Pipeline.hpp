@@ -10,6 +10,8 @@
 #include "Command.hpp"
 #include "Framebuffer.hpp"
 #include "RenderPass.hpp"
+#include "Profiler.hpp"
+#include "Upload.hpp"
 
 namespace sdfRay4d::vkHelpers
 {
@@ -40,6 +42,16 @@ namespace sdfRay4d::vkHelpers
 
     public:
       void createCache() noexcept;
+      void createProfiler(
+        uint32_t _frameCount,
+        float _timestampPeriod,
+        uint32_t _timestampValidBits
+      ) noexcept;
+      void createUploader(
+        const UploadHelper::Queue &_transferQueue,
+        uint32_t _graphicsFamilyIndex,
+        uint32_t _hostVisibleMemoryIndex
+      ) noexcept;
 
     /**
      * Pipeline Worker Helpers/Overloads
@@ -78,8 +90,11 @@ namespace sdfRay4d::vkHelpers
       void destroyPipelineLayout            (pipeline::Layout &_pipelineLayout) noexcept;
       void destroyPipelineLayout            (const MaterialPtr &_material) noexcept;
       void destroyRenderPass() noexcept;
+      void destroyOffscreenFramebuffer      (const MaterialPtr &_material) noexcept;
       void destroyBuffers() noexcept;
       void destroyMaterials() noexcept;
+      void destroyProfiler() noexcept;
+      void destroyUploader() noexcept;
 
       void swapSDFRPipelines(
         const MaterialPtr &_oldMaterial,
@@ -89,11 +104,20 @@ namespace sdfRay4d::vkHelpers
     public:
       void setFramebufferAttachments        (const ImageViewList &_fbAttachments) noexcept;
       renderpass::RenderPass &getRenderPass (bool _useDefault = true) noexcept;
+      renderpass::RenderPass &getOffscreenRenderPass() noexcept;
+      void createOffscreenFramebuffer(
+        const MaterialPtr &_material,
+        const ImageViewList &_fbAttachments,
+        uint32_t _extentWidth,
+        uint32_t _extentHeight
+      ) noexcept;
 
     public:
       inline DescriptorHelper  &getDescriptorHelper()  noexcept { return m_descriptorHelper; }
       inline BufferHelper      &getBufferHelper()      noexcept { return m_bufferHelper; }
       inline CommandHelper     &getCommandHelper()     noexcept { return m_commandHelper; }
+      inline ProfilerHelper    &getProfilerHelper()    noexcept { return m_profilerHelper; }
+      inline UploadHelper      &getUploadHelper()      noexcept { return m_uploadHelper; }
 
     /**
      * Create Pipeline Helpers (on Worker Thread)
@@ -148,6 +172,8 @@ namespace sdfRay4d::vkHelpers
       DescriptorHelper              m_descriptorHelper;
       BufferHelper                  m_bufferHelper;
       CommandHelper                 m_commandHelper;
+      ProfilerHelper                m_profilerHelper;
+      UploadHelper                  m_uploadHelper;
 
       image::SampleCountFlagBits  m_sampleCountFlags;
 
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <deque>
+
+#include <QMutex>
+
+#include "BaseHelper.hpp"
+
+namespace sdfRay4d::vkHelpers
+{
+  /**
+   * @class ProfilerHelper
+   * @brief GPU timestamp queries per pass
+   *
+   * @note each concurrent frame owns its own range of queries. Results of
+   * a frame slot are read back (without waiting) when Qt Vulkan hands out
+   * the same slot again, i.e. concurrentFrameCount frames later, when the
+   * slot's fence is already signaled and the results are available.
+   *
+   * @note no pipeline statistics, Qt Vulkan's (Qt 5) device creation
+   * doesn't enable the pipelineStatisticsQuery device feature
+   *
+   * @example
+   *
+   */
+  class ProfilerHelper : protected BaseHelper
+  {
+    friend class PipelineHelper;
+    friend class CommandHelper;
+
+    public:
+      struct Stats
+      {
+        std::string label;
+
+        double minMs            = 0.0;
+        double avgMs            = 0.0;
+        double maxMs            = 0.0;
+
+        size_t sampleCount      = 0;
+      };
+
+      using StatsList = std::vector<Stats>;
+
+    /**
+     * @note ProfilerHelper is non-copyable
+     */
+    public:
+      ProfilerHelper() = default;
+      ProfilerHelper(const ProfilerHelper&) = delete;
+
+    /**
+     * Rolling Stats (GUI Thread)
+     * -------------------------------------------------
+     *
+     */
+    public:
+      StatsList getStats() noexcept;
+      QString getSummary() noexcept;
+      bool exportStats(const QString &_filePath) noexcept;
+
+      [[nodiscard]] bool isSupported() const noexcept { return m_isSupported; }
+
+    /**
+     * Query Pool Helpers
+     * -------------------------------------------------
+     *
+     */
+    private:
+      void init(
+        const device::Device &_device,
+        QVulkanDeviceFunctions *_deviceFuncs,
+        uint32_t _frameCount,
+        float _timestampPeriod,
+        uint32_t _timestampValidBits
+      ) noexcept;
+      void createQueryPools() noexcept;
+      void destroyQueryPools() noexcept;
+
+    /**
+     * Command Recording Helpers (Frame Worker Thread)
+     * -------------------------------------------------
+     *
+     */
+    private:
+      void beginFrame(
+        const command::CmdBuffer &_cmdBuffer,
+        int _frameId
+      ) noexcept;
+      void writeTimestamp(
+        const command::CmdBuffer &_cmdBuffer,
+        const std::string &_label
+      ) noexcept;
+
+    private:
+      void readResults(uint32_t _frameSlot) noexcept;
+      void addSample(
+        const std::string &_label,
+        double _durationMs
+      ) noexcept;
+
+    private:
+      /**
+       * @struct FrameQueries
+       * @brief labels (scopes) recorded into a frame slot's query range
+       */
+      struct FrameQueries
+      {
+        std::vector<std::string>  labels;
+        bool                      isRecorded = false;
+      };
+
+      /**
+       * @struct Samples
+       * @brief rolling window of samples per label
+       */
+      struct Samples
+      {
+        std::string               label;
+        std::deque<double>        durations;
+      };
+
+    private:
+      device::Device              m_device              = VK_NULL_HANDLE;
+      QVulkanDeviceFunctions      *m_deviceFuncs        = nullptr;
+
+      query::Pool                 m_timestampPool       = VK_NULL_HANDLE;
+
+      uint32_t                    m_frameCount          = 0;
+      uint32_t                    m_frameSlot           = 0;
+      float                       m_timestampPeriod     = 0.0f; // nanoseconds per tick
+      uint64_t                    m_timestampMask       = 0;
+
+      bool                        m_isSupported         = false;
+
+      std::vector<FrameQueries>   m_frames;
+
+      QMutex                      m_statsMutex; // GUI vs. frame worker thread, stats only
+      std::vector<Samples>        m_samples;
+  };
+}
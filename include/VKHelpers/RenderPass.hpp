@@ -42,8 +42,12 @@ namespace sdfRay4d::vkHelpers
         const Format &_colorFormat = VK_FORMAT_B8G8R8A8_UNORM,
         const Format &_depthStencilFormat = VK_FORMAT_D16_UNORM//VK_FORMAT_D24_UNORM_S8_UINT
       ) noexcept;
+      void createOffscreenRenderPass(const Format &_colorFormat) noexcept;
       void createBeginInfo(const std::vector<MaterialPtr> &_materials) noexcept;
       renderpass::RenderPass &getRenderPass(bool _useDefault = true) noexcept;
+      renderpass::RenderPass &getOffscreenRenderPass(
+        const Format &_colorFormat = VK_FORMAT_R16G16B16A16_SFLOAT
+      ) noexcept;
       renderpass::BeginInfo &getBeginInfo() noexcept { return m_beginInfo; }
 
     /**
@@ -55,6 +59,12 @@ namespace sdfRay4d::vkHelpers
       void setFramebufferAttachments(const ImageViewList &_fbAttachments) noexcept;
       void setDefaultFramebuffer(const framebuffer::Framebuffer &_framebuffer) noexcept;
       void setFramebufferSize(uint32_t _extentWidth, uint32_t _extentHeight) noexcept;
+      void createOffscreenFramebuffer(
+        const MaterialPtr &_material,
+        const ImageViewList &_attachments,
+        uint32_t _extentWidth,
+        uint32_t _extentHeight
+      ) noexcept;
 
     private:
       FramebufferHelper m_framebufferHelper; // friend
@@ -64,6 +74,7 @@ namespace sdfRay4d::vkHelpers
 
       renderpass::RenderPass m_defaultRenderPass      = VK_NULL_HANDLE;
       renderpass::RenderPass m_renderPass             = VK_NULL_HANDLE;
+      renderpass::RenderPass m_offscreenRenderPass    = VK_NULL_HANDLE;
 
       image::SampleCountFlagBits m_sampleCountFlags = {};
       Clear m_clearValues[3]                          = {};
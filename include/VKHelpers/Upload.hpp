@@ -0,0 +1,201 @@
+#pragma once
+
+#include <QMutex>
+#include <QThread>
+
+#include "BaseHelper.hpp"
+#include "SPSCQueue.hpp"
+
+namespace sdfRay4d::vkHelpers
+{
+  /**
+   * @class UploadHelper
+   * @brief asynchronous uploads into device local buffers, streamed
+   * through a persistently mapped staging ring on the transfer queue
+   * (a dedicated one if available, see VulkanWindow::requestTransferQueue)
+   *
+   * @note copies are batched into the open command buffer until flushed.
+   * Each submitted batch gets a completion token, a monotonically increasing
+   * value reached once its copies finished (a fence per batch). Tokens are
+   * polled without blocking, so the caller swaps the data in once it's
+   * resident, rather than waiting for the queue.
+   *
+   * @note if the transfer queue family isn't the graphics one, the destination
+   * ranges are released by their batch and acquired by the next frame recorded
+   * after their token completed (see recordAcquireBarriers), so the
+   * destination buffers are still created with exclusive sharing.
+   *
+   * @note if the transfer queue is Qt's graphics queue (no dedicated one),
+   * the batches are only ever submitted on the GUI thread, the thread
+   * QVulkanWindow submits the frames on: a worker's batch is queued to it
+   * (see Queue::guiContext), vkQueueSubmit isn't externally synchronized.
+   *
+   * @note threads that mustn't block (e.g. with the renderer's m_guiMutex
+   * locked) stream through tryUpload instead, retrying the rest later on
+   *
+   * @example
+   *   const auto &token = upload.upload(buffer, offset, data, size);
+   *   upload.flush();
+   *   ...
+   *   if(upload.isComplete(token)) // safe to draw from buffer (next frame)
+   */
+  class UploadHelper : protected BaseHelper
+  {
+    friend class PipelineHelper;
+
+    public:
+      using Token = uint64_t;
+
+      /**
+       * @struct Queue
+       */
+      struct Queue
+      {
+        VkQueue   queue       = VK_NULL_HANDLE;
+        uint32_t  familyIndex = 0;
+        QObject   *guiContext = nullptr; // set if shared with Qt (submitted on its thread)
+      };
+
+    /**
+     * @note UploadHelper is non-copyable
+     */
+    public:
+      UploadHelper() = default;
+      UploadHelper(const UploadHelper&) = delete;
+
+    /**
+     * Upload Functions (any thread)
+     * -------------------------------------------------
+     *
+     */
+    public:
+      Token upload(
+        const buffer::Buffer &_dstBuffer,
+        device::Size _dstOffset,
+        const void *_data,
+        size_t _byteSize
+      ) noexcept;
+      size_t tryUpload(
+        const buffer::Buffer &_dstBuffer,
+        device::Size _dstOffset,
+        const void *_data,
+        size_t _byteSize
+      ) noexcept;
+      Token flush() noexcept;
+      bool isComplete(Token _token) noexcept;
+      void wait(Token _token) noexcept;
+
+    /**
+     * GUI Thread
+     * -------------------------------------------------
+     *
+     */
+    public:
+      void close() noexcept;
+
+    /**
+     * Frame Worker Thread
+     * -------------------------------------------------
+     *
+     */
+    public:
+      void recordAcquireBarriers(const command::CmdBuffer &_cmdBuffer) noexcept;
+
+    public:
+      [[nodiscard]] bool isOwnershipTransferred() const noexcept
+      {
+        return m_transferQueue.familyIndex != m_graphicsFamilyIndex;
+      }
+
+      [[nodiscard]] bool isSubmittable() const noexcept
+      {
+        return !m_transferQueue.guiContext
+          || QThread::currentThread() == m_transferQueue.guiContext->thread();
+      }
+
+    private:
+      void init(
+        const device::Device &_device,
+        QVulkanDeviceFunctions *_deviceFuncs,
+        const Queue &_transferQueue,
+        uint32_t _graphicsFamilyIndex,
+        uint32_t _hostVisibleMemoryIndex
+      ) noexcept;
+      void destroy() noexcept;
+      void recordCopy(
+        const buffer::Buffer &_dstBuffer,
+        device::Size _dstOffset,
+        const quint8 *_data,
+        size_t _size,
+        device::Size _ringOffset
+      ) noexcept;
+
+    /**
+     * Staging Ring Helpers
+     * -------------------------------------------------
+     *
+     */
+    private:
+      void createRing(uint32_t _hostVisibleMemoryIndex) noexcept;
+      void destroyRing() noexcept;
+      device::Size reserve(device::Size _byteSize) noexcept;
+      bool tryReserve(device::Size _byteSize, device::Size &_ringOffset) noexcept;
+
+    /**
+     * Batch Helpers
+     * -------------------------------------------------
+     *
+     */
+    private:
+      /**
+       * @struct Batch
+       * @brief command buffer recording/in flight, reused round-robin
+       */
+      struct Batch
+      {
+        command::CmdBuffer                  cmdBuffer     = VK_NULL_HANDLE;
+        VkFence                             fence         = VK_NULL_HANDLE;
+        uint64_t                            ringEnd       = 0; // ring position released on completion
+        size_t                              acquiredCount = 0; // barriers handed over to the frame worker
+        bool                                isRecording   = false;
+        std::vector<VkBufferMemoryBarrier>  barriers; // ownership transfers (release, then acquire)
+      };
+
+    private:
+      void createBatches() noexcept;
+      void destroyBatches() noexcept;
+      Batch &beginBatch() noexcept;
+      Token submitBatch() noexcept;
+      void submitPendingBatches() noexcept;
+      bool retireBatch(bool _isBlocking) noexcept;
+      void retireBatches() noexcept;
+      void waitForOldestBatch() noexcept;
+
+    private:
+      device::Device              m_device              = VK_NULL_HANDLE;
+      QVulkanDeviceFunctions      *m_deviceFuncs        = VK_NULL_HANDLE;
+
+      Queue                       m_transferQueue;
+      uint32_t                    m_graphicsFamilyIndex = 0;
+
+      command::CmdPool            m_cmdPool             = VK_NULL_HANDLE;
+      std::vector<Batch>          m_batches;
+      Token                       m_submittedToken      = 0;
+      Token                       m_completedToken      = 0;
+      Token                       m_queuedToken         = 0; // handed to the queue (GUI thread if shared)
+      bool                        m_isClosed            = false; // later batches are dropped if not queued
+
+      buffer::Buffer              m_ringBuffer          = VK_NULL_HANDLE;
+      device::Memory              m_ringMemory          = VK_NULL_HANDLE;
+      quint8                      *m_mappedRing         = nullptr; // persistently mapped
+      uint64_t                    m_ringHead            = 0; // next write position (monotonic)
+      uint64_t                    m_ringTail            = 0; // oldest position in flight (monotonic)
+
+      QMutex                      m_uploadMutex; // producers, everything but the acquire barriers
+
+      SPSCQueue<
+        VkBufferMemoryBarrier,
+        constants::upload::acquireCapacity
+      >                           m_acquireBarriers; // completed batches -> frame worker
+  };
+}
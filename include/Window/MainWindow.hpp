@@ -36,8 +36,27 @@ namespace sdfRay4d
     private slots:
       void autoCompileSDFGraph();
       void compileSDFGraph();
+      void extractSDFGraphMesh();
       void saveSDFNodes();
 
+    /**
+     * GPU Profiler Slots
+     * -------------------------------------------------
+     */
+    private slots:
+      void toggleProfiler(bool _isVisible);
+      void updateProfiler();
+      void exportProfiler();
+
+    /**
+     * Render Settings Slots
+     * -------------------------------------------------
+     */
+    private slots:
+      void setLightingQuality(QAction *_action);
+      void setShaderOptimization(QAction *_action);
+      void setRaymarchQuality(QAction *_action);
+
     /**
      * Main Menu Button Slots
      * -------------------------------------------------
@@ -54,6 +73,8 @@ namespace sdfRay4d
     private:
       void createSDFGraphActions();
       void createSDFGraphWidgetConnections();
+      void createProfilerActions();
+      void createRenderSettingsActions();
       void createActions();
       void createMenus();
 
@@ -101,6 +122,11 @@ namespace sdfRay4d
     private:
       QMenu *m_windowMenu             = nullptr;
       QMenu *m_sdfGraphMenu           = nullptr;
+      QMenu *m_profilerMenu           = nullptr;
+      QMenu *m_renderMenu             = nullptr;
+      QMenu *m_lightingMenu           = nullptr;
+      QMenu *m_optimizationMenu       = nullptr;
+      QMenu *m_qualityMenu            = nullptr;
       QMenu *m_helpMenu               = nullptr;
 
     /**
@@ -113,7 +139,21 @@ namespace sdfRay4d
       QAction *m_quitAction           = nullptr;
       QAction *m_autoCompileAction    = nullptr;
       QAction *m_compileAction        = nullptr;
+      QAction *m_extractMeshAction    = nullptr;
       QAction *m_saveAction           = nullptr;
+      QAction *m_toggleProfilerAction = nullptr;
+      QAction *m_exportProfilerAction = nullptr;
+
+      QActionGroup *m_lightingActions = nullptr;
+      QActionGroup *m_optimizationActions = nullptr;
+      QActionGroup *m_qualityActions  = nullptr;
+
+    /**
+     * GPU Profiler (status bar overlay)
+     */
+    private:
+      QLabel *m_profilerLabel         = nullptr;
+      QTimer *m_profilerTimer         = nullptr;
 
       QSize m_windowSize;
   };
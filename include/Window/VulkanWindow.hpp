@@ -5,6 +5,10 @@
 #include <nodes/Node>
 
 #include "Renderer.hpp"
+#include "Mesh.hpp"
+#include "SDFGraph/BrickMap.hpp"
+#include "SDFGraph/MeshSDF.hpp"
+#include "SDFGraph/Tape.hpp"
 
 namespace sdfRay4d
 {
@@ -24,11 +28,44 @@ namespace sdfRay4d
 
     public:
       MaterialPtr &getSDFRMaterial(bool _isNew = false);
-      void createSDFRPipeline();
+      void createSDFRPipeline(
+        uint64_t _graphKey = 0,
+        const sdfGraph::Tape::DataPtr &_tape = nullptr
+      );
+      bool useCachedSDFRPipeline(uint64_t _graphKey);
+
+    public:
+      QString getProfilerSummary();
+      bool exportProfilerStats(const QString &_filePath);
+
+    /**
+     * @note VK_QUEUE_FAMILY_IGNORED if no separate transfer queue was requested
+     */
+    public:
+      [[nodiscard]] uint32_t transferQueueFamilyIndex() const { return m_transferQueueFamilyIndex; }
+      [[nodiscard]] uint32_t transferQueueIndex() const { return m_transferQueueIndex; }
+
+    public:
+      void setLightingScale(float _scale);
+      void setRaymarchQuality(const RaymarchQuality &_quality);
+      void setBrickMap(const sdfGraph::BrickMap::DataPtr &_data);
+      void setMeshVolume(const sdfGraph::MeshSDF::DataPtr &_data);
+      bool setSceneTape(const sdfGraph::Tape::DataPtr &_data);
+      void setActorMesh(const Mesh::DataPtr &_data);
 
     signals:
       void compileSDFGraph(bool _isAutoCompile = false);
 
+    private slots:
+      void applyRaymarchQuality();
+
+    private:
+      void requestTransferQueue(
+        const VkQueueFamilyProperties *_properties,
+        uint32_t _queueFamilyCount,
+        QVector<VkDeviceQueueCreateInfo> &_createInfos
+      );
+
     private:
       void mousePressEvent    (QMouseEvent *_event) override;
       void mouseReleaseEvent  (QMouseEvent *_event) override;
@@ -40,6 +77,9 @@ namespace sdfRay4d
       Renderer *m_renderer = nullptr;
       bool m_isDebug = false;
 
+      uint32_t m_transferQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+      uint32_t m_transferQueueIndex = 0;
+
       bool m_pressed = false;
       QPoint m_lastPos;
   };
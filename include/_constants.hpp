@@ -10,14 +10,192 @@
 namespace sdfRay4d::constants
 {
   static constexpr const auto autoCompileInterval = 350; // milliseconds
+  static constexpr const auto specializeDelay     = 500;  // milliseconds without edits before the interpreted scene is compiled
+  static constexpr const auto optimizeDelay       = 2000; // milliseconds without edits before the full SPIR-V optimization
 
   static constexpr const auto shaderVersion       = 450;
   static constexpr const auto shaderTmpl    = "/* ------ PLACEHOLDER (DO NOT CHANGE) ------ */";
+  static constexpr const auto shaderMapDefine = "SDF_GRAPH_MAP"; // generated map/mapGrad replace the defaults
+  static constexpr const auto shaderAnalyticDefine = "SDF_GRAPH_ANALYTIC"; // generated mapMarch/castAnalytic (see castRay)
 
   static constexpr const auto shadersPath   = "assets/shaders/";
   static constexpr const auto modelsPath    = "assets/models/";
   static constexpr const auto texturesPath  = "assets/textures/";
 
+  /**
+   * @namespace Asset Bundle (packed static assets, see asset_bundle_pack.sh)
+   */
+  namespace bundle
+  {
+    static constexpr const auto filePath  = "assets.bundle";
+    static constexpr const auto version   = 1;
+    static constexpr const auto alignment = 16; // of the entries' data (e.g. SPIR-V words, vertices)
+    static constexpr const auto hashSize  = 8;  // leading bytes of the content's SHA-256
+  }
+
+  /**
+   * @namespace GPU Profiler
+   */
+  namespace profiler
+  {
+    static constexpr const auto maxScopes       = 16;   // timestamp/statistics queries per frame
+    static constexpr const auto windowSize      = 120;  // rolling min/avg/max window (frames)
+    static constexpr const auto overlayInterval = 500;  // milliseconds
+  }
+
+  /**
+   * @namespace Frame Worker (persistent render thread)
+   */
+  namespace frameWorker
+  {
+    static constexpr const auto jobCapacity = 8;    // power of two, > concurrent frame count
+    static constexpr const auto spinCount   = 16;   // idle polls (yielding) before parking, i.e. a job per frame parks
+    static constexpr const auto pinnedCore  = -1;   // -1: last logical core, < -1: not pinned
+  }
+
+  /**
+   * @namespace SDFR Lighting (soft shadows & AO) resolution
+   */
+  namespace lighting
+  {
+    static constexpr const auto targetScale   = 0.5f;   // offscreen target size (of the swapchain extent)
+    static constexpr const auto defaultScale  = 0.5f;   // 1.0: full (main pass), 0.5: half, 0.25: quarter
+  }
+
+  /**
+   * @namespace SDFR Pipeline Cache (recent SDF Graph revisions)
+   */
+  namespace pipelineCache
+  {
+    static constexpr const auto capacity = 8; // built pipelines kept alive besides the current one
+  }
+
+  /**
+   * @namespace SDF Graph CPU Evaluator (batch queries)
+   */
+  namespace evaluator
+  {
+    static constexpr const auto parallelThreshold = 16384;  // points, smaller batches run on the caller thread
+    static constexpr const auto chunkSize         = 4096;   // points per thread pool task (multiple of 8)
+  }
+
+  /**
+   * @namespace CPU Reference Raymarcher
+   */
+  namespace raymarcher
+  {
+    static constexpr const auto tileSize  = 16;   // pixels per tile side (one ray packet per tile)
+  }
+
+  /**
+   * @namespace SDF Graph Mesh Extractor (dual contouring)
+   */
+  namespace meshExtractor
+  {
+    static constexpr const auto resolution  = 128;  // cells along the longest axis of the scene bounds
+    static constexpr const auto chunkSize   = 32;   // cells per chunk side (one thread pool task), power of two
+    static constexpr const auto leafSize    = 4;    // cells per finest octree block side, power of two
+  }
+
+  /**
+   * @namespace Mesh to SDF Conversion (jump flooding)
+   */
+  namespace meshSDF
+  {
+    static constexpr const auto resolution    = 128;  // samples along the longest axis (incl. padding)
+    static constexpr const auto maxResolution = 256;  // mesh volume storage capacity per axis
+    static constexpr const auto padding       = 4;    // samples around the mesh bounds
+    static constexpr const auto slabSize      = 4;    // z slices per thread pool task
+    static constexpr const auto cachePath     = "cache/mesh_sdf/";
+    static constexpr const auto headerSize    = 8;    // origin, spacing (vec4) + dims (uvec4)
+    static constexpr const auto maxBytes      = (
+      headerSize +
+      maxResolution * maxResolution * maxResolution / 2
+    ) * 4; // packHalf2x16 pairs, see volumes.partial.glsl
+  }
+
+  /**
+   * @namespace SDF Graph Brick Map (baked static primitives)
+   */
+  namespace brickMap
+  {
+    static constexpr const auto brickSize   = 8;        // samples per axis (see volumes.partial.glsl)
+    static constexpr const auto cellSize    = 0.125f;   // world units per cell (brick)
+    static constexpr const auto maxCells    = 64 * 64 * 64;
+    static constexpr const auto maxBricks   = 4096;
+    static constexpr const auto headerSize  = 8;        // origin (vec4) + dims (uvec4)
+    static constexpr const auto maxBytes    = (
+      headerSize +
+      maxCells +
+      maxBricks * brickSize * brickSize * brickSize
+    ) * 4;
+  }
+
+  /**
+   * @namespace SDFR Storage Buffer (brick map, mesh volume, scene tape)
+   */
+  namespace storage
+  {
+    static constexpr const auto slotCount = 2; // per range, drawn/written (see Renderer::StorageRange)
+  }
+
+  /**
+   * @namespace SDF Graph Scene Tape (interpreted bytecode, see Tape)
+   */
+  namespace tape
+  {
+    static constexpr const auto stackSize       = 8;    // see TAPE_STACK_SIZE (sdfr_pass.frag)
+    static constexpr const auto maxInstructions = 1024;
+    static constexpr const auto maxNodes        = 512;  // see MAX_NODES (sdfr_binning.comp)
+    static constexpr const auto headerSize      = 4;    // instruction count, stack depth, node count (uvec4)
+    static constexpr const auto instructionSize = 8;    // (opcode, material), operand (2 uvec4)
+    static constexpr const auto nodeSize        = 12;   // instruction range, translation, bounding sphere (3 uvec4)
+    static constexpr const auto maxBytes        = (
+      headerSize +
+      maxInstructions * instructionSize +
+      maxNodes * nodeSize
+    ) * 4;
+  }
+
+  /**
+   * @namespace SDFR Tile Binning (compute prepass, see sdfr_binning.comp)
+   */
+  namespace binning
+  {
+    static constexpr const auto tileSize    = 16;         // pixels per tile side, see TILE_SIZE
+    static constexpr const auto capacity    = 31;         // nodes per tile list, overflowing tiles march every node
+    static constexpr const auto binSize     = 1 + capacity; // count + node indices (uint)
+    static constexpr const auto maxTiles    = 256 * 256;  // e.g. 4096 x 4096 pixels, the remaining tiles aren't binned
+    static constexpr const auto groupSize   = 64;         // invocations per workgroup (local_size_x)
+    static constexpr const auto maxBytes    = maxTiles * binSize * 4;
+  }
+
+  /**
+   * @namespace Actor Mesh
+   */
+  namespace mesh
+  {
+    static constexpr const auto vertexSize        = 8 * 4;    // x, y, z, u, v, nx, ny, nz (.buf, Mesh::Data)
+    static constexpr const auto packedVertexSize  = 16;       // see MeshOptimizer::Vertex
+    static constexpr const auto maxVertexCount    = 1 << 19;  // actor vertex buffer capacity
+    static constexpr const auto maxIndexCount     = 1 << 20;  // actor index buffer capacity (uint32)
+    static constexpr const auto headerSize        = 4 + 4 + 6 * 4; // .buf: format, vertexCount, aabb
+    static constexpr const auto vertexCacheSize   = 16;       // post-transform FIFO entries (Tipsify)
+    static constexpr const auto slotCount         = 2;        // actor buffer slots, drawn/uploading
+  }
+
+  /**
+   * @namespace Uploads (staging ring, transfer queue)
+   */
+  namespace upload
+  {
+    static constexpr const auto ringSize        = 1 << 24;  // host visible staging bytes
+    static constexpr const auto chunkSize       = 1 << 22;  // bytes per copy, at most a quarter of the ring
+    static constexpr const auto alignment       = 16;       // of the copies' source offsets
+    static constexpr const auto batchCount      = 4;        // command buffers in flight
+    static constexpr const auto acquireCapacity = 1024;     // ownership barriers handed to the frame worker
+  }
+
   /**
    * @namespace Models
    */
@@ -72,6 +250,12 @@ namespace sdfRay4d::constants
      */
     namespace raymarch
     {
+      namespace comp
+      {
+        static constexpr const auto binning = "Raymarch/static/sdfr_binning.comp";
+        static constexpr const auto binningSPV = "Raymarch/static/sdfr_binning.comp.spv";
+      }
+
       namespace vert
       {
         static constexpr const auto main = "Raymarch/static/sdfr_pass.vert";
@@ -86,7 +270,9 @@ namespace sdfRay4d::constants
         namespace partials
         {
           static constexpr const auto distanceFuncs = "Raymarch/_partials/distance_functions.partial.glsl";
+          static constexpr const auto gradients = "Raymarch/_partials/gradients.partial.glsl";
           static constexpr const auto operations = "Raymarch/_partials/operations.partial.glsl";
+          static constexpr const auto volumes = "Raymarch/_partials/volumes.partial.glsl";
         }
       }
     }
@@ -2,7 +2,6 @@
 
 #include <iostream>
 #include <thread>
-#include <regex>
 
 /**
  * Data Structures
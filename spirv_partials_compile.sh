@@ -16,7 +16,7 @@ cd ${PARTS_SHADERS_PATH} || return
 sdfr_pass_file_copy=sdfr_pass.frag
 sdfr_pass_file_orig=../dynamic/sdfr_pass.frag
 
-GLSL_FILE_COUNT=2
+GLSL_FILE_COUNT=4
 counter=0
 for ext in glsl vert frag comp; do
   for file in *.${ext}; do
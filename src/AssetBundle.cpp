@@ -0,0 +1,228 @@
+/*****************************************************
+ * Class: AssetBundle (General)
+ * Members: General Functions (Public/Private)
+ * Partials: None
+ *****************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <QCryptographicHash>
+#include <QDir>
+
+#include "AssetBundle.hpp"
+
+using namespace sdfRay4d;
+
+/**
+ * @brief maps the bundle, for the lifetime of the process
+ *
+ * @note in debug builds, the content hashes of all entries are verified
+ *
+ * @param[in] _filePath
+ * @return false if there is no (valid) bundle, assets are then read from their files
+ */
+bool AssetBundle::open(const QString &_filePath)
+{
+  auto &bundle = getInstance();
+
+  if(bundle.m_header) return true;
+
+  if(!QFile::exists(_filePath))
+  {
+    qDebug("No asset bundle (%s), reading loose asset files", qPrintable(_filePath));
+    return false;
+  }
+
+  if(!bundle.map(_filePath))
+  {
+    qWarning("Ignoring invalid asset bundle %s", qPrintable(_filePath));
+
+    bundle.m_file.close(); // unmaps
+    bundle.m_data     = nullptr;
+    bundle.m_size     = 0;
+    bundle.m_header   = nullptr;
+    bundle.m_entries  = nullptr;
+
+    return false;
+  }
+
+  qDebug(
+    "Asset bundle %s: %u entries, %lld bytes",
+    qPrintable(_filePath),
+    bundle.m_header->entryCount,
+    bundle.m_size
+  );
+
+  return true;
+}
+
+bool AssetBundle::isOpen()
+{
+  return getInstance().m_header != nullptr;
+}
+
+/**
+ * @brief zero-copy view of a bundled asset
+ *
+ * @param[in] _assetPath e.g. assets/shaders/Depth/depth_pass.vert.spv
+ * @return raw data view (valid until the process exits), null if not bundled
+ */
+QByteArray AssetBundle::get(const QString &_assetPath)
+{
+  const auto &bundle = getInstance();
+
+  if(!bundle.m_header) return {};
+
+  const auto *entry = bundle.find(QDir::cleanPath(_assetPath).toUtf8());
+
+  if(!entry) return {};
+
+  return QByteArray::fromRawData(
+    reinterpret_cast<const char*>(bundle.m_data + entry->dataOffset),
+    (int) entry->dataSize
+  );
+}
+
+/**
+ * @brief bundled asset (view) or the loose file's bytes
+ *
+ * @param[in] _assetPath
+ * @return null if neither is found
+ */
+QByteArray AssetBundle::read(const QString &_assetPath)
+{
+  const auto &bytes = get(_assetPath);
+
+  if(!bytes.isNull()) return bytes;
+
+  QFile file(_assetPath);
+
+  if(!file.open(QIODevice::ReadOnly)) return {};
+
+  return file.readAll();
+}
+
+AssetBundle &AssetBundle::getInstance()
+{
+  static AssetBundle bundle;
+
+  return bundle;
+}
+
+/**
+ *
+ * @param[in] _filePath
+ * @return false if it cannot be mapped or is invalid
+ */
+bool AssetBundle::map(const QString &_filePath)
+{
+  m_file.setFileName(_filePath);
+
+  if(!m_file.open(QIODevice::ReadOnly)) return false;
+
+  m_size = m_file.size();
+
+  if(m_size < (qint64) sizeof(Header)) return false;
+
+  m_data = m_file.map(0, m_size);
+
+  if(!m_data) return false;
+
+  m_header  = reinterpret_cast<const Header*>(m_data);
+  m_entries = reinterpret_cast<const Entry*>(m_data + m_header->indexOffset);
+
+  return isValid();
+}
+
+/**
+ * @brief header and index bounds, so lookups never read past the mapping
+ * @return boolean
+ */
+bool AssetBundle::isValid() const
+{
+  const Header expected;
+  const auto &size = (uint64_t) m_size;
+
+  if(
+    std::memcmp(m_header->magic, expected.magic, sizeof(expected.magic)) != 0 ||
+    m_header->version != expected.version ||
+    m_header->alignment != expected.alignment ||
+    m_header->indexOffset % alignof(Entry) != 0 ||
+    m_header->indexOffset > size ||
+    m_header->entryCount > (size - m_header->indexOffset) / sizeof(Entry) ||
+    m_header->pathsOffset > size
+  ) return false;
+
+  for(uint32_t i = 0; i < m_header->entryCount; i++)
+  {
+    const auto &entry = m_entries[i];
+
+    if(
+      entry.pathOffset + (uint64_t) entry.pathSize > size - m_header->pathsOffset ||
+      entry.dataOffset > size ||
+      entry.dataSize > size - entry.dataOffset ||
+      entry.dataSize > (uint64_t) std::numeric_limits<int>::max()
+    ) return false;
+
+#ifndef NDEBUG
+    if(!isHashValid(entry)) return false;
+#endif
+  }
+
+  return true;
+}
+
+/**
+ *
+ * @param[in] _entry
+ * @return boolean
+ */
+bool AssetBundle::isHashValid(const Entry &_entry) const
+{
+  const auto &hash = QCryptographicHash::hash(
+    QByteArray::fromRawData(
+      reinterpret_cast<const char*>(m_data + _entry.dataOffset),
+      (int) _entry.dataSize
+    ),
+    QCryptographicHash::Sha256
+  );
+
+  return std::memcmp(hash.constData(), _entry.hash, sizeof(_entry.hash)) == 0;
+}
+
+/**
+ * @brief binary search over the (sorted) index
+ *
+ * @param[in] _path
+ * @return entry, nullptr if not found
+ */
+const AssetBundle::Entry *AssetBundle::find(const QByteArray &_path) const
+{
+  const auto *paths = reinterpret_cast<const char*>(m_data + m_header->pathsOffset);
+
+  const auto &compare = [&](const Entry &_entry, const QByteArray &_key)
+  {
+    const auto &pathSize = (size_t) _entry.pathSize;
+    const auto &keySize = (size_t) _key.size();
+    const auto &order = std::memcmp(
+      paths + _entry.pathOffset,
+      _key.constData(),
+      std::min(pathSize, keySize)
+    );
+
+    return order < 0 || (order == 0 && pathSize < keySize);
+  };
+
+  const auto *end = m_entries + m_header->entryCount;
+  const auto *entry = std::lower_bound(m_entries, end, _path, compare);
+
+  if(
+    entry == end ||
+    entry->pathSize != (uint32_t) _path.size() ||
+    std::memcmp(paths + entry->pathOffset, _path.constData(), _path.size()) != 0
+  ) return nullptr;
+
+  return entry;
+}
@@ -0,0 +1,175 @@
+/*****************************************************
+ * Class: FrameWorker (General)
+ * Members: General Functions (Public/Private)
+ * Partials: None
+ *****************************************************/
+
+#include <QtGlobal>
+
+#if defined(Q_OS_WIN)
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#elif defined(Q_OS_LINUX)
+  #include <pthread.h>
+  #include <sched.h>
+#endif
+
+#include "FrameWorker.hpp"
+
+using namespace sdfRay4d;
+
+FrameWorker::~FrameWorker()
+{
+  stop();
+}
+
+/**
+ * @brief spawns the render thread (if not already running)
+ *
+ * @param[in] _callback invoked on the render thread per frame job
+ * @param[in] _pinnedCore logical core to pin to (-1: last core, < -1: none)
+ */
+void FrameWorker::start(
+  const Callback &_callback,
+  int _pinnedCore
+)
+{
+  if(isRunning()) return;
+
+  m_callback = _callback;
+  m_submittedCount.store(0, std::memory_order_relaxed);
+  m_completedCount.store(0, std::memory_order_relaxed);
+  m_isRunning.store(true, std::memory_order_release);
+
+  m_thread = std::thread(&FrameWorker::run, this);
+
+  const auto &coreCount = (int) std::thread::hardware_concurrency();
+
+  if(_pinnedCore == -1) _pinnedCore = coreCount - 1;
+  if(_pinnedCore >= 0 && _pinnedCore < coreCount) pin(_pinnedCore);
+}
+
+/**
+ * @note waits for the already submitted jobs to finish
+ */
+void FrameWorker::stop()
+{
+  if(!isRunning()) return;
+
+  waitForIdle();
+
+  {
+    std::lock_guard<std::mutex> locker(m_parkMutex);
+    m_isRunning.store(false, std::memory_order_release);
+  }
+  m_parkCondition.notify_one();
+
+  if(m_thread.joinable()) m_thread.join();
+}
+
+/**
+ * @note producer (GUI thread) only
+ * @param[in] _job
+ * @return false if the queue is full or the worker isn't running
+ */
+bool FrameWorker::submit(const FrameJob &_job) noexcept
+{
+  if(!isRunning() || !m_jobs.push(_job)) return false;
+
+  m_submittedCount.fetch_add(1, std::memory_order_relaxed);
+
+  /**
+   * @note pairs with the fence in run(), so either the worker
+   * sees the pushed job before parking or we see it parked
+   */
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if(m_isParked.load(std::memory_order_relaxed))
+  {
+    std::lock_guard<std::mutex> locker(m_parkMutex);
+    m_parkCondition.notify_one();
+  }
+
+  return true;
+}
+
+/**
+ * @brief blocks (yielding) until all submitted jobs are completed
+ */
+void FrameWorker::waitForIdle() const noexcept
+{
+  while(
+    m_completedCount.load(std::memory_order_acquire) <
+    m_submittedCount.load(std::memory_order_relaxed)
+  )
+  {
+    std::this_thread::yield();
+  }
+}
+
+void FrameWorker::run()
+{
+  FrameJob job;
+  auto idleCount = 0;
+
+  while(isRunning())
+  {
+    if(m_jobs.pop(job))
+    {
+      m_callback(job);
+      m_completedCount.fetch_add(1, std::memory_order_release);
+
+      idleCount = 0;
+      continue;
+    }
+
+    if(++idleCount < constants::frameWorker::spinCount)
+    {
+      std::this_thread::yield();
+      continue;
+    }
+
+    // park (slow path)
+    std::unique_lock<std::mutex> locker(m_parkMutex);
+
+    m_isParked.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    m_parkCondition.wait(locker, [this]()
+    {
+      return !m_jobs.isEmpty() || !isRunning();
+    });
+
+    m_isParked.store(false, std::memory_order_relaxed);
+    idleCount = 0;
+  }
+}
+
+/**
+ * @note no hard affinity API on macOS (thread affinity tags are hints only)
+ * @param[in] _core
+ */
+void FrameWorker::pin(int _core) noexcept
+{
+#if defined(Q_OS_WIN)
+  const auto &mask = (DWORD_PTR) 1 << _core;
+
+  if(!SetThreadAffinityMask(m_thread.native_handle(), mask))
+  {
+    qWarning("Failed to pin frame worker to core %d", _core);
+  }
+#elif defined(Q_OS_LINUX)
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(_core, &cpuSet);
+
+  if(pthread_setaffinity_np(m_thread.native_handle(), sizeof(cpu_set_t), &cpuSet) != 0)
+  {
+    qWarning("Failed to pin frame worker to core %d", _core);
+  }
+#else
+  Q_UNUSED(_core)
+#endif
+}
@@ -4,14 +4,21 @@
  * Partials: None
  *****************************************************/
 
+#include <limits>
+
 #include <QtConcurrentRun>
 #include <QFile>
 
+#include "AssetBundle.hpp"
 #include "Mesh.hpp"
 
 using namespace sdfRay4d;
 
 /**
+ * @note the mesh is validated in place, geom refers to the mapped
+ * vertices (no copy), either in the asset bundle (mapped for the
+ * process lifetime) or in the memory-mapped file, for as long as
+ * the data (or any copy of it) is alive
  *
  * @param[in] _fileName
  */
@@ -24,13 +31,44 @@ void Mesh::load(const QString &_fileName)
   m_worker = QtConcurrent::run([_fileName]()
   {
     Data md;
-    QFile f(_fileName);
-    if (!f.open(QIODevice::ReadOnly)) {
-      qWarning("Failed to open %s", qPrintable(_fileName));
+
+    std::shared_ptr<QFile> file;
+
+    const auto &bundled = AssetBundle::get(_fileName);
+
+    const char *p = bundled.isNull() ? nullptr : bundled.constData();
+    qint64 fileSize = bundled.size();
+
+    if (!p)
+    {
+      file = std::make_shared<QFile>(_fileName);
+
+      if (!file->open(QIODevice::ReadOnly))
+      {
+        qWarning("Failed to open %s", qPrintable(_fileName));
+        return md;
+      }
+
+      fileSize = file->size();
+    }
+
+    if (fileSize < constants::mesh::headerSize)
+    {
+      qWarning("Truncated header in %s", qPrintable(_fileName));
       return md;
     }
-    QByteArray buf = f.readAll();
-    const char *p = buf.constData();
+
+    if (file)
+    {
+      p = reinterpret_cast<const char*>(file->map(0, fileSize));
+
+      if (!p)
+      {
+        qWarning("Failed to map %s: %s", qPrintable(_fileName), qPrintable(file->errorString()));
+        return md;
+      }
+    }
+
     quint32 format;
     memcpy(&format, p, 4);
 
@@ -39,18 +77,42 @@ void Mesh::load(const QString &_fileName)
       qWarning("Invalid format in %s", qPrintable(_fileName));
       return md;
     }
-    int ofs = 4;
-    memcpy(&md.vertexCount, p + ofs, 4);
-    ofs += 4;
-    memcpy(md.aabb, p + ofs, 6 * 4);
-    ofs += 6 * 4;
-    const int byteCount = md.vertexCount * 8 * 4;
-    md.geom.resize(byteCount);
-    memcpy(md.geom.data(), p + ofs, byteCount);
+
+    qint32 vertexCount;
+    memcpy(&vertexCount, p + 4, 4);
+
+    const auto &byteCount = (qint64) vertexCount * constants::mesh::vertexSize;
+
+    if (
+      vertexCount <= 0 ||
+      byteCount > fileSize - constants::mesh::headerSize ||
+      byteCount > std::numeric_limits<int>::max()
+    )
+    {
+      qWarning("Invalid vertex count (%d) in %s", vertexCount, qPrintable(_fileName));
+      return md;
+    }
+
+    md.vertexCount = vertexCount;
+    memcpy(md.aabb, p + 8, 6 * 4);
+    md.geom = QByteArray::fromRawData(p + constants::mesh::headerSize, (int) byteCount);
+    md.file = std::move(file);
+
     return md;
   });
 }
 
+/**
+ * @brief replaces the (loaded) data, e.g. by a mesh extracted from the SDF Graph
+ * @param[in] _data
+ */
+void Mesh::set(const Data &_data)
+{
+  reset();
+
+  m_data = _data;
+}
+
 /**
  *
  * @return Mesh::Data instance
@@ -0,0 +1,243 @@
+/*****************************************************
+ * Class: MeshOptimizer (General)
+ * Members: General Functions (Public/Private)
+ *
+ * This Class is split into partials to categorize
+ * and classify the functionality
+ * for the purpose of readability/maintainability
+ *
+ * The partials can be found in the respective
+ * directory named as the class name
+ *
+ * Partials:
+ * - vertex_cache_helpers.cpp
+ *****************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+#include <QtCore/qfloat16.h>
+
+#include "MeshOptimizer.hpp"
+
+using namespace sdfRay4d;
+
+namespace
+{
+  /**
+   * @namespace packing
+   * @brief quantized vertex helpers
+   */
+  namespace packing
+  {
+    /**
+     * @struct VertexHash
+     * @brief the quantized vertex is hashed by its bytes (FNV-1a)
+     */
+    struct VertexHash
+    {
+      size_t operator()(const MeshOptimizer::Vertex &_vertex) const noexcept
+      {
+        const auto *bytes = reinterpret_cast<const uint8_t*>(&_vertex);
+        uint64_t hash = 14695981039346656037ull;
+
+        for(size_t i = 0; i < sizeof(MeshOptimizer::Vertex); i++)
+        {
+          hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+
+        return (size_t) hash;
+      }
+    };
+
+    struct VertexEqual
+    {
+      bool operator()(
+        const MeshOptimizer::Vertex &_a,
+        const MeshOptimizer::Vertex &_b
+      ) const noexcept
+      {
+        return std::memcmp(&_a, &_b, sizeof(MeshOptimizer::Vertex)) == 0;
+      }
+    };
+
+    /**
+     * @note octahedral encoding (Cigolle et al. 2014), see decodeNormal
+     * in rasterized_mesh_pass.vert
+     */
+    void encodeNormal(const float *_normal, int16_t *_encoded) noexcept
+    {
+      const auto &length = std::abs(_normal[0]) + std::abs(_normal[1]) + std::abs(_normal[2]);
+
+      float x = 0.0f;
+      float y = 0.0f;
+
+      if(length > 0.0f)
+      {
+        x = _normal[0] / length;
+        y = _normal[1] / length;
+
+        if(_normal[2] < 0.0f)
+        {
+          const auto foldedX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+          const auto foldedY = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+
+          x = foldedX;
+          y = foldedY;
+        }
+      }
+
+      _encoded[0] = (int16_t) std::lround(std::clamp(x, -1.0f, 1.0f) * 32767.0f);
+      _encoded[1] = (int16_t) std::lround(std::clamp(y, -1.0f, 1.0f) * 32767.0f);
+    }
+  }
+}
+
+/**
+ *
+ * @param[in] _mesh
+ * @param[out] _stats (optional)
+ * @return optimized data, invalid if the mesh has no (non degenerate) triangles
+ */
+MeshOptimizer::DataPtr MeshOptimizer::optimize(
+  const Mesh::Data &_mesh,
+  Stats *_stats
+)
+{
+  auto data = quantize(_mesh);
+
+  const auto &sourceACMR = _stats
+    ? getACMR(data.indices, data.vertices.size())
+    : 0.0f;
+
+  optimizeVertexCache(data);
+  optimizeVertexFetch(data);
+
+  if(_stats)
+  {
+    Stats stats;
+    stats.sourceVertexCount = _mesh.vertexCount;
+    stats.sourceBytes       = (uint64_t) std::max(_mesh.vertexCount, 0) * constants::mesh::vertexSize;
+    stats.packedBytes       =
+      data.vertices.size() * sizeof(Vertex) +
+      data.indices.size() * sizeof(uint32_t);
+    stats.sourceACMR        = sourceACMR;
+    stats.packedACMR        = getACMR(data.indices, data.vertices.size());
+
+    *_stats = stats;
+  }
+
+  return std::make_shared<const Data>(std::move(data));
+}
+
+/**
+ * @brief quantizes and deduplicates the vertices, the (source)
+ * triangle order is kept
+ *
+ * @param[in] _mesh
+ * @return indexed data
+ */
+MeshOptimizer::Data MeshOptimizer::quantize(const Mesh::Data &_mesh)
+{
+  static_assert(sizeof(Vertex) == constants::mesh::packedVertexSize, "see setVertexInputState");
+
+  Data data;
+
+  constexpr auto floatCount = constants::mesh::vertexSize / (int) sizeof(float);
+  const auto vertexCount = std::min(
+    std::max(_mesh.vertexCount, 0),
+    (int) (_mesh.geom.size() / constants::mesh::vertexSize)
+  ) / 3 * 3;
+
+  if(vertexCount == 0) return data;
+
+  // read a vertex at a time, the (mapped) payload isn't necessarily float aligned
+  const auto *source = _mesh.geom.constData();
+  float attributes[floatCount];
+
+  const auto &readVertex = [&](int _vertex)
+  {
+    std::memcpy(
+      attributes,
+      source + (size_t) _vertex * constants::mesh::vertexSize,
+      sizeof(attributes)
+    );
+  };
+
+  float max[3];
+
+  for(auto axis = 0; axis < 3; axis++)
+  {
+    data.min[axis]  = std::numeric_limits<float>::max();
+    max[axis]       = std::numeric_limits<float>::lowest();
+  }
+
+  for(auto i = 0; i < vertexCount; i++)
+  {
+    readVertex(i);
+
+    for(auto axis = 0; axis < 3; axis++)
+    {
+      data.min[axis]  = std::min(data.min[axis], attributes[axis]);
+      max[axis]       = std::max(max[axis], attributes[axis]);
+    }
+  }
+
+  for(auto axis = 0; axis < 3; axis++)
+  {
+    data.extent[axis] = std::max(max[axis] - data.min[axis], std::numeric_limits<float>::min());
+  }
+
+  std::unordered_map<Vertex, uint32_t, packing::VertexHash, packing::VertexEqual> uniqueVertices;
+  uniqueVertices.reserve((size_t) vertexCount);
+
+  data.indices.reserve((size_t) vertexCount);
+
+  for(auto triangle = 0; triangle < vertexCount; triangle += 3)
+  {
+    uint32_t indices[3];
+
+    for(auto corner = 0; corner < 3; corner++)
+    {
+      readVertex(triangle + corner);
+
+      Vertex vertex;
+
+      for(auto axis = 0; axis < 3; axis++)
+      {
+        const auto &unit = (attributes[axis] - data.min[axis]) / data.extent[axis];
+
+        vertex.position[axis] = (uint16_t) std::lround(std::clamp(unit, 0.0f, 1.0f) * 65535.0f);
+      }
+      vertex.position[3] = 65535;
+
+      packing::encodeNormal(attributes + 5, vertex.normal);
+
+      for(auto axis = 0; axis < 2; axis++)
+      {
+        const qfloat16 texCoord(attributes[3 + axis]);
+        std::memcpy(&vertex.texCoord[axis], &texCoord, sizeof(uint16_t));
+      }
+
+      const auto &it = uniqueVertices.emplace(vertex, (uint32_t) data.vertices.size());
+
+      if(it.second) data.vertices.push_back(vertex);
+
+      indices[corner] = it.first->second;
+    }
+
+    // collapsed by the quantization (or degenerate already)
+    if(
+      indices[0] == indices[1] ||
+      indices[1] == indices[2] ||
+      indices[2] == indices[0]
+    ) continue;
+
+    data.indices.insert(data.indices.end(), indices, indices + 3);
+  }
+
+  return data;
+}
@@ -0,0 +1,201 @@
+/*****************************************************
+ * Partial Class: MeshOptimizer
+ * Members: Vertex Cache Helpers (Private)
+ *****************************************************/
+
+#include <algorithm>
+#include <limits>
+
+#include "MeshOptimizer.hpp"
+
+using namespace sdfRay4d;
+
+/**
+ * @brief reorders the triangles for the post-transform vertex cache,
+ * Tipsify (Sander, Nehab, Barczak 2007)
+ *
+ * @note linear time: triangles are fanned around a vertex, the next
+ * vertex is picked among the ones just emitted (most likely still
+ * in the cache) and dead ends fall back to the recently used ones
+ *
+ * @param[in, out] _data
+ */
+void MeshOptimizer::optimizeVertexCache(Data &_data)
+{
+  const auto &cacheSize = constants::mesh::vertexCacheSize;
+  const auto &vertexCount = _data.vertices.size();
+  const auto &triangleCount = _data.indices.size() / 3;
+
+  if(triangleCount == 0) return;
+
+  // vertex -> triangles adjacency (offsets + flat list)
+  std::vector<uint32_t> liveCount(vertexCount, 0);
+
+  for(const auto &index : _data.indices) liveCount[index]++;
+
+  std::vector<uint32_t> offsets(vertexCount + 1, 0);
+
+  for(size_t vertex = 0; vertex < vertexCount; vertex++)
+  {
+    offsets[vertex + 1] = offsets[vertex] + liveCount[vertex];
+  }
+
+  std::vector<uint32_t> adjacency(_data.indices.size());
+  std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+
+  for(size_t triangle = 0; triangle < triangleCount; triangle++)
+  {
+    for(auto corner = 0; corner < 3; corner++)
+    {
+      adjacency[cursor[_data.indices[triangle * 3 + corner]]++] = (uint32_t) triangle;
+    }
+  }
+
+  std::vector<uint32_t> cacheTime(vertexCount, 0);
+  std::vector<bool> isEmitted(triangleCount, false);
+  std::vector<uint32_t> deadEnds;
+  std::vector<uint32_t> candidates;
+
+  std::vector<uint32_t> indices;
+  indices.reserve(_data.indices.size());
+
+  uint32_t time = cacheSize + 1;
+  size_t nextVertex = 1;
+  auto fanning = 0ll;
+
+  while(fanning >= 0)
+  {
+    candidates.clear();
+
+    for(auto i = offsets[fanning]; i < offsets[fanning + 1]; i++)
+    {
+      const auto &triangle = adjacency[i];
+
+      if(isEmitted[triangle]) continue;
+
+      isEmitted[triangle] = true;
+
+      for(auto corner = 0; corner < 3; corner++)
+      {
+        const auto &vertex = _data.indices[triangle * 3 + corner];
+
+        indices.push_back(vertex);
+        deadEnds.push_back(vertex);
+        candidates.push_back(vertex);
+
+        liveCount[vertex]--;
+
+        if(time - cacheTime[vertex] > (uint32_t) cacheSize)
+        {
+          cacheTime[vertex] = time++;
+        }
+      }
+    }
+
+    // candidate still in the cache after fanning it, with the highest priority
+    fanning = -1;
+    auto priority = -1ll;
+
+    for(const auto &vertex : candidates)
+    {
+      if(liveCount[vertex] == 0) continue;
+
+      auto candidatePriority = 0ll;
+
+      if(time - cacheTime[vertex] + 2 * liveCount[vertex] <= (uint32_t) cacheSize)
+      {
+        candidatePriority = time - cacheTime[vertex];
+      }
+
+      if(candidatePriority > priority)
+      {
+        priority = candidatePriority;
+        fanning = vertex;
+      }
+    }
+
+    if(fanning >= 0) continue;
+
+    // dead end: most recently used vertex with live triangles, or the next one in order
+    while(!deadEnds.empty())
+    {
+      const auto vertex = deadEnds.back();
+      deadEnds.pop_back();
+
+      if(liveCount[vertex] > 0)
+      {
+        fanning = vertex;
+        break;
+      }
+    }
+
+    while(fanning < 0 && nextVertex < vertexCount)
+    {
+      if(liveCount[nextVertex] > 0) fanning = (long long) nextVertex;
+
+      nextVertex++;
+    }
+  }
+
+  _data.indices = std::move(indices);
+}
+
+/**
+ * @brief reorders the vertices by their first use in the
+ * (cache optimized) index buffer, for locality of the vertex fetches
+ *
+ * @param[in, out] _data
+ */
+void MeshOptimizer::optimizeVertexFetch(Data &_data)
+{
+  const auto &invalid = std::numeric_limits<uint32_t>::max();
+
+  std::vector<uint32_t> remap(_data.vertices.size(), invalid);
+  std::vector<Vertex> vertices;
+  vertices.reserve(_data.vertices.size());
+
+  for(auto &index : _data.indices)
+  {
+    if(remap[index] == invalid)
+    {
+      remap[index] = (uint32_t) vertices.size();
+      vertices.push_back(_data.vertices[index]);
+    }
+
+    index = remap[index];
+  }
+
+  _data.vertices = std::move(vertices);
+}
+
+/**
+ * @brief simulates a FIFO post-transform cache
+ * (see constants::mesh::vertexCacheSize)
+ *
+ * @param[in] _indices
+ * @param[in] _vertexCount
+ * @return average cache miss ratio, 0.5 (ideal) ... 3
+ */
+float MeshOptimizer::getACMR(
+  const std::vector<uint32_t> &_indices,
+  size_t _vertexCount
+)
+{
+  if(_indices.size() < 3) return 0.0f;
+
+  const auto &cacheSize = (uint32_t) constants::mesh::vertexCacheSize;
+
+  // FIFO: a vertex is cached as long as less than cacheSize misses happened since its own
+  std::vector<uint64_t> missTime(_vertexCount, 0);
+  uint64_t misses = 0;
+
+  for(const auto &index : _indices)
+  {
+    if(missTime[index] == 0 || misses - missTime[index] >= cacheSize)
+    {
+      missTime[index] = ++misses;
+    }
+  }
+
+  return (float) misses / (float) (_indices.size() / 3);
+}
@@ -15,9 +15,11 @@
  *      - init_materials_helpers.cpp
  *      - init_shaders_helpers.cpp
  *      - sdf_graph_pipeline_helpers.cpp
+ *      - sdfr_pipeline_cache_helpers.cpp
  * - frame (frame.cpp)
  *      - buffers.cpp
  *      - command_exec_helpers.cpp
+ *      - frame_state_helpers.cpp
  * - swapchain_resources.cpp
  * - user_input_helpers.cpp
  *****************************************************/
@@ -42,11 +44,6 @@ Renderer::Renderer(
     QString(constants::modelsPath) +
       QString(constants::modelsPaths::actor)
   );
-
-  connect(
-    &m_frameWatcher, &QFutureWatcherBase::finished,
-    this, &Renderer::updateFrame
-  );
 }
 
 void Renderer::markViewProjDirty()
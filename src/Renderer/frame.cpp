@@ -18,29 +18,58 @@ void Renderer::startNextFrame()
    * per frame, exposing the current command buffer.
    *
    * As command buffers handle CPU Workload,
-   * generating command buffers can be
-   * offloaded to a CPU worker thread
+   * generating command buffers is offloaded to
+   * the persistent frame worker (render) thread.
+   *
+   * @note current frame accessors are only valid
+   * on the GUI thread, hence captured into the job
    */
-  const auto &worker = QtConcurrent::run(
-    this,
-    &Renderer::buildFrame
-  );
-  m_frameWatcher.setFuture(worker);
+  const FrameJob job = {
+    m_vkWindow->currentCommandBuffer(),
+    m_vkWindow->currentFramebuffer(),
+    m_vkWindow->currentFrame(),
+    (uint32_t) m_windowSize.width(),
+    (uint32_t) m_windowSize.height()
+  };
+
+  if(!m_frameWorker.submit(job))
+  {
+    qWarning("Frame worker is not available, building frame on GUI thread");
+    buildFrame(job);
+  }
 }
 
-void Renderer::buildFrame()
+/**
+ * @note runs on the frame worker thread and only reads
+ * the latest published frame state snapshot (lock-free)
+ *
+ * @param[in] _job
+ */
+void Renderer::buildFrame(const FrameJob &_job)
 {
-  // makes this function Thread-safe
-  QMutexLocker locker(&m_guiMutex);
+  auto frameState = std::atomic_load(&m_frameState);
 
-  createDepthView();
-  createBuffers();
+  if(!frameState)
+  {
+    initFrameState();
+    frameState = std::atomic_load(&m_frameState);
+  }
 
-  m_pipelineHelper.waitForWorkersToFinish();
+  executeCommands(_job, *frameState);
 
-  executeCommands();
+  m_builtFrameCount.fetch_add(1, std::memory_order_acq_rel);
+
+  // signals completion back to the GUI thread (updateFrame)
+  QMetaObject::invokeMethod(
+    this,
+    [this]() { updateFrame(); },
+    Qt::QueuedConnection
+  );
 }
 
+/**
+ * @note runs on the GUI thread (queued from buildFrame)
+ */
 void Renderer::updateFrame()
 {
   if(!m_isFramePending) return;
@@ -3,6 +3,8 @@
  * Members: Frame - Command Execution Helpers (Private)
  *****************************************************/
 
+#include <QtMath>
+
 #include "Renderer.hpp"
 
 using namespace sdfRay4d;
@@ -10,23 +12,71 @@ using namespace sdfRay4d;
 /**
  * @brief generates/initializes and executes command buffers
  * @note per frame
+ * @param[in] _job current frame's command buffer/framebuffer/extent
+ * @param[in] _frameState snapshot of the passes to record
  */
-void Renderer::executeCommands()
+void Renderer::executeCommands(
+  const FrameJob &_job,
+  const FrameState &_frameState
+)
 {
   auto &command = m_pipelineHelper.getCommandHelper();
 
+  updateActorUniforms(_job, _frameState);
+
   command.init(
-    m_vkWindow->currentCommandBuffer(),
-    m_vkWindow->currentFramebuffer(),
-    m_vkWindow->currentFrame(),
-    m_windowSize.width(),
-    m_windowSize.height()
+    _job.cmdBuffer,
+    _job.framebuffer,
+    _job.frameId,
+    _job.width,
+    _job.height
+  );
+
+  /**
+   * @note buffer ranges uploaded on a dedicated transfer queue family are
+   * acquired before any pass reads them. Barriers are drained after the
+   * snapshot was loaded, so they're never recorded later than the first
+   * frame drawing the uploaded data.
+   */
+  m_pipelineHelper.getUploadHelper().recordAcquireBarriers(_job.cmdBuffer);
+
+  // device local storage, the first frames read the empty scene tape (slot 0)
+  if(!m_builtFrameCount.load(std::memory_order_acquire))
+  {
+    command.executeFillBuffer(
+      m_sdfrMaterial->storageBuffer,
+      m_tapeRange.offset,
+      constants::tape::headerSize * 4
+    );
+  }
+
+  /**
+   * @note SDFR tile binning, the node lists are read by every
+   * SDFR pass (castRay), hence dispatched ahead of them
+   */
+  command.executeComputePasses(
+    _frameState.computeMaterial,
+    _frameState.computePasses,
+    _frameState.computeClearSize
+  );
+
+  /**
+   * @note reduced resolution soft shadows/AO (and hit distance for
+   * the depth-aware upsampling), sampled by the main SDFR pass
+   */
+  const auto &lightingScale = _frameState.lightingScale;
+
+  command.executeOffscreenPass(
+    _frameState.offscreenMaterial,
+    _frameState.offscreenPasses,
+    _frameState.offscreenWidth,
+    _frameState.offscreenHeight,
+    qMin((uint32_t) qCeil(_job.width * lightingScale), _frameState.offscreenWidth),
+    qMin((uint32_t) qCeil(_job.height * lightingScale), _frameState.offscreenHeight)
   );
 
   // Custom RenderPass with depth attachment only
-  command.executeRenderPass({
-    m_depthMaterial // bind material and draw
-  });
+  command.executeRenderPass(_frameState.depthPasses);
 
   /**
    * @note since need to read from the depth buffer in the depth pass shader
@@ -34,12 +84,9 @@ void Renderer::executeCommands()
    * explicit device synchronization is required here.
    */
   command.executePipelineBarrier(
-    m_depthMaterial
+    _frameState.barrierMaterial
   );
 
-  // default Qt Vulkan RenderPass
-  command.executeRenderPass({
-    m_actorMaterial, // bind material and draw
-    m_sdfrMaterial // bind material and draw
-  });
+  // default Qt Vulkan RenderPass (actor, SDFR)
+  command.executeRenderPass(_frameState.mainPasses);
 }
@@ -3,13 +3,15 @@
  * Members: Frame - Buffers (Private)
  *****************************************************/
 
+#include <cstring>
+
 #include "Renderer.hpp"
 
 using namespace sdfRay4d;
 
 void Renderer::createBuffers()
 {
-  if (m_depthMaterial->buffer) return;
+  if (m_depthMaterial->dynamicUniformBuffer) return;
 
   markViewProjDirty();
 
@@ -17,6 +19,8 @@ void Renderer::createBuffers()
 
   for (const auto &material : m_materials)
   {
+    if(!material->bufferSize) continue; // e.g. compute (storage buffers only)
+
     if(material == m_sdfrMaterial)
     {
       material->bufferSize *= m_concurrentFrameCount;
@@ -30,6 +34,18 @@ void Renderer::createBuffers()
     );
   }
 
+  /**
+   * Depth Dynamic Uniform Buffer
+   *
+   * @note the actor's vertex uniforms (same layout), per frame as well
+   */
+  buffer.createBuffer(
+    m_depthMaterial->vertUniSize * m_concurrentFrameCount,
+    VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+    m_depthMaterial->dynamicUniformBuffer,
+    m_depthMaterial->dynamicUniformMemReq
+  );
+
   /**
    * Actor Dynamic Uniform Buffer
    *
@@ -48,9 +64,38 @@ void Renderer::createBuffers()
     m_actorMaterial->dynamicUniformMemReq
   );
 
-  // Allocate memory for everything at once.
+  /**
+   * SDFR Brick Map Storage Buffer
+   *
+   * @note device local (read every march step), fixed capacity, double
+   * buffered ranges whose spare slots are uploaded into whenever the SDF Graph
+   * bakes its static primitives or emits its scene tape (see uploadStorage)
+   */
+  buffer.createBuffer(
+    m_sdfrMaterial->storageSize,
+    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+    m_sdfrMaterial->storageBuffer,
+    m_sdfrMaterial->storageMemReq
+  );
+
+  /**
+   * SDFR Tile Bins Storage Buffer
+   *
+   * @note device local, cleared and written by the binning
+   * dispatches every frame (see executeComputePasses)
+   */
+  buffer.createBuffer(
+    m_binningMaterial->storageSize,
+    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+    m_binningMaterial->storageBuffer,
+    m_binningMaterial->storageMemReq
+  );
+
+  // Allocate (host visible) memory for the uniform buffers at once.
+  m_depthMaterial->uniMemStartOffset = 0;
+
   device::Size sdfUniformStartOffset = setDynamicOffsetAlignment(
-    0 + m_actorMaterial->memReq.size
+    m_depthMaterial->uniMemStartOffset + m_depthMaterial->dynamicUniformMemReq.size
   );
   m_actorMaterial->uniMemStartOffset = setDynamicOffsetAlignment(
     sdfUniformStartOffset + m_sdfrMaterial->memReq.size
@@ -61,15 +106,205 @@ void Renderer::createBuffers()
     m_vkWindow->hostVisibleMemoryIndex()
   );
 
-  buffer.bindBufferMemory(m_depthMaterial->buffer, 0);
-  buffer.bindBufferMemory(m_actorMaterial->buffer, m_depthMaterial->vertUniSize);
+  /**
+   * Actor Vertex Buffer
+   *
+   * @note fixed capacity (see initActorMaterial), a slot is rewritten
+   * whenever the actor mesh is replaced (see uploadActorMesh)
+   */
+  m_actorMaterial->bufferMemOffset = 0;
+
+  const auto &binsAlignment = m_binningMaterial->storageMemReq.alignment;
+  m_binningMaterial->storageMemOffset = (
+    m_actorMaterial->memReq.size +
+    binsAlignment - 1
+  ) & ~(binsAlignment - 1);
+
+  const auto &storageAlignment = m_sdfrMaterial->storageMemReq.alignment;
+  m_sdfrMaterial->storageMemOffset = (
+    m_binningMaterial->storageMemOffset +
+    m_binningMaterial->storageMemReq.size +
+    storageAlignment - 1
+  ) & ~(storageAlignment - 1);
+
+  buffer.allocateDeviceMemory(
+    m_sdfrMaterial->storageMemOffset + m_sdfrMaterial->storageMemReq.size,
+    m_vkWindow->deviceLocalMemoryIndex()
+  );
+
+  buffer.bindBufferMemory(m_depthMaterial->dynamicUniformBuffer, m_depthMaterial->uniMemStartOffset);
+  buffer.bindBufferDeviceMemory(m_actorMaterial->buffer, m_actorMaterial->bufferMemOffset);
+  buffer.bindBufferDeviceMemory(m_binningMaterial->storageBuffer, m_binningMaterial->storageMemOffset);
   buffer.bindBufferMemory(m_sdfrMaterial->buffer, sdfUniformStartOffset);
 
+  buffer.bindBufferDeviceMemory(m_sdfrMaterial->storageBuffer, m_sdfrMaterial->storageMemOffset);
+
   buffer.bindBufferMemory(m_actorMaterial->dynamicUniformBuffer, m_actorMaterial->uniMemStartOffset);
 
+  buffer.mapMemory();
+
+  // the empty scene tape (slot 0) is cleared by the first frame (see executeCommands)
+
+  /**
+   * @note the initial mesh is swapped in by the swap worker once uploaded,
+   * the first frames are drawn without it (m_guiMutex is locked, see uploadActorMesh)
+   */
+  m_pendingActorMesh = optimizeActorMesh(*m_actorMesh.data());
+  m_isActorMeshPending.store(true, std::memory_order_release);
+  uploadActorMesh();
+
   updateDescriptorSets();
 }
 
+/**
+ * @brief streams the (optimized) vertices and indices of the actor
+ * upload into its slot of the device local actor buffer, as far as
+ * the staging ring allows, and sets its token once all of it is
+ *
+ * @note m_guiMutex has to be locked, the slot must not be read by any frame in flight
+ *
+ * @return false while it's yet to be continued (see uploadActorMesh)
+ */
+bool Renderer::uploadVertices()
+{
+  const auto &data = *m_actorUpload.data;
+  const auto &slotSize = m_actorMaterial->bufferSize / constants::mesh::slotCount;
+  const auto &slotOffset = m_actorUpload.slot * slotSize;
+
+  const auto &vertexBytes = data.vertices.size() * sizeof(MeshOptimizer::Vertex);
+  auto indexUploadedSize = m_actorUpload.uploadedSize > vertexBytes
+    ? m_actorUpload.uploadedSize - vertexBytes
+    : 0;
+
+  auto isUploaded = streamUpload(
+    m_actorMaterial->buffer,
+    slotOffset,
+    data.vertices.data(),
+    vertexBytes,
+    m_actorUpload.uploadedSize
+  );
+
+  if(isUploaded)
+  {
+    isUploaded = streamUpload(
+      m_actorMaterial->buffer,
+      slotOffset + m_actorMaterial->indexOffset,
+      data.indices.data(),
+      data.indices.size() * sizeof(uint32_t),
+      indexUploadedSize
+    );
+    m_actorUpload.uploadedSize = vertexBytes + indexUploadedSize;
+  }
+
+  const auto &token = m_pipelineHelper.getUploadHelper().flush();
+
+  if(isUploaded) m_actorUpload.token = token;
+
+  return isUploaded;
+}
+
+/**
+ * @brief uploads the rest of the data, as far as the staging ring
+ * allows without waiting for the transfer queue (see UploadHelper::tryUpload)
+ *
+ * @param[in] _dstBuffer
+ * @param[in] _dstOffset of the data
+ * @param[in] _data
+ * @param[in] _byteSize
+ * @param[in,out] _uploadedSize bytes uploaded so far
+ * @return true once every byte is (the token of the next flush completes it)
+ */
+bool Renderer::streamUpload(
+  const buffer::Buffer &_dstBuffer,
+  device::Size _dstOffset,
+  const void *_data,
+  size_t _byteSize,
+  size_t &_uploadedSize
+)
+{
+  if(_uploadedSize < _byteSize)
+  {
+    _uploadedSize += m_pipelineHelper.getUploadHelper().tryUpload(
+      _dstBuffer,
+      _dstOffset + _uploadedSize,
+      static_cast<const quint8*>(_data) + _uploadedSize,
+      _byteSize - _uploadedSize
+    );
+  }
+
+  return _uploadedSize >= _byteSize;
+}
+
+/**
+ * @brief writes the actor's vertex/fragment uniforms of the current frame,
+ * and its vertex uniforms for the depth pass
+ *
+ * @note runs on the frame worker. The frame slot's range of the
+ * dynamic uniform buffer is not in use by the device, as Qt Vulkan
+ * waits for its fence before handing the slot out again.
+ *
+ * @param[in] _job
+ * @param[in] _frameState
+ */
+void Renderer::updateActorUniforms(
+  const FrameJob &_job,
+  const FrameState &_frameState
+)
+{
+  const auto &vertUniSize = m_actorMaterial->vertUniSize;
+  const auto &frameOffset = m_actorMaterial->uniMemStartOffset +
+    (device::Size) _job.frameId * (vertUniSize + m_actorMaterial->fragUniSize);
+
+  // std140: mat4 vp, mat4 model, mat3 modelNormal (3 * vec4), see rasterized_mesh_pass.vert
+  float vertUniforms[16 + 16 + 12] = {};
+
+  const auto &viewProj = _frameState.proj * _frameState.view;
+  std::memcpy(vertUniforms, viewProj.constData(), 16 * sizeof(float));
+
+  // quantized positions are dequantized by the model matrix, not the normals
+  QMatrix4x4 model;
+  const auto &dequantizedModel = model * _frameState.actorDequantization;
+  std::memcpy(vertUniforms + 16, dequantizedModel.constData(), 16 * sizeof(float));
+
+  const auto &modelNormal = model.normalMatrix();
+
+  for(auto column = 0; column < 3; column++)
+  {
+    std::memcpy(vertUniforms + 32 + column * 4, modelNormal.constData() + column * 3, 3 * sizeof(float));
+  }
+
+  /**
+   * @note std140, see rasterized_mesh_pass.frag
+   * vec3 cameraPos, ka, kd, ks, lightPos, attenuation (vec4 aligned),
+   * vec3 color, float intensity, float specularExp
+   */
+  const auto &cameraPos = _frameState.view.inverted().map(QVector3D());
+
+  const float fragUniforms[6 * 4 + 3 + 2] = {
+    cameraPos.x(), cameraPos.y(), cameraPos.z(), 0.0f,
+    0.05f, 0.05f, 0.05f, 0.0f, // ka
+    0.8f, 0.8f, 0.75f, 0.0f, // kd
+    0.5f, 0.5f, 0.5f, 0.0f, // ks
+    cameraPos.x(), cameraPos.y(), cameraPos.z(), 0.0f, // head light
+    1.0f, 0.0f, 0.0f, 0.0f, // attenuation
+    1.0f, 1.0f, 1.0f, // color
+    1.0f, // intensity
+    64.0f // specularExp
+  };
+
+  auto &buffer = m_pipelineHelper.getBufferHelper();
+
+  buffer.copyToMemory(frameOffset, vertUniforms, sizeof(vertUniforms));
+  buffer.copyToMemory(frameOffset + vertUniSize, fragUniforms, sizeof(fragUniforms));
+
+  // see depth_pass.vert
+  buffer.copyToMemory(
+    m_depthMaterial->uniMemStartOffset + (device::Size) _job.frameId * m_depthMaterial->vertUniSize,
+    vertUniforms,
+    sizeof(vertUniforms)
+  );
+}
+
 void Renderer::updateDescriptorSets()
 {
   auto &descriptor = m_pipelineHelper.getDescriptorHelper();
@@ -78,7 +313,7 @@ void Renderer::updateDescriptorSets()
     m_depthMaterial->descSets[0],
     m_depthMaterial->layoutBindings[0],
     {
-      m_depthMaterial->buffer, // buffer
+      m_depthMaterial->dynamicUniformBuffer, // buffer
       0, // offset
       m_depthMaterial->vertUniSize // range
     }
@@ -111,6 +346,73 @@ void Renderer::updateDescriptorSets()
       VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, // imageLayout
     }
   );
+  descriptor.addWriteSet(
+    m_sdfrMaterial->descSets[0],
+    m_sdfrMaterial->layoutBindings[1],
+    {
+      m_sdfrMaterial->texture.getSampler(), // sampler
+      m_sdfrMaterial->texture.getImageView(), // imageView
+      VK_IMAGE_LAYOUT_GENERAL, // imageLayout (see offscreen renderPass)
+    }
+  );
+  /**
+   * @note storage ranges are double buffered, the drawn slot is
+   * selected by the pass' dynamic offsets (see publishFrameState)
+   */
+  descriptor.addWriteSet(
+    m_sdfrMaterial->descSets[0],
+    m_sdfrMaterial->layoutBindings[2],
+    {
+      m_sdfrMaterial->storageBuffer, // buffer
+      m_brickMapRange.offset, // offset
+      m_brickMapRange.slotSize // range
+    }
+  );
+  descriptor.addWriteSet(
+    m_sdfrMaterial->descSets[0],
+    m_sdfrMaterial->layoutBindings[3],
+    {
+      m_sdfrMaterial->storageBuffer, // buffer
+      m_meshVolumeRange.offset, // offset
+      constants::meshSDF::maxBytes // range
+    }
+  );
+  descriptor.addWriteSet(
+    m_sdfrMaterial->descSets[0],
+    m_sdfrMaterial->layoutBindings[4],
+    {
+      m_sdfrMaterial->storageBuffer, // buffer
+      m_tapeRange.offset, // offset
+      constants::tape::maxBytes // range
+    }
+  );
+  descriptor.addWriteSet(
+    m_sdfrMaterial->descSets[0],
+    m_sdfrMaterial->layoutBindings[5],
+    {
+      m_binningMaterial->storageBuffer, // buffer
+      0, // offset
+      m_binningMaterial->storageSize // range
+    }
+  );
+  descriptor.addWriteSet(
+    m_binningMaterial->descSets[0],
+    m_binningMaterial->layoutBindings[0],
+    {
+      m_sdfrMaterial->storageBuffer, // buffer
+      m_tapeRange.offset, // offset
+      constants::tape::maxBytes // range
+    }
+  );
+  descriptor.addWriteSet(
+    m_binningMaterial->descSets[0],
+    m_binningMaterial->layoutBindings[1],
+    {
+      m_binningMaterial->storageBuffer, // buffer
+      0, // offset
+      m_binningMaterial->storageSize // range
+    }
+  );
 
   descriptor.updateDescriptorSets();
 }
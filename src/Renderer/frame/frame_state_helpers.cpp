@@ -0,0 +1,214 @@
+/*****************************************************
+ * Partial Class: Renderer
+ * Members: Frame - State Snapshot Helpers (Private)
+ *****************************************************/
+
+#include <algorithm>
+
+#include "Renderer.hpp"
+
+using namespace sdfRay4d;
+
+/**
+ * @brief one-off frame resources and the initial snapshot
+ *
+ * @note runs on the frame worker for the first frame after
+ * initResources only, as the pipelines are still being created
+ * by the pipeline workers until then
+ */
+void Renderer::initFrameState()
+{
+  m_pipelineHelper.waitForWorkersToFinish();
+
+  QMutexLocker locker(&m_guiMutex);
+
+  createDepthView();
+  createLightingView();
+  createBuffers();
+
+  // the initial SDFR pipeline, cached as the tape interpreter's (see setSceneTape)
+  getSDFRPipeline();
+
+  publishFrameState(true);
+}
+
+/**
+ * @brief publishes an immutable snapshot of the current frame state
+ *
+ * @note writers only (GUI thread/swap worker) with m_guiMutex locked.
+ * Until the initial snapshot exists, changes are picked up by it.
+ *
+ * @param[in] _isInitial
+ * @return published snapshot version (0 if none)
+ */
+uint64_t Renderer::publishFrameState(bool _isInitial)
+{
+  if(!_isInitial && !std::atomic_load(&m_frameState)) return 0;
+
+  auto frameState = std::make_shared<FrameState>();
+
+  /**
+   * @note SDFR push constants are extended with the lighting scale and
+   * pass mode (0: main, 1: lighting), see FSConst in sdfr_pass.frag
+   */
+  auto sdfrPass = createPass(m_sdfrMaterial);
+  sdfrPass.pushConstants.insert(
+    sdfrPass.pushConstants.end(),
+    { m_lightingScale, 0.0f }
+  );
+
+  // storage slots written last (binding order), see uploadStorage
+  sdfrPass.dynamicOffsets = {
+    (uint32_t) (m_brickMapRange.slot * m_brickMapRange.slotSize),
+    (uint32_t) (m_meshVolumeRange.slot * m_meshVolumeRange.slotSize),
+    (uint32_t) (m_tapeRange.slot * m_tapeRange.slotSize)
+  };
+
+  auto lightingPass = sdfrPass;
+  lightingPass.pipeline = m_sdfrMaterial->offscreenPipeline;
+  lightingPass.pushConstants.back() = 1.0f;
+  lightingPass.name = "SDFR Lighting Pass";
+
+  // the depth material only owns the uniforms, it draws the actor mesh
+  auto depthPass = createPass(m_depthMaterial);
+  depthPass.vertexCount   = m_actorMaterial->vertexCount;
+  depthPass.vertexBuffer  = m_actorMaterial->buffer;
+  depthPass.indexCount    = m_actorMaterial->indexCount;
+  depthPass.indexOffset   = m_actorMaterial->vertexOffset + m_actorMaterial->indexOffset;
+  depthPass.vertexOffset  = m_actorMaterial->vertexOffset;
+
+  frameState->depthPasses = {
+    depthPass
+  };
+  frameState->mainPasses = {
+    createPass(m_actorMaterial),
+    sdfrPass
+  };
+  frameState->barrierMaterial = m_depthMaterial;
+
+  frameState->computePasses   = createBinningPasses(sdfrPass);
+  frameState->computeMaterial = m_binningMaterial;
+  frameState->computeClearSize = (device::Size) getBinningTileCount() * constants::binning::binSize * 4;
+
+  // full resolution lighting is computed in the main SDFR pass
+  if(m_lightingScale < 1.0f)
+  {
+    frameState->offscreenPasses = { lightingPass };
+  }
+  frameState->offscreenMaterial = m_sdfrMaterial;
+  frameState->offscreenWidth    = (uint32_t) m_lightingExtent.width();
+  frameState->offscreenHeight   = (uint32_t) m_lightingExtent.height();
+  frameState->lightingScale     = m_lightingScale;
+
+  frameState->view    = m_camera.viewMatrix();
+  frameState->proj    = m_proj;
+  frameState->actorDequantization = m_actorDequantization;
+  frameState->version = ++m_frameStateVersion;
+
+  const auto &version = frameState->version;
+
+  std::atomic_store(&m_frameState, FrameStatePtr(std::move(frameState)));
+
+  /**
+   * @note frames built so far (and the one being built) may still read
+   * the previously published slots (see swapActorMesh)
+   */
+  const auto &freeFrame =
+    m_builtFrameCount.load(std::memory_order_acquire) +
+    (uint64_t) m_concurrentFrameCount + 1;
+
+  for(auto *range : { &m_brickMapRange, &m_meshVolumeRange, &m_tapeRange })
+  {
+    if(range->publishedSlot == range->slot) continue;
+
+    range->publishedSlot = range->slot;
+    range->freeFrame     = freeFrame;
+  }
+
+  return version;
+}
+
+/**
+ *
+ * @param[in] _material
+ * @return FrameState::Pass
+ */
+FrameState::Pass Renderer::createPass(const MaterialPtr &_material) const
+{
+  return {
+    _material,
+    _material->pipeline,
+    _material->pipelineLayout,
+    _material->pushConstants,
+    _material->name,
+    _material->vertexCount,
+    _material->buffer,
+    _material->indexCount,
+    _material->vertexOffset + _material->indexOffset,
+    _material->vertexOffset
+  };
+}
+
+/**
+ * @brief SDFR tile binning dispatches: bins the scene tape's nodes,
+ * then sorts each tile's list (see sdfr_binning.comp)
+ *
+ * @note the camera is the SDFR passes', i.e. same push constants
+ * (pass mode 0: bin nodes, 1: sort tiles)
+ *
+ * @param[in] _sdfrPass
+ * @return compute passes, none until the binning pipeline exists
+ */
+FrameState::PassList Renderer::createBinningPasses(const FrameState::Pass &_sdfrPass) const
+{
+  if(!m_binningMaterial->pipeline) return {};
+
+  const auto &groupSize = constants::binning::groupSize;
+  const auto tileCount = getBinningTileCount();
+
+  auto binPass = createPass(m_binningMaterial);
+  binPass.pushConstants = _sdfrPass.pushConstants;
+  binPass.pushConstants.back() = 0.0f;
+  binPass.dynamicOffsets = { _sdfrPass.dynamicOffsets.back() }; // scene tape slot
+  binPass.groupCount = (constants::tape::maxNodes + groupSize - 1) / groupSize;
+
+  auto sortPass = binPass;
+  sortPass.pushConstants.back() = 1.0f;
+  sortPass.groupCount = (uint32_t) ((tileCount + groupSize - 1) / groupSize);
+  sortPass.name = "SDFR Binning Sort Pass";
+
+  return {
+    binPass,
+    sortPass
+  };
+}
+
+/**
+ * @brief tiles of the swapchain extent, binned (and cleared) per frame
+ *
+ * @return uint32_t up to constants::binning::maxTiles
+ */
+uint32_t Renderer::getBinningTileCount() const
+{
+  const auto &tileSize = constants::binning::tileSize;
+
+  return (uint32_t) std::min(
+    ((m_windowSize.width() + tileSize - 1) / tileSize) *
+    ((m_windowSize.height() + tileSize - 1) / tileSize),
+    constants::binning::maxTiles
+  );
+}
+
+/**
+ * @note GUI thread, picked up by the next published snapshot
+ *
+ * @param[in] _scale of the swapchain extent (1.0: full, 0.5: half, 0.25: quarter)
+ */
+void Renderer::setLightingScale(float _scale)
+{
+  QMutexLocker locker(&m_guiMutex);
+
+  m_lightingScale = qBound(0.25f, _scale, 1.0f);
+
+  publishFrameState();
+}
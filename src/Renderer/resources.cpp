@@ -39,15 +39,40 @@ void Renderer::initResources()
   initShaders();
 
   m_pipelineHelper.createCache();
+  m_pipelineHelper.createProfiler(
+    m_vkWindow->concurrentFrameCount(),
+    getDeviceLimits()->timestampPeriod,
+    getTimestampValidBits()
+  );
+  m_pipelineHelper.createUploader(
+    getTransferQueue(),
+    m_vkWindow->graphicsQueueFamilyIndex(),
+    m_vkWindow->hostVisibleMemoryIndex()
+  );
   m_pipelineHelper.createWorkers(m_materials);
+
+  m_frameWorker.start([this](const FrameJob &_job)
+  {
+    buildFrame(_job);
+  });
 }
 
 void Renderer::releaseResources()
 {
   qDebug("releaseResources");
 
+  // a worker waiting for an upload on Qt's queue would wait for this thread
+  m_pipelineHelper.getUploadHelper().close();
+
+  m_frameWorker.stop();
+  m_swapWorker.waitForFinished();
   m_pipelineHelper.waitForWorkersToFinish();
 
+  // device is idle at this point
+  releaseSDFRPipelines();
+  destroyRetiredSDFRPipelines(true);
+  std::atomic_store(&m_frameState, FrameStatePtr());
+
   m_pipelineHelper.destroyDescriptors();
   m_pipelineHelper.destroyPipelines();
   m_pipelineHelper.destroyRenderPass();
@@ -55,4 +80,11 @@ void Renderer::releaseResources()
   m_pipelineHelper.destroyTextures();
   m_pipelineHelper.destroyBuffers();
   m_pipelineHelper.destroyMaterials();
+  m_pipelineHelper.destroyProfiler();
+  m_pipelineHelper.destroyUploader();
+
+  m_actorUpload = {};
+  m_actorSlot = 0;
+  m_actorSlotFreeFrame = 0;
+  m_builtFrameCount.store(0, std::memory_order_release);
 }
@@ -3,6 +3,8 @@
  * Members: Init Resources Helpers (Private)
  *****************************************************/
 
+#include <QtMath>
+
 #include "Renderer.hpp"
 
 using namespace sdfRay4d;
@@ -26,6 +28,7 @@ void Renderer::initMaterials()
   initDepthMaterial();
   initActorMaterial();
   initSDFRMaterial();
+  initBinningMaterial();
 }
 
 void Renderer::initShaders()
@@ -33,6 +36,43 @@ void Renderer::initShaders()
   initDepthShaders();
   initActorShaders();
   initSDFRShaders();
+  initBinningShaders();
+}
+
+/**
+ * @brief queue of the upload helper: the one requested on device
+ * creation (see VulkanWindow::requestTransferQueue), or the graphics queue
+ *
+ * @note the graphics queue is Qt's, so its uploads are submitted
+ * on the GUI thread (the renderer's)
+ *
+ * @return UploadHelper::Queue
+ */
+vkHelpers::UploadHelper::Queue Renderer::getTransferQueue()
+{
+  const auto &familyIndex = m_vkWindow->transferQueueFamilyIndex();
+
+  if(familyIndex == VK_QUEUE_FAMILY_IGNORED)
+  {
+    qDebug("Uploads: no separate transfer queue, using the graphics queue (GUI thread)");
+    return { m_vkWindow->graphicsQueue(), m_vkWindow->graphicsQueueFamilyIndex(), this };
+  }
+
+  VkQueue queue = VK_NULL_HANDLE;
+  m_deviceFuncs->vkGetDeviceQueue(
+    m_device,
+    familyIndex,
+    m_vkWindow->transferQueueIndex(),
+    &queue
+  );
+
+  qDebug(
+    "Uploads: transfer queue family %u (queue %u)",
+    familyIndex,
+    m_vkWindow->transferQueueIndex()
+  );
+
+  return { queue, familyIndex, nullptr };
 }
 
 const VkPhysicalDeviceLimits *Renderer::getDeviceLimits() const
@@ -40,6 +80,37 @@ const VkPhysicalDeviceLimits *Renderer::getDeviceLimits() const
   return &m_vkWindow->physicalDeviceProperties()->limits;
 }
 
+/**
+ * @brief timestamp valid bits of the graphics queue family
+ * (0 if timestamps are not supported on the queue)
+ * @return uint32_t
+ */
+uint32_t Renderer::getTimestampValidBits() const
+{
+  const auto &physicalDevice = m_vkWindow->physicalDevice();
+  const auto &instanceFuncs = m_vkWindow->vulkanInstance()->functions();
+
+  uint32_t queueFamilyCount = 0;
+  instanceFuncs->vkGetPhysicalDeviceQueueFamilyProperties(
+    physicalDevice,
+    &queueFamilyCount,
+    nullptr
+  );
+
+  std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+  instanceFuncs->vkGetPhysicalDeviceQueueFamilyProperties(
+    physicalDevice,
+    &queueFamilyCount,
+    queueFamilies.data()
+  );
+
+  const auto &graphicsFamilyIndex = m_vkWindow->graphicsQueueFamilyIndex();
+
+  if(graphicsFamilyIndex >= queueFamilyCount) return 0;
+
+  return queueFamilies[graphicsFamilyIndex].timestampValidBits;
+}
+
 device::Size Renderer::setDynamicOffsetAlignment(
   device::Size _offset
 )
@@ -84,3 +155,74 @@ void Renderer::createDepthView()
     depthTexture.getImageView() // framebuffer depth attachment for custom renderPass
   });
 }
+
+/**
+ * @brief creates the reduced resolution SDFR lighting target
+ * (soft shadows, AO, hit distance) and its offscreen framebuffer
+ *
+ * @note the target is sized for the largest (half) lighting resolution,
+ * lower resolutions only use its top-left corner, so switching the
+ * quality at runtime doesn't recreate any resources
+ *
+ * @note recreated (and rebound) if the swapchain extent changed,
+ * the device is idle then (see initSwapChainResources)
+ */
+void Renderer::createLightingView()
+{
+  auto &lightingTexture = m_sdfrMaterial->texture;
+  auto &lightingView = lightingTexture.getImageView();
+
+  const QSize extent = {
+    qMax(1, qCeil(m_windowSize.width() * constants::lighting::targetScale)),
+    qMax(1, qCeil(m_windowSize.height() * constants::lighting::targetScale))
+  };
+
+  const auto isResized = lightingView != VK_NULL_HANDLE;
+
+  if(isResized)
+  {
+    if(extent == m_lightingExtent) return;
+
+    m_pipelineHelper.destroyOffscreenFramebuffer(m_sdfrMaterial);
+    m_pipelineHelper.destroyTexture(lightingTexture);
+
+    lightingTexture.createSampler(getDeviceLimits()->maxSamplerAnisotropy);
+  }
+
+  m_lightingExtent = extent;
+
+  lightingTexture.createImage(
+    m_lightingExtent.width(),
+    m_lightingExtent.height(),
+    VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
+    | VK_IMAGE_USAGE_SAMPLED_BIT,
+    VK_FORMAT_R16G16B16A16_SFLOAT
+  );
+  lightingTexture.createImageMemory(m_vkWindow->deviceLocalMemoryIndex());
+  lightingTexture.createImageView(
+    VK_IMAGE_ASPECT_COLOR_BIT,
+    lightingView
+  );
+
+  m_pipelineHelper.createOffscreenFramebuffer(
+    m_sdfrMaterial,
+    { lightingTexture.getImageView() },
+    m_lightingExtent.width(),
+    m_lightingExtent.height()
+  );
+
+  if(!isResized) return; // bound along with the buffers (see updateDescriptorSets)
+
+  auto &descriptor = m_pipelineHelper.getDescriptorHelper();
+
+  descriptor.addWriteSet(
+    m_sdfrMaterial->descSets[0],
+    m_sdfrMaterial->layoutBindings[1],
+    {
+      lightingTexture.getSampler(), // sampler
+      lightingTexture.getImageView(), // imageView
+      VK_IMAGE_LAYOUT_GENERAL, // imageLayout (see offscreen renderPass)
+    }
+  );
+  descriptor.updateDescriptorSets();
+}
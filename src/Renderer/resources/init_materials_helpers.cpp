@@ -14,11 +14,11 @@ void Renderer::initDepthMaterial()
     m_deviceFuncs
   );
 
-  material->vertexCount = m_actorMesh.data()->vertexCount; // FIXME
-  material->bufferSize = material->vertexCount * 8 * sizeof(float); // FIXME
-  material->bufferUsage =
-      VK_BUFFER_USAGE_VERTEX_BUFFER_BIT // Vertex Buffer
-    | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT; // Uniform Buffer
+  /**
+   * @note no buffer of its own but the per frame uniforms (see createBuffers),
+   * it draws the actor's vertex buffer (see publishFrameState)
+   */
+  material->name = "Depth Pass";
 
   material->sourceStage =
       VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT
@@ -65,9 +65,27 @@ void Renderer::initActorMaterial()
     m_deviceFuncs
   );
 
-  material->vertexCount = m_actorMesh.data()->vertexCount;
-  material->bufferSize = material->vertexCount * 8 * sizeof(float);
-  material->bufferUsage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT; // Vertex Buffer
+  /**
+   * @note the vertex buffer has a fixed capacity, as the actor mesh
+   * can be replaced at runtime (e.g. by a mesh extracted from the SDF Graph)
+   *
+   * @note it's device local and split into slots of optimized vertices
+   * followed by the indices: one drawn, the other one being uploaded
+   * into on the transfer queue (see uploadActorMesh)
+   */
+  material->name = "Actor Pass";
+  material->vertexCount = 0; // see uploadActorMesh
+  material->indexCount = 0;
+  material->vertexOffset = 0;
+  material->indexOffset = constants::mesh::maxVertexCount * constants::mesh::packedVertexSize;
+  material->bufferSize = constants::mesh::slotCount * (
+    material->indexOffset +
+    constants::mesh::maxIndexCount * sizeof(uint32_t)
+  );
+  material->bufferUsage =
+      VK_BUFFER_USAGE_VERTEX_BUFFER_BIT // Vertex Buffer
+    | VK_BUFFER_USAGE_INDEX_BUFFER_BIT // Index Buffer
+    | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
   material->uniMemStartOffset = setDynamicOffsetAlignment(
     0 + material->memReq.size
   );
@@ -120,6 +138,7 @@ void Renderer::initActorMaterial()
  */
 void Renderer::initSDFRMaterial(const MaterialPtr &_material)
 {
+  _material->name = "SDFR Pass";
   _material->isHotSwappable = true;
 
   _material->vertexCount = 2 * 3;
@@ -137,8 +156,17 @@ void Renderer::initSDFRMaterial(const MaterialPtr &_material)
   // default Qt Vulkan RenderPass
   _material->renderPass = m_pipelineHelper.getRenderPass();
 
+  // reduced resolution lighting (soft shadows/AO) RenderPass
+  _material->offscreenRenderPass = m_pipelineHelper.getOffscreenRenderPass();
+
   _material->setPushConstantRange(0, 64);
 
+  // see sdfr_pass.frag
+  _material->setSpecialization(
+    m_raymarchQuality,
+    RaymarchQuality::getMapEntries()
+  );
+
   _material->vertUniSize = setDynamicOffsetAlignment(
     2 * 64 + 48
   ); // see rasterized_mesh_pass.vert
@@ -153,11 +181,19 @@ void Renderer::initSDFRMaterial(const MaterialPtr &_material)
   _material->descPoolSizes = {
     {
       VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, // type
+      2 // descriptorCount
+    },
+    {
+      VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, // type
+      3 // descriptorCount
+    },
+    {
+      VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, // type
       1 // descriptorCount
     }
   };
 
-  _material->layoutBindings.resize(1);
+  _material->layoutBindings.resize(6);
 
   _material->layoutBindings[0] = {
     0, // binding
@@ -165,7 +201,42 @@ void Renderer::initSDFRMaterial(const MaterialPtr &_material)
     1, // descriptorCount
     shader::StageFlag::FRAGMENT, // stageFlags
     nullptr // pImmutableSamplers
-  };
+  }; // depth texture
+  _material->layoutBindings[1] = {
+    1, // binding
+    VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, // descriptorType
+    1, // descriptorCount
+    shader::StageFlag::FRAGMENT, // stageFlags
+    nullptr // pImmutableSamplers
+  }; // lighting texture (offscreen pass)
+  _material->layoutBindings[2] = {
+    2, // binding
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, // descriptorType
+    1, // descriptorCount
+    shader::StageFlag::FRAGMENT, // stageFlags
+    nullptr // pImmutableSamplers
+  }; // brick map (volumes.partial.glsl)
+  _material->layoutBindings[3] = {
+    3, // binding
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, // descriptorType
+    1, // descriptorCount
+    shader::StageFlag::FRAGMENT, // stageFlags
+    nullptr // pImmutableSamplers
+  }; // mesh volume (volumes.partial.glsl)
+  _material->layoutBindings[4] = {
+    4, // binding
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, // descriptorType
+    1, // descriptorCount
+    shader::StageFlag::FRAGMENT, // stageFlags
+    nullptr // pImmutableSamplers
+  }; // scene tape (sdfr_pass.frag)
+  _material->layoutBindings[5] = {
+    5, // binding
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, // descriptorType
+    1, // descriptorCount
+    shader::StageFlag::FRAGMENT, // stageFlags
+    nullptr // pImmutableSamplers
+  }; // tile bins (see initBinningMaterial)
   _material->descSetLayoutCount = 1;
   _material->dynamicDescCount = 0;
 }
@@ -179,5 +250,91 @@ void Renderer::initSDFRMaterial()
 
   initSDFRMaterial(m_sdfrMaterial);
 
+  /**
+   * @note baked static SDF Graph primitives (see BrickMap), followed by
+   * the mesh volume (see MeshSDF) and the scene tape (see Tape), two slots
+   * each, selected per snapshot by the dynamic offsets (see publishFrameState)
+   */
+  const auto &storageAlignment = getDeviceLimits()->minStorageBufferOffsetAlignment;
+  const auto &alignStorage = [&](device::Size _size)
+  {
+    return ((_size + storageAlignment - 1) / storageAlignment) * storageAlignment;
+  };
+
+  m_brickMapRange = { 0, alignStorage(constants::brickMap::maxBytes) };
+  m_meshVolumeRange = {
+    m_brickMapRange.offset + constants::storage::slotCount * m_brickMapRange.slotSize,
+    alignStorage(constants::meshSDF::maxBytes)
+  };
+  m_tapeRange = {
+    m_meshVolumeRange.offset + constants::storage::slotCount * m_meshVolumeRange.slotSize,
+    alignStorage(constants::tape::maxBytes)
+  };
+
+  m_sdfrMaterial->storageSize = m_tapeRange.offset + constants::storage::slotCount * m_tapeRange.slotSize;
+
+  // the initial pipeline's (see getSDFRPipeline)
+  m_newSDFRGraphKey = 0;
+  m_newSDFRQuality  = m_raymarchQuality;
+
   m_materials.push_back(m_sdfrMaterial);
 }
+
+/**
+ * @brief compute prepass of the SDFR passes, bins the scene tape's
+ * nodes into per tile lists (see sdfr_binning.comp)
+ *
+ * @note it reads the SDFR material's scene tape and owns the tile bins,
+ * a device local storage buffer only written by its dispatches
+ * (cleared per frame) and read by the SDFR passes
+ */
+void Renderer::initBinningMaterial()
+{
+  auto &material = m_binningMaterial = std::make_shared<Mat>(
+    m_device,
+    m_deviceFuncs
+  );
+
+  material->name = "SDFR Binning Pass";
+  material->storageSize = constants::binning::maxBytes;
+
+  // same push constants as the SDFR passes (camera, pass mode)
+  material->setPushConstantRange(0, 64, shader::StageFlag::COMPUTE);
+
+  material->sourceStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+  material->destinationStage =
+      VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+    | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+
+  material->descPoolSizes = {
+    {
+      VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, // type
+      1 // descriptorCount
+    },
+    {
+      VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, // type
+      1 // descriptorCount
+    }
+  };
+
+  material->layoutBindings.resize(2);
+
+  material->layoutBindings[0] = {
+    0, // binding
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, // descriptorType
+    1, // descriptorCount
+    shader::StageFlag::COMPUTE, // stageFlags
+    nullptr // pImmutableSamplers
+  }; // scene tape (node table)
+  material->layoutBindings[1] = {
+    1, // binding
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, // descriptorType
+    1, // descriptorCount
+    shader::StageFlag::COMPUTE, // stageFlags
+    nullptr // pImmutableSamplers
+  }; // tile bins
+  material->descSetLayoutCount = 1;
+  material->dynamicDescCount = 0;
+
+  m_materials.push_back(material);
+}
@@ -60,3 +60,15 @@ void Renderer::initSDFRShaders()
     fragmentShader.load(QString(sdfrShaders::frag::mainSPV));
   }
 }
+
+void Renderer::initBinningShaders()
+{
+  namespace sdfrShaders = constants::shadersPaths::raymarch;
+
+  auto &computeShader = m_binningMaterial->computeShader;
+
+  if (!computeShader.isValid())
+  {
+    computeShader.load(QString(sdfrShaders::comp::binningSPV));
+  }
+}
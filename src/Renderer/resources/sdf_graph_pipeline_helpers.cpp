@@ -25,7 +25,16 @@ Renderer::MaterialPtr &Renderer::getSDFRMaterial(bool _isNew)
   return m_newSDFRMaterial;
 }
 
-void Renderer::createSDFRPipeline()
+/**
+ * @param[in] _graphKey SDF Graph revision the new pipeline is cached
+ * for once swapped in (0: tape interpreter), see SDFGraph::getPipelineKey
+ * @param[in] _tape of the revision, its node table is uploaded along
+ * with the pipeline (see setPendingSceneTape)
+ */
+void Renderer::createSDFRPipeline(
+  uint64_t _graphKey,
+  const sdfGraph::Tape::DataPtr &_tape
+)
 {
   /**
    * @note at this point, new SDFR Material, should've been created
@@ -35,6 +44,14 @@ void Renderer::createSDFRPipeline()
 
   initSDFRMaterial(newMaterial);
 
+  // created with the current raymarch quality
+  m_isRaymarchQualityPending = false;
+
+  m_newSDFRGraphKey = _graphKey;
+  m_newSDFRTape     = _tape;
+  m_newSDFRQuality  = m_raymarchQuality;
+  m_isNewSDFRStale  = false;
+
   m_isNewWorker = true;
   m_pipelineHelper.createWorker(
     newMaterial,
@@ -48,74 +65,641 @@ void Renderer::createSDFRPipeline()
  */
 void Renderer::swapSDFRPipelines()
 {
+  if(
+    !m_isNewWorker &&
+    m_retiredPipelines.empty() &&
+    !m_isSDFRPipelinePending.load(std::memory_order_acquire) &&
+    !m_isActorMeshPending.load(std::memory_order_acquire)
+  ) return;
+
+  QMutexLocker locker(&m_guiMutex);
+
+  destroyRetiredSDFRPipelines();
+  uploadActorMesh();
+
+  /**
+   * @note cached pipeline (see useCachedSDFRPipeline, setSceneTape), no worker
+   * to wait for. Its data is uploaded into the spare storage slots, so it's
+   * retried with a later frame until the data is resident.
+   */
+  if(m_isSDFRPipelinePending.load(std::memory_order_acquire))
+  {
+    setPendingSceneTape(m_pendingSDFRPipeline->graphKey, m_pendingSDFRPipeline->tape);
+
+    if(uploadStorage())
+    {
+      m_isSDFRPipelinePending.store(false, std::memory_order_release);
+
+      setSDFRPipeline(m_pendingSDFRPipeline);
+      m_pendingSDFRPipeline = nullptr;
+
+      // unless published along with it (i.e. it's not the current one)
+      publishStorageSlots();
+    }
+  }
+
   if(!m_isNewWorker) return;
 
-  m_isNewWorker = false;
+  // edited (interpreted) since, the setSceneTape's tape is kept pending
+  if(!m_isNewSDFRStale)
+  {
+    setPendingSceneTape(m_newSDFRGraphKey, m_newSDFRTape);
+  }
 
-  QMutexLocker locker(&m_guiMutex);
+  if(!uploadStorage()) return;
 
-  m_oldPipeline.pipeline  = m_sdfrMaterial->pipeline;
-  m_oldPipeline.layout    = m_sdfrMaterial->pipelineLayout;
+  m_isNewWorker = false;
 
   m_pipelineHelper.waitForWorkerToFinish();
-  m_destroyWorker.waitForFinished();
+
+  // shares the current one (if not yet) before it's swapped out
+  const auto &currentPipeline = getSDFRPipeline();
 
   m_pipelineHelper.swapSDFRPipelines(
     m_sdfrMaterial,
     m_newSDFRMaterial
   );
 
+  // nothing swapped, keep the current pipeline
+  if(m_sdfrMaterial->pipeline == currentPipeline->pipeline)
+  {
+    publishStorageSlots();
+    return;
+  }
+
+  const auto &newPipeline = createSDFRPipelinePtr(
+    m_sdfrMaterial,
+    m_newSDFRGraphKey,
+    m_newSDFRQuality,
+    m_newSDFRMaterial->fragmentShader.getSPIRV(),
+    m_newSDFRTape
+  );
+
+  /**
+   * @note the swapped in material's shader module, descriptor set layouts,
+   * pool and texture are not referenced by any recorded command buffer
+   * (only its pipeline/layout are), so they can go right away, before
+   * the material is reused by the next compile
+   */
+  m_pipelineHelper.destroyShaderModule(m_newSDFRMaterial->fragmentShader);
+  m_pipelineHelper.destroyDescriptorSetLayouts(m_newSDFRMaterial->descSetLayouts);
+  m_pipelineHelper.destroyDescriptorPool(m_newSDFRMaterial->descPool);
+  m_pipelineHelper.destroyTexture(m_newSDFRMaterial->texture);
+
+  // edited (interpreted) since, only kept in case the edit is reverted
+  if(m_isNewSDFRStale)
+  {
+    m_sdfrMaterial->pipeline          = currentPipeline->pipeline;
+    m_sdfrMaterial->pipelineLayout    = currentPipeline->layout;
+    m_sdfrMaterial->offscreenPipeline = currentPipeline->offscreenPipeline;
+
+    cacheSDFRPipeline(newPipeline);
+    publishStorageSlots();
+    return;
+  }
+
   /**
-   * @note this waits for the graphics queue/fences to become idle
-   * and signals when the existing command buffers finished
-   * their execution.
-   *
-   * @note Although it may stall the pipeline, that is the only way
-   * Qt Vulkan seems to expose in this case. Otherwise, I could've used
-   * vkGetFenceStatus and pass the inflight Fence to check every frame,
-   * which is not available through Qt Vulkan public API (resides in
-   * QVulkanWindowPrivate class -> FrameResources struct).
-   *
-   * @note Since the shader compilation is expected to be a one-off
-   * design session for the user, than a game realtime/interactive
-   * session, therefore the speed is not expected to be
-   * very high.
+   * @note the old pipeline is retired (see createSDFRPipelinePtr)
+   * unless it's still cached, i.e. reverting to it swaps it right back
    */
+  cacheSDFRPipeline(newPipeline);
+  setSDFRPipeline(newPipeline);
+}
+
+/**
+ * @brief stores the raymarch quality of the next SDFR pipelines
+ * and recreates the current one with it (see applyRaymarchQuality)
+ *
+ * @note GUI thread
+ *
+ * @param[in] _quality
+ * @return false if it's deferred, i.e. applyRaymarchQuality has to be retried
+ */
+bool Renderer::setRaymarchQuality(const RaymarchQuality &_quality)
+{
+  {
+    QMutexLocker locker(&m_guiMutex);
+
+    m_raymarchQuality = _quality;
+    m_isRaymarchQualityPending = true;
+  }
+
+  return applyRaymarchQuality();
+}
+
+/**
+ * @brief recreates the SDFR pipeline with the pending raymarch quality
+ * from the SPIR-V of the current one, i.e. only the specialization
+ * constants change, no GLSL is assembled or compiled
+ * (or swaps the cached one back in, if built with it before)
+ *
+ * @note GUI thread, same as the SDF Graph's compiles
+ *
+ * @return false while another new SDFR pipeline is yet to be swapped in
+ */
+bool Renderer::applyRaymarchQuality()
+{
+  QMutexLocker locker(&m_guiMutex);
+
+  if(!m_isRaymarchQualityPending) return true;
+
+  // not initialized yet, the initial pipeline is created with it
+  if(!m_sdfrMaterial) return true;
+
+  // its shader module is destroyed once swapped in (see swapSDFRPipelines)
+  if(m_isNewWorker) return false;
+
+  // the SDF Graph's material, if it has been opened
+  const auto &newMaterial = getSDFRMaterial(!m_newSDFRMaterial);
+  auto &fragmentShader = newMaterial->fragmentShader;
+
+  if(fragmentShader.isValid()) return false;
+
+  // the pipeline to be swapped in next, otherwise the current one
+  const auto &currentPipeline = m_pendingSDFRPipeline
+    ? m_pendingSDFRPipeline
+    : m_sdfrPipeline;
+  const auto &graphKey = currentPipeline ? currentPipeline->graphKey : 0;
+
+  const auto &cachedPipeline = findSDFRPipeline(graphKey);
+
+  if(cachedPipeline)
+  {
+    m_isRaymarchQualityPending = false;
+    m_pendingSDFRPipeline = cachedPipeline;
+    m_isSDFRPipelinePending.store(true, std::memory_order_release);
 
-  const auto &queue = m_vkWindow->graphicsQueue();
-  const auto &result = m_deviceFuncs->vkQueueWaitIdle(queue);
-
-  if(result == VK_SUCCESS)
-  {
-    /**
-     * @note this worker helps clearing up all stale/orphaned
-     * vulkan objects for auto compile as a follow up for swapWorker.
-     * FIXME:
-     * But may not clear up some;
-     * - if switch back & forth between manual and auto, and then make changes
-     *   quite repeatedly and fast.
-     * - if multiple objects on auto-compile are loaded and changed quite
-     *   repeatedly and fast.
-     * @todo
-     *    replace async threads with fibers to address above issues
-     *    and help removing stale pointers and optimize auto compile
-     *    more efficiently
-     */
-    m_destroyWorker = QtConcurrent::run([&]()
+    return true;
+  }
+
+  /**
+   * @note the current pipeline's SPIR-V,
+   * otherwise the initial (precompiled) one
+   */
+  fragmentShader.reload(
+    currentPipeline
+      ? currentPipeline->spvBytes
+      : m_sdfrMaterial->fragmentShader.getSPIRV()
+  );
+
+  if(!fragmentShader.isValid()) return true;
+
+  createSDFRPipeline(graphKey, currentPipeline ? currentPipeline->tape : nullptr);
+
+  return true;
+}
+
+/**
+ * @brief destroys retired SDFR pipelines once no frame in flight
+ * records with them, never waits for a queue
+ *
+ * @note Qt Vulkan waits for a frame's fence before starting the frame
+ * concurrentFrameCount frames later (see swapActorMesh)
+ *
+ * @note m_guiMutex has to be locked (or all workers stopped)
+ *
+ * @param[in] _isForced skip the frame check (device is idle)
+ */
+void Renderer::destroyRetiredSDFRPipelines(bool _isForced)
+{
+  if(m_retiredPipelines.empty()) return;
+
+  const auto &builtFrameCount = m_builtFrameCount.load(std::memory_order_acquire);
+
+  const auto &retiredIt = std::partition(
+    m_retiredPipelines.begin(), m_retiredPipelines.end(),
+    [&](const RetiredPipeline &_retiredPipeline)
     {
-      QMutexLocker locker(&m_guiMutex);
+      return _isForced || _retiredPipeline.freeFrame <= builtFrameCount;
+    }
+  );
+
+  if(retiredIt == m_retiredPipelines.begin()) return;
+
+  for(auto it = m_retiredPipelines.begin(); it != retiredIt; it++)
+  {
+    m_pipelineHelper.destroyPipelineLayout(it->layout);
+    m_pipelineHelper.destroyPipeline(it->pipeline);
+    m_pipelineHelper.destroyPipeline(it->offscreenPipeline);
+  }
+
+  m_retiredPipelines.erase(m_retiredPipelines.begin(), retiredIt);
+}
+
+/**
+ * @brief stores the baked brick map to be uploaded
+ * along with the next SDFR pipeline swap
+ *
+ * @note the SDF Graph sets it right before createSDFRPipeline,
+ * as the new pipeline's map() is generated for this data
+ *
+ * @param[in] _data
+ */
+void Renderer::setBrickMap(const sdfGraph::BrickMap::DataPtr &_data)
+{
+  QMutexLocker locker(&m_guiMutex);
+
+  m_pendingBrickMap = _data;
+}
+
+/**
+ * @note m_guiMutex has to be locked (see uploadStorage)
+ *
+ * @return false while it's being uploaded
+ */
+bool Renderer::uploadBrickMap()
+{
+  if(!m_pendingBrickMap) return true;
+
+  const auto &byteSize = m_pendingBrickMap->size() * sizeof(uint32_t);
+
+  if(byteSize > m_brickMapRange.slotSize)
+  {
+    qWarning("Brick map (%zu bytes) exceeds the storage buffer", byteSize);
+    m_pendingBrickMap = nullptr;
+    return true;
+  }
+
+  return uploadStorage(m_brickMapRange, m_pendingBrickMap);
+}
+
+/**
+ * @brief stores the mesh volume to be uploaded along with
+ * the next SDFR pipeline swap (see setBrickMap)
+ *
+ * @param[in] _data
+ */
+void Renderer::setMeshVolume(const sdfGraph::MeshSDF::DataPtr &_data)
+{
+  QMutexLocker locker(&m_guiMutex);
+
+  m_pendingMeshVolume = _data;
+}
+
+/**
+ * @note same as uploadBrickMap, its slots follow the brick map's
+ * in the storage buffer (see initSDFRMaterial)
+ */
+bool Renderer::uploadMeshVolume()
+{
+  if(!m_pendingMeshVolume) return true;
+
+  const auto &byteSize = m_pendingMeshVolume->size() * sizeof(uint32_t);
+
+  if(byteSize > constants::meshSDF::maxBytes)
+  {
+    qWarning("Mesh volume (%zu bytes) exceeds the storage buffer", byteSize);
+    m_pendingMeshVolume = nullptr;
+    return true;
+  }
+
+  return uploadStorage(m_meshVolumeRange, m_pendingMeshVolume);
+}
+
+/**
+ * @brief interprets the SDF Graph's scene tape with the next frame, until
+ * its specialized pipeline has been created (i.e. no GLSL is compiled)
+ *
+ * @note GUI thread, the tape interpreter's pipeline is swapped in along
+ * with the tape (and the pending brick map/mesh volume). If it's not
+ * cached for the current raymarch quality, it's recreated from the
+ * initial SPIR-V first.
+ *
+ * @param[in] _data
+ * @return false if it can't be interpreted yet (compile right away instead)
+ */
+bool Renderer::setSceneTape(const sdfGraph::Tape::DataPtr &_data)
+{
+  QMutexLocker locker(&m_guiMutex);
 
-      m_pipelineHelper.destroyShaderModule(m_newSDFRMaterial->fragmentShader);
-      m_pipelineHelper.destroyDescriptorSetLayouts(m_newSDFRMaterial->descSetLayouts);
-      m_pipelineHelper.destroyDescriptorPool(m_newSDFRMaterial->descPool);
-      m_pipelineHelper.destroyTexture(m_newSDFRMaterial->texture);
+  if(!_data || !m_sdfrMaterial) return false;
 
-      m_pipelineHelper.destroyPipelineLayout(m_oldPipeline.layout);
-      m_pipelineHelper.destroyPipeline(m_oldPipeline.pipeline);
-    });
+  const auto &tapePipeline = findSDFRPipeline(0);
+
+  if(tapePipeline)
+  {
+    m_pendingSDFRPipeline = tapePipeline;
+    m_isSDFRPipelinePending.store(true, std::memory_order_release);
   }
   else
   {
-    qFatal("Failed to wait for graphics queue to become idle: %d", result);
+    if(m_isNewWorker) return false;
+
+    const auto &newMaterial = getSDFRMaterial(!m_newSDFRMaterial);
+    auto &fragmentShader = newMaterial->fragmentShader;
+
+    if(fragmentShader.isValid()) return false;
+
+    fragmentShader.reload(m_sdfrMaterial->fragmentShader.getSPIRV());
+
+    if(!fragmentShader.isValid()) return false;
+
+    createSDFRPipeline(0);
+  }
+
+  // the specialized pipeline being created (if any) is of a previous revision
+  if(m_isNewWorker && m_newSDFRGraphKey != 0)
+  {
+    m_isNewSDFRStale = true;
+  }
+
+  m_pendingSceneTape = _data;
+
+  return true;
+}
+
+/**
+ * @note same as uploadBrickMap, its slots follow the mesh volume's
+ * in the storage buffer (see initSDFRMaterial)
+ */
+bool Renderer::uploadSceneTape()
+{
+  if(!m_pendingSceneTape) return true;
+
+  const auto &byteSize = m_pendingSceneTape->size() * sizeof(uint32_t);
+
+  if(byteSize > constants::tape::maxBytes)
+  {
+    qWarning("Scene tape (%zu bytes) exceeds the storage buffer", byteSize);
+    m_pendingSceneTape = nullptr;
+    return true;
+  }
+
+  return uploadStorage(m_tapeRange, m_pendingSceneTape);
+}
+
+/**
+ * @brief a compiled revision bins its nodes by the node table, which has
+ * to be its own (e.g. a cached revision swapped back in). Without one
+ * (exceeds the tape's capacity) every tile marches every node.
+ *
+ * @note m_guiMutex has to be locked
+ *
+ * @param[in] _graphKey of the pipeline to be swapped in (0: tape interpreter,
+ * its tape is set by setSceneTape)
+ * @param[in] _tape
+ */
+void Renderer::setPendingSceneTape(
+  uint64_t _graphKey,
+  const sdfGraph::Tape::DataPtr &_tape
+)
+{
+  if(_graphKey == 0) return;
+
+  // the same one every call, as it's compared with the one being uploaded
+  static const auto emptyTape = std::make_shared<const sdfGraph::Tape::Data>(
+    constants::tape::headerSize,
+    0
+  );
+
+  m_pendingSceneTape = _tape ? _tape : emptyTape;
+}
+
+/**
+ * @brief streams the pending storage data (brick map, mesh volume,
+ * scene tape) into the spare slots of their ranges, and switches the
+ * ranges to them once all of it is resident, i.e. the slots are drawn
+ * from the next published snapshot on (see publishFrameState)
+ *
+ * @note m_guiMutex has to be locked, never waits for a queue
+ *
+ * @return false while it's being uploaded (retried with a later frame)
+ */
+bool Renderer::uploadStorage()
+{
+  // every range is streamed, even if an earlier one is still in flight
+  auto isUploaded = uploadBrickMap();
+  isUploaded = uploadMeshVolume() && isUploaded;
+  isUploaded = uploadSceneTape() && isUploaded;
+
+  if(!isUploaded) return false;
+
+  const auto &swapSlot = [](StorageRange &_range, auto &_pendingData)
+  {
+    if(!_pendingData) return;
+
+    _range.slot = (_range.publishedSlot + 1) % constants::storage::slotCount;
+    _range.upload = nullptr;
+    _pendingData = nullptr;
+  };
+
+  swapSlot(m_brickMapRange, m_pendingBrickMap);
+  swapSlot(m_meshVolumeRange, m_pendingMeshVolume);
+  swapSlot(m_tapeRange, m_pendingSceneTape);
+
+  return true;
+}
+
+/**
+ * @brief whether frames in flight may still read the range's spare slot
+ *
+ * @note m_guiMutex has to be locked
+ *
+ * @param[in] _range
+ * @return bool
+ */
+bool Renderer::isStorageBusy(const StorageRange &_range) const
+{
+  return
+    _range.slot != _range.publishedSlot ||
+    m_builtFrameCount.load(std::memory_order_acquire) < _range.freeFrame;
+}
+
+/**
+ * @brief streams the data into the spare slot of the range on the transfer
+ * queue (over several calls, if the staging ring is full), same as the
+ * actor mesh (see uploadActorMesh)
+ *
+ * @note m_guiMutex has to be locked. Other data restarts the upload.
+ *
+ * @param[in] _range
+ * @param[in] _data within the slot capacity
+ * @return true once its token completed
+ */
+bool Renderer::uploadStorage(
+  StorageRange &_range,
+  const StorageRange::DataPtr &_data
+)
+{
+  auto &upload = m_pipelineHelper.getUploadHelper();
+
+  if(_range.upload != _data)
+  {
+    if(isStorageBusy(_range)) return false;
+
+    _range.upload       = _data;
+    _range.uploadedSize = 0;
+    _range.token        = 0;
   }
+
+  if(!_range.token)
+  {
+    const auto &slot = (_range.publishedSlot + 1) % constants::storage::slotCount;
+
+    const auto &isUploaded = streamUpload(
+      m_sdfrMaterial->storageBuffer,
+      _range.offset + slot * _range.slotSize,
+      _data->data(),
+      _data->size() * sizeof(uint32_t),
+      _range.uploadedSize
+    );
+
+    const auto &token = upload.flush();
+
+    if(!isUploaded) return false;
+
+    _range.token = token;
+  }
+
+  return upload.isComplete(_range.token);
+}
+
+/**
+ * @brief publishes the written storage slots, unless a snapshot
+ * has been published since (e.g. along with the swapped pipeline)
+ *
+ * @note m_guiMutex has to be locked
+ */
+void Renderer::publishStorageSlots()
+{
+  if(
+    m_brickMapRange.slot == m_brickMapRange.publishedSlot &&
+    m_meshVolumeRange.slot == m_meshVolumeRange.publishedSlot &&
+    m_tapeRange.slot == m_tapeRange.publishedSlot
+  ) return;
+
+  publishFrameState();
+}
+
+/**
+ * @brief stores the actor mesh to be uploaded by the swap worker
+ * (see swapSDFRPipelines)
+ *
+ * @note any thread, e.g. the SDF Graph's mesh extraction worker,
+ * which also runs the (import-time) optimization
+ *
+ * @param[in] _data
+ */
+void Renderer::setActorMesh(const Mesh::DataPtr &_data)
+{
+  if(!_data) return;
+
+  const auto &optimizedData = optimizeActorMesh(*_data);
+
+  QMutexLocker locker(&m_guiMutex);
+
+  m_pendingActorMesh = optimizedData;
+  m_isActorMeshPending.store(true, std::memory_order_release);
+}
+
+/**
+ * @brief quantized, indexed and vertex cache optimized (see MeshOptimizer)
+ *
+ * @param[in] _data
+ * @return MeshOptimizer::DataPtr
+ */
+MeshOptimizer::DataPtr Renderer::optimizeActorMesh(const Mesh::Data &_data)
+{
+  MeshOptimizer::Stats stats;
+  const auto &optimizedData = MeshOptimizer::optimize(_data, &stats);
+
+  qDebug(
+    "Actor mesh: %d -> %zu vertices (%zu indices), %llu -> %llu bytes, ACMR %.3f -> %.3f",
+    stats.sourceVertexCount,
+    optimizedData->vertices.size(),
+    optimizedData->indices.size(),
+    (unsigned long long) stats.sourceBytes,
+    (unsigned long long) stats.packedBytes,
+    stats.sourceACMR,
+    stats.packedACMR
+  );
+
+  return optimizedData;
+}
+
+/**
+ * @note m_guiMutex has to be locked
+ *
+ * @note never waits for a queue: the mesh is streamed into the spare slot
+ * of the actor buffer on the transfer queue (over several calls, if the
+ * staging ring is full) and swapped in by a later call, once its token
+ * completed. Meanwhile frames keep drawing the current slot.
+ */
+void Renderer::uploadActorMesh()
+{
+  auto &upload = m_pipelineHelper.getUploadHelper();
+
+  if(m_actorUpload.data)
+  {
+    if(!m_actorUpload.token && !uploadVertices()) return;
+
+    if(!upload.isComplete(m_actorUpload.token)) return;
+
+    swapActorMesh();
+  }
+
+  if(!m_pendingActorMesh)
+  {
+    m_isActorMeshPending.store(false, std::memory_order_release);
+    return;
+  }
+
+  // the spare slot is still read by frames in flight
+  if(m_builtFrameCount.load(std::memory_order_acquire) < m_actorSlotFreeFrame) return;
+
+  const auto data = std::move(m_pendingActorMesh);
+
+  if(
+    data->vertices.size() > (size_t) constants::mesh::maxVertexCount ||
+    data->indices.size() > (size_t) constants::mesh::maxIndexCount
+  )
+  {
+    qWarning(
+      "Actor mesh (%zu vertices, %zu indices) exceeds the vertex buffer (%d vertices, %d indices)",
+      data->vertices.size(),
+      data->indices.size(),
+      constants::mesh::maxVertexCount,
+      constants::mesh::maxIndexCount
+    );
+    m_isActorMeshPending.store(false, std::memory_order_release);
+    return;
+  }
+
+  m_actorUpload.data = data;
+  m_actorUpload.slot = (m_actorSlot + 1) % constants::mesh::slotCount;
+
+  uploadVertices();
+}
+
+/**
+ * @brief draws the uploaded actor mesh from the next published snapshot on
+ *
+ * @note m_guiMutex has to be locked
+ */
+void Renderer::swapActorMesh()
+{
+  const auto data = std::move(m_actorUpload.data);
+  const auto &slotSize = m_actorMaterial->bufferSize / constants::mesh::slotCount;
+
+  m_actorMaterial->vertexOffset = m_actorUpload.slot * slotSize;
+  m_actorMaterial->vertexCount  = (uint32_t) data->vertices.size();
+  m_actorMaterial->indexCount   = (uint32_t) data->indices.size();
+
+  m_actorDequantization.setToIdentity();
+  m_actorDequantization.translate(data->min[0], data->min[1], data->min[2]);
+  m_actorDequantization.scale(data->extent[0], data->extent[1], data->extent[2]);
+
+  /**
+   * @note frames built so far (and the one being built) may still draw
+   * the previous slot. Qt Vulkan waits for a frame's fence before starting
+   * the frame concurrentFrameCount frames later, so the last of them has
+   * finished once that many more frames have been built.
+   */
+  m_actorSlotFreeFrame =
+    m_builtFrameCount.load(std::memory_order_acquire) +
+    (uint64_t) m_concurrentFrameCount + 1;
+  m_actorSlot = m_actorUpload.slot;
+  m_actorUpload = {};
+
+  publishFrameState();
 }
@@ -0,0 +1,225 @@
+/*****************************************************
+ * Partial Class: Renderer
+ * Members: SDFR Pipeline Cache Helpers (Public/Private)
+ *****************************************************/
+
+#include <algorithm>
+
+#include "Renderer.hpp"
+
+using namespace sdfRay4d;
+
+/**
+ * PUBLIC
+ *
+ * @brief swaps in the pipeline built for a recent SDF Graph revision
+ * (with the current raymarch quality), instead of compiling it again
+ *
+ * @note GUI thread, the swap worker swaps it in along with the
+ * pending brick map/mesh volume (see swapSDFRPipelines)
+ *
+ * @param[in] _graphKey see SDFGraph::getPipelineKey
+ * @return false if it's not cached (or a new pipeline is being created)
+ */
+bool Renderer::useCachedSDFRPipeline(uint64_t _graphKey)
+{
+  QMutexLocker locker(&m_guiMutex);
+
+  if(m_isNewWorker || !m_sdfrMaterial) return false;
+
+  const auto &cachedPipeline = findSDFRPipeline(_graphKey);
+
+  if(!cachedPipeline) return false;
+
+  m_pendingSDFRPipeline = cachedPipeline;
+  m_isSDFRPipelinePending.store(true, std::memory_order_release);
+
+  return true;
+}
+
+/**
+ * PRIVATE
+ *
+ * @brief shares the material's pipeline handles, which are
+ * retired once the last reference has been released
+ *
+ * @note m_guiMutex has to be locked when the last reference is released,
+ * by then the snapshot without the pipeline (if it was current) has
+ * already been published
+ *
+ * @param[in] _material
+ * @param[in] _graphKey
+ * @param[in] _quality
+ * @param[in] _spvBytes
+ * @param[in] _tape of the revision (node table), see setPendingSceneTape
+ * @return SDFRPipelinePtr
+ */
+Renderer::SDFRPipelinePtr Renderer::createSDFRPipelinePtr(
+  const MaterialPtr &_material,
+  uint64_t _graphKey,
+  const RaymarchQuality &_quality,
+  const std::vector<uint32_t> &_spvBytes,
+  const sdfGraph::Tape::DataPtr &_tape
+)
+{
+  return SDFRPipelinePtr(
+    new SDFRPipeline {
+      _material->pipeline,
+      _material->pipelineLayout,
+      _material->offscreenPipeline,
+      _graphKey,
+      _quality,
+      _spvBytes,
+      _tape
+    },
+    [this](SDFRPipeline *_pipeline)
+    {
+      /**
+       * @note released after the snapshot without it has been published
+       * (see setSDFRPipeline), frames built so far (and the one being
+       * built) may still record with it
+       */
+      m_retiredPipelines.push_back({
+        _pipeline->pipeline,
+        _pipeline->layout,
+        m_builtFrameCount.load(std::memory_order_acquire) + (uint64_t) m_concurrentFrameCount + 1,
+        _pipeline->offscreenPipeline
+      });
+
+      delete _pipeline;
+    }
+  );
+}
+
+/**
+ * @note the initial pipeline (created along with the other materials'
+ * pipelines) interprets the scene tape, it's shared and cached once
+ * created (see initFrameState)
+ *
+ * @return current SDFR pipeline
+ */
+const Renderer::SDFRPipelinePtr &Renderer::getSDFRPipeline()
+{
+  if(!m_sdfrPipeline)
+  {
+    m_sdfrPipeline = createSDFRPipelinePtr(
+      m_sdfrMaterial,
+      0,
+      m_newSDFRQuality,
+      m_sdfrMaterial->fragmentShader.getSPIRV(),
+      nullptr
+    );
+
+    cacheSDFRPipeline(m_sdfrPipeline);
+  }
+
+  return m_sdfrPipeline;
+}
+
+/**
+ * @brief marks the pipeline of the revision (with the current
+ * raymarch quality) as the most recently used one
+ *
+ * @param[in] _graphKey 0: tape interpreter
+ * @return cached pipeline, nullptr if none
+ */
+Renderer::SDFRPipelinePtr Renderer::findSDFRPipeline(uint64_t _graphKey)
+{
+  for(auto it = m_sdfrPipelineCache.begin(); it != m_sdfrPipelineCache.end(); it++)
+  {
+    if((*it)->graphKey != _graphKey || !((*it)->quality == m_raymarchQuality)) continue;
+
+    m_sdfrPipelineCache.splice(m_sdfrPipelineCache.begin(), m_sdfrPipelineCache, it);
+
+    return m_sdfrPipelineCache.front();
+  }
+
+  return nullptr;
+}
+
+/**
+ * @brief adds the pipeline as the most recently used one, replacing the one
+ * of the same revision/quality (e.g. fully optimized) and evicting the least
+ * recently used ones over capacity
+ *
+ * @note the tape interpreter's are never evicted (nor counted),
+ * there's at most one per raymarch quality
+ *
+ * @param[in] _pipeline
+ */
+void Renderer::cacheSDFRPipeline(const SDFRPipelinePtr &_pipeline)
+{
+  m_sdfrPipelineCache.remove_if([&](const SDFRPipelinePtr &_cachedPipeline)
+  {
+    return
+      _cachedPipeline->graphKey == _pipeline->graphKey &&
+      _cachedPipeline->quality == _pipeline->quality;
+  });
+
+  m_sdfrPipelineCache.push_front(_pipeline);
+
+  const auto &isEvictable = [](const SDFRPipelinePtr &_cachedPipeline)
+  {
+    return _cachedPipeline->graphKey != 0;
+  };
+
+  auto count = std::count_if(
+    m_sdfrPipelineCache.begin(), m_sdfrPipelineCache.end(),
+    isEvictable
+  );
+
+  for(auto it = m_sdfrPipelineCache.end(); count > constants::pipelineCache::capacity;)
+  {
+    if(!isEvictable(*--it)) continue;
+
+    it = m_sdfrPipelineCache.erase(it);
+    count--;
+  }
+}
+
+/**
+ * @brief makes the pipeline the SDFR material's (current) one
+ * and releases the previous one after publishing the snapshot
+ *
+ * @param[in] _pipeline
+ */
+void Renderer::setSDFRPipeline(const SDFRPipelinePtr &_pipeline)
+{
+  auto previousPipeline = getSDFRPipeline();
+
+  if(previousPipeline == _pipeline) return;
+
+  m_sdfrMaterial->pipeline          = _pipeline->pipeline;
+  m_sdfrMaterial->pipelineLayout    = _pipeline->layout;
+  m_sdfrMaterial->offscreenPipeline = _pipeline->offscreenPipeline;
+
+  m_sdfrPipeline = _pipeline;
+
+  /**
+   * @note the frame worker keeps recording with the previous pipeline
+   * until it picks up the newly published snapshot, so it's only retired
+   * (if not cached) once released, after that snapshot has been published
+   */
+  publishFrameState();
+}
+
+/**
+ * @brief releases the cached and the current pipeline (retired),
+ * the SDFR material doesn't own its pipeline anymore
+ *
+ * @note device is idle
+ */
+void Renderer::releaseSDFRPipelines()
+{
+  m_pendingSDFRPipeline = nullptr;
+  m_isSDFRPipelinePending.store(false, std::memory_order_release);
+  m_sdfrPipelineCache.clear();
+
+  if(!m_sdfrPipeline) return;
+
+  m_sdfrPipeline = nullptr;
+
+  m_sdfrMaterial->pipeline          = VK_NULL_HANDLE;
+  m_sdfrMaterial->pipelineLayout    = VK_NULL_HANDLE;
+  m_sdfrMaterial->offscreenPipeline = VK_NULL_HANDLE;
+}
@@ -11,6 +11,8 @@ void Renderer::initSwapChainResources()
 {
   qDebug("initSwapChainResources");
 
+  QMutexLocker locker(&m_guiMutex);
+
   /**
    * @note
    *
@@ -42,6 +44,14 @@ void Renderer::initSwapChainResources()
     m_nearPlane, // near plane
     m_farPlane, // far plane
   };
+
+  // resized (the initial target is created along with the frame resources)
+  if(m_sdfrMaterial->texture.getImageView())
+  {
+    createLightingView();
+  }
+
+  publishFrameState();
 }
 
 void Renderer::releaseSwapChainResources()
@@ -49,7 +59,7 @@ void Renderer::releaseSwapChainResources()
   qDebug("releaseSwapChainResources");
 
   m_swapWorker.waitForFinished();
-  m_frameWatcher.waitForFinished();
+  m_frameWorker.waitForIdle();
 
   if (m_isFramePending)
   {
@@ -12,6 +12,7 @@ void Renderer::yaw(float degrees)
   QMutexLocker locker(&m_guiMutex);
   m_camera.yaw(degrees);
   markViewProjDirty();
+  publishFrameState();
 }
 
 void Renderer::pitch(float degrees)
@@ -19,6 +20,7 @@ void Renderer::pitch(float degrees)
   QMutexLocker locker(&m_guiMutex);
   m_camera.pitch(degrees);
   markViewProjDirty();
+  publishFrameState();
 }
 
 void Renderer::walk(float amount)
@@ -26,6 +28,7 @@ void Renderer::walk(float amount)
   QMutexLocker locker(&m_guiMutex);
   m_camera.walk(amount);
   markViewProjDirty();
+  publishFrameState();
 }
 
 void Renderer::strafe(float amount)
@@ -33,4 +36,5 @@ void Renderer::strafe(float amount)
   QMutexLocker locker(&m_guiMutex);
   m_camera.strafe(amount);
   markViewProjDirty();
+  publishFrameState();
 }
@@ -11,12 +11,23 @@
  *          - CubeDataModel
  *          - SphereDataModel
  *          - TorusDataModel
+ *          - MeshDataModel
  * - MapDataModel
  * - OperationDataModel
  * - ShapeDataModel
+ * - CodeGen (map/mapGrad GLSL generation from the scene IR)
+ * - BrickMap (baked static primitives)
+ * - MeshExtractor (scene IR to actor mesh)
+ * - MeshSDF (mesh to signed distance volume)
  *****************************************************/
 
+#include <algorithm>
+#include <functional>
+
 #include "SDFGraph.hpp"
+#include "SDFGraph/CodeGen.hpp"
+#include "SDFGraph/MeshExtractor.hpp"
+#include "SDFGraph/Tape.hpp"
 
 #include "SDFGraph/DataModels/Operations/UnionDataModel.hpp"
 #include "SDFGraph/DataModels/Operations/SubtractionDataModel.hpp"
@@ -24,6 +35,7 @@
 #include "SDFGraph/DataModels/Shapes/CubeDataModel.hpp"
 #include "SDFGraph/DataModels/Shapes/SphereDataModel.hpp"
 #include "SDFGraph/DataModels/Shapes/TorusDataModel.hpp"
+#include "SDFGraph/DataModels/Shapes/MeshDataModel.hpp"
 
 using namespace sdfRay4d::sdfGraph;
 
@@ -43,16 +55,45 @@ SDFGraph::SDFGraph(
 
   namespace sdfrShaders = constants::shadersPaths::raymarch::frag;
 
-  m_sdfrMaterial->fragmentShader.preload({
-    sdfrShaders::partials::distanceFuncs,
-    sdfrShaders::partials::operations,
-    sdfrShaders::main
-  });
+  /**
+   * @note the distance functions and operations are parsed once (library),
+   * so a re-compile only parses the generated map() and the main shader,
+   * along with the partials'/library's functions the generated map() uses
+   */
+  m_sdfrMaterial->fragmentShader.preload(
+    {
+      sdfrShaders::partials::gradients,
+      sdfrShaders::partials::volumes,
+      sdfrShaders::main
+    },
+    {
+      sdfrShaders::partials::distanceFuncs,
+      sdfrShaders::partials::operations
+    }
+  );
 
   connect(
     m_graphScene, &FlowScene::connectionDeleted,
     this, &SDFGraph::removeMapNode
   );
+
+  m_optimizeTimer = new QTimer(this);
+  m_optimizeTimer->setSingleShot(true);
+  m_optimizeTimer->setInterval(constants::optimizeDelay);
+
+  connect(
+    m_optimizeTimer, &QTimer::timeout,
+    this, &SDFGraph::optimize
+  );
+
+  m_specializeTimer = new QTimer(this);
+  m_specializeTimer->setSingleShot(true);
+  m_specializeTimer->setInterval(constants::specializeDelay);
+
+  connect(
+    m_specializeTimer, &QTimer::timeout,
+    this, &SDFGraph::specialize
+  );
 }
 
 /**
@@ -223,34 +264,79 @@ void SDFGraph::compile(bool _isAutoCompile)
     setMapNodes();
   }
 
-  std::string shaderData;
+  /**
+   * @note the map nodes are lowered to a scene IR, from which
+   * both map() and its analytic gradient mapGrad() are generated
+   */
+  auto scene = createScene();
 
-  for(const auto &mapNode : m_mapNodes)
+  if(scene.isEmpty() && !m_isMapNodeRemoved) return;
+
+  /**
+   * @note static primitives are replaced by the brick map, only the
+   * regions around the ones that changed since the last bake are re-baked
+   */
+  m_brickMap.bake(scene);
+
+  if(m_brickMap.isDirty())
   {
-    const auto &mapData = mapNode->getData().toStdString();
+    m_vkWindow->setBrickMap(m_brickMap.getData());
+  }
 
-    if(mapData.empty()) continue;
+  setMeshVolume(scene);
 
-    shaderData += "res = ";
-    shaderData += mapData;
-    shaderData += "\n  ";
+  m_shaderData = CodeGen::generate(scene);
+  m_sceneTape  = Tape::generate(scene);
+
+  /**
+   * @note a recent revision (e.g. an undone edit) swaps its
+   * cached pipeline back in, fully optimized if it was before
+   */
+  if(m_vkWindow->useCachedSDFRPipeline(getPipelineKey(false)))
+  {
+    qDebug("SDFR shader (full): cached pipeline");
+
+    m_specializeTimer->stop();
+    m_optimizeTimer->stop();
+    m_isMapNodeRemoved = false;
+    return;
   }
 
-  if(
-    m_sdfrMaterial->fragmentShader.isValid() ||
-    (shaderData.empty() && !m_isMapNodeRemoved)
-  ) return;
+  if(m_vkWindow->useCachedSDFRPipeline(getPipelineKey(true)))
+  {
+    qDebug("SDFR shader (fast): cached pipeline");
 
-  m_sdfrMaterial->fragmentShader.load(shaderData);
+    m_specializeTimer->stop();
+
+    if(m_optimization != SPIRVCompiler::Optimization::OFF)
+    {
+      m_optimizeTimer->start();
+    }
+
+    m_isMapNodeRemoved = false;
+    return;
+  }
 
   /**
-   * @note to avoid any race condition creating
-   * a new pipeline needs to be done inside this function
-   * after the shader load thread has finished its execution.
-   * Because this function is a Qt Slot handling event queues
-   * with IPC method on a separate thread.
+   * @note the edit is interpreted (see Tape) with the next frame,
+   * its shader is only compiled once the graph has been idle for
+   * a while (see specialize), not per edit
    */
-  m_vkWindow->createSDFRPipeline();
+  if(m_vkWindow->setSceneTape(m_sceneTape))
+  {
+    m_optimizeTimer->stop();
+    m_specializeTimer->start();
+  }
+  else if(m_sdfrMaterial->fragmentShader.isValid())
+  {
+    // the last compile hasn't been swapped in yet
+    m_specializeTimer->start();
+    return;
+  }
+  else
+  {
+    specialize();
+  }
 
   /**
    * @note this has to be set back to false after shader
@@ -268,6 +354,252 @@ void SDFGraph::autoCompile()
   compile(true);
 }
 
+/**
+ *
+ * @note OFF unless the optimizer is built in, as the idle
+ * recompile (see optimize) would produce the same module
+ *
+ * @param[in] _optimization
+ */
+void SDFGraph::setOptimization(SPIRVCompiler::Optimization _optimization)
+{
+  m_optimization = SPIRVCompiler::isOptimizerAvailable()
+    ? _optimization
+    : SPIRVCompiler::Optimization::OFF;
+
+  if(m_optimization == SPIRVCompiler::Optimization::OFF)
+  {
+    m_optimizeTimer->stop();
+  }
+  else if(!m_shaderData.empty())
+  {
+    m_optimizeTimer->start();
+  }
+}
+
+/**
+ * @note Qt SLOT
+ *
+ * @brief compiles the last generated map(), i.e. the shader specialized
+ * for the graph replacing the tape interpreter once its pipeline has
+ * been created (see Renderer::setSceneTape)
+ *
+ * @note edits only run the fast optimizer passes, the full ones
+ * run once the graph has been idle for a while (see optimize)
+ */
+void SDFGraph::specialize()
+{
+  if(m_shaderData.empty()) return;
+
+  // the last compile hasn't been swapped in yet
+  if(m_sdfrMaterial->fragmentShader.isValid())
+  {
+    m_specializeTimer->start();
+    return;
+  }
+
+  m_sdfrMaterial->fragmentShader.load(m_shaderData, m_optimization, true);
+
+  printShaderStats(false);
+
+  if(m_optimization != SPIRVCompiler::Optimization::OFF)
+  {
+    m_optimizeTimer->start();
+  }
+
+  /**
+   * @note to avoid any race condition creating
+   * a new pipeline needs to be done inside this function
+   * after the shader load thread has finished its execution.
+   * Because this function is a Qt Slot handling event queues
+   * with IPC method on a separate thread.
+   */
+  m_vkWindow->createSDFRPipeline(getPipelineKey(true), m_sceneTape);
+}
+
+/**
+ * @note Qt SLOT
+ *
+ * @brief recompiles the last compiled map() with the full optimizer
+ * passes, once the graph has been idle (see constants::optimizeDelay),
+ * the pipeline is replaced when done (same as compile)
+ */
+void SDFGraph::optimize()
+{
+  // still interpreted, the fast compile restarts it (see specialize)
+  if(
+    m_optimization == SPIRVCompiler::Optimization::OFF ||
+    m_shaderData.empty() ||
+    m_specializeTimer->isActive()
+  ) return;
+
+  // the last compile hasn't been swapped in yet
+  if(m_sdfrMaterial->fragmentShader.isValid())
+  {
+    m_optimizeTimer->start();
+    return;
+  }
+
+  if(m_vkWindow->useCachedSDFRPipeline(getPipelineKey(false))) return;
+
+  m_sdfrMaterial->fragmentShader.load(m_shaderData, m_optimization);
+
+  printShaderStats(true);
+
+  m_vkWindow->createSDFRPipeline(getPipelineKey(false), m_sceneTape);
+}
+
+/**
+ * @brief identifies the SDFR pipeline compiled from the last generated
+ * map() with the current optimization (see Renderer::useCachedSDFRPipeline)
+ *
+ * @param[in] _isFastOptimization fast optimizer passes only (edits)
+ * @return non-zero key
+ */
+uint64_t SDFGraph::getPipelineKey(bool _isFastOptimization) const
+{
+  const auto &isFast =
+    _isFastOptimization &&
+    m_optimization != SPIRVCompiler::Optimization::OFF;
+
+  auto key = (uint64_t) std::hash<std::string>{}(m_shaderData);
+  key ^= ((uint64_t) m_optimization << 1 | (uint64_t) isFast) * 0x9e3779b97f4a7c15ull;
+
+  return key != 0 ? key : 1;
+}
+
+/**
+ * @brief assembly/compile/optimize times and the SPIR-V instruction count delta
+ * @param[in] _isOptimized full (idle-time) optimization
+ */
+void SDFGraph::printShaderStats(bool _isOptimized) const
+{
+  const auto &shader = m_sdfrMaterial->fragmentShader;
+  const auto &assemblyStats = shader.getAssemblyStats();
+  const auto &compileStats = shader.getCompileStats();
+
+  qDebug(
+    "SDFR shader (%s): assembled %d bytes (%d/%d functions stripped) in %.3f ms, "
+    "compiled in %.3f ms, optimized in %.3f ms, %zu -> %zu instructions (%+lld)",
+    _isOptimized ? "full" : "fast",
+    assemblyStats.byteCount,
+    assemblyStats.strippedFunctionCount,
+    assemblyStats.functionCount,
+    assemblyStats.seconds * 1e3,
+    compileStats.compileSeconds * 1e3,
+    compileStats.optimizeSeconds * 1e3,
+    compileStats.instructionCount,
+    compileStats.optimizedInstructionCount,
+    (long long) compileStats.optimizedInstructionCount - (long long) compileStats.instructionCount
+  );
+}
+
+/**
+ * @note Qt SLOT
+ *
+ * @note the (unbaked) scene IR is polygonized on the thread pool and
+ * replaces the actor mesh, a previous extraction has to finish first
+ */
+void SDFGraph::extractMesh()
+{
+  if(!m_meshWorker.isFinished()) return;
+
+  if(!m_isAutoCompile)
+  {
+    m_worker.waitForFinished();
+
+    setMapNodes();
+  }
+
+  const auto &scene = createScene();
+
+  if(scene.isEmpty()) return;
+
+  m_meshWorker = QtConcurrent::run([this, scene]()
+  {
+    MeshExtractor::Settings settings;
+    MeshExtractor::Stats stats;
+
+    const auto &data = std::make_shared<const Mesh::Data>(
+      MeshExtractor::extract(scene, settings, &stats)
+    );
+
+    qDebug(
+      "Mesh extracted: %llu triangles, %.3f s (%.2f ms per million cells, %d/%d chunks)",
+      (unsigned long long) stats.triangleCount,
+      stats.seconds,
+      stats.secondsPerMillionCells() * 1e3,
+      stats.activeChunkCount,
+      stats.chunkCount
+    );
+
+    if(!data->isValid()) return;
+
+    m_vkWindow->setActorMesh(data);
+  });
+}
+
+/**
+ * @return scene IR of the valid map nodes
+ */
+ir::Scene SDFGraph::createScene() const
+{
+  ir::Scene scene;
+
+  for(const auto &mapNode : m_mapNodes)
+  {
+    const auto &node = mapNode->getNode();
+
+    if(!node || mapNode->getData().isEmpty()) continue;
+
+    // mesh shape still converting
+    if(
+      node->primitive.type == ir::PrimitiveType::Mesh &&
+      !node->primitive.volume
+    ) continue;
+
+    scene.nodes.push_back(*node);
+  }
+
+  return scene;
+}
+
+/**
+ * @brief uploads the volume sampled by the (unbaked) mesh shapes
+ *
+ * @note the SDFR storage buffer holds a single mesh volume, mesh
+ * shapes of any other volume are dropped from the scene
+ * (baked ones are not affected, they are sampled on the CPU)
+ *
+ * @param[in,out] _scene
+ */
+void SDFGraph::setMeshVolume(sdfGraph::ir::Scene &_scene)
+{
+  ir::VolumePtr volume = nullptr;
+
+  const auto &end = std::remove_if(
+    _scene.nodes.begin(),
+    _scene.nodes.end(),
+    [&volume](const ir::Node &_node)
+    {
+      if(_node.primitive.type != ir::PrimitiveType::Mesh) return false;
+
+      if(!volume) volume = _node.primitive.volume;
+
+      if(_node.primitive.volume == volume) return false;
+
+      qWarning("Only a single mesh volume is supported, unbaked mesh shape dropped");
+      return true;
+    }
+  );
+  _scene.nodes.erase(end, _scene.nodes.end());
+
+  if(!volume || volume == m_meshVolume) return;
+
+  m_meshVolume = volume;
+  m_vkWindow->setMeshVolume(MeshSDF::getData(*volume));
+}
+
 /**
  *
  * @return DataModelRegistryPtr instance
@@ -283,6 +615,7 @@ SDFGraph::DataModelRegistryPtr SDFGraph::registerModels()
   registry->registerModel<CubeDataModel>(shapeCatName);
   registry->registerModel<SphereDataModel>(shapeCatName);
   registry->registerModel<TorusDataModel>(shapeCatName);
+  registry->registerModel<MeshDataModel>(shapeCatName);
 
   registry->registerModel<UnionDataModel>(opCatName);
 //  registry->registerModel<SubtractionDataModel>(opCatName); // FIXME
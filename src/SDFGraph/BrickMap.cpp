@@ -0,0 +1,414 @@
+/*****************************************************
+ * Class: BrickMap (General)
+ * Members: General Functions (Public/Private)
+ * Partials: None
+ *****************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <QtCore/qfloat16.h>
+
+#include "_constants.hpp"
+#include "SDFGraph/BrickMap.hpp"
+#include "SDFGraph/Evaluator.hpp"
+
+using namespace sdfRay4d::sdfGraph;
+
+namespace
+{
+  namespace brickMap = sdfRay4d::constants::brickMap;
+
+  constexpr uint32_t emptyInside  = 0xFFFFFFFEu; // see volumes.partial.glsl
+  constexpr uint32_t emptyOutside = 0xFFFFFFFFu;
+
+  constexpr auto brickSamples     = brickMap::brickSize * brickMap::brickSize * brickMap::brickSize;
+
+  /**
+   * @note a cell gets a brick if its center is closer to the surface
+   * than halfDiagonal + cellSize / 2, so every point of an empty cell
+   * is at least cellSize / 2 away from it (the shader's empty step).
+   *
+   * @note dirty regions/grid bounds are padded by the brick threshold plus
+   * a half diagonal, so primitives outside of a cell's padded region can't
+   * change its samples nor whether it has a brick.
+   */
+  const auto halfDiagonal   = 0.5f * std::sqrt(3.0f) * brickMap::cellSize;
+  const auto brickThreshold = halfDiagonal + 0.5f * brickMap::cellSize;
+  const auto padding        = brickThreshold + halfDiagonal;
+
+  /**
+   *
+   * @param[in] _distance
+   * @param[in] _material
+   * @return GLSL packHalf2x16(vec2(_distance, _material))
+   */
+  uint32_t packHalf2x16(float _distance, float _material)
+  {
+    const qfloat16 halves[2] = { qfloat16(_distance), qfloat16(_material) };
+
+    uint16_t bits[2];
+    std::memcpy(bits, halves, sizeof(bits));
+
+    return (uint32_t) bits[0] | ((uint32_t) bits[1] << 16u);
+  }
+}
+
+/**
+ * @brief bakes the static primitives of the scene and replaces
+ * them by the brick map (see ir::Scene)
+ *
+ * @note only static unions ahead of the first subtraction are baked,
+ * as union is commutative/associative and they can be folded right after
+ * the base without changing the scene
+ *
+ * @param[in,out] _scene
+ * @return false if nothing was baked (the scene is left unchanged)
+ */
+bool BrickMap::bake(ir::Scene &_scene)
+{
+  std::vector<ir::Primitive> primitives;
+  std::vector<ir::Node> nodes;
+
+  auto isSubtracted = false;
+
+  for(const auto &node : _scene.nodes)
+  {
+    isSubtracted |= node.operation == ir::OperationType::Subtraction;
+
+    if(
+      !isSubtracted &&
+      node.operation == ir::OperationType::Union &&
+      node.primitive.isStatic &&
+      isBakeable(node.primitive)
+    )
+    {
+      primitives.push_back(node.primitive);
+      continue;
+    }
+
+    nodes.push_back(node);
+  }
+
+  if(primitives.empty())
+  {
+    clear();
+    return false;
+  }
+
+  if(primitives == m_primitives)
+  {
+    _scene.nodes = std::move(nodes);
+    _scene.hasBrickMap = true;
+    return true;
+  }
+
+  Bounds bounds = Evaluator::getBounds(primitives.front(), padding);
+
+  for(const auto &primitive : primitives)
+  {
+    const auto &primitiveBounds = Evaluator::getBounds(primitive, padding);
+
+    for(auto axis = 0; axis < 3; axis++)
+    {
+      bounds.min[axis] = std::min(bounds.min[axis], primitiveBounds.min[axis]);
+      bounds.max[axis] = std::max(bounds.max[axis], primitiveBounds.max[axis]);
+    }
+  }
+
+  const auto previousPrimitives = std::move(m_primitives);
+  m_primitives = primitives;
+
+  auto isBaked = true;
+
+  if(previousPrimitives.empty() || !contains(bounds))
+  {
+    isBaked = resize(bounds) && bakeCells(bounds);
+  }
+  else
+  {
+    const auto count = std::max(previousPrimitives.size(), primitives.size());
+
+    for(auto i = 0u; i < count && isBaked; i++)
+    {
+      if(
+        i < previousPrimitives.size() &&
+        i < primitives.size() &&
+        previousPrimitives[i] == primitives[i]
+      ) continue;
+
+      if(i < previousPrimitives.size())
+      {
+        isBaked &= bakeCells(Evaluator::getBounds(previousPrimitives[i], padding));
+      }
+      if(i < primitives.size())
+      {
+        isBaked &= bakeCells(Evaluator::getBounds(primitives[i], padding));
+      }
+    }
+  }
+
+  if(!isBaked)
+  {
+    qWarning("Brick map exceeds its capacity, static nodes are not baked");
+
+    clear();
+    return false;
+  }
+
+  m_isDirty = true;
+
+  _scene.nodes = std::move(nodes);
+  _scene.hasBrickMap = true;
+
+  return true;
+}
+
+void BrickMap::clear() noexcept
+{
+  m_primitives.clear();
+  m_cells.clear();
+  m_bricks.clear();
+  m_freeBricks.clear();
+
+  m_origin  = {};
+  m_dims    = {};
+  m_isDirty = false;
+}
+
+/**
+ * @brief packs the map for the SDFR storage buffer:
+ * header (origin, cellSize, dims, brick slots), cells, bricks
+ *
+ * @return DataPtr
+ */
+BrickMap::DataPtr BrickMap::getData() noexcept
+{
+  m_isDirty = false;
+
+  const auto &data = std::make_shared<Data>();
+  data->reserve(brickMap::headerSize + m_cells.size() + m_bricks.size());
+
+  const float header[4] = { m_origin[0], m_origin[1], m_origin[2], brickMap::cellSize };
+  uint32_t headerBits[4];
+  std::memcpy(headerBits, header, sizeof(headerBits));
+
+  data->insert(data->end(), headerBits, headerBits + 4);
+  data->push_back((uint32_t) m_dims[0]);
+  data->push_back((uint32_t) m_dims[1]);
+  data->push_back((uint32_t) m_dims[2]);
+  data->push_back((uint32_t) (m_bricks.size() / brickSamples));
+
+  data->insert(data->end(), m_cells.begin(), m_cells.end());
+  data->insert(data->end(), m_bricks.begin(), m_bricks.end());
+
+  return data;
+}
+
+/**
+ * @note the plane is unbounded
+ *
+ * @param[in] _primitive
+ * @return boolean
+ */
+bool BrickMap::isBakeable(const ir::Primitive &_primitive) noexcept
+{
+  return _primitive.type != ir::PrimitiveType::Plane;
+}
+
+/**
+ * @brief (re)creates an empty grid snapped to the cell size
+ *
+ * @param[in] _bounds
+ * @return false if the grid exceeds the max cell count
+ */
+bool BrickMap::resize(const Bounds &_bounds) noexcept
+{
+  const auto &cellSize = brickMap::cellSize;
+
+  size_t cellCount = 1;
+
+  for(auto axis = 0; axis < 3; axis++)
+  {
+    const auto &minCell = std::floor(_bounds.min[axis] / cellSize);
+    const auto &maxCell = std::ceil(_bounds.max[axis] / cellSize);
+
+    m_origin[axis]  = minCell * cellSize;
+    m_dims[axis]    = std::max((int) (maxCell - minCell), 1);
+
+    cellCount *= (size_t) m_dims[axis];
+  }
+
+  if(cellCount > (size_t) brickMap::maxCells) return false;
+
+  m_cells.assign(cellCount, emptyOutside);
+  m_bricks.clear();
+  m_freeBricks.clear();
+
+  return true;
+}
+
+/**
+ *
+ * @param[in] _bounds
+ * @return true if the grid covers the bounds
+ */
+bool BrickMap::contains(const Bounds &_bounds) const noexcept
+{
+  if(m_cells.empty()) return false;
+
+  for(auto axis = 0; axis < 3; axis++)
+  {
+    const auto &max = m_origin[axis] + (float) m_dims[axis] * brickMap::cellSize;
+
+    if(_bounds.min[axis] < m_origin[axis] || _bounds.max[axis] > max) return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief bakes all cells overlapping the bounds
+ *
+ * @param[in] _bounds
+ * @return false if out of brick slots
+ */
+bool BrickMap::bakeCells(const Bounds &_bounds) noexcept
+{
+  Index3 minCell;
+  Index3 maxCell;
+
+  for(auto axis = 0; axis < 3; axis++)
+  {
+    const auto &min = (_bounds.min[axis] - m_origin[axis]) / brickMap::cellSize;
+    const auto &max = (_bounds.max[axis] - m_origin[axis]) / brickMap::cellSize;
+
+    minCell[axis] = std::clamp((int) std::floor(min), 0, m_dims[axis] - 1);
+    maxCell[axis] = std::clamp((int) std::floor(max), 0, m_dims[axis] - 1);
+  }
+
+  for(auto z = minCell[2]; z <= maxCell[2]; z++)
+  {
+    for(auto y = minCell[1]; y <= maxCell[1]; y++)
+    {
+      for(auto x = minCell[0]; x <= maxCell[0]; x++)
+      {
+        if(!bakeCell({ x, y, z })) return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+/**
+ *
+ * @param[in] _cell
+ * @return false if out of brick slots
+ */
+bool BrickMap::bakeCell(const Index3 &_cell) noexcept
+{
+  const auto &cellSize = brickMap::cellSize;
+  const auto &cellIndex = (uint32_t) (
+    _cell[0] + m_dims[0] * (_cell[1] + m_dims[1] * _cell[2])
+  );
+
+  const ir::Vec3 center = {
+    m_origin[0] + ((float) _cell[0] + 0.5f) * cellSize,
+    m_origin[1] + ((float) _cell[1] + 0.5f) * cellSize,
+    m_origin[2] + ((float) _cell[2] + 0.5f) * cellSize
+  };
+
+  const auto &distance = Evaluator::distance(m_primitives, center);
+
+  if(std::abs(distance) >= brickThreshold)
+  {
+    releaseBrick(cellIndex);
+    m_cells[cellIndex] = distance < 0.0f ? emptyInside : emptyOutside;
+
+    return true;
+  }
+
+  auto brick = m_cells[cellIndex];
+
+  if(brick >= emptyInside)
+  {
+    if(!m_freeBricks.empty())
+    {
+      brick = m_freeBricks.back();
+      m_freeBricks.pop_back();
+    }
+    else
+    {
+      brick = (uint32_t) (m_bricks.size() / brickSamples);
+
+      if(brick >= (uint32_t) brickMap::maxBricks) return false;
+
+      m_bricks.resize(m_bricks.size() + brickSamples);
+    }
+
+    m_cells[cellIndex] = brick;
+  }
+
+  bakeBrick(brick, _cell);
+
+  return true;
+}
+
+/**
+ * @note samples span the whole cell (both faces included),
+ * so neighbouring bricks share their boundary samples
+ *
+ * @param[in] _brick
+ * @param[in] _cell
+ */
+void BrickMap::bakeBrick(uint32_t _brick, const Index3 &_cell) noexcept
+{
+  const auto &brickSize = brickMap::brickSize;
+  const auto &spacing = brickMap::cellSize / (float) (brickSize - 1);
+
+  Evaluator::Points points;
+  points.reserve(brickSamples);
+
+  for(auto z = 0; z < brickSize; z++)
+  {
+    for(auto y = 0; y < brickSize; y++)
+    {
+      for(auto x = 0; x < brickSize; x++)
+      {
+        points.push_back({
+          m_origin[0] + (float) _cell[0] * brickMap::cellSize + (float) x * spacing,
+          m_origin[1] + (float) _cell[1] * brickMap::cellSize + (float) y * spacing,
+          m_origin[2] + (float) _cell[2] * brickMap::cellSize + (float) z * spacing
+        });
+      }
+    }
+  }
+
+  std::vector<float> distances;
+  std::vector<float> materials;
+
+  Evaluator::distances(m_primitives, points, distances, &materials);
+
+  auto *samples = m_bricks.data() + (size_t) _brick * brickSamples;
+
+  for(auto i = 0; i < brickSamples; i++)
+  {
+    samples[i] = packHalf2x16(distances[i], materials[i]);
+  }
+}
+
+/**
+ *
+ * @param[in] _cellIndex
+ */
+void BrickMap::releaseBrick(uint32_t _cellIndex) noexcept
+{
+  const auto &brick = m_cells[_cellIndex];
+
+  if(brick >= emptyInside) return;
+
+  m_freeBricks.push_back(brick);
+  m_cells[_cellIndex] = emptyOutside;
+}
@@ -0,0 +1,375 @@
+/*****************************************************
+ * Class: CodeGen (General)
+ * Members: General Functions (Public/Private)
+ * Partials: None
+ *****************************************************/
+
+#include "_constants.hpp"
+#include "SDFGraph/CodeGen.hpp"
+
+using namespace sdfRay4d::sdfGraph;
+
+/**
+ * @brief scene functions (map, mapGrad, mapMarch) replacing
+ * the shader template's default (tape interpreter) ones
+ *
+ * @param[in] _scene
+ * @return GLSL source
+ */
+std::string CodeGen::generate(const ir::Scene &_scene)
+{
+  std::string source;
+
+  source += "#define ";
+  source += constants::shaderMapDefine;
+  source += "\n\n";
+  source += generateMap(_scene);
+  source += "\n";
+  source += generateMapGrad(_scene);
+  source += "\n";
+  source += generateMap(_scene, true);
+
+  if(hasAnalytic(_scene))
+  {
+    source += "\n#define ";
+    source += constants::shaderAnalyticDefine;
+    source += "\n\n";
+    source += generateCastAnalytic(_scene);
+  }
+
+  return source;
+}
+
+/**
+ *
+ * @param[in] _scene
+ * @return GLSL source of vec2 map(vec3 pos) (distance, material)
+ */
+std::string CodeGen::generateMap(const ir::Scene &_scene)
+{
+  return generateMap(_scene, false);
+}
+
+/**
+ *
+ * @note the march's nodes are only evaluated if they're binned to the
+ * ray's screen tile (nextBin, see sdfr_binning.comp). Node i is the
+ * tape's node record i (see Tape), the base is always evaluated.
+ *
+ * @param[in] _scene
+ * @param[in] _isMarchOnly without the analytic terms and the nodes of other
+ * tiles, i.e. vec2 mapMarch(vec3 pos) (see generateCastAnalytic)
+ * @return GLSL source of the map function
+ */
+std::string CodeGen::generateMap(const ir::Scene &_scene, bool _isMarchOnly)
+{
+  const auto &topLevelStart = getTopLevelStart(_scene);
+  const auto &isMarched = [&](const ir::Primitive &_primitive, size_t _index)
+  {
+    return !_isMarchOnly || !isAnalytic(_primitive) || _index < topLevelStart;
+  };
+
+  std::string source = _isMarchOnly
+    ? "vec2 mapMarch( in vec3 pos )\n"
+    : "vec2 map( in vec3 pos )\n";
+
+  source += "{\n";
+  source += isMarched(_scene.base, 0)
+    ? "  vec2 res = vec2( " + toDistance(_scene.base) + ", " + toFloat(_scene.base.material) + " );\n"
+    : "  vec2 res = vec2( 1e10, -1.0 );\n";
+
+  if(_scene.hasBrickMap)
+  {
+    source += "  res = opUnion( res, sdBrickMap( pos ) );\n";
+  }
+
+  for(size_t i = 0; _isMarchOnly && i < _scene.nodes.size(); i++)
+  {
+    if(!isMarched(_scene.nodes[i].primitive, i)) continue;
+
+    source += "  BinCursor bin = getBinCursor();\n";
+    break;
+  }
+
+  for(size_t i = 0; i < _scene.nodes.size(); i++)
+  {
+    const auto &node = _scene.nodes[i];
+
+    if(!isMarched(node.primitive, i)) continue;
+
+    const auto &distance = toDistance(node.primitive);
+    const auto &binned = _isMarchOnly
+      ? "if( nextBin( bin, " + std::to_string(i) + "u ) ) "
+      : std::string();
+
+    switch(node.operation)
+    {
+      case ir::OperationType::Union:
+        source += "  " + binned + "res = opUnion( res, vec2( " + distance + ", " + toFloat(node.primitive.material) + " ) );\n";
+        break;
+      case ir::OperationType::Subtraction:
+        source += "  " + binned + "res.x = opSubtraction( res.x, " + distance + " );\n";
+        break;
+    }
+  }
+
+  source +=
+    "  return res;\n"
+    "}\n";
+
+  return source;
+}
+
+/**
+ * @note forward-mode AD: each statement propagates the dual number
+ * vec4(d, dd/dpos) of the expression, so the gradient costs one
+ * evaluation of the scene instead of 4 (tetrahedral finite differences)
+ *
+ * @param[in] _scene
+ * @return GLSL source of vec4 mapGrad(vec3 pos) (distance, gradient)
+ */
+std::string CodeGen::generateMapGrad(const ir::Scene &_scene)
+{
+  std::string source =
+    "vec4 mapGrad( in vec3 pos )\n"
+    "{\n"
+    "  vec4 res = " + toDual(_scene.base) + ";\n";
+
+  if(_scene.hasBrickMap)
+  {
+    source += "  res = opUnionGrad( res, sdBrickMapGrad( pos ) );\n";
+  }
+
+  for(const auto &node : _scene.nodes)
+  {
+    const auto &dual = toDual(node.primitive);
+
+    switch(node.operation)
+    {
+      case ir::OperationType::Union:
+        source += "  res = opUnionGrad( res, " + dual + " );\n";
+        break;
+      case ir::OperationType::Subtraction:
+        source += "  res = opSubtractionGrad( res, " + dual + " );\n";
+        break;
+    }
+  }
+
+  source +=
+    "  return res;\n"
+    "}\n";
+
+  return source;
+}
+
+/**
+ * @brief nearest hit of the analytic terms, the march (mapMarch) only has
+ * to find a nearer one of the remaining terms (see castRay)
+ *
+ * @note the top-level terms (see getTopLevelStart) are only unioned,
+ * so the scene's surface is the nearest of the terms' surfaces
+ *
+ * @param[in] _scene
+ * @return GLSL source of vec2 castAnalytic(vec3 ro, vec3 rd, float tmin, float tmax)
+ * (hit distance, material), (tmax, -1) if none
+ */
+std::string CodeGen::generateCastAnalytic(const ir::Scene &_scene)
+{
+  const auto &topLevelStart = getTopLevelStart(_scene);
+
+  std::string source =
+    "vec2 castAnalytic( in vec3 ro, in vec3 rd, in float tmin, in float tmax )\n"
+    "{\n"
+    "  vec2 res = vec2( tmax, -1.0 );\n"
+    "  float t;\n";
+
+  const auto &appendIntersection = [&](const ir::Primitive &_primitive)
+  {
+    source += "  t = " + toIntersection(_primitive) + ";\n";
+    source += "  if( t>=0.0 && t<=res.x ) res = vec2( t, " + toFloat(_primitive.material) + " );\n";
+  };
+
+  if(topLevelStart == 0 && isAnalytic(_scene.base)) appendIntersection(_scene.base);
+
+  for(size_t i = topLevelStart; i < _scene.nodes.size(); i++)
+  {
+    if(isAnalytic(_scene.nodes[i].primitive)) appendIntersection(_scene.nodes[i].primitive);
+  }
+
+  source +=
+    "  return res;\n"
+    "}\n";
+
+  return source;
+}
+
+/**
+ * @note no subtraction is applied to the base and the nodes from there on,
+ * i.e. they're top-level terms of the scene's union
+ *
+ * @param[in] _scene
+ * @return index of the node after the last subtraction (0: base included)
+ */
+size_t CodeGen::getTopLevelStart(const ir::Scene &_scene)
+{
+  size_t start = 0;
+
+  for(size_t i = 0; i < _scene.nodes.size(); i++)
+  {
+    if(_scene.nodes[i].operation == ir::OperationType::Subtraction) start = i + 1;
+  }
+
+  return start;
+}
+
+/**
+ *
+ * @param[in] _primitive
+ * @return whether the primitive has a closed-form ray intersection
+ */
+bool CodeGen::isAnalytic(const ir::Primitive &_primitive)
+{
+  switch(_primitive.type)
+  {
+    case ir::PrimitiveType::Plane:
+    case ir::PrimitiveType::Sphere:
+    case ir::PrimitiveType::Box:    return true;
+    default:                        return false;
+  }
+}
+
+/**
+ *
+ * @param[in] _scene
+ * @return whether any top-level term is intersected analytically
+ */
+bool CodeGen::hasAnalytic(const ir::Scene &_scene)
+{
+  const auto &topLevelStart = getTopLevelStart(_scene);
+
+  if(topLevelStart == 0 && isAnalytic(_scene.base)) return true;
+
+  for(size_t i = topLevelStart; i < _scene.nodes.size(); i++)
+  {
+    if(isAnalytic(_scene.nodes[i].primitive)) return true;
+  }
+
+  return false;
+}
+
+/**
+ *
+ * @param[in] _primitive
+ * @return distance function call
+ */
+std::string CodeGen::toDistance(const ir::Primitive &_primitive)
+{
+  switch(_primitive.type)
+  {
+    case ir::PrimitiveType::Sphere: return "sdSphere(" + toArguments(_primitive) + ")";
+    case ir::PrimitiveType::Box:    return "sdBox(" + toArguments(_primitive) + ")";
+    case ir::PrimitiveType::Torus:  return "sdTorus(" + toArguments(_primitive) + ")";
+    case ir::PrimitiveType::Mesh:   return toBounded(_primitive, "sdMeshVolume(" + toArguments(_primitive) + ")");
+    case ir::PrimitiveType::Plane:
+    default:                        return "sdPlane(" + toArguments(_primitive) + ")";
+  }
+}
+
+/**
+ *
+ * @param[in] _primitive
+ * @return dual (distance, gradient) function call
+ */
+std::string CodeGen::toDual(const ir::Primitive &_primitive)
+{
+  switch(_primitive.type)
+  {
+    case ir::PrimitiveType::Sphere: return "sdSphereGrad(" + toArguments(_primitive) + ")";
+    case ir::PrimitiveType::Box:    return "sdBoxGrad(" + toArguments(_primitive) + ")";
+    case ir::PrimitiveType::Torus:  return "sdTorusGrad(" + toArguments(_primitive) + ")";
+    case ir::PrimitiveType::Mesh:   return toBounded(_primitive, "sdMeshVolumeGrad(" + toArguments(_primitive) + ")");
+    case ir::PrimitiveType::Plane:
+    default:                        return "sdPlaneGrad(" + toArguments(_primitive) + ")";
+  }
+}
+
+/**
+ * @note the ray is translated (ro - position) like the
+ * distance functions' position
+ *
+ * @param[in] _primitive analytic (see isAnalytic)
+ * @return ray intersection function call
+ */
+std::string CodeGen::toIntersection(const ir::Primitive &_primitive)
+{
+  const auto &ro = _primitive.position == ir::Vec3 {}
+    ? std::string("ro")
+    : "ro - " + toVec3(_primitive.position);
+
+  switch(_primitive.type)
+  {
+    case ir::PrimitiveType::Sphere: return "iSphere(" + ro + ", rd, tmin, res.x, " + toVec3(_primitive.dimensions) + ")";
+    case ir::PrimitiveType::Box:    return "iBox(" + ro + ", rd, tmin, res.x, " + toVec3(_primitive.dimensions) + ")";
+    case ir::PrimitiveType::Plane:
+    default:                        return "iPlane(" + ro + ", rd, tmin, res.x)";
+  }
+}
+
+/**
+ * @brief scales the primitive's distance (dual) down to a 1-Lipschitz bound,
+ * i.e. map() never overestimates the distance to the surface by more than
+ * the raymarcher's over-relaxation can recover from (see castRay)
+ *
+ * @note only mesh volumes (sampled, see MeshSDF::getLipschitz) may exceed 1,
+ * the analytic primitives are exact and union/subtraction (min/max) keep
+ * the largest bound of their operands, so scaling per term is sufficient
+ *
+ * @param[in] _primitive
+ * @param[in] _call distance/dual function call
+ * @return scaled function call
+ */
+std::string CodeGen::toBounded(const ir::Primitive &_primitive, const std::string &_call)
+{
+  if(!_primitive.volume || _primitive.volume->lipschitz <= 1.0f) return _call;
+
+  return "(" + _call + " * " + toFloat(1.0f / _primitive.volume->lipschitz) + ")";
+}
+
+/**
+ * @note position is translated (pos - position), which has
+ * an identity jacobian and leaves the primitive's gradient as is
+ *
+ * @param[in] _primitive
+ * @return argument list
+ */
+std::string CodeGen::toArguments(const ir::Primitive &_primitive)
+{
+  const auto &pos = _primitive.position == ir::Vec3 {}
+    ? std::string("pos")
+    : "pos - " + toVec3(_primitive.position);
+
+  switch(_primitive.type)
+  {
+    case ir::PrimitiveType::Sphere:
+    case ir::PrimitiveType::Box:    return pos + ", " + toVec3(_primitive.dimensions);
+    case ir::PrimitiveType::Torus:  return pos + ", " + toVec2(_primitive.dimensions);
+    case ir::PrimitiveType::Mesh:   return pos + ", " + toFloat(_primitive.dimensions[0]);
+    case ir::PrimitiveType::Plane:
+    default:                        return pos;
+  }
+}
+
+std::string CodeGen::toFloat(float _value)
+{
+  return std::to_string(_value);
+}
+
+std::string CodeGen::toVec2(const ir::Vec3 &_value)
+{
+  return "vec2(" + toFloat(_value[0]) + ", " + toFloat(_value[1]) + ")";
+}
+
+std::string CodeGen::toVec3(const ir::Vec3 &_value)
+{
+  return "vec3(" + toFloat(_value[0]) + ", " + toFloat(_value[1]) + ", " + toFloat(_value[2]) + ")";
+}
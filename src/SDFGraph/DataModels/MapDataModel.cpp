@@ -9,6 +9,14 @@ QString MapDataModel::getData()
   return m_mapData ? m_mapData->shaderData : "";
 }
 
+/**
+ * @return scene IR node (nullptr if not connected)
+ */
+const sdfRay4d::sdfGraph::ir::Node *MapDataModel::getNode() const
+{
+  return m_mapData ? &m_mapData->node : nullptr;
+}
+
 unsigned int MapDataModel::nPorts(PortType _portType) const
 {
   unsigned int result = 1;
@@ -18,7 +18,10 @@ void SubtractionDataModel::applyOperation()
   {
     m_validationState = NodeValidationState::Valid;
     m_validationError = QString();
-    m_data = std::make_shared<MapData>(data);
+    m_data = std::make_shared<MapData>(
+      data,
+      ir::Node { ir::OperationType::Subtraction, shape2->primitive }
+    );
   }
   else
   {
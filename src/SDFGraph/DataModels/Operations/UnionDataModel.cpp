@@ -18,7 +18,10 @@ void UnionDataModel::applyOperation()
   {
     m_validationState = NodeValidationState::Valid;
     m_validationError = QString();
-    m_data = std::make_shared<MapData>(data);
+    m_data = std::make_shared<MapData>(
+      data,
+      ir::Node { ir::OperationType::Union, shape2->primitive }
+    );
   }
   else
   {
@@ -11,6 +11,7 @@ ShapeDataModel::ShapeDataModel()
 
 , m_scale       (new QSlider(Qt::Horizontal))
 , m_transform   (new QSlider(Qt::Horizontal))
+, m_static      (new QCheckBox("Static (baked)"))
 
 , m_color       (sdfGraph::vec4(0.6, 0.6, 0.6, 1.0)) // origin color
 , m_dimensions  (sdfGraph::vec4(0.25,0.25, 0.25, 1.0)) // origin dimensions
@@ -30,6 +31,7 @@ ShapeDataModel::ShapeDataModel()
   m_layout->addWidget(m_scale);
   m_layout->addWidget(m_transLabel);
   m_layout->addWidget(m_transform);
+  m_layout->addWidget(m_static);
 
   m_widget->setLayout(m_layout);
 
@@ -47,6 +49,25 @@ void ShapeDataModel::createConnections()
     m_transform, &QSlider::valueChanged,
     this, &ShapeDataModel::onTransform
   );
+
+  connect(
+    m_static, &QCheckBox::toggled,
+    this, &ShapeDataModel::onStatic
+  );
+}
+
+/**
+ * @brief the shape's primitive, flagged as static
+ * (baked into the brick map) if checked by the user
+ *
+ * @return ir::Primitive
+ */
+ir::Primitive ShapeDataModel::createPrimitive()
+{
+  auto primitive = getPrimitive();
+  primitive.isStatic = m_static->isChecked();
+
+  return primitive;
 }
 
 unsigned int ShapeDataModel::nPorts(PortType _portType) const
@@ -83,7 +104,7 @@ NodeDataType ShapeDataModel::dataType(
 NodeDataPtr ShapeDataModel::outData(PortIndex _portIndex)
 {
   auto shaderData = getData();
-  m_data = std::make_shared<ShapeData>(shaderData);
+  m_data = std::make_shared<ShapeData>(shaderData, createPrimitive());
 
   m_validationState = NodeValidationState::Valid;
   m_validationError = QString();
@@ -107,7 +128,7 @@ void ShapeDataModel::onScale(float _value)
   //  m_dimensions.w = std::to_string(_value * .025f);
 
   auto shaderData = getData();
-  m_data = std::make_shared<ShapeData>(shaderData);
+  m_data = std::make_shared<ShapeData>(shaderData, createPrimitive());
 
   emit dataUpdated(0);
 }
@@ -122,7 +143,17 @@ void ShapeDataModel::onTransform(float _value)
   //  m_position.w = std::to_string(_value * .025f);
 
   auto shaderData = getData();
-  m_data = std::make_shared<ShapeData>(shaderData);
+  m_data = std::make_shared<ShapeData>(shaderData, createPrimitive());
+
+  emit dataUpdated(0);
+}
+
+void ShapeDataModel::onStatic(bool _isStatic)
+{
+  Q_UNUSED(_isStatic);
+
+  auto shaderData = getData();
+  m_data = std::make_shared<ShapeData>(shaderData, createPrimitive());
 
   emit dataUpdated(0);
 }
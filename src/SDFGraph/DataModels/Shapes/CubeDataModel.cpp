@@ -17,3 +17,13 @@ QString CubeDataModel::getData()
 
   return QString::fromStdString(shaderCode);
 }
+
+ir::Primitive CubeDataModel::getPrimitive()
+{
+  return {
+    ir::PrimitiveType::Box,
+    m_position.xyz(),
+    m_dimensions.xyz(),
+    3.0f
+  };
+}
@@ -0,0 +1,78 @@
+#include <QtConcurrentRun>
+
+#include "SDFGraph/DataModels/Shapes/MeshDataModel.hpp"
+
+using namespace sdfRay4d::sdfGraph;
+
+MeshDataModel::MeshDataModel() : ShapeDataModel()
+{
+  connect(
+    &m_converter, &QFutureWatcher<ir::VolumePtr>::finished,
+    this, &MeshDataModel::onConverted
+  );
+
+  m_converter.setFuture(QtConcurrent::run([]()
+  {
+    const auto &fileName =
+      QString(constants::modelsPath) +
+      QString(constants::modelsPaths::actor);
+
+    MeshSDF::Stats stats;
+    const auto &volume = MeshSDF::load(fileName, MeshSDF::Settings(), &stats);
+
+    qDebug(
+      "Mesh SDF %s: %d triangles, %llu samples, %llu seeds, %d passes in %.3fs%s",
+      qPrintable(fileName),
+      stats.triangleCount,
+      (unsigned long long) stats.sampleCount,
+      (unsigned long long) stats.seedCount,
+      stats.passCount,
+      stats.seconds,
+      stats.isCacheHit ? " (cached)" : ""
+    );
+
+    return volume;
+  }));
+}
+
+QString MeshDataModel::getData()
+{
+  std::string shaderCode =
+    "vec2( sdMeshVolume(pos - vec3(" +
+                m_position.x +
+        ", " +  m_position.y +
+        ", " +  m_position.z +
+      "), " +   m_dimensions.x +
+    " ), 25.0 )";
+
+  return QString::fromStdString(shaderCode);
+}
+
+ir::Primitive MeshDataModel::getPrimitive()
+{
+  return {
+    ir::PrimitiveType::Mesh,
+    m_position.xyz(),
+    m_dimensions.xyz(),
+    25.0f,
+    false,
+    m_volume
+  };
+}
+
+/**
+ * @note GUI thread
+ */
+void MeshDataModel::onConverted()
+{
+  m_volume = m_converter.result();
+
+  if(!m_volume)
+  {
+    m_validationState = NodeValidationState::Error;
+    m_validationError = QString("Failed to convert the mesh");
+    return;
+  }
+
+  emit dataUpdated(0);
+}
@@ -17,3 +17,13 @@ QString SphereDataModel::getData()
 
   return QString::fromStdString(shaderCode);
 }
+
+ir::Primitive SphereDataModel::getPrimitive()
+{
+  return {
+    ir::PrimitiveType::Sphere,
+    m_position.xyz(),
+    m_dimensions.xyz(),
+    46.9f
+  };
+}
@@ -16,3 +16,13 @@ QString TorusDataModel::getData()
 
   return QString::fromStdString(shaderCode);
 }
+
+ir::Primitive TorusDataModel::getPrimitive()
+{
+  return {
+    ir::PrimitiveType::Torus,
+    m_position.xyz(),
+    m_dimensions.xyz(),
+    25.0f
+  };
+}
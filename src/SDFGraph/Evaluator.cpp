@@ -0,0 +1,491 @@
+/*****************************************************
+ * Partial Class: Evaluator (General)
+ * Members: General Functions (Public/Private)
+ *
+ * This Class is split into partials to categorize
+ * and classify the functionality
+ * for the purpose of readability/maintainability
+ *
+ * The partials can be found in the respective
+ * directory named as the class name
+ *
+ * Partials:
+ * - batch_kernels.cpp
+ * - interval_helpers.cpp
+ *****************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <QtConcurrentMap>
+
+#include "_constants.hpp"
+#include "SDFGraph/Evaluator.hpp"
+
+using namespace sdfRay4d::sdfGraph;
+
+/**
+ *
+ * @param[in] _count
+ */
+void Evaluator::Points::reserve(size_t _count)
+{
+  x.reserve(_count);
+  y.reserve(_count);
+  z.reserve(_count);
+}
+
+void Evaluator::Points::clear() noexcept
+{
+  x.clear();
+  y.clear();
+  z.clear();
+}
+
+/**
+ *
+ * @param[in] _pos
+ */
+void Evaluator::Points::push_back(const ir::Vec3 &_pos)
+{
+  x.push_back(_pos[0]);
+  y.push_back(_pos[1]);
+  z.push_back(_pos[2]);
+}
+
+/**
+ * @note no default case, so a primitive type added to the IR
+ * but not to the evaluator is flagged at compile time (-Wswitch)
+ *
+ * @param[in] _primitive
+ * @return false if it's not evaluated as is (e.g. a mesh still converting)
+ */
+bool Evaluator::isSupported(const ir::Primitive &_primitive) noexcept
+{
+  switch(_primitive.type)
+  {
+    case ir::PrimitiveType::Plane:
+    case ir::PrimitiveType::Sphere:
+    case ir::PrimitiveType::Box:
+    case ir::PrimitiveType::Torus:
+      return true;
+    case ir::PrimitiveType::Mesh:
+      return _primitive.volume != nullptr;
+  }
+
+  return false;
+}
+
+/**
+ * @param[in] _scene
+ * @return false if it has a brick map (not sampled) or an unsupported node
+ */
+bool Evaluator::isSupported(const ir::Scene &_scene) noexcept
+{
+  if(_scene.hasBrickMap || !isSupported(_scene.base)) return false;
+
+  for(const auto &node : _scene.nodes)
+  {
+    switch(node.operation)
+    {
+      case ir::OperationType::Union:
+      case ir::OperationType::Subtraction:
+        if(!isSupported(node.primitive)) return false;
+        continue;
+    }
+
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ *
+ * @param[in] _primitive
+ * @param[in] _pos world space position
+ * @return signed distance
+ */
+float Evaluator::distance(
+  const ir::Primitive &_primitive,
+  const ir::Vec3 &_pos
+) noexcept
+{
+  const auto &px = _pos[0] - _primitive.position[0];
+  const auto &py = _pos[1] - _primitive.position[1];
+  const auto &pz = _pos[2] - _primitive.position[2];
+
+  const auto &dims = _primitive.dimensions;
+
+  switch(_primitive.type)
+  {
+    case ir::PrimitiveType::Sphere:
+    {
+      return std::sqrt(px * px + py * py + pz * pz) - dims[0];
+    }
+    case ir::PrimitiveType::Box:
+    {
+      const auto &dx = std::abs(px) - dims[0];
+      const auto &dy = std::abs(py) - dims[1];
+      const auto &dz = std::abs(pz) - dims[2];
+
+      const auto qx = std::max(dx, 0.0f);
+      const auto qy = std::max(dy, 0.0f);
+      const auto qz = std::max(dz, 0.0f);
+
+      return
+        std::min(std::max(dx, std::max(dy, dz)), 0.0f) +
+        std::sqrt(qx * qx + qy * qy + qz * qz);
+    }
+    case ir::PrimitiveType::Torus:
+    {
+      const auto &qx = std::sqrt(px * px + pz * pz) - dims[0];
+
+      return std::sqrt(qx * qx + py * py) - dims[1];
+    }
+    case ir::PrimitiveType::Mesh:
+    {
+      if(!_primitive.volume) return std::numeric_limits<float>::max();
+
+      // uniform scale keeps it a distance: s * d(p / s),
+      // scaled down to a 1-Lipschitz bound (see MeshSDF::getLipschitz, CodeGen::toBounded)
+      const auto scale = std::max(dims[0], 1e-4f);
+      const auto &volume = *_primitive.volume;
+
+      return scale * distance(volume, { px / scale, py / scale, pz / scale }) / volume.lipschitz;
+    }
+    case ir::PrimitiveType::Plane:
+    default:
+    {
+      return py;
+    }
+  }
+}
+
+/**
+ * @brief trilinear sample of the volume (see sdMeshVolume)
+ *
+ * @note outside of the grid, the distance to the grid's box is combined
+ * with the sample at the closest grid point: as the surface is inside,
+ * sqrt(box^2 + sample^2) is a lower bound of the distance to it
+ *
+ * @param[in] _volume
+ * @param[in] _pos volume space position
+ * @return signed distance
+ */
+float Evaluator::distance(
+  const ir::Volume &_volume,
+  const ir::Vec3 &_pos
+) noexcept
+{
+  const auto &dims = _volume.dims;
+
+  if(dims[0] < 2 || dims[1] < 2 || dims[2] < 2) return std::numeric_limits<float>::max();
+
+  auto outside = 0.0f;
+  int index[3];
+  float weight[3];
+
+  for(auto axis = 0; axis < 3; axis++)
+  {
+    const auto &size = (float) (dims[axis] - 1) * _volume.spacing;
+    const auto &pos = _pos[axis] - _volume.origin[axis];
+    const auto clamped = std::clamp(pos, 0.0f, size);
+
+    outside += (pos - clamped) * (pos - clamped);
+
+    const auto &sample = clamped / _volume.spacing;
+
+    index[axis]   = std::min((int) sample, dims[axis] - 2);
+    weight[axis]  = sample - (float) index[axis];
+  }
+
+  const auto &dy = (size_t) dims[0];
+  const auto &dz = (size_t) dims[0] * (size_t) dims[1];
+  const auto *samples = _volume.distances.data() +
+    (size_t) index[0] + dy * (size_t) index[1] + dz * (size_t) index[2];
+
+  const auto &mix = [](float _a, float _b, float _t) { return _a + (_b - _a) * _t; };
+
+  const auto &x00 = mix(samples[0],       samples[1],           weight[0]);
+  const auto &x10 = mix(samples[dy],      samples[dy + 1],      weight[0]);
+  const auto &x01 = mix(samples[dz],      samples[dz + 1],      weight[0]);
+  const auto &x11 = mix(samples[dz + dy], samples[dz + dy + 1], weight[0]);
+
+  const auto &result = mix(mix(x00, x10, weight[1]), mix(x01, x11, weight[1]), weight[2]);
+
+  if(outside > 0.0f)
+  {
+    const auto sampleDistance = std::max(result, 0.0f);
+
+    return std::sqrt(outside + sampleDistance * sampleDistance);
+  }
+
+  return result;
+}
+
+/**
+ * @brief union (opUnion) of the primitives
+ *
+ * @param[in] _primitives
+ * @param[in] _pos world space position
+ * @param[out] _material material of the closest primitive (optional)
+ * @return signed distance (max float if there are no primitives)
+ */
+float Evaluator::distance(
+  const std::vector<ir::Primitive> &_primitives,
+  const ir::Vec3 &_pos,
+  float *_material
+) noexcept
+{
+  auto result = std::numeric_limits<float>::max();
+
+  for(const auto &primitive : _primitives)
+  {
+    const auto &primitiveDistance = distance(primitive, _pos);
+
+    if(!(result < primitiveDistance)) // see opUnion
+    {
+      result = primitiveDistance;
+      if(_material) *_material = primitive.material;
+    }
+  }
+
+  return result;
+}
+
+/**
+ * @brief the scene's map() (see CodeGen::generateMap)
+ *
+ * @param[in] _scene
+ * @param[in] _pos world space position
+ * @param[out] _material (optional)
+ * @return signed distance
+ */
+float Evaluator::distance(
+  const ir::Scene &_scene,
+  const ir::Vec3 &_pos,
+  float *_material
+) noexcept
+{
+  auto result = distance(_scene.base, _pos);
+  auto material = _scene.base.material;
+
+  for(const auto &node : _scene.nodes)
+  {
+    const auto &nodeDistance = distance(node.primitive, _pos);
+
+    switch(node.operation)
+    {
+      case ir::OperationType::Union:
+        if(!(result < nodeDistance)) // see opUnion
+        {
+          result = nodeDistance;
+          material = node.primitive.material;
+        }
+        break;
+      case ir::OperationType::Subtraction:
+        result = std::max(-nodeDistance, result);
+        break;
+    }
+  }
+
+  if(_material) *_material = material;
+
+  return result;
+}
+
+/**
+ * @note planes are unbounded, only their position is returned
+ *
+ * @param[in] _primitive
+ * @param[in] _padding
+ * @return Bounds
+ */
+Evaluator::Bounds Evaluator::getBounds(
+  const ir::Primitive &_primitive,
+  float _padding
+) noexcept
+{
+  const auto &dims = _primitive.dimensions;
+  ir::Vec3 extents = {};
+  ir::Vec3 center = _primitive.position;
+
+  switch(_primitive.type)
+  {
+    case ir::PrimitiveType::Sphere:
+      extents = { std::abs(dims[0]), std::abs(dims[0]), std::abs(dims[0]) };
+      break;
+    case ir::PrimitiveType::Box:
+      extents = { std::abs(dims[0]), std::abs(dims[1]), std::abs(dims[2]) };
+      break;
+    case ir::PrimitiveType::Torus:
+    {
+      const auto &radius = std::abs(dims[0]) + std::abs(dims[1]);
+      extents = { radius, std::abs(dims[1]), radius };
+      break;
+    }
+    case ir::PrimitiveType::Mesh:
+    {
+      if(!_primitive.volume) break;
+
+      const auto &volume = *_primitive.volume;
+      const auto scale = std::max(dims[0], 1e-4f);
+
+      for(auto axis = 0; axis < 3; axis++)
+      {
+        const auto &halfSize = 0.5f * (float) std::max(volume.dims[axis] - 1, 0) * volume.spacing;
+
+        extents[axis] = scale * halfSize;
+        center[axis] += scale * (volume.origin[axis] + halfSize);
+      }
+      break;
+    }
+    case ir::PrimitiveType::Plane:
+    default:
+      break;
+  }
+
+  Bounds bounds;
+
+  for(auto axis = 0; axis < 3; axis++)
+  {
+    bounds.min[axis] = center[axis] - extents[axis] - _padding;
+    bounds.max[axis] = center[axis] + extents[axis] + _padding;
+  }
+
+  return bounds;
+}
+
+/**
+ * @brief batched union (opUnion) of the primitives
+ *
+ * @param[in] _primitives
+ * @param[in] _points
+ * @param[out] _distances resized to the point count
+ * @param[out] _materials resized to the point count (optional)
+ */
+void Evaluator::distances(
+  const std::vector<ir::Primitive> &_primitives,
+  const Points &_points,
+  std::vector<float> &_distances,
+  std::vector<float> *_materials
+)
+{
+  std::vector<ir::Node> nodes;
+  nodes.reserve(_primitives.size());
+
+  for(const auto &primitive : _primitives)
+  {
+    nodes.push_back({ ir::OperationType::Union, primitive });
+  }
+
+  distances(nodes, _points, _distances, _materials);
+}
+
+/**
+ * @brief batched fold of the nodes without the base
+ * (i.e. starting from an empty scene)
+ *
+ * @param[in] _nodes
+ * @param[in] _points
+ * @param[out] _distances resized to the point count
+ * @param[out] _materials resized to the point count (optional)
+ */
+void Evaluator::distances(
+  const std::vector<ir::Node> &_nodes,
+  const Points &_points,
+  std::vector<float> &_distances,
+  std::vector<float> *_materials
+)
+{
+  _distances.resize(_points.size());
+  if(_materials) _materials->resize(_points.size());
+
+  Batch batch;
+  batch.nodes     = _nodes.data();
+  batch.nodeCount = _nodes.size();
+  batch.x         = _points.x.data();
+  batch.y         = _points.y.data();
+  batch.z         = _points.z.data();
+  batch.distances = _distances.data();
+  batch.materials = _materials ? _materials->data() : nullptr;
+  batch.count     = _points.size();
+
+  evaluate(batch);
+}
+
+/**
+ * @brief batched map() of the scene
+ *
+ * @note the scene has to be supported (see isSupported)
+ *
+ * @param[in] _scene
+ * @param[in] _points
+ * @param[out] _distances resized to the point count
+ * @param[out] _materials resized to the point count (optional)
+ */
+void Evaluator::distances(
+  const ir::Scene &_scene,
+  const Points &_points,
+  std::vector<float> &_distances,
+  std::vector<float> *_materials
+)
+{
+  Q_ASSERT_X(isSupported(_scene), "Evaluator::distances", "brick map or unsupported node");
+
+  _distances.resize(_points.size());
+  if(_materials) _materials->resize(_points.size());
+
+  Batch batch;
+  batch.base      = &_scene.base;
+  batch.nodes     = _scene.nodes.data();
+  batch.nodeCount = _scene.nodes.size();
+  batch.x         = _points.x.data();
+  batch.y         = _points.y.data();
+  batch.z         = _points.z.data();
+  batch.distances = _distances.data();
+  batch.materials = _materials ? _materials->data() : nullptr;
+  batch.count     = _points.size();
+
+  evaluate(batch);
+}
+
+/**
+ * @note small batches are evaluated on the caller thread, as
+ * dispatching them to the thread pool costs more than the kernel
+ *
+ * @param[in] _batch
+ */
+void Evaluator::evaluate(const Batch &_batch)
+{
+  namespace evaluator = constants::evaluator;
+
+  if(_batch.count < (size_t) evaluator::parallelThreshold)
+  {
+    evaluateKernel(_batch);
+    return;
+  }
+
+  const auto &chunkSize = (size_t) evaluator::chunkSize;
+
+  std::vector<Batch> chunks;
+  chunks.reserve((_batch.count + chunkSize - 1) / chunkSize);
+
+  for(size_t offset = 0; offset < _batch.count; offset += chunkSize)
+  {
+    auto chunk = _batch;
+
+    chunk.x         += offset;
+    chunk.y         += offset;
+    chunk.z         += offset;
+    chunk.distances += offset;
+    chunk.materials  = _batch.materials ? _batch.materials + offset : nullptr;
+    chunk.count      = std::min(chunkSize, _batch.count - offset);
+
+    chunks.push_back(chunk);
+  }
+
+  QtConcurrent::blockingMap(chunks, [](const Batch &_chunk) { evaluateKernel(_chunk); });
+}
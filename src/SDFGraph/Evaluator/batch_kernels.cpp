@@ -0,0 +1,283 @@
+/*****************************************************
+ * Partial Class: Evaluator
+ * Members: Batch Kernels - SIMD (Private)
+ *****************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SDF_EVALUATOR_SSE2
+#endif
+
+#include "SDFGraph/Evaluator.hpp"
+
+using namespace sdfRay4d::sdfGraph;
+
+namespace
+{
+  /**
+   * @namespace simd
+   * @brief minimal float lane wrappers for the evaluator kernels
+   *
+   * @note the lane width is picked at compile time
+   * (see SIMD_AVX2_ENABLED build env variable)
+   */
+  namespace simd
+  {
+#if defined(__AVX2__)
+    using Float = __m256;
+    constexpr size_t width = 8;
+
+    inline Float set1(float _a)                             { return _mm256_set1_ps(_a); }
+    inline Float load(const float *_p)                      { return _mm256_loadu_ps(_p); }
+    inline void store(float *_p, Float _a)                  { _mm256_storeu_ps(_p, _a); }
+    inline Float add(Float _a, Float _b)                    { return _mm256_add_ps(_a, _b); }
+    inline Float sub(Float _a, Float _b)                    { return _mm256_sub_ps(_a, _b); }
+    inline Float mul(Float _a, Float _b)                    { return _mm256_mul_ps(_a, _b); }
+    inline Float min(Float _a, Float _b)                    { return _mm256_min_ps(_a, _b); }
+    inline Float max(Float _a, Float _b)                    { return _mm256_max_ps(_a, _b); }
+    inline Float sqrt(Float _a)                             { return _mm256_sqrt_ps(_a); }
+    inline Float abs(Float _a)                              { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), _a); }
+    inline Float lessThan(Float _a, Float _b)               { return _mm256_cmp_ps(_a, _b, _CMP_LT_OQ); }
+    inline Float select(Float _mask, Float _a, Float _b)    { return _mm256_blendv_ps(_b, _a, _mask); }
+#elif defined(SDF_EVALUATOR_SSE2)
+    using Float = __m128;
+    constexpr size_t width = 4;
+
+    inline Float set1(float _a)                             { return _mm_set1_ps(_a); }
+    inline Float load(const float *_p)                      { return _mm_loadu_ps(_p); }
+    inline void store(float *_p, Float _a)                  { _mm_storeu_ps(_p, _a); }
+    inline Float add(Float _a, Float _b)                    { return _mm_add_ps(_a, _b); }
+    inline Float sub(Float _a, Float _b)                    { return _mm_sub_ps(_a, _b); }
+    inline Float mul(Float _a, Float _b)                    { return _mm_mul_ps(_a, _b); }
+    inline Float min(Float _a, Float _b)                    { return _mm_min_ps(_a, _b); }
+    inline Float max(Float _a, Float _b)                    { return _mm_max_ps(_a, _b); }
+    inline Float sqrt(Float _a)                             { return _mm_sqrt_ps(_a); }
+    inline Float abs(Float _a)                              { return _mm_andnot_ps(_mm_set1_ps(-0.0f), _a); }
+    inline Float lessThan(Float _a, Float _b)               { return _mm_cmplt_ps(_a, _b); }
+    inline Float select(Float _mask, Float _a, Float _b)
+    {
+      return _mm_or_ps(_mm_and_ps(_mask, _a), _mm_andnot_ps(_mask, _b));
+    }
+#else
+    using Float = float;
+    constexpr size_t width = 1;
+
+    inline Float set1(float _a)                             { return _a; }
+    inline Float load(const float *_p)                      { return *_p; }
+    inline void store(float *_p, Float _a)                  { *_p = _a; }
+    inline Float add(Float _a, Float _b)                    { return _a + _b; }
+    inline Float sub(Float _a, Float _b)                    { return _a - _b; }
+    inline Float mul(Float _a, Float _b)                    { return _a * _b; }
+    inline Float min(Float _a, Float _b)                    { return _a < _b ? _a : _b; }
+    inline Float max(Float _a, Float _b)                    { return _a > _b ? _a : _b; }
+    inline Float sqrt(Float _a)                             { return std::sqrt(_a); }
+    inline Float abs(Float _a)                              { return std::abs(_a); }
+    inline Float lessThan(Float _a, Float _b)               { return _a < _b ? 1.0f : 0.0f; }
+    inline Float select(Float _mask, Float _a, Float _b)    { return _mask != 0.0f ? _a : _b; }
+#endif
+
+    inline Float length(Float _x, Float _y)
+    {
+      return sqrt(add(mul(_x, _x), mul(_y, _y)));
+    }
+
+    inline Float length(Float _x, Float _y, Float _z)
+    {
+      return sqrt(add(add(mul(_x, _x), mul(_y, _y)), mul(_z, _z)));
+    }
+
+    /**
+     * @brief lane counterpart of Evaluator::distance(primitive, pos)
+     *
+     * @param[in] _primitive
+     * @param[in] _x
+     * @param[in] _y
+     * @param[in] _z
+     * @return signed distances
+     */
+    inline Float distance(
+      const ir::Primitive &_primitive,
+      Float _x,
+      Float _y,
+      Float _z
+    )
+    {
+      const auto &px = sub(_x, set1(_primitive.position[0]));
+      const auto &py = sub(_y, set1(_primitive.position[1]));
+      const auto &pz = sub(_z, set1(_primitive.position[2]));
+
+      const auto &dims = _primitive.dimensions;
+
+      switch(_primitive.type)
+      {
+        case ir::PrimitiveType::Sphere:
+        {
+          return sub(length(px, py, pz), set1(dims[0]));
+        }
+        case ir::PrimitiveType::Box:
+        {
+          const auto &zero = set1(0.0f);
+
+          const auto &dx = sub(abs(px), set1(dims[0]));
+          const auto &dy = sub(abs(py), set1(dims[1]));
+          const auto &dz = sub(abs(pz), set1(dims[2]));
+
+          return add(
+            min(max(dx, max(dy, dz)), zero),
+            length(max(dx, zero), max(dy, zero), max(dz, zero))
+          );
+        }
+        case ir::PrimitiveType::Torus:
+        {
+          const auto &qx = sub(length(px, pz), set1(dims[0]));
+
+          return sub(length(qx, py), set1(dims[1]));
+        }
+        case ir::PrimitiveType::Mesh:
+        {
+          // trilinear volume lookups are gathers, sampled lane by lane
+          float x[width];
+          float y[width];
+          float z[width];
+          float distances[width];
+
+          store(x, _x);
+          store(y, _y);
+          store(z, _z);
+
+          for(size_t lane = 0; lane < width; lane++)
+          {
+            distances[lane] = Evaluator::distance(_primitive, { x[lane], y[lane], z[lane] });
+          }
+
+          return load(distances);
+        }
+        case ir::PrimitiveType::Plane:
+        default:
+        {
+          return py;
+        }
+      }
+    }
+
+    /**
+     * @brief lane counterpart of Evaluator::distance(scene, pos)
+     *
+     * @param[in] _base nullptr: union of the nodes only
+     * @param[in] _nodes
+     * @param[in] _nodeCount
+     * @param[in] _x
+     * @param[in] _y
+     * @param[in] _z
+     * @param[out] _distance
+     * @param[out] _material
+     */
+    inline void map(
+      const ir::Primitive *_base,
+      const ir::Node *_nodes,
+      size_t _nodeCount,
+      Float _x,
+      Float _y,
+      Float _z,
+      Float &_distance,
+      Float &_material
+    )
+    {
+      _distance = _base ? distance(*_base, _x, _y, _z) : set1(std::numeric_limits<float>::max());
+      _material = set1(_base ? _base->material : 0.0f);
+
+      for(size_t n = 0; n < _nodeCount; n++)
+      {
+        const auto &node = _nodes[n];
+        const auto &nodeDistance = distance(node.primitive, _x, _y, _z);
+
+        switch(node.operation)
+        {
+          case ir::OperationType::Union:
+          {
+            // opUnion keeps the current result only if strictly closer
+            const auto &mask = lessThan(_distance, nodeDistance);
+
+            _distance = select(mask, _distance, nodeDistance);
+            _material = select(mask, _material, set1(node.primitive.material));
+            break;
+          }
+          case ir::OperationType::Subtraction:
+          {
+            _distance = max(sub(set1(0.0f), nodeDistance), _distance);
+            break;
+          }
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief evaluates the batch simd::width points at a time
+ *
+ * @note the tail is padded (with its last point) to a full lane width
+ *
+ * @param[in] _batch
+ */
+void Evaluator::evaluateKernel(const Batch &_batch) noexcept
+{
+  simd::Float distance;
+  simd::Float material;
+
+  for(size_t i = 0; i < _batch.count; i += simd::width)
+  {
+    const auto laneCount = std::min(simd::width, _batch.count - i);
+
+    if(laneCount == simd::width)
+    {
+      simd::map(
+        _batch.base, _batch.nodes, _batch.nodeCount,
+        simd::load(_batch.x + i),
+        simd::load(_batch.y + i),
+        simd::load(_batch.z + i),
+        distance, material
+      );
+
+      simd::store(_batch.distances + i, distance);
+      if(_batch.materials) simd::store(_batch.materials + i, material);
+
+      continue;
+    }
+
+    float x[simd::width];
+    float y[simd::width];
+    float z[simd::width];
+
+    for(size_t lane = 0; lane < simd::width; lane++)
+    {
+      const auto &index = i + std::min(lane, laneCount - 1);
+
+      x[lane] = _batch.x[index];
+      y[lane] = _batch.y[index];
+      z[lane] = _batch.z[index];
+    }
+
+    simd::map(
+      _batch.base, _batch.nodes, _batch.nodeCount,
+      simd::load(x), simd::load(y), simd::load(z),
+      distance, material
+    );
+
+    float distances[simd::width];
+    float materials[simd::width];
+
+    simd::store(distances, distance);
+    simd::store(materials, material);
+
+    std::copy(distances, distances + laneCount, _batch.distances + i);
+    if(_batch.materials) std::copy(materials, materials + laneCount, _batch.materials + i);
+  }
+}
+
@@ -0,0 +1,223 @@
+/*****************************************************
+ * Partial Class: Evaluator
+ * Members: Interval Arithmetic Helpers (Public)
+ *****************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "SDFGraph/Evaluator.hpp"
+
+using namespace sdfRay4d::sdfGraph;
+
+namespace
+{
+  using Interval = Evaluator::Interval;
+
+  /**
+   * @namespace interval
+   * @brief the operations of the distance functions on intervals,
+   * i.e. the range of the result for any values within the operands'
+   */
+  namespace interval
+  {
+    Interval sub(const Interval &_a, float _b) noexcept
+    {
+      return { _a.min - _b, _a.max - _b };
+    }
+
+    Interval add(const Interval &_a, const Interval &_b) noexcept
+    {
+      return { _a.min + _b.min, _a.max + _b.max };
+    }
+
+    Interval abs(const Interval &_a) noexcept
+    {
+      if(_a.min >= 0.0f) return _a;
+      if(_a.max <= 0.0f) return { -_a.max, -_a.min };
+
+      return { 0.0f, std::max(-_a.min, _a.max) };
+    }
+
+    Interval sq(const Interval &_a) noexcept
+    {
+      const auto &a = abs(_a);
+
+      return { a.min * a.min, a.max * a.max };
+    }
+
+    Interval max(const Interval &_a, const Interval &_b) noexcept
+    {
+      return { std::max(_a.min, _b.min), std::max(_a.max, _b.max) };
+    }
+
+    Interval min(const Interval &_a, const Interval &_b) noexcept
+    {
+      return { std::min(_a.min, _b.min), std::min(_a.max, _b.max) };
+    }
+
+    Interval length(const Interval &_x, const Interval &_y) noexcept
+    {
+      const auto &l2 = add(sq(_x), sq(_y));
+
+      return { std::sqrt(l2.min), std::sqrt(l2.max) };
+    }
+
+    Interval length(const Interval &_x, const Interval &_y, const Interval &_z) noexcept
+    {
+      const auto &l2 = add(add(sq(_x), sq(_y)), sq(_z));
+
+      return { std::sqrt(l2.min), std::sqrt(l2.max) };
+    }
+  }
+}
+
+/**
+ * PUBLIC
+ *
+ * @brief range of the primitive's distance within the bounds
+ *
+ * @note conservative, the operands of the distance function are treated
+ * as independent. Mesh volumes are bound by their (1-Lipschitz scaled)
+ * distance at the center of the bounds, see MeshSDF::getLipschitz
+ *
+ * @param[in] _primitive
+ * @param[in] _bounds world space
+ * @return Interval
+ */
+Evaluator::Interval Evaluator::getRange(
+  const ir::Primitive &_primitive,
+  const Bounds &_bounds
+) noexcept
+{
+  const Interval px = { _bounds.min[0] - _primitive.position[0], _bounds.max[0] - _primitive.position[0] };
+  const Interval py = { _bounds.min[1] - _primitive.position[1], _bounds.max[1] - _primitive.position[1] };
+  const Interval pz = { _bounds.min[2] - _primitive.position[2], _bounds.max[2] - _primitive.position[2] };
+
+  const auto &dims = _primitive.dimensions;
+
+  switch(_primitive.type)
+  {
+    case ir::PrimitiveType::Sphere:
+    {
+      return interval::sub(interval::length(px, py, pz), dims[0]);
+    }
+    case ir::PrimitiveType::Box:
+    {
+      const auto &dx = interval::sub(interval::abs(px), dims[0]);
+      const auto &dy = interval::sub(interval::abs(py), dims[1]);
+      const auto &dz = interval::sub(interval::abs(pz), dims[2]);
+
+      const Interval zero = { 0.0f, 0.0f };
+
+      return interval::add(
+        interval::min(interval::max(dx, interval::max(dy, dz)), zero),
+        interval::length(interval::max(dx, zero), interval::max(dy, zero), interval::max(dz, zero))
+      );
+    }
+    case ir::PrimitiveType::Torus:
+    {
+      const auto &qx = interval::sub(interval::length(px, pz), dims[0]);
+
+      return interval::sub(interval::length(qx, py), dims[1]);
+    }
+    case ir::PrimitiveType::Mesh:
+    {
+      if(!_primitive.volume)
+      {
+        return { std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+      }
+
+      ir::Vec3 center;
+      auto radius = 0.0f;
+
+      for(auto axis = 0; axis < 3; axis++)
+      {
+        const auto &halfSize = 0.5f * (_bounds.max[axis] - _bounds.min[axis]);
+
+        center[axis] = _bounds.min[axis] + halfSize;
+        radius += halfSize * halfSize;
+      }
+
+      radius = std::sqrt(radius);
+
+      const auto &centerDistance = distance(_primitive, center);
+
+      return { centerDistance - radius, centerDistance + radius };
+    }
+    case ir::PrimitiveType::Plane:
+    default:
+    {
+      return py;
+    }
+  }
+}
+
+/**
+ * PUBLIC
+ *
+ * @brief specializes the scene's expression to the bounds (e.g. the
+ * frustum segment of a screen tile), by pruning the nodes that cannot
+ * be the result of their operation anywhere within the bounds
+ *
+ * @note the result equals the scene's within the bounds. A union node that
+ * is always nearer than the nodes before becomes the base of the expression
+ * (the brick map, if any, is dropped along with them).
+ *
+ * @note used by the CPU raymarcher only, whose tiles know their ray segments.
+ * The GPU passes have no per-tile depth bounds, they prune per tile by
+ * binning the nodes that can be hit instead (see sdfr_binning.comp)
+ *
+ * @param[in] _scene
+ * @param[in] _bounds world space
+ * @return specialized scene
+ */
+ir::Scene Evaluator::specialize(
+  const ir::Scene &_scene,
+  const Bounds &_bounds
+)
+{
+  ir::Scene scene;
+  scene.base        = _scene.base;
+  scene.hasBrickMap = _scene.hasBrickMap;
+  scene.nodes.reserve(_scene.nodes.size());
+
+  auto range = getRange(_scene.base, _bounds);
+
+  // the brick map isn't sampled, so its (unioned) range is unknown
+  if(_scene.hasBrickMap) range.min = -std::numeric_limits<float>::max();
+
+  for(const auto &node : _scene.nodes)
+  {
+    const auto &nodeRange = getRange(node.primitive, _bounds);
+
+    switch(node.operation)
+    {
+      case ir::OperationType::Union:
+        if(range.max < nodeRange.min) continue;
+
+        if(nodeRange.max < range.min)
+        {
+          scene.base        = node.primitive;
+          scene.hasBrickMap = false;
+          scene.nodes.clear();
+
+          range = nodeRange;
+          continue;
+        }
+
+        range = interval::min(range, nodeRange);
+        break;
+      case ir::OperationType::Subtraction:
+        if(range.min >= -nodeRange.min) continue;
+
+        range = interval::max(range, { -nodeRange.max, -nodeRange.min });
+        break;
+    }
+
+    scene.nodes.push_back(node);
+  }
+
+  return scene;
+}
@@ -0,0 +1,222 @@
+/*****************************************************
+ * Partial Class: MeshExtractor (General)
+ * Members: General Functions (Public/Private)
+ *
+ * This Class is split into partials to categorize
+ * and classify the functionality
+ * for the purpose of readability/maintainability
+ *
+ * The partials can be found in the respective
+ * directory named as the class name
+ *
+ * Partials:
+ * - chunk_helpers.cpp
+ *****************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <QtConcurrentMap>
+
+#include "SDFGraph/MeshExtractor.hpp"
+
+using namespace sdfRay4d::sdfGraph;
+
+double MeshExtractor::Stats::secondsPerMillionCells() const noexcept
+{
+  if(cellCount == 0) return 0.0;
+
+  return seconds * 1e6 / (double) cellCount;
+}
+
+/**
+ * @note chunks are sampled (and their vertices created) in a first parallel
+ * pass, as the quads of a chunk's crossed edges connect vertices of the
+ * neighbouring chunks' cells. The second pass emits the quads per chunk,
+ * which are concatenated in chunk order (deterministic output).
+ *
+ * @note the brick map is not sampled, extract the scene before it's baked
+ *
+ * @param[in] _scene
+ * @param[in] _settings
+ * @param[out] _stats (optional)
+ * @return triangle list in the Mesh::Data vertex layout (empty if nothing to extract)
+ */
+MeshExtractor::Data MeshExtractor::extract(
+  const ir::Scene &_scene,
+  const Settings &_settings,
+  Stats *_stats
+)
+{
+  const auto &startTime = std::chrono::steady_clock::now();
+
+  Data data;
+  Stats stats;
+
+  auto isEmpty = true;
+  const auto &grid = createGrid(_scene, _settings, isEmpty);
+
+  if(isEmpty)
+  {
+    if(_stats) *_stats = stats;
+    return data;
+  }
+
+  const auto &chunkSize = constants::meshExtractor::chunkSize;
+  const auto &nodes = _scene.nodes;
+
+  std::vector<Chunk> chunks(
+    (size_t) grid.chunks[0] * (size_t) grid.chunks[1] * (size_t) grid.chunks[2]
+  );
+
+  auto chunkIt = chunks.begin();
+
+  for(auto z = 0; z < grid.chunks[2]; z++)
+  {
+    for(auto y = 0; y < grid.chunks[1]; y++)
+    {
+      for(auto x = 0; x < grid.chunks[0]; x++)
+      {
+        (chunkIt++)->cell = { x * chunkSize, y * chunkSize, z * chunkSize };
+      }
+    }
+  }
+
+  QtConcurrent::blockingMap(chunks, [&](Chunk &_chunk)
+  {
+    sampleChunk(nodes, grid, _chunk);
+
+    if(_chunk.isActive) createVertices(nodes, grid, _chunk);
+  });
+
+  // neighbouring chunks are only read (cells/vertices) from here on
+  QtConcurrent::blockingMap(chunks, [&](Chunk &_chunk)
+  {
+    if(_chunk.isActive) createQuads(grid, chunks, _chunk);
+  });
+
+  auto byteCount = 0;
+
+  for(const auto &chunk : chunks)
+  {
+    byteCount += chunk.geom.size();
+
+    stats.sampleCount += chunk.sampleCount;
+    stats.activeChunkCount += chunk.isActive ? 1 : 0;
+  }
+
+  data.geom.reserve(byteCount);
+
+  for(const auto &chunk : chunks)
+  {
+    data.geom.append(chunk.geom);
+  }
+
+  const auto &vertexSize = (int) constants::mesh::vertexSize;
+  data.vertexCount = data.geom.size() / vertexSize;
+
+  // min/max pairs per axis (see .buf files)
+  for(auto axis = 0; axis < 3; axis++)
+  {
+    data.aabb[axis * 2]     = data.vertexCount > 0 ? std::numeric_limits<float>::max() : 0.0f;
+    data.aabb[axis * 2 + 1] = data.vertexCount > 0 ? std::numeric_limits<float>::lowest() : 0.0f;
+  }
+
+  for(auto i = 0; i < data.vertexCount; i++)
+  {
+    float position[3];
+    std::memcpy(position, data.geom.constData() + i * vertexSize, sizeof(position));
+
+    for(auto axis = 0; axis < 3; axis++)
+    {
+      data.aabb[axis * 2]     = std::min(data.aabb[axis * 2], position[axis]);
+      data.aabb[axis * 2 + 1] = std::max(data.aabb[axis * 2 + 1], position[axis]);
+    }
+  }
+
+  if(_stats)
+  {
+    const std::chrono::duration<double> &duration = std::chrono::steady_clock::now() - startTime;
+
+    stats.seconds       = duration.count();
+    stats.cellCount     = (uint64_t) grid.dims[0] * (uint64_t) grid.dims[1] * (uint64_t) grid.dims[2];
+    stats.triangleCount = (uint64_t) data.vertexCount / 3;
+    stats.chunkCount    = (int) chunks.size();
+
+    *_stats = stats;
+  }
+
+  return data;
+}
+
+/**
+ * @brief covers the bounds of the scene's unions (subtractions only
+ * remove from them) with cubic cells, padded by two cells
+ *
+ * @param[in] _scene
+ * @param[in] _settings
+ * @param[out] _isEmpty nothing bounded to extract
+ * @return Grid
+ */
+MeshExtractor::Grid MeshExtractor::createGrid(
+  const ir::Scene &_scene,
+  const Settings &_settings,
+  bool &_isEmpty
+) noexcept
+{
+  const auto &chunkSize = constants::meshExtractor::chunkSize;
+
+  Grid grid;
+  Evaluator::Bounds bounds;
+
+  _isEmpty = true;
+
+  for(const auto &node : _scene.nodes)
+  {
+    if(
+      node.operation != ir::OperationType::Union ||
+      node.primitive.type == ir::PrimitiveType::Plane
+    ) continue;
+
+    const auto &primitiveBounds = Evaluator::getBounds(node.primitive, _settings.padding);
+
+    for(auto axis = 0; axis < 3; axis++)
+    {
+      bounds.min[axis] = _isEmpty
+        ? primitiveBounds.min[axis]
+        : std::min(bounds.min[axis], primitiveBounds.min[axis]);
+      bounds.max[axis] = _isEmpty
+        ? primitiveBounds.max[axis]
+        : std::max(bounds.max[axis], primitiveBounds.max[axis]);
+    }
+
+    _isEmpty = false;
+  }
+
+  if(_isEmpty) return grid;
+
+  auto extent = 0.0f;
+
+  for(auto axis = 0; axis < 3; axis++)
+  {
+    extent = std::max(extent, bounds.max[axis] - bounds.min[axis]);
+  }
+
+  grid.cellSize = std::max(extent, 1e-3f) / (float) std::max(_settings.resolution, 1);
+
+  const auto &padding = 2.0f * grid.cellSize;
+
+  for(auto axis = 0; axis < 3; axis++)
+  {
+    const auto &size = bounds.max[axis] - bounds.min[axis] + 2.0f * padding;
+
+    grid.origin[axis] = bounds.min[axis] - padding;
+    grid.dims[axis]   = std::max((int) std::ceil(size / grid.cellSize), 1);
+    grid.chunks[axis] = (grid.dims[axis] + chunkSize - 1) / chunkSize;
+  }
+
+  return grid;
+}
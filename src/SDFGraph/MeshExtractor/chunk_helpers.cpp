@@ -0,0 +1,569 @@
+/*****************************************************
+ * Partial Class: MeshExtractor
+ * Members: Chunk Helpers (Private)
+ *
+ * Octree sampling, surface vertices (cells)
+ * and quads (crossed edges) of a chunk
+ *****************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "SDFGraph/MeshExtractor.hpp"
+
+using namespace sdfRay4d::sdfGraph;
+
+namespace
+{
+  namespace meshExtractor = sdfRay4d::constants::meshExtractor;
+
+  constexpr auto cornerSide = meshExtractor::chunkSize + 1;
+
+  /**
+   * @note tetrahedral offsets of the gradient (see calcNormal in sdfr_pass.frag)
+   */
+  constexpr float tetrahedron[4][3] = {
+    {  1.0f, -1.0f, -1.0f },
+    { -1.0f, -1.0f,  1.0f },
+    { -1.0f,  1.0f, -1.0f },
+    {  1.0f,  1.0f,  1.0f }
+  };
+
+  inline int cornerIndex(int _x, int _y, int _z) noexcept
+  {
+    return _x + cornerSide * (_y + cornerSide * _z);
+  }
+
+  inline int cellIndex(int _x, int _y, int _z) noexcept
+  {
+    const auto &chunkSize = meshExtractor::chunkSize;
+
+    return _x + chunkSize * (_y + chunkSize * _z);
+  }
+
+  /**
+   *
+   * @param[in,out] _points
+   * @param[in] _pos
+   * @param[in] _epsilon offset along the tetrahedron vertices
+   */
+  inline void pushTetrahedron(
+    sdfRay4d::sdfGraph::Evaluator::Points &_points,
+    const sdfRay4d::sdfGraph::ir::Vec3 &_pos,
+    float _epsilon
+  )
+  {
+    for(const auto &offset : tetrahedron)
+    {
+      _points.push_back({
+        _pos[0] + offset[0] * _epsilon,
+        _pos[1] + offset[1] * _epsilon,
+        _pos[2] + offset[2] * _epsilon
+      });
+    }
+  }
+
+  /**
+   *
+   * @param[in] _distances 4 samples (see pushTetrahedron)
+   * @return unnormalized gradient * 4 * epsilon
+   */
+  inline sdfRay4d::sdfGraph::ir::Vec3 tetrahedronGradient(const float *_distances)
+  {
+    sdfRay4d::sdfGraph::ir::Vec3 gradient = {};
+
+    for(auto i = 0; i < 4; i++)
+    {
+      for(auto axis = 0; axis < 3; axis++)
+      {
+        gradient[axis] += tetrahedron[i][axis] * _distances[i];
+      }
+    }
+
+    return gradient;
+  }
+}
+
+/**
+ * @brief refines the chunk's octree towards the surface and samples the
+ * corners of the leaf blocks close to it (one batched query per level)
+ *
+ * @note a block whose center is further away from the surface than its
+ * half diagonal can't be crossed by it (distances are exact or lower
+ * bounds), so all of its corners have the sign of its center distance
+ * and the whole block is skipped
+ *
+ * @param[in] _nodes
+ * @param[in] _grid
+ * @param[in,out] _chunk
+ */
+void MeshExtractor::sampleChunk(
+  const std::vector<ir::Node> &_nodes,
+  const Grid &_grid,
+  Chunk &_chunk
+)
+{
+  /**
+   * @struct Block
+   * @brief octree node, first cell (chunk) and size in cells
+   */
+  struct Block
+  {
+    Index3 cell = {};
+    int size    = 0;
+  };
+
+  const auto &cellSize = _grid.cellSize;
+  const auto &margin = 0.5f * cellSize; // rounding/inexact distances
+
+  std::vector<Block> blocks = { { {}, meshExtractor::chunkSize } };
+  std::vector<Block> children;
+  std::vector<Block> leaves;
+  std::vector<std::pair<Block, float>> farBlocks;
+
+  Evaluator::Points points;
+  std::vector<float> distances;
+
+  while(!blocks.empty())
+  {
+    points.clear();
+
+    for(const auto &block : blocks)
+    {
+      const auto &halfSize = 0.5f * (float) block.size;
+
+      points.push_back({
+        _grid.origin[0] + ((float) (_chunk.cell[0] + block.cell[0]) + halfSize) * cellSize,
+        _grid.origin[1] + ((float) (_chunk.cell[1] + block.cell[1]) + halfSize) * cellSize,
+        _grid.origin[2] + ((float) (_chunk.cell[2] + block.cell[2]) + halfSize) * cellSize
+      });
+    }
+
+    Evaluator::distances(_nodes, points, distances);
+    _chunk.sampleCount += points.size();
+
+    children.clear();
+
+    for(auto i = 0u; i < blocks.size(); i++)
+    {
+      const auto &block = blocks[i];
+      const auto &halfDiagonal = 0.5f * std::sqrt(3.0f) * (float) block.size * cellSize;
+
+      if(std::abs(distances[i]) > halfDiagonal + margin)
+      {
+        farBlocks.emplace_back(block, distances[i]);
+        continue;
+      }
+
+      if(block.size <= meshExtractor::leafSize)
+      {
+        leaves.push_back(block);
+        continue;
+      }
+
+      const auto &childSize = block.size / 2;
+
+      for(auto child = 0; child < 8; child++)
+      {
+        Block childBlock = { block.cell, childSize };
+        auto isInside = true;
+
+        for(auto axis = 0; axis < 3; axis++)
+        {
+          childBlock.cell[axis] += ((child >> axis) & 1) * childSize;
+          isInside &= _chunk.cell[axis] + childBlock.cell[axis] < _grid.dims[axis];
+        }
+
+        if(isInside) children.push_back(childBlock);
+      }
+    }
+
+    blocks.swap(children);
+  }
+
+  if(leaves.empty()) return;
+
+  _chunk.isActive = true;
+  _chunk.corners.assign(
+    (size_t) cornerSide * cornerSide * cornerSide,
+    std::numeric_limits<float>::max()
+  );
+
+  for(const auto &farBlock : farBlocks)
+  {
+    const auto &block = farBlock.first;
+
+    for(auto z = block.cell[2]; z <= block.cell[2] + block.size; z++)
+    {
+      for(auto y = block.cell[1]; y <= block.cell[1] + block.size; y++)
+      {
+        for(auto x = block.cell[0]; x <= block.cell[0] + block.size; x++)
+        {
+          _chunk.corners[cornerIndex(x, y, z)] = farBlock.second;
+        }
+      }
+    }
+  }
+
+  // exact corners of the leaves (shared corners are sampled once)
+  std::vector<uint8_t> isSampled(_chunk.corners.size(), 0);
+  std::vector<int> sampledCorners;
+
+  points.clear();
+
+  for(const auto &block : leaves)
+  {
+    for(auto z = block.cell[2]; z <= block.cell[2] + block.size; z++)
+    {
+      for(auto y = block.cell[1]; y <= block.cell[1] + block.size; y++)
+      {
+        for(auto x = block.cell[0]; x <= block.cell[0] + block.size; x++)
+        {
+          const auto &index = cornerIndex(x, y, z);
+
+          if(isSampled[index]) continue;
+          isSampled[index] = 1;
+
+          sampledCorners.push_back(index);
+          points.push_back({
+            _grid.origin[0] + (float) (_chunk.cell[0] + x) * cellSize,
+            _grid.origin[1] + (float) (_chunk.cell[1] + y) * cellSize,
+            _grid.origin[2] + (float) (_chunk.cell[2] + z) * cellSize
+          });
+        }
+      }
+    }
+  }
+
+  Evaluator::distances(_nodes, points, distances);
+  _chunk.sampleCount += points.size();
+
+  for(auto i = 0u; i < sampledCorners.size(); i++)
+  {
+    _chunk.corners[sampledCorners[i]] = distances[i];
+  }
+}
+
+/**
+ * @brief one vertex per cell crossed by the surface, at the mass point of
+ * its edge crossings, projected onto the surface (one Newton step, kept
+ * within the cell) with its normal
+ *
+ * @note only cells of leaf blocks can be crossed, far blocks' corners
+ * all have the same sign
+ *
+ * @param[in] _nodes
+ * @param[in] _grid
+ * @param[in,out] _chunk
+ */
+void MeshExtractor::createVertices(
+  const std::vector<ir::Node> &_nodes,
+  const Grid &_grid,
+  Chunk &_chunk
+)
+{
+  const auto &chunkSize = meshExtractor::chunkSize;
+  const auto &cellSize = _grid.cellSize;
+
+  _chunk.cellVertices.assign((size_t) chunkSize * chunkSize * chunkSize, -1);
+
+  std::vector<Index3> vertexCells;
+
+  Index3 maxCell;
+
+  for(auto axis = 0; axis < 3; axis++)
+  {
+    maxCell[axis] = std::min(chunkSize, _grid.dims[axis] - _chunk.cell[axis]);
+  }
+
+  for(auto z = 0; z < maxCell[2]; z++)
+  {
+    for(auto y = 0; y < maxCell[1]; y++)
+    {
+      for(auto x = 0; x < maxCell[0]; x++)
+      {
+        float corners[8];
+        auto insideMask = 0;
+
+        for(auto corner = 0; corner < 8; corner++)
+        {
+          corners[corner] = _chunk.corners[cornerIndex(
+            x + (corner & 1),
+            y + ((corner >> 1) & 1),
+            z + ((corner >> 2) & 1)
+          )];
+
+          if(corners[corner] < 0.0f) insideMask |= 1 << corner;
+        }
+
+        if(insideMask == 0 || insideMask == 0xFF) continue;
+
+        // mass point of the crossings of the 12 edges (corner pairs differing in one axis)
+        ir::Vec3 massPoint = {};
+        auto crossingCount = 0;
+
+        for(auto corner = 0; corner < 8; corner++)
+        {
+          for(auto axis = 0; axis < 3; axis++)
+          {
+            const auto &bit = 1 << axis;
+            if(corner & bit) continue;
+
+            const auto &other = corner | bit;
+            if(((insideMask >> corner) & 1) == ((insideMask >> other) & 1)) continue;
+
+            const auto &t = corners[corner] / (corners[corner] - corners[other]);
+
+            for(auto i = 0; i < 3; i++)
+            {
+              massPoint[i] += i == axis ? t : (float) ((corner >> i) & 1);
+            }
+            crossingCount++;
+          }
+        }
+
+        const Index3 cell = { _chunk.cell[0] + x, _chunk.cell[1] + y, _chunk.cell[2] + z };
+        ir::Vec3 position;
+
+        for(auto axis = 0; axis < 3; axis++)
+        {
+          position[axis] =
+            _grid.origin[axis] +
+            ((float) cell[axis] + massPoint[axis] / (float) crossingCount) * cellSize;
+        }
+
+        _chunk.cellVertices[cellIndex(x, y, z)] = (int32_t) _chunk.vertices.size();
+        _chunk.vertices.push_back(position);
+        vertexCells.push_back(cell);
+      }
+    }
+  }
+
+  if(_chunk.vertices.empty()) return;
+
+  const auto &epsilon = 0.05f * cellSize;
+
+  Evaluator::Points points;
+  std::vector<float> distances;
+
+  points.reserve(_chunk.vertices.size() * 5);
+
+  for(const auto &vertex : _chunk.vertices)
+  {
+    points.push_back(vertex);
+    pushTetrahedron(points, vertex, epsilon);
+  }
+
+  Evaluator::distances(_nodes, points, distances);
+  _chunk.sampleCount += points.size();
+
+  for(auto i = 0u; i < _chunk.vertices.size(); i++)
+  {
+    const auto *samples = distances.data() + i * 5;
+    const auto &gradient = tetrahedronGradient(samples + 1);
+
+    auto lengthSquared = 0.0f;
+    for(const auto &value : gradient) lengthSquared += value * value;
+
+    if(lengthSquared <= 0.0f) continue;
+
+    // p -= d * grad / |grad|^2, with grad = gradient / (4 * epsilon)
+    const auto &step = samples[0] * 4.0f * epsilon / lengthSquared;
+
+    for(auto axis = 0; axis < 3; axis++)
+    {
+      const auto &cellMin = _grid.origin[axis] + (float) vertexCells[i][axis] * cellSize;
+
+      _chunk.vertices[i][axis] = std::clamp(
+        _chunk.vertices[i][axis] - step * gradient[axis],
+        cellMin,
+        cellMin + cellSize
+      );
+    }
+  }
+
+  points.clear();
+
+  for(const auto &vertex : _chunk.vertices)
+  {
+    pushTetrahedron(points, vertex, epsilon);
+  }
+
+  Evaluator::distances(_nodes, points, distances);
+  _chunk.sampleCount += points.size();
+
+  _chunk.normals.resize(_chunk.vertices.size());
+
+  for(auto i = 0u; i < _chunk.vertices.size(); i++)
+  {
+    auto normal = tetrahedronGradient(distances.data() + i * 4);
+
+    auto length = 0.0f;
+    for(const auto &value : normal) length += value * value;
+    length = std::sqrt(length);
+
+    if(length > 0.0f)
+    {
+      for(auto &value : normal) value /= length;
+    }
+    else
+    {
+      normal = { 0.0f, 1.0f, 0.0f };
+    }
+
+    _chunk.normals[i] = normal;
+  }
+}
+
+/**
+ * @brief one quad per crossed edge starting at the chunk's corners,
+ * connecting the vertices of the four cells around the edge
+ *
+ * @note the quad faces outwards (CCW, see rasterized_mesh_pass),
+ * i.e. towards the outside corner of the edge
+ *
+ * @param[in] _grid
+ * @param[in] _chunks all chunks (cells/vertices are read only)
+ * @param[in,out] _chunk
+ */
+void MeshExtractor::createQuads(
+  const Grid &_grid,
+  const std::vector<Chunk> &_chunks,
+  Chunk &_chunk
+)
+{
+  const auto &chunkSize = meshExtractor::chunkSize;
+
+  /**
+   * @param[in] _cell grid cell
+   * @param[out] _position
+   * @param[out] _normal
+   * @return false if the cell has no vertex
+   */
+  const auto &getVertex = [&](
+    const Index3 &_cell,
+    ir::Vec3 &_position,
+    ir::Vec3 &_normal
+  )
+  {
+    for(auto axis = 0; axis < 3; axis++)
+    {
+      if(_cell[axis] < 0 || _cell[axis] >= _grid.dims[axis]) return false;
+    }
+
+    const auto &chunk = _chunks[
+      (size_t) (_cell[0] / chunkSize) +
+      (size_t) _grid.chunks[0] * (
+        (size_t) (_cell[1] / chunkSize) +
+        (size_t) _grid.chunks[1] * (size_t) (_cell[2] / chunkSize)
+      )
+    ];
+
+    if(chunk.cellVertices.empty()) return false;
+
+    const auto &vertex = chunk.cellVertices[cellIndex(
+      _cell[0] % chunkSize,
+      _cell[1] % chunkSize,
+      _cell[2] % chunkSize
+    )];
+
+    if(vertex < 0) return false;
+
+    _position = chunk.vertices[(size_t) vertex];
+    _normal   = chunk.normals[(size_t) vertex];
+
+    return true;
+  };
+
+  const auto &appendVertex = [&](const ir::Vec3 &_position, const ir::Vec3 &_normal)
+  {
+    // planar uv along the dominant normal axis
+    auto axis = 0;
+    if(std::abs(_normal[1]) > std::abs(_normal[axis])) axis = 1;
+    if(std::abs(_normal[2]) > std::abs(_normal[axis])) axis = 2;
+
+    const float vertex[8] = {
+      _position[0], _position[1], _position[2],
+      _position[(axis + 1) % 3], _position[(axis + 2) % 3],
+      _normal[0], _normal[1], _normal[2]
+    };
+
+    _chunk.geom.append(reinterpret_cast<const char*>(vertex), sizeof(vertex));
+  };
+
+  ir::Vec3 positions[4];
+  ir::Vec3 normals[4];
+
+  for(auto z = 0; z < chunkSize; z++)
+  {
+    for(auto y = 0; y < chunkSize; y++)
+    {
+      for(auto x = 0; x < chunkSize; x++)
+      {
+        const Index3 corner = { _chunk.cell[0] + x, _chunk.cell[1] + y, _chunk.cell[2] + z };
+
+        if(corner[0] > _grid.dims[0] || corner[1] > _grid.dims[1] || corner[2] > _grid.dims[2]) continue;
+
+        const auto &distance = _chunk.corners[cornerIndex(x, y, z)];
+
+        for(auto axis = 0; axis < 3; axis++)
+        {
+          if(corner[axis] + 1 > _grid.dims[axis]) continue;
+
+          const auto &nextDistance = _chunk.corners[cornerIndex(
+            x + (axis == 0),
+            y + (axis == 1),
+            z + (axis == 2)
+          )];
+
+          const auto &isInside = distance < 0.0f;
+          if(isInside == (nextDistance < 0.0f)) continue;
+
+          /**
+           * @note cells around the edge, (u - 1, v - 1), (u, v - 1), (u, v), (u - 1, v)
+           * wind counter clockwise around +axis (u = axis + 1, v = axis + 2)
+           */
+          const auto &u = (axis + 1) % 3;
+          const auto &v = (axis + 2) % 3;
+          const int offsets[4][2] = { { -1, -1 }, { 0, -1 }, { 0, 0 }, { -1, 0 } };
+
+          auto isQuad = true;
+
+          for(auto i = 0; i < 4 && isQuad; i++)
+          {
+            auto cell = corner;
+            cell[u] += offsets[i][0];
+            cell[v] += offsets[i][1];
+
+            // outwards: +axis if the edge starts inside, -axis otherwise
+            const auto &vertex = isInside ? i : 3 - i;
+            isQuad = getVertex(cell, positions[vertex], normals[vertex]);
+          }
+
+          if(!isQuad) continue;
+
+          // split along the shorter diagonal
+          auto diagonal02 = 0.0f;
+          auto diagonal13 = 0.0f;
+
+          for(auto i = 0; i < 3; i++)
+          {
+            diagonal02 += (positions[2][i] - positions[0][i]) * (positions[2][i] - positions[0][i]);
+            diagonal13 += (positions[3][i] - positions[1][i]) * (positions[3][i] - positions[1][i]);
+          }
+
+          const int triangles[2][6] = {
+            { 0, 1, 2, 0, 2, 3 },
+            { 0, 1, 3, 1, 2, 3 }
+          };
+
+          for(const auto &vertex : triangles[diagonal02 <= diagonal13 ? 0 : 1])
+          {
+            appendVertex(positions[vertex], normals[vertex]);
+          }
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,393 @@
+/*****************************************************
+ * Partial Class: MeshSDF (General)
+ * Members: General Functions (Public/Private)
+ *
+ * This Class is split into partials to categorize
+ * and classify the functionality
+ * for the purpose of readability/maintainability
+ *
+ * The partials can be found in the respective
+ * directory named as the class name
+ *
+ * Partials:
+ * - cache_helpers.cpp
+ * - jump_flood_helpers.cpp
+ *****************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <QtCore/qfloat16.h>
+
+#include "SDFGraph/MeshSDF.hpp"
+
+using namespace sdfRay4d::sdfGraph;
+
+/**
+ * @brief loads the mesh (.buf) and converts it,
+ * unless its volume is found in the cache
+ *
+ * @note blocking, call it from a worker thread
+ *
+ * @param[in] _fileName
+ * @param[in] _settings
+ * @param[out] _stats (optional)
+ * @return volume, nullptr if the mesh is invalid/empty
+ */
+ir::VolumePtr MeshSDF::load(
+  const QString &_fileName,
+  const Settings &_settings,
+  Stats *_stats
+)
+{
+  const auto &startTime = std::chrono::steady_clock::now();
+
+  Mesh mesh;
+  mesh.load(_fileName);
+
+  const auto &data = *mesh.data(); // waits for the loader
+
+  if(!data.isValid())
+  {
+    if(_stats) *_stats = Stats();
+    return nullptr;
+  }
+
+  const auto &cachePath = _settings.isCached
+    ? getCachePath(data, _settings)
+    : QString();
+
+  if(!cachePath.isEmpty())
+  {
+    const auto &volume = readCache(cachePath);
+
+    if(volume)
+    {
+      if(_stats)
+      {
+        const std::chrono::duration<double> &duration = std::chrono::steady_clock::now() - startTime;
+
+        Stats stats;
+        stats.seconds       = duration.count();
+        stats.sampleCount   = volume->distances.size();
+        stats.triangleCount = data.vertexCount / 3;
+        stats.isCacheHit    = true;
+
+        *_stats = stats;
+      }
+
+      return volume;
+    }
+  }
+
+  const auto &volume = convert(data, _settings, _stats);
+
+  if(volume && !cachePath.isEmpty())
+  {
+    writeCache(cachePath, *volume);
+  }
+
+  return volume;
+}
+
+/**
+ *
+ * @param[in] _mesh triangle list in the Mesh::Data vertex layout
+ * @param[in] _settings
+ * @param[out] _stats (optional)
+ * @return volume, nullptr if the mesh has no (non degenerate) triangles
+ */
+ir::VolumePtr MeshSDF::convert(
+  const Mesh::Data &_mesh,
+  const Settings &_settings,
+  Stats *_stats
+)
+{
+  const auto &startTime = std::chrono::steady_clock::now();
+
+  ir::Vec3 halfExtents = {};
+  const auto &triangles = createTriangles(_mesh, halfExtents);
+
+  if(triangles.empty())
+  {
+    if(_stats) *_stats = Stats();
+    return nullptr;
+  }
+
+  auto volume = createGrid(halfExtents, _settings.resolution);
+
+  Flood flooding;
+  seed(triangles, volume, flooding);
+
+  const auto &seedCount = flooding.points.size();
+  const auto &passCount = flood(volume, flooding);
+
+  resolveSigns(triangles, flooding, volume);
+
+  volume.lipschitz = getLipschitz(volume);
+
+  if(_stats)
+  {
+    const std::chrono::duration<double> &duration = std::chrono::steady_clock::now() - startTime;
+
+    Stats stats;
+    stats.seconds       = duration.count();
+    stats.sampleCount   = volume.distances.size();
+    stats.seedCount     = seedCount;
+    stats.triangleCount = (int) triangles.size();
+    stats.passCount     = passCount;
+
+    *_stats = stats;
+  }
+
+  return std::make_shared<const ir::Volume>(std::move(volume));
+}
+
+/**
+ * @brief packs the volume for the SDFR storage buffer: header
+ * (origin, spacing, dims), packHalf2x16 pairs of consecutive samples
+ *
+ * @param[in] _volume
+ * @return DataPtr
+ */
+MeshSDF::DataPtr MeshSDF::getData(const ir::Volume &_volume)
+{
+  const auto &sampleCount = _volume.distances.size();
+
+  const auto &data = std::make_shared<Data>();
+  data->reserve(constants::meshSDF::headerSize + (sampleCount + 1) / 2);
+
+  const float header[4] = {
+    _volume.origin[0],
+    _volume.origin[1],
+    _volume.origin[2],
+    _volume.spacing
+  };
+  uint32_t headerBits[4];
+  std::memcpy(headerBits, header, sizeof(headerBits));
+
+  data->insert(data->end(), headerBits, headerBits + 4);
+  data->push_back((uint32_t) _volume.dims[0]);
+  data->push_back((uint32_t) _volume.dims[1]);
+  data->push_back((uint32_t) _volume.dims[2]);
+  data->push_back(0u);
+
+  for(size_t i = 0; i < sampleCount; i += 2)
+  {
+    const qfloat16 halves[2] = {
+      qfloat16(_volume.distances[i]),
+      qfloat16(i + 1 < sampleCount ? _volume.distances[i + 1] : 0.0f)
+    };
+
+    uint16_t bits[2];
+    std::memcpy(bits, halves, sizeof(bits));
+
+    data->push_back((uint32_t) bits[0] | ((uint32_t) bits[1] << 16u));
+  }
+
+  return data;
+}
+
+/**
+ * @brief normalizes the triangle list into [-1, 1] along the
+ * longest axis of its bounds, degenerate triangles are dropped
+ *
+ * @param[in] _mesh
+ * @param[out] _halfExtents normalized
+ * @return triangles
+ */
+std::vector<MeshSDF::Triangle> MeshSDF::createTriangles(
+  const Mesh::Data &_mesh,
+  ir::Vec3 &_halfExtents
+)
+{
+  const auto &vertexSize = (int) constants::mesh::vertexSize;
+  const auto vertexCount = std::min(
+    _mesh.vertexCount,
+    (int) (_mesh.geom.size() / vertexSize)
+  );
+
+  std::vector<ir::Vec3> positions((size_t) std::max(vertexCount, 0));
+
+  ir::Vec3 min = {
+    std::numeric_limits<float>::max(),
+    std::numeric_limits<float>::max(),
+    std::numeric_limits<float>::max()
+  };
+  ir::Vec3 max = {
+    std::numeric_limits<float>::lowest(),
+    std::numeric_limits<float>::lowest(),
+    std::numeric_limits<float>::lowest()
+  };
+
+  for(auto i = 0; i < vertexCount; i++)
+  {
+    std::memcpy(positions[i].data(), _mesh.geom.constData() + i * vertexSize, sizeof(ir::Vec3));
+
+    for(auto axis = 0; axis < 3; axis++)
+    {
+      min[axis] = std::min(min[axis], positions[i][axis]);
+      max[axis] = std::max(max[axis], positions[i][axis]);
+    }
+  }
+
+  auto halfExtent = 0.0f;
+
+  for(auto axis = 0; axis < 3; axis++)
+  {
+    halfExtent = std::max(halfExtent, 0.5f * (max[axis] - min[axis]));
+  }
+
+  std::vector<Triangle> triangles;
+
+  if(vertexCount < 3 || !(halfExtent > 0.0f)) return triangles;
+
+  for(auto axis = 0; axis < 3; axis++)
+  {
+    _halfExtents[axis] = 0.5f * (max[axis] - min[axis]) / halfExtent;
+  }
+
+  const ir::Vec3 center = {
+    0.5f * (min[0] + max[0]),
+    0.5f * (min[1] + max[1]),
+    0.5f * (min[2] + max[2])
+  };
+
+  for(auto &position : positions)
+  {
+    for(auto axis = 0; axis < 3; axis++)
+    {
+      position[axis] = (position[axis] - center[axis]) / halfExtent;
+    }
+  }
+
+  triangles.reserve((size_t) vertexCount / 3);
+
+  for(auto i = 0; i + 2 < vertexCount; i += 3)
+  {
+    const auto &a = positions[i];
+    const auto &b = positions[i + 1];
+    const auto &c = positions[i + 2];
+
+    const ir::Vec3 ab = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+    const ir::Vec3 ac = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+    const ir::Vec3 normal = {
+      ab[1] * ac[2] - ab[2] * ac[1],
+      ab[2] * ac[0] - ab[0] * ac[2],
+      ab[0] * ac[1] - ab[1] * ac[0]
+    };
+
+    if(normal[0] == 0.0f && normal[1] == 0.0f && normal[2] == 0.0f) continue;
+
+    triangles.push_back({ a, b, c });
+  }
+
+  return triangles;
+}
+
+/**
+ * @brief grid centered on the normalized mesh, padded by
+ * constants::meshSDF::padding samples on each side
+ *
+ * @param[in] _halfExtents normalized
+ * @param[in] _resolution samples along the longest axis
+ * @return volume without samples
+ */
+ir::Volume MeshSDF::createGrid(
+  const ir::Vec3 &_halfExtents,
+  int _resolution
+)
+{
+  const auto &padding = constants::meshSDF::padding;
+  const auto resolution = std::clamp(
+    _resolution,
+    2 * padding + 3,
+    constants::meshSDF::maxResolution
+  );
+
+  ir::Volume volume;
+  volume.spacing = 2.0f / (float) (resolution - 1 - 2 * padding);
+
+  for(auto axis = 0; axis < 3; axis++)
+  {
+    const auto &samples = (int) std::ceil(2.0f * _halfExtents[axis] / volume.spacing) + 1;
+
+    volume.dims[axis]   = std::min(samples + 2 * padding, resolution);
+    volume.origin[axis] = -0.5f * (float) (volume.dims[axis] - 1) * volume.spacing;
+  }
+
+  return volume;
+}
+
+/**
+ * @brief bound of the trilinear interpolation's gradient, i.e. by how much
+ * the (jump flooded, quantized) samples overestimate the distance per unit
+ *
+ * @note within a cell, each partial derivative is a bilinear mix of the
+ * cell's 4 edge differences along its axis, so it's bound by the largest
+ * of them. Cells with all samples inside of the surface are skipped, as
+ * sphere tracing stops at the surface.
+ *
+ * @param[in] _volume
+ * @return Lipschitz bound, at least 1
+ */
+float MeshSDF::getLipschitz(const ir::Volume &_volume) noexcept
+{
+  const auto &dims = _volume.dims;
+
+  if(dims[0] < 2 || dims[1] < 2 || dims[2] < 2 || !(_volume.spacing > 0.0f)) return 1.0f;
+
+  const auto &dy = (size_t) dims[0];
+  const auto &dz = (size_t) dims[0] * (size_t) dims[1];
+  const size_t strides[3] = { 1, dy, dz };
+  const auto *distances = _volume.distances.data();
+
+  auto maxGradient = 0.0f;
+
+  for(auto z = 0; z < dims[2] - 1; z++)
+  for(auto y = 0; y < dims[1] - 1; y++)
+  for(auto x = 0; x < dims[0] - 1; x++)
+  {
+    const auto &base = (size_t) x + dy * (size_t) y + dz * (size_t) z;
+    const size_t corners[8] = {
+      base,           base + 1,
+      base + dy,      base + dy + 1,
+      base + dz,      base + dz + 1,
+      base + dz + dy, base + dz + dy + 1
+    };
+
+    auto isInside = true;
+
+    for(const auto &corner : corners)
+    {
+      isInside = isInside && distances[corner] <= 0.0f;
+    }
+
+    if(isInside) continue;
+
+    auto gradient = 0.0f;
+
+    for(auto axis = 0; axis < 3; axis++)
+    {
+      auto edge = 0.0f;
+
+      // corners without the axis' bit are the edges' first samples
+      for(auto corner = 0; corner < 8; corner++)
+      {
+        if(corner & (1 << axis)) continue;
+
+        const auto &sample = corners[corner];
+        edge = std::max(edge, std::abs(distances[sample + strides[axis]] - distances[sample]));
+      }
+
+      gradient += edge * edge;
+    }
+
+    maxGradient = std::max(maxGradient, gradient);
+  }
+
+  return std::max(std::sqrt(maxGradient) / _volume.spacing, 1.0f);
+}
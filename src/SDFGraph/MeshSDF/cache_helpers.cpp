@@ -0,0 +1,169 @@
+/*****************************************************
+ * Partial Class: MeshSDF
+ * Members: Cache Helpers (Private)
+ *****************************************************/
+
+#include <cstring>
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "SDFGraph/MeshSDF.hpp"
+
+using namespace sdfRay4d::sdfGraph;
+
+namespace
+{
+  /**
+   * @struct CacheHeader
+   * @brief followed by the (float) distances
+   *
+   * @note bump the version whenever the conversion changes its output
+   */
+  struct CacheHeader
+  {
+    char magic[4]     = { 'M', 'S', 'D', 'F' };
+    uint32_t version  = 1;
+    int32_t dims[3]   = {};
+    float origin[3]   = {};
+    float spacing     = 0.0f;
+  };
+}
+
+/**
+ * @note keyed by the mesh data and the resolution, a modified
+ * mesh (or resolution) never reads a stale volume
+ *
+ * @param[in] _mesh
+ * @param[in] _settings
+ * @return file path of the cached volume
+ */
+QString MeshSDF::getCachePath(
+  const Mesh::Data &_mesh,
+  const Settings &_settings
+)
+{
+  const CacheHeader header;
+  const int32_t key[2] = { _settings.resolution, _mesh.vertexCount };
+
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  hash.addData(reinterpret_cast<const char*>(&header.version), sizeof(header.version));
+  hash.addData(reinterpret_cast<const char*>(key), sizeof(key));
+  hash.addData(_mesh.geom);
+
+  return QDir(constants::meshSDF::cachePath).filePath(
+    QString::fromLatin1(hash.result().toHex()) + ".sdf"
+  );
+}
+
+/**
+ *
+ * @param[in] _filePath
+ * @return volume, nullptr if not cached (or invalid)
+ */
+ir::VolumePtr MeshSDF::readCache(const QString &_filePath)
+{
+  QFile file(_filePath);
+
+  if(!file.exists() || !file.open(QIODevice::ReadOnly)) return nullptr;
+
+  const CacheHeader expected;
+  CacheHeader header;
+
+  const auto &isHeaderRead = file.read(
+    reinterpret_cast<char*>(&header),
+    sizeof(header)
+  ) == (qint64) sizeof(header);
+
+  if(
+    !isHeaderRead ||
+    std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+    header.version != expected.version
+  )
+  {
+    qWarning("Ignoring invalid mesh SDF cache %s", qPrintable(_filePath));
+    return nullptr;
+  }
+
+  auto volume = std::make_shared<ir::Volume>();
+  size_t sampleCount = 1;
+
+  for(auto axis = 0; axis < 3; axis++)
+  {
+    if(header.dims[axis] < 2 || header.dims[axis] > constants::meshSDF::maxResolution)
+    {
+      qWarning("Ignoring invalid mesh SDF cache %s", qPrintable(_filePath));
+      return nullptr;
+    }
+
+    volume->dims[axis]    = header.dims[axis];
+    volume->origin[axis]  = header.origin[axis];
+
+    sampleCount *= (size_t) header.dims[axis];
+  }
+
+  volume->spacing = header.spacing;
+  volume->distances.resize(sampleCount);
+
+  const auto &byteSize = (qint64) (sampleCount * sizeof(float));
+
+  if(file.read(reinterpret_cast<char*>(volume->distances.data()), byteSize) != byteSize)
+  {
+    qWarning("Ignoring truncated mesh SDF cache %s", qPrintable(_filePath));
+    return nullptr;
+  }
+
+  volume->lipschitz = getLipschitz(*volume);
+
+  return volume;
+}
+
+/**
+ * @note written atomically, so a concurrent (or interrupted)
+ * conversion never leaves a partial volume behind
+ *
+ * @param[in] _filePath
+ * @param[in] _volume
+ */
+void MeshSDF::writeCache(
+  const QString &_filePath,
+  const ir::Volume &_volume
+)
+{
+  if(!QDir().mkpath(QFileInfo(_filePath).absolutePath()))
+  {
+    qWarning("Failed to create the mesh SDF cache directory for %s", qPrintable(_filePath));
+    return;
+  }
+
+  CacheHeader header;
+  header.spacing = _volume.spacing;
+
+  for(auto axis = 0; axis < 3; axis++)
+  {
+    header.dims[axis]   = _volume.dims[axis];
+    header.origin[axis] = _volume.origin[axis];
+  }
+
+  QSaveFile file(_filePath);
+
+  if(!file.open(QIODevice::WriteOnly))
+  {
+    qWarning("Failed to write mesh SDF cache %s", qPrintable(_filePath));
+    return;
+  }
+
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(
+    reinterpret_cast<const char*>(_volume.distances.data()),
+    (qint64) (_volume.distances.size() * sizeof(float))
+  );
+
+  if(!file.commit())
+  {
+    qWarning("Failed to write mesh SDF cache %s", qPrintable(_filePath));
+  }
+}
@@ -0,0 +1,604 @@
+/*****************************************************
+ * Partial Class: MeshSDF
+ * Members: Jump Flooding Helpers - Thread Pool (Private)
+ *****************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include <QtConcurrentMap>
+
+#include "SDFGraph/MeshSDF.hpp"
+
+using namespace sdfRay4d::sdfGraph;
+
+namespace
+{
+  /**
+   * @namespace jfa
+   * @brief vector/triangle helpers of the conversion passes
+   */
+  namespace jfa
+  {
+    using Vec3 = sdfRay4d::sdfGraph::ir::Vec3;
+
+    inline Vec3 sub(const Vec3 &_a, const Vec3 &_b)
+    {
+      return { _a[0] - _b[0], _a[1] - _b[1], _a[2] - _b[2] };
+    }
+
+    inline Vec3 mad(const Vec3 &_a, const Vec3 &_b, float _s)
+    {
+      return { _a[0] + _b[0] * _s, _a[1] + _b[1] * _s, _a[2] + _b[2] * _s };
+    }
+
+    inline float dot(const Vec3 &_a, const Vec3 &_b)
+    {
+      return _a[0] * _b[0] + _a[1] * _b[1] + _a[2] * _b[2];
+    }
+
+    inline float distance2(const Vec3 &_a, const Vec3 &_b)
+    {
+      const auto &d = sub(_a, _b);
+      return dot(d, d);
+    }
+
+    /**
+     * @note Ericson, Real-Time Collision Detection (5.1.5),
+     * voronoi regions of the vertices, edges and face
+     *
+     * @param[in] _p
+     * @param[in] _a
+     * @param[in] _b
+     * @param[in] _c
+     * @return closest point on the (non degenerate) triangle
+     */
+    inline Vec3 closestPoint(
+      const Vec3 &_p,
+      const Vec3 &_a,
+      const Vec3 &_b,
+      const Vec3 &_c
+    )
+    {
+      const auto &ab = sub(_b, _a);
+      const auto &ac = sub(_c, _a);
+      const auto &ap = sub(_p, _a);
+
+      const auto d1 = dot(ab, ap);
+      const auto d2 = dot(ac, ap);
+      if(d1 <= 0.0f && d2 <= 0.0f) return _a;
+
+      const auto &bp = sub(_p, _b);
+      const auto d3 = dot(ab, bp);
+      const auto d4 = dot(ac, bp);
+      if(d3 >= 0.0f && d4 <= d3) return _b;
+
+      const auto vc = d1 * d4 - d3 * d2;
+      if(vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return mad(_a, ab, d1 / (d1 - d3));
+
+      const auto &cp = sub(_p, _c);
+      const auto d5 = dot(ab, cp);
+      const auto d6 = dot(ac, cp);
+      if(d6 >= 0.0f && d5 <= d6) return _c;
+
+      const auto vb = d5 * d2 - d1 * d6;
+      if(vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return mad(_a, ac, d2 / (d2 - d6));
+
+      const auto va = d3 * d6 - d5 * d4;
+      if(va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+      {
+        return mad(_b, sub(_c, _b), (d4 - d3) / ((d4 - d3) + (d5 - d6)));
+      }
+
+      const auto denom = 1.0f / (va + vb + vc);
+
+      return mad(mad(_a, ab, vb * denom), ac, vc * denom);
+    }
+
+    /**
+     * @brief 2D edge function in the (y, z) projection
+     *
+     * @note evaluated in a canonical vertex order, so that the two triangles
+     * sharing an edge get exactly negated values (no double/missed crossing)
+     *
+     * @param[in] _u
+     * @param[in] _v
+     * @param[in] _y
+     * @param[in] _z
+     * @return > 0 if the point is left of u -> v
+     */
+    inline float edgeFunction(const Vec3 &_u, const Vec3 &_v, float _y, float _z)
+    {
+      const auto &isSwapped = _v[1] < _u[1] || (_v[1] == _u[1] && _v[2] < _u[2]);
+
+      const auto &u = isSwapped ? _v : _u;
+      const auto &v = isSwapped ? _u : _v;
+
+      const auto w = (v[1] - u[1]) * (_z - u[2]) - (v[2] - u[2]) * (_y - u[1]);
+
+      return isSwapped ? -w : w;
+    }
+
+    /**
+     * @note top-left fill rule: points exactly on an edge are only
+     * covered by one of the (counter clockwise) triangles sharing it
+     *
+     * @param[in] _w edge function
+     * @param[in] _u
+     * @param[in] _v
+     * @return boolean
+     */
+    inline bool isCovered(float _w, const Vec3 &_u, const Vec3 &_v)
+    {
+      if(_w != 0.0f) return _w > 0.0f;
+
+      const auto &dz = _v[2] - _u[2];
+
+      return dz > 0.0f || (dz == 0.0f && _v[1] < _u[1]);
+    }
+
+    /**
+     *
+     * @param[in] _a
+     * @param[in] _b
+     * @param[in] _c
+     * @param[in] _y
+     * @param[in] _z
+     * @param[out] _x of the crossing
+     * @return true if the row (y, z) along x crosses the triangle
+     */
+    inline bool crossRow(
+      const Vec3 &_a,
+      const Vec3 &_b,
+      const Vec3 &_c,
+      float _y,
+      float _z,
+      float &_x
+    )
+    {
+      const auto &area = edgeFunction(_a, _b, _c[1], _c[2]);
+
+      if(area == 0.0f) return false; // parallel to x
+
+      // counter clockwise in (y, z)
+      const auto &b = area > 0.0f ? _b : _c;
+      const auto &c = area > 0.0f ? _c : _b;
+
+      const auto w0 = edgeFunction(b, c, _y, _z);
+      const auto w1 = edgeFunction(c, _a, _y, _z);
+      const auto w2 = edgeFunction(_a, b, _y, _z);
+
+      if(!isCovered(w0, b, c) || !isCovered(w1, c, _a) || !isCovered(w2, _a, b)) return false;
+
+      _x = (w0 * _a[0] + w1 * b[0] + w2 * c[0]) / (w0 + w1 + w2);
+
+      return true;
+    }
+
+    /**
+     *
+     * @param[in] _volume
+     * @param[in] _min
+     * @param[in] _max
+     * @param[in] _padding samples
+     * @param[out] _minSample
+     * @param[out] _maxSample
+     * @return false if the bounds miss the grid
+     */
+    inline bool getSampleBounds(
+      const sdfRay4d::sdfGraph::ir::Volume &_volume,
+      const Vec3 &_min,
+      const Vec3 &_max,
+      int _padding,
+      std::array<int, 3> &_minSample,
+      std::array<int, 3> &_maxSample
+    )
+    {
+      for(auto axis = 0; axis < 3; axis++)
+      {
+        const auto &min = (_min[axis] - _volume.origin[axis]) / _volume.spacing;
+        const auto &max = (_max[axis] - _volume.origin[axis]) / _volume.spacing;
+
+        _minSample[axis] = std::max((int) std::ceil(min) - _padding, 0);
+        _maxSample[axis] = std::min((int) std::floor(max) + _padding, _volume.dims[axis] - 1);
+
+        if(_minSample[axis] > _maxSample[axis]) return false;
+      }
+
+      return true;
+    }
+
+    inline Vec3 getMin(const Vec3 &_a, const Vec3 &_b, const Vec3 &_c)
+    {
+      return {
+        std::min({ _a[0], _b[0], _c[0] }),
+        std::min({ _a[1], _b[1], _c[1] }),
+        std::min({ _a[2], _b[2], _c[2] })
+      };
+    }
+
+    inline Vec3 getMax(const Vec3 &_a, const Vec3 &_b, const Vec3 &_c)
+    {
+      return {
+        std::max({ _a[0], _b[0], _c[0] }),
+        std::max({ _a[1], _b[1], _c[1] }),
+        std::max({ _a[2], _b[2], _c[2] })
+      };
+    }
+
+    /**
+     *
+     * @param[in] _sliceCount
+     * @return [0, _sliceCount)
+     */
+    inline std::vector<int> createRange(int _sliceCount)
+    {
+      std::vector<int> range((size_t) std::max(_sliceCount, 0));
+      std::iota(range.begin(), range.end(), 0);
+
+      return range;
+    }
+  }
+}
+
+/**
+ * @brief seeds every sample within a cell of a triangle with
+ * its closest point on the surface
+ *
+ * @note the grid is split into z slabs processed in parallel, each slab
+ * only writes its own samples. Triangles are binned into the slabs their
+ * (padded) bounds overlap, seed points are concatenated in slab order.
+ *
+ * @param[in] _triangles
+ * @param[in] _volume grid
+ * @param[out] _flood
+ */
+void MeshSDF::seed(
+  const std::vector<Triangle> &_triangles,
+  const ir::Volume &_volume,
+  Flood &_flood
+)
+{
+  const auto &dims = _volume.dims;
+  const auto &slabSize = constants::meshSDF::slabSize;
+  const auto &slabCount = (dims[2] + slabSize - 1) / slabSize;
+  const auto &sliceSize = (size_t) dims[0] * (size_t) dims[1];
+
+  std::vector<Index3> minSamples(_triangles.size());
+  std::vector<Index3> maxSamples(_triangles.size());
+  std::vector<std::vector<int32_t>> slabTriangles((size_t) slabCount);
+
+  for(auto i = 0u; i < _triangles.size(); i++)
+  {
+    const auto &triangle = _triangles[i];
+
+    const auto &isInside = jfa::getSampleBounds(
+      _volume,
+      jfa::getMin(triangle.a, triangle.b, triangle.c),
+      jfa::getMax(triangle.a, triangle.b, triangle.c),
+      1,
+      minSamples[i],
+      maxSamples[i]
+    );
+
+    if(!isInside) continue;
+
+    for(auto slab = minSamples[i][2] / slabSize; slab <= maxSamples[i][2] / slabSize; slab++)
+    {
+      slabTriangles[slab].push_back((int32_t) i);
+    }
+  }
+
+  _flood.seeds.assign(sliceSize * (size_t) dims[2], -1);
+
+  std::vector<std::vector<ir::Vec3>> slabPoints((size_t) slabCount);
+  auto slabs = jfa::createRange(slabCount);
+
+  QtConcurrent::blockingMap(slabs, [&](int _slab)
+  {
+    const auto &minZ = _slab * slabSize;
+    const auto maxZ = std::min(minZ + slabSize, dims[2]) - 1;
+    const auto &slabSamples = sliceSize * (size_t) (maxZ - minZ + 1);
+
+    std::vector<float> distances(slabSamples, std::numeric_limits<float>::max());
+    std::vector<ir::Vec3> points(slabSamples);
+
+    for(const auto &index : slabTriangles[_slab])
+    {
+      const auto &triangle = _triangles[index];
+      const auto &minSample = minSamples[index];
+      const auto &maxSample = maxSamples[index];
+
+      for(auto z = std::max(minSample[2], minZ); z <= std::min(maxSample[2], maxZ); z++)
+      {
+        for(auto y = minSample[1]; y <= maxSample[1]; y++)
+        {
+          for(auto x = minSample[0]; x <= maxSample[0]; x++)
+          {
+            const ir::Vec3 pos = {
+              _volume.origin[0] + (float) x * _volume.spacing,
+              _volume.origin[1] + (float) y * _volume.spacing,
+              _volume.origin[2] + (float) z * _volume.spacing
+            };
+
+            const auto &point = jfa::closestPoint(pos, triangle.a, triangle.b, triangle.c);
+            const auto &distance = jfa::distance2(pos, point);
+            const auto &local = (size_t) x + (size_t) dims[0] * ((size_t) y + (size_t) dims[1] * (size_t) (z - minZ));
+
+            if(distance < distances[local])
+            {
+              distances[local] = distance;
+              points[local] = point;
+            }
+          }
+        }
+      }
+    }
+
+    auto &seedPoints = slabPoints[_slab];
+    auto *seeds = _flood.seeds.data() + sliceSize * (size_t) minZ;
+
+    for(size_t local = 0; local < slabSamples; local++)
+    {
+      if(distances[local] == std::numeric_limits<float>::max()) continue;
+
+      seeds[local] = (int32_t) seedPoints.size();
+      seedPoints.push_back(points[local]);
+    }
+  });
+
+  std::vector<int32_t> offsets((size_t) slabCount, 0);
+  size_t pointCount = 0;
+
+  for(auto slab = 0; slab < slabCount; slab++)
+  {
+    offsets[slab] = (int32_t) pointCount;
+    pointCount += slabPoints[slab].size();
+  }
+
+  _flood.points.clear();
+  _flood.points.reserve(pointCount);
+
+  for(const auto &points : slabPoints)
+  {
+    _flood.points.insert(_flood.points.end(), points.begin(), points.end());
+  }
+
+  QtConcurrent::blockingMap(slabs, [&](int _slab)
+  {
+    const auto &minZ = _slab * slabSize;
+    const auto maxZ = std::min(minZ + slabSize, dims[2]);
+
+    auto *seeds = _flood.seeds.data() + sliceSize * (size_t) minZ;
+    const auto *end = _flood.seeds.data() + sliceSize * (size_t) maxZ;
+
+    for(; seeds != end; seeds++)
+    {
+      if(*seeds >= 0) *seeds += offsets[_slab];
+    }
+  });
+}
+
+/**
+ * @brief 1+JFA, each pass keeps the closest of the seed points
+ * found by the sample itself and its 26 neighbours at +-step
+ *
+ * @param[in] _volume grid
+ * @param[in,out] _flood
+ * @return pass count
+ */
+int MeshSDF::flood(
+  const ir::Volume &_volume,
+  Flood &_flood
+)
+{
+  const auto &dims = _volume.dims;
+  const auto &slabSize = constants::meshSDF::slabSize;
+  const auto &slabCount = (dims[2] + slabSize - 1) / slabSize;
+  const auto &sliceSize = (size_t) dims[0] * (size_t) dims[1];
+
+  auto step = 1;
+
+  while(step * 2 <= std::max({ dims[0], dims[1], dims[2] }) / 2) step *= 2;
+
+  std::vector<int> steps;
+
+  for(; step >= 1; step /= 2) steps.push_back(step);
+
+  steps.push_back(1);
+
+  _flood.nextSeeds.resize(_flood.seeds.size());
+
+  auto slabs = jfa::createRange(slabCount);
+
+  for(const auto &jump : steps)
+  {
+    QtConcurrent::blockingMap(slabs, [&](int _slab)
+    {
+      const auto &minZ = _slab * slabSize;
+      const auto maxZ = std::min(minZ + slabSize, dims[2]);
+
+      const auto *seeds = _flood.seeds.data();
+      const auto *points = _flood.points.data();
+      auto *nextSeeds = _flood.nextSeeds.data();
+
+      // seed rows of the (up to 9) neighbour rows at +-jump in y/z
+      const int32_t *rows[9];
+
+      for(auto z = minZ; z < maxZ; z++)
+      {
+        for(auto y = 0; y < dims[1]; y++)
+        {
+          auto rowCount = 0;
+
+          for(auto dz = -jump; dz <= jump; dz += jump)
+          {
+            if(z + dz < 0 || z + dz >= dims[2]) continue;
+
+            for(auto dy = -jump; dy <= jump; dy += jump)
+            {
+              if(y + dy < 0 || y + dy >= dims[1]) continue;
+
+              rows[rowCount++] = seeds + (size_t) dims[0] * (size_t) (y + dy) + sliceSize * (size_t) (z + dz);
+            }
+          }
+
+          const auto &rowIndex = (size_t) dims[0] * (size_t) y + sliceSize * (size_t) z;
+
+          for(auto x = 0; x < dims[0]; x++)
+          {
+            const ir::Vec3 pos = {
+              _volume.origin[0] + (float) x * _volume.spacing,
+              _volume.origin[1] + (float) y * _volume.spacing,
+              _volume.origin[2] + (float) z * _volume.spacing
+            };
+
+            const auto &index = rowIndex + (size_t) x;
+
+            const auto &minX = x >= jump ? x - jump : x;
+            const auto &maxX = x + jump < dims[0] ? x + jump : x;
+
+            auto seed = seeds[index];
+            auto checked = seed; // neighbours mostly share their seeds
+            auto distance = seed >= 0
+              ? jfa::distance2(pos, points[seed])
+              : std::numeric_limits<float>::max();
+
+            for(auto row = 0; row < rowCount; row++)
+            {
+              for(auto neighbourX = minX; neighbourX <= maxX; neighbourX += jump)
+              {
+                const auto &neighbour = rows[row][neighbourX];
+
+                if(neighbour < 0 || neighbour == checked) continue;
+
+                checked = neighbour;
+
+                const auto &neighbourDistance = jfa::distance2(pos, points[neighbour]);
+
+                if(neighbourDistance < distance)
+                {
+                  distance = neighbourDistance;
+                  seed = neighbour;
+                }
+              }
+            }
+
+            nextSeeds[index] = seed;
+          }
+        }
+      }
+    });
+
+    _flood.seeds.swap(_flood.nextSeeds);
+  }
+
+  _flood.nextSeeds.clear();
+  _flood.nextSeeds.shrink_to_fit();
+
+  return (int) steps.size();
+}
+
+/**
+ * @brief signed distances: parity of the crossings of each grid row
+ * (a ray along x) with the triangles, odd is inside
+ *
+ * @note triangles are binned per z slice, the slices are processed in parallel
+ *
+ * @param[in] _triangles
+ * @param[in] _flood
+ * @param[in,out] _volume distances are (re)written
+ */
+void MeshSDF::resolveSigns(
+  const std::vector<Triangle> &_triangles,
+  const Flood &_flood,
+  ir::Volume &_volume
+)
+{
+  const auto &dims = _volume.dims;
+  const auto &sliceSize = (size_t) dims[0] * (size_t) dims[1];
+
+  std::vector<ir::Vec3> mins(_triangles.size());
+  std::vector<ir::Vec3> maxs(_triangles.size());
+  std::vector<std::vector<int32_t>> sliceTriangles((size_t) dims[2]);
+
+  for(auto i = 0u; i < _triangles.size(); i++)
+  {
+    const auto &triangle = _triangles[i];
+
+    mins[i] = jfa::getMin(triangle.a, triangle.b, triangle.c);
+    maxs[i] = jfa::getMax(triangle.a, triangle.b, triangle.c);
+
+    // slices (z samples) within the triangle's z range
+    const auto minZ = std::max(
+      (int) std::ceil((mins[i][2] - _volume.origin[2]) / _volume.spacing),
+      0
+    );
+    const auto maxZ = std::min(
+      (int) std::floor((maxs[i][2] - _volume.origin[2]) / _volume.spacing),
+      dims[2] - 1
+    );
+
+    for(auto z = minZ; z <= maxZ; z++)
+    {
+      sliceTriangles[z].push_back((int32_t) i);
+    }
+  }
+
+  _volume.distances.resize(sliceSize * (size_t) dims[2]);
+
+  auto slices = jfa::createRange(dims[2]);
+
+  QtConcurrent::blockingMap(slices, [&](int _z)
+  {
+    const auto &posZ = _volume.origin[2] + (float) _z * _volume.spacing;
+
+    std::vector<float> crossings;
+
+    for(auto y = 0; y < dims[1]; y++)
+    {
+      const auto &posY = _volume.origin[1] + (float) y * _volume.spacing;
+
+      crossings.clear();
+
+      for(const auto &index : sliceTriangles[_z])
+      {
+        if(posY < mins[index][1] || posY > maxs[index][1]) continue;
+
+        const auto &triangle = _triangles[index];
+        auto crossing = 0.0f;
+
+        if(jfa::crossRow(triangle.a, triangle.b, triangle.c, posY, posZ, crossing))
+        {
+          crossings.push_back(crossing);
+        }
+      }
+
+      std::sort(crossings.begin(), crossings.end());
+
+      size_t crossed = 0;
+
+      for(auto x = 0; x < dims[0]; x++)
+      {
+        const ir::Vec3 pos = {
+          _volume.origin[0] + (float) x * _volume.spacing,
+          posY,
+          posZ
+        };
+
+        while(crossed < crossings.size() && crossings[crossed] < pos[0]) crossed++;
+
+        const auto &index = (size_t) x + (size_t) dims[0] * (size_t) y + sliceSize * (size_t) _z;
+        const auto &seed = _flood.seeds[index];
+
+        const auto &distance = seed >= 0
+          ? std::sqrt(jfa::distance2(pos, _flood.points[seed]))
+          : std::numeric_limits<float>::max();
+
+        _volume.distances[index] = (crossed % 2) == 1 ? -distance : distance;
+      }
+    }
+  });
+}
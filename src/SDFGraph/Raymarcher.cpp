@@ -0,0 +1,406 @@
+/*****************************************************
+ * Partial Class: Raymarcher (General)
+ * Members: General Functions (Public/Private)
+ *
+ * This Class is split into partials to categorize
+ * and classify the functionality
+ * for the purpose of readability/maintainability
+ *
+ * The partials can be found in the respective
+ * directory named as the class name
+ *
+ * Partials:
+ * - packet_helpers.cpp
+ *****************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "_constants.hpp"
+#include "SDFGraph/MeshSDF.hpp"
+#include "SDFGraph/Raymarcher.hpp"
+
+using namespace sdfRay4d::sdfGraph;
+
+namespace
+{
+  /**
+   * @class TileQueue
+   * @brief a worker's tiles: popped by the owner from the front,
+   * stolen by the other workers from the back
+   */
+  class TileQueue
+  {
+    public:
+      void push(int _tile)
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tiles.push_back(_tile);
+      }
+
+      bool pop(int &_tile)
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_tiles.empty()) return false;
+
+        _tile = m_tiles.front();
+        m_tiles.pop_front();
+        return true;
+      }
+
+      bool steal(int &_tile)
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_tiles.empty()) return false;
+
+        _tile = m_tiles.back();
+        m_tiles.pop_back();
+        return true;
+      }
+
+    private:
+      std::mutex m_mutex;
+      std::deque<int> m_tiles;
+  };
+}
+
+double Raymarcher::Stats::raysPerSecond() const noexcept
+{
+  if(seconds <= 0.0) return 0.0;
+
+  return (double) (primaryRays + shadowRays) / seconds;
+}
+
+double Raymarcher::Stats::raysPerSecondPerCore() const noexcept
+{
+  if(threadCount <= 0) return 0.0;
+
+  return raysPerSecond() / (double) threadCount;
+}
+
+/**
+ * @note every worker starts with a contiguous range of tiles (coherent
+ * rays/cache), and steals from the back of the others' ranges once its
+ * own is exhausted, so expensive regions (e.g. many shadowed hits) don't
+ * leave the other workers idle. Tiles are never added while rendering,
+ * so a worker is done once its own queue is empty and nothing can be stolen.
+ *
+ * @param[in] _scene has to be supported by the Evaluator (see isSupported)
+ * @param[in] _settings
+ * @param[out] _stats (optional)
+ * @return RGB32 image, null if the scene isn't supported
+ */
+QImage Raymarcher::render(
+  const ir::Scene &_scene,
+  const Settings &_settings,
+  Stats *_stats
+)
+{
+  if(!Evaluator::isSupported(_scene))
+  {
+    qWarning("CPU render: the scene has a brick map or nodes the evaluator doesn't support");
+    return {};
+  }
+
+  QImage image(_settings.width, _settings.height, QImage::Format_RGB32);
+
+  if(image.isNull()) return image;
+
+  const auto &tileSize = constants::raymarcher::tileSize;
+  const auto &tilesX = (_settings.width + tileSize - 1) / tileSize;
+  const auto &tilesY = (_settings.height + tileSize - 1) / tileSize;
+  const auto &tileCount = tilesX * tilesY;
+
+  const auto threadCount = std::max(
+    1,
+    std::min(
+      _settings.threadCount > 0
+        ? _settings.threadCount
+        : (int) std::max(std::thread::hardware_concurrency(), 1u),
+      tileCount
+    )
+  );
+
+  std::vector<TileQueue> queues(threadCount);
+
+  for(auto tile = 0; tile < tileCount; tile++)
+  {
+    queues[(size_t) ((int64_t) tile * threadCount / tileCount)].push(tile);
+  }
+
+  std::atomic<uint64_t> shadowRays { 0 };
+  std::atomic<uint64_t> marchSteps { 0 };
+  std::atomic<uint64_t> termSteps { 0 };
+
+  // workers write distinct tiles of the (detached) pixel data
+  auto *bits = image.bits();
+  const auto &bytesPerLine = image.bytesPerLine();
+
+  const auto &startTime = std::chrono::steady_clock::now();
+
+  const auto &worker = [&](int _workerId)
+  {
+    Packet packet;
+    auto tile = 0;
+
+    while(true)
+    {
+      auto hasTile = queues[_workerId].pop(tile);
+
+      for(auto i = 1; i < threadCount && !hasTile; i++)
+      {
+        hasTile = queues[(_workerId + i) % threadCount].steal(tile);
+      }
+
+      if(!hasTile) break;
+
+      renderTile(_scene, _settings, tile % tilesX, tile / tilesX, packet, bits, bytesPerLine);
+    }
+
+    shadowRays += packet.shadowRays;
+    marchSteps += packet.marchSteps;
+    termSteps += packet.termSteps;
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve((size_t) threadCount - 1);
+
+  for(auto workerId = 1; workerId < threadCount; workerId++)
+  {
+    threads.emplace_back(worker, workerId);
+  }
+
+  worker(0);
+
+  for(auto &thread : threads) thread.join();
+
+  if(_stats)
+  {
+    const std::chrono::duration<double> &duration = std::chrono::steady_clock::now() - startTime;
+
+    _stats->seconds     = duration.count();
+    _stats->primaryRays = (uint64_t) _settings.width * (uint64_t) _settings.height;
+    _stats->shadowRays  = shadowRays.load();
+    _stats->marchSteps  = marchSteps.load();
+    _stats->termSteps   = termSteps.load();
+    _stats->threadCount = threadCount;
+  }
+
+  return image;
+}
+
+/**
+ * @brief the primitives of sdfr_pass.frag's original demo map()
+ * supported by the IR, for headless previews/golden images
+ *
+ * @return ir::Scene
+ */
+ir::Scene Raymarcher::createReferenceScene()
+{
+  ir::Scene scene;
+
+  scene.nodes = {
+    { ir::OperationType::Union, { ir::PrimitiveType::Sphere,  { 0.0f, 0.25f, 0.0f }, { 0.25f, 0.25f, 0.25f }, 46.9f } },
+    { ir::OperationType::Union, { ir::PrimitiveType::Box,     { 1.0f, 0.25f, 0.0f }, { 0.25f, 0.25f, 0.25f }, 3.0f } },
+    { ir::OperationType::Union, { ir::PrimitiveType::Torus,   { 0.0f, 0.25f, 1.0f }, { 0.20f, 0.05f, 0.0f }, 25.0f } },
+    { ir::OperationType::Subtraction, { ir::PrimitiveType::Sphere, { 1.0f, 0.5f, 0.0f }, { 0.2f, 0.2f, 0.2f } } }
+  };
+
+  return scene;
+}
+
+/**
+ * @brief reads a scene IR file for headless renders, i.e. the SDF Graph's
+ * map nodes in order (the base is the ground plane), e.g.
+ *
+ * { "nodes": [
+ *   { "operation": "union", "primitive": "sphere", "position": [0, 0.25, 0],
+ *     "dimensions": [0.25, 0, 0], "material": 46.9 },
+ *   { "operation": "subtraction", "primitive": "mesh", "mesh": "bunny.buf",
+ *     "position": [1, 0.5, 0], "dimensions": [0.5, 0, 0] }
+ * ] }
+ *
+ * @note mesh paths are relative to the scene file, converted by MeshSDF
+ * (cached). Unknown operations/primitives fail the whole scene.
+ *
+ * @param[in] _filePath (.json)
+ * @param[out] _scene
+ * @return false if it can't be read/parsed (warned)
+ */
+bool Raymarcher::loadScene(const QString &_filePath, ir::Scene &_scene)
+{
+  QFile file(_filePath);
+
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    qWarning("Failed to open scene %s", qPrintable(_filePath));
+    return false;
+  }
+
+  QJsonParseError error;
+  const auto document = QJsonDocument::fromJson(file.readAll(), &error);
+
+  if(document.isNull())
+  {
+    qWarning("Failed to parse scene %s: %s", qPrintable(_filePath), qPrintable(error.errorString()));
+    return false;
+  }
+
+  static const QHash<QString, ir::OperationType> operations = {
+    { "union",        ir::OperationType::Union },
+    { "subtraction",  ir::OperationType::Subtraction }
+  };
+  static const QHash<QString, ir::PrimitiveType> primitives = {
+    { "plane",  ir::PrimitiveType::Plane },
+    { "sphere", ir::PrimitiveType::Sphere },
+    { "box",    ir::PrimitiveType::Box },
+    { "torus",  ir::PrimitiveType::Torus },
+    { "mesh",   ir::PrimitiveType::Mesh }
+  };
+
+  const auto &toVec3 = [](const QJsonValue &_value)
+  {
+    const auto &array = _value.toArray();
+
+    return ir::Vec3 {
+      (float) array.at(0).toDouble(),
+      (float) array.at(1).toDouble(),
+      (float) array.at(2).toDouble()
+    };
+  };
+
+  const auto &directory = QFileInfo(_filePath).absoluteDir();
+
+  ir::Scene scene;
+
+  for(const auto &value : document.object().value("nodes").toArray())
+  {
+    const auto &object = value.toObject();
+    const auto &operation = object.value("operation").toString("union");
+    const auto &primitive = object.value("primitive").toString();
+
+    if(!operations.contains(operation) || !primitives.contains(primitive))
+    {
+      qWarning(
+        "Unsupported scene node (operation \"%s\", primitive \"%s\") in %s",
+        qPrintable(operation),
+        qPrintable(primitive),
+        qPrintable(_filePath)
+      );
+      return false;
+    }
+
+    ir::Node node;
+    node.operation            = operations.value(operation);
+    node.primitive.type       = primitives.value(primitive);
+    node.primitive.position   = toVec3(object.value("position"));
+    node.primitive.dimensions = toVec3(object.value("dimensions"));
+    node.primitive.material   = (float) object.value("material").toDouble(1.0);
+
+    if(node.primitive.type == ir::PrimitiveType::Mesh)
+    {
+      const auto &meshPath = directory.absoluteFilePath(object.value("mesh").toString());
+
+      node.primitive.volume = MeshSDF::load(meshPath, MeshSDF::Settings());
+
+      if(!node.primitive.volume)
+      {
+        qWarning("Failed to convert mesh %s of scene %s", qPrintable(meshPath), qPrintable(_filePath));
+        return false;
+      }
+    }
+
+    scene.nodes.push_back(node);
+  }
+
+  _scene = std::move(scene);
+
+  return true;
+}
+
+/**
+ * @note the packet (scratch buffers) is reused across the worker's tiles
+ *
+ * @param[in] _scene
+ * @param[in] _settings
+ * @param[in] _tileX
+ * @param[in] _tileY
+ * @param[in,out] _packet
+ * @param[out] _bits RGB32 image data
+ * @param[in] _bytesPerLine
+ */
+void Raymarcher::renderTile(
+  const ir::Scene &_scene,
+  const Settings &_settings,
+  int _tileX,
+  int _tileY,
+  Packet &_packet,
+  uchar *_bits,
+  int _bytesPerLine
+)
+{
+  const auto &tileSize = constants::raymarcher::tileSize;
+
+  const auto &minX = _tileX * tileSize;
+  const auto &minY = _tileY * tileSize;
+  const auto maxX = std::min(minX + tileSize, _settings.width);
+  const auto maxY = std::min(minY + tileSize, _settings.height);
+
+  _packet.origins.clear();
+  _packet.directions.clear();
+
+  for(auto y = minY; y < maxY; y++)
+  {
+    for(auto x = minX; x < maxX; x++)
+    {
+      QVector3D origin;
+      QVector3D direction;
+
+      // gl_FragCoord (pixel center, Vulkan: top left origin)
+      setupRay(_settings, (float) x + 0.5f, (float) y + 0.5f, origin, direction);
+
+      _packet.origins.push_back(origin);
+      _packet.directions.push_back(direction);
+    }
+  }
+
+  castRays(_scene, _settings, _packet);
+  calcNormals(_packet.scene, _packet);
+  calcSoftShadows(_scene, _packet, true, _packet.shadowDif);
+  calcSoftShadows(_scene, _packet, false, _packet.shadowDom);
+  calcAO(_scene, _packet);
+
+  const auto &width = maxX - minX;
+  auto hit = 0;
+
+  for(auto y = minY; y < maxY; y++)
+  {
+    auto *scanLine = reinterpret_cast<QRgb*>(_bits + (size_t) y * (size_t) _bytesPerLine);
+
+    for(auto x = minX; x < maxX; x++)
+    {
+      const auto &ray = (uint32_t) ((y - minY) * width + (x - minX));
+      const auto &isHit = hit < (int) _packet.hits.size() && _packet.hits[hit] == ray;
+
+      const auto &color = shade(_packet, ray, isHit ? hit++ : -1);
+
+      scanLine[x] = qRgb(
+        qRound(color.x() * 255.0f),
+        qRound(color.y() * 255.0f),
+        qRound(color.z() * 255.0f)
+      );
+    }
+  }
+}
@@ -0,0 +1,491 @@
+/*****************************************************
+ * Partial Class: Raymarcher
+ * Members: Packet Helpers (Private)
+ *
+ * CPU counterparts of sdfr_pass.frag's
+ * setupRay, castRay, calcNormal, softshadow,
+ * calcAO and render, marching all active rays
+ * of a packet with a single batched query per step
+ *****************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "SDFGraph/Raymarcher.hpp"
+
+using namespace sdfRay4d::sdfGraph;
+
+namespace
+{
+  const QVector3D keyLight = QVector3D(-0.4f, 0.7f, -0.6f).normalized();
+
+  inline void pushPoint(Evaluator::Points &_points, const QVector3D &_pos)
+  {
+    _points.push_back({ _pos.x(), _pos.y(), _pos.z() });
+  }
+
+  inline QVector3D reflect(const QVector3D &_incident, const QVector3D &_normal)
+  {
+    return _incident - 2.0f * QVector3D::dotProduct(_normal, _incident) * _normal;
+  }
+
+  inline float smoothstep(float _edge0, float _edge1, float _x)
+  {
+    const auto t = std::clamp((_x - _edge0) / (_edge1 - _edge0), 0.0f, 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+  }
+
+  inline QVector3D mix(const QVector3D &_a, const QVector3D &_b, float _t)
+  {
+    return _a + (_b - _a) * _t;
+  }
+}
+
+/**
+ *
+ * @param[in] _settings
+ * @param[in] _fragX gl_FragCoord.x
+ * @param[in] _fragY gl_FragCoord.y
+ * @param[out] _origin
+ * @param[out] _direction
+ */
+void Raymarcher::setupRay(
+  const Settings &_settings,
+  float _fragX,
+  float _fragY,
+  QVector3D &_origin,
+  QVector3D &_direction
+)
+{
+  const auto &width   = (float) _settings.width;
+  const auto &height  = (float) _settings.height;
+
+  const auto &moX     = _settings.mouseX / width;
+  const auto &moY     = _settings.mouseY / height;
+  const auto &time    = 15.0f + _settings.time;
+
+  const auto &px      = (-width + 2.0f * _fragX) / height;
+  const auto &py      = -(-height + 2.0f * _fragY) / height;
+
+  _origin = {
+    -0.5f + 3.5f * std::cos(0.1f * time + 6.0f * moX),
+    1.0f + 6.0f * moY,
+    0.5f + 4.0f * std::sin(0.1f * time + 6.0f * moX)
+  };
+
+  // setCamera (cr = 0)
+  const QVector3D target(-0.5f, -0.4f, 0.5f);
+  const auto &cw = (target - _origin).normalized();
+  const auto &cu = QVector3D::crossProduct(cw, QVector3D(0.0f, 1.0f, 0.0f)).normalized();
+  const auto &cv = QVector3D::crossProduct(cu, cw).normalized();
+
+  const auto &dir = QVector3D(px, py, 2.0f).normalized();
+
+  _direction = cu * dir.x() + cv * dir.y() + cw * dir.z();
+}
+
+/**
+ * @brief castRay for all rays of the packet
+ *
+ * @note the hits are collected in ray order
+ *
+ * @note over-relaxed sphere tracing, i.e. steps back to a plain sphere
+ * tracing step (per ray) once the unbounding spheres don't overlap
+ *
+ * @note the rays march the scene specialized to the tile's frustum
+ * segment (the bounds of the rays' [tMin, tMax] segments), which is kept
+ * in the packet for the normals at the hits (see Evaluator::specialize)
+ *
+ * @param[in] _scene
+ * @param[in] _settings
+ * @param[in,out] _packet
+ */
+void Raymarcher::castRays(
+  const ir::Scene &_scene,
+  const Settings &_settings,
+  Packet &_packet
+)
+{
+  const auto &rayCount = _packet.origins.size();
+
+  _packet.t.resize(rayCount);
+  _packet.tMax.resize(rayCount);
+  _packet.materials.assign(rayCount, -1.0f);
+  _packet.omega.assign(rayCount, std::max(_settings.relaxation, 1.0f));
+  _packet.prevRadius.assign(rayCount, 0.0f);
+  _packet.stepLength.assign(rayCount, 0.0f);
+  _packet.active.resize(rayCount);
+
+  for(auto ray = 0u; ray < rayCount; ray++)
+  {
+    const auto &origin    = _packet.origins[ray];
+    const auto &direction = _packet.directions[ray];
+
+    auto tMin = 1.0f;
+    auto tMax = 20.0f;
+
+    // bounding volume
+    const auto &tp1 = (0.0f - origin.y()) / direction.y();
+    if(tp1 > 0.0f) tMax = std::min(tMax, tp1);
+
+    const auto &tp2 = (1.6f - origin.y()) / direction.y();
+    if(tp2 > 0.0f)
+    {
+      if(origin.y() > 1.6f) tMin = std::max(tMin, tp2);
+      else tMax = std::min(tMax, tp2);
+    }
+
+    _packet.t[ray]      = tMin;
+    _packet.tMax[ray]   = tMax;
+    _packet.active[ray] = ray;
+  }
+
+  specialize(_scene, _settings, _packet);
+
+  const auto &termCount = 1 + _packet.scene.nodes.size();
+
+  for(auto step = 0; step < 64 && !_packet.active.empty(); step++)
+  {
+    _packet.points.clear();
+
+    for(const auto &ray : _packet.active)
+    {
+      pushPoint(_packet.points, _packet.origins[ray] + _packet.directions[ray] * _packet.t[ray]);
+    }
+
+    evaluate(_packet.scene, _packet);
+
+    _packet.marchSteps += _packet.active.size();
+    _packet.termSteps += _packet.active.size() * termCount;
+
+    size_t activeCount = 0;
+
+    for(size_t i = 0; i < _packet.active.size(); i++)
+    {
+      const auto &ray = _packet.active[i];
+      const auto &t = _packet.t[ray];
+      const auto &distance = _packet.distances[i];
+
+      auto &omega = _packet.omega[ray];
+      auto &stepLength = _packet.stepLength[ray];
+
+      if(omega > 1.0f && distance + _packet.prevRadius[ray] < stepLength)
+      {
+        stepLength = _packet.prevRadius[ray] - stepLength;
+        omega = 1.0f;
+      }
+      else
+      {
+        if(distance < 0.0005f * t || t > _packet.tMax[ray]) continue;
+
+        stepLength = omega * distance;
+
+        // a relaxed step can't leave the segment (nor the specialized scene's
+        // bounds), a plain one past it can't miss a surface within it
+        if(t + stepLength > _packet.tMax[ray]) stepLength = distance;
+
+        _packet.prevRadius[ray] = distance;
+        _packet.materials[ray] = _packet.sampleMaterials[i];
+      }
+
+      _packet.t[ray] += stepLength;
+      _packet.active[activeCount++] = ray;
+    }
+
+    _packet.active.resize(activeCount);
+  }
+
+  _packet.hits.clear();
+
+  for(auto ray = 0u; ray < rayCount; ray++)
+  {
+    if(_packet.t[ray] > _packet.tMax[ray]) _packet.materials[ray] = -1.0f;
+    if(_packet.materials[ray] > -0.5f) _packet.hits.push_back(ray);
+  }
+}
+
+/**
+ * @brief specializes the scene to the tile's frustum segment
+ *
+ * @note the bounds of the rays' segments contain every point the rays
+ * are marched to within them, padded by the normals' offsets
+ *
+ * @param[in] _scene
+ * @param[in] _settings
+ * @param[in,out] _packet
+ */
+void Raymarcher::specialize(
+  const ir::Scene &_scene,
+  const Settings &_settings,
+  Packet &_packet
+)
+{
+  if(!_settings.isSpecialized || _packet.active.empty())
+  {
+    _packet.scene = _scene;
+    return;
+  }
+
+  Evaluator::Bounds bounds;
+  bounds.min = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+  bounds.max = { -bounds.min[0], -bounds.min[1], -bounds.min[2] };
+
+  for(const auto &ray : _packet.active)
+  {
+    const auto &origin    = _packet.origins[ray];
+    const auto &direction = _packet.directions[ray];
+
+    for(const auto &t : { _packet.t[ray], _packet.tMax[ray] })
+    {
+      const auto &point = origin + direction * t;
+
+      for(auto axis = 0; axis < 3; axis++)
+      {
+        bounds.min[axis] = std::min(bounds.min[axis], point[axis]);
+        bounds.max[axis] = std::max(bounds.max[axis], point[axis]);
+      }
+    }
+  }
+
+  for(auto axis = 0; axis < 3; axis++)
+  {
+    bounds.min[axis] -= 0.001f;
+    bounds.max[axis] += 0.001f;
+  }
+
+  _packet.scene = Evaluator::specialize(_scene, bounds);
+}
+
+/**
+ * @note tetrahedral differences (4 map() evaluations per hit)
+ *
+ * @param[in] _scene
+ * @param[in,out] _packet
+ */
+void Raymarcher::calcNormals(const ir::Scene &_scene, Packet &_packet)
+{
+  const auto &hitCount = _packet.hits.size();
+  const auto &e = 0.5773f * 0.0005f;
+
+  const QVector3D offsets[4] = {
+    {  e, -e, -e },
+    { -e, -e,  e },
+    { -e,  e, -e },
+    {  e,  e,  e }
+  };
+
+  _packet.positions.resize(hitCount);
+  _packet.normals.resize(hitCount);
+  _packet.reflections.resize(hitCount);
+  _packet.points.clear();
+
+  for(size_t hit = 0; hit < hitCount; hit++)
+  {
+    const auto &ray = _packet.hits[hit];
+
+    _packet.positions[hit] = _packet.origins[ray] + _packet.directions[ray] * _packet.t[ray];
+
+    for(const auto &offset : offsets)
+    {
+      pushPoint(_packet.points, _packet.positions[hit] + offset);
+    }
+  }
+
+  evaluate(_scene, _packet);
+
+  for(size_t hit = 0; hit < hitCount; hit++)
+  {
+    QVector3D gradient;
+
+    for(auto i = 0; i < 4; i++)
+    {
+      gradient += offsets[i] * _packet.distances[hit * 4 + i];
+    }
+
+    _packet.normals[hit] = gradient.normalized();
+    _packet.reflections[hit] = reflect(_packet.directions[_packet.hits[hit]], _packet.normals[hit]);
+  }
+}
+
+/**
+ * @brief softshadow( pos, dir, 0.02, 2.5 ) for all hits of the packet
+ *
+ * @param[in] _scene
+ * @param[in,out] _packet
+ * @param[in] _isKeyLight key light (dif) or reflection (dom) direction
+ * @param[out] _shadows per hit
+ */
+void Raymarcher::calcSoftShadows(
+  const ir::Scene &_scene,
+  Packet &_packet,
+  bool _isKeyLight,
+  std::vector<float> &_shadows
+)
+{
+  const auto &hitCount = _packet.hits.size();
+
+  _shadows.assign(hitCount, 1.0f);
+  _packet.shadowT.assign(hitCount, 0.02f);
+  _packet.active.resize(hitCount);
+
+  for(auto hit = 0u; hit < hitCount; hit++) _packet.active[hit] = hit;
+
+  _packet.shadowRays += hitCount;
+
+  for(auto step = 0; step < 16 && !_packet.active.empty(); step++)
+  {
+    _packet.points.clear();
+
+    for(const auto &hit : _packet.active)
+    {
+      const auto &direction = _isKeyLight ? keyLight : _packet.reflections[hit];
+
+      pushPoint(_packet.points, _packet.positions[hit] + direction * _packet.shadowT[hit]);
+    }
+
+    evaluate(_scene, _packet);
+
+    size_t activeCount = 0;
+
+    for(size_t i = 0; i < _packet.active.size(); i++)
+    {
+      const auto &hit = _packet.active[i];
+      const auto &h = _packet.distances[i];
+      auto &t = _packet.shadowT[hit];
+
+      _shadows[hit] = std::min(_shadows[hit], 8.0f * h / t);
+      t += std::clamp(h, 0.02f, 0.10f);
+
+      if(h < 0.001f || t > 2.5f) continue;
+
+      _packet.active[activeCount++] = hit;
+    }
+
+    _packet.active.resize(activeCount);
+  }
+
+  for(auto &shadow : _shadows) shadow = std::clamp(shadow, 0.0f, 1.0f);
+}
+
+/**
+ *
+ * @param[in] _scene
+ * @param[in,out] _packet
+ */
+void Raymarcher::calcAO(const ir::Scene &_scene, Packet &_packet)
+{
+  const auto &hitCount = _packet.hits.size();
+
+  _packet.occlusion.assign(hitCount, 0.0f);
+  _packet.points.clear();
+
+  for(auto i = 0; i < 5; i++)
+  {
+    const auto &hr = 0.01f + 0.12f * (float) i / 4.0f;
+
+    for(size_t hit = 0; hit < hitCount; hit++)
+    {
+      pushPoint(_packet.points, _packet.normals[hit] * hr + _packet.positions[hit]);
+    }
+  }
+
+  evaluate(_scene, _packet);
+
+  auto sca = 1.0f;
+
+  for(auto i = 0; i < 5; i++)
+  {
+    const auto &hr = 0.01f + 0.12f * (float) i / 4.0f;
+
+    for(size_t hit = 0; hit < hitCount; hit++)
+    {
+      _packet.occlusion[hit] += -(_packet.distances[i * hitCount + hit] - hr) * sca;
+    }
+
+    sca *= 0.95f;
+  }
+
+  for(auto &occ : _packet.occlusion) occ = std::clamp(1.0f - 3.0f * occ, 0.0f, 1.0f);
+}
+
+/**
+ * @brief render() (material and lighting) and gamma of a ray
+ *
+ * @param[in] _packet
+ * @param[in] _ray
+ * @param[in] _hit index of the ray's hit, -1 if missed
+ * @return color
+ */
+QVector3D Raymarcher::shade(const Packet &_packet, uint32_t _ray, int _hit)
+{
+  const auto &rd = _packet.directions[_ray];
+
+  auto col = QVector3D(0.7f, 0.9f, 1.0f) + QVector3D(1.0f, 1.0f, 1.0f) * (rd.y() * 0.8f);
+
+  if(_hit >= 0)
+  {
+    const auto &t   = _packet.t[_ray];
+    const auto &m   = _packet.materials[_ray];
+    const auto &pos = _packet.positions[_hit];
+    const auto &nor = _packet.normals[_hit];
+    const auto &ref = _packet.reflections[_hit];
+
+    // material
+    col = QVector3D(
+      0.45f + 0.35f * std::sin(0.05f * (m - 1.0f)),
+      0.45f + 0.35f * std::sin(0.08f * (m - 1.0f)),
+      0.45f + 0.35f * std::sin(0.10f * (m - 1.0f))
+    );
+
+    if(m < 1.5f)
+    {
+      const auto &checker = std::floor(5.0f * pos.z()) + std::floor(5.0f * pos.x());
+      const auto &f = checker - 2.0f * std::floor(checker / 2.0f); // mod( checker, 2.0 )
+
+      col = QVector3D(1.0f, 1.0f, 1.0f) * (0.3f + 0.1f * f);
+    }
+
+    // lighting
+    const auto &occ = _packet.occlusion[_hit];
+    const auto amb = std::clamp(0.5f + 0.5f * nor.y(), 0.0f, 1.0f);
+    const auto dom = smoothstep(-0.1f, 0.1f, ref.y()) * _packet.shadowDom[_hit];
+    const auto fre = std::pow(std::clamp(1.0f + QVector3D::dotProduct(nor, rd), 0.0f, 1.0f), 2.0f);
+    const auto spe = std::pow(std::clamp(QVector3D::dotProduct(ref, keyLight), 0.0f, 1.0f), 16.0f);
+    const auto dif =
+      std::clamp(QVector3D::dotProduct(nor, keyLight), 0.0f, 1.0f) *
+      _packet.shadowDif[_hit];
+    const auto bac =
+      std::clamp(QVector3D::dotProduct(nor, QVector3D(-keyLight.x(), 0.0f, -keyLight.z()).normalized()), 0.0f, 1.0f) *
+      std::clamp(1.0f - pos.y(), 0.0f, 1.0f);
+
+    QVector3D lin;
+    lin += 1.30f * dif * QVector3D(1.00f, 0.80f, 0.55f);
+    lin += 2.00f * spe * QVector3D(1.00f, 0.90f, 0.70f) * dif;
+    lin += 0.40f * amb * QVector3D(0.40f, 0.60f, 1.00f) * occ;
+    lin += 0.50f * dom * QVector3D(0.40f, 0.60f, 1.00f) * occ;
+    lin += 0.50f * bac * QVector3D(0.25f, 0.25f, 0.25f) * occ;
+    lin += 0.25f * fre * QVector3D(1.00f, 1.00f, 1.00f) * occ;
+    col = col * lin;
+
+    col = mix(col, QVector3D(0.8f, 0.9f, 1.0f), 1.0f - std::exp(-0.0002f * t * t * t));
+  }
+
+  // clamp & gamma
+  return {
+    std::pow(std::clamp(col.x(), 0.0f, 1.0f), 0.4545f),
+    std::pow(std::clamp(col.y(), 0.0f, 1.0f), 0.4545f),
+    std::pow(std::clamp(col.z(), 0.0f, 1.0f), 0.4545f)
+  };
+}
+
+/**
+ * @brief batched map() of the packet's points (distances, sampleMaterials)
+ *
+ * @param[in] _scene
+ * @param[in,out] _packet
+ */
+void Raymarcher::evaluate(const ir::Scene &_scene, Packet &_packet)
+{
+  Evaluator::distances(_scene, _packet.points, _packet.distances, &_packet.sampleMaterials);
+}
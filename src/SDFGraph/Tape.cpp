@@ -0,0 +1,231 @@
+/*****************************************************
+ * Class: Tape (General)
+ * Members: General Functions (Public/Private)
+ * Partials: None
+ *****************************************************/
+
+#include <cmath>
+#include <cstring>
+
+#include <QtGlobal>
+
+#include "_constants.hpp"
+#include "SDFGraph/Tape.hpp"
+#include "SDFGraph/Evaluator.hpp"
+
+using namespace sdfRay4d::sdfGraph;
+
+namespace
+{
+  namespace tape = sdfRay4d::constants::tape;
+
+  /**
+   * @param[in] _value
+   * @return float bits (uintBitsToFloat in the shader)
+   */
+  uint32_t toBits(float _value) noexcept
+  {
+    uint32_t bits;
+    std::memcpy(&bits, &_value, sizeof(bits));
+
+    return bits;
+  }
+}
+
+/**
+ * @note mirrors the expression emitted by CodeGen::generateMap:
+ * op_n( ... op_1(opUnion(base, brickMap), p_1) ..., p_n )
+ *
+ * @param[in] _scene
+ * @return tape, nullptr if it exceeds the shader's capacity
+ * (the specialized shader is compiled right away instead)
+ */
+Tape::DataPtr Tape::generate(const ir::Scene &_scene)
+{
+  Data data(tape::headerSize, 0);
+  data.reserve(
+    tape::headerSize +
+    (2 * _scene.nodes.size() + 4) * tape::instructionSize +
+    _scene.nodes.size() * tape::nodeSize
+  );
+
+  Data nodes;
+  nodes.reserve(_scene.nodes.size() * tape::nodeSize);
+
+  const auto &getCount = [&data]()
+  {
+    return (uint32_t) ((data.size() - tape::headerSize) / tape::instructionSize);
+  };
+
+  ir::Vec3 position = {};
+  auto depth = 1;
+
+  appendPrimitive(data, _scene.base, position);
+
+  if(_scene.hasBrickMap)
+  {
+    append(data, Opcode::BrickMap);
+    append(data, Opcode::Union);
+
+    depth = 2;
+  }
+
+  for(const auto &node : _scene.nodes)
+  {
+    const auto &first = getCount();
+
+    appendPrimitive(data, node.primitive, position);
+
+    switch(node.operation)
+    {
+      case ir::OperationType::Union:        append(data, Opcode::Union); break;
+      case ir::OperationType::Subtraction:  append(data, Opcode::Subtraction); break;
+    }
+
+    appendNode(nodes, node.primitive, first, getCount());
+
+    depth = 2;
+  }
+
+  const auto &count = getCount();
+
+  if(
+    count > (uint32_t) tape::maxInstructions ||
+    _scene.nodes.size() > (size_t) tape::maxNodes ||
+    depth > tape::stackSize
+  )
+  {
+    qWarning("Scene tape (%u instructions) exceeds the shader's capacity", count);
+    return nullptr;
+  }
+
+  data[0] = count;
+  data[1] = (uint32_t) depth;
+  data[2] = (uint32_t) _scene.nodes.size();
+
+  data.insert(data.end(), nodes.begin(), nodes.end());
+
+  return std::make_shared<const Data>(std::move(data));
+}
+
+/**
+ * @note the translation is part of the record, as the node's instructions
+ * only translate the position if it differs from the previous primitive's
+ *
+ * @note the bounding sphere encloses the primitive's bounds, planes
+ * are unbounded (negative radius), i.e. binned to every tile
+ *
+ * @param[in] _nodes node table
+ * @param[in] _primitive
+ * @param[in] _first instruction of the node
+ * @param[in] _end instruction after the node's operation
+ */
+void Tape::appendNode(
+  Data &_nodes,
+  const ir::Primitive &_primitive,
+  uint32_t _first,
+  uint32_t _end
+)
+{
+  const auto &bounds = Evaluator::getBounds(_primitive);
+
+  ir::Vec3 center;
+  auto radius = 0.0f;
+
+  for(auto axis = 0; axis < 3; axis++)
+  {
+    const auto &halfSize = 0.5f * (bounds.max[axis] - bounds.min[axis]);
+
+    center[axis] = bounds.min[axis] + halfSize;
+    radius += halfSize * halfSize;
+  }
+
+  radius = _primitive.type == ir::PrimitiveType::Plane
+    ? -1.0f
+    : std::sqrt(radius);
+
+  const auto &translation = _primitive.position;
+
+  _nodes.insert(_nodes.end(), {
+    _first,
+    _end,
+    0,
+    0,
+    toBits(translation[0]),
+    toBits(translation[1]),
+    toBits(translation[2]),
+    0,
+    toBits(center[0]),
+    toBits(center[1]),
+    toBits(center[2]),
+    toBits(radius)
+  });
+}
+
+/**
+ * @note the translation is only emitted if it differs from the previous
+ * primitive's, i.e. it's a register rather than part of every primitive
+ *
+ * @param[in] _data
+ * @param[in] _primitive
+ * @param[in,out] _position translation of the previous primitive
+ */
+void Tape::appendPrimitive(
+  Data &_data,
+  const ir::Primitive &_primitive,
+  ir::Vec3 &_position
+)
+{
+  if(_primitive.position != _position)
+  {
+    append(_data, Opcode::Translate, 0.0f, _primitive.position);
+
+    _position = _primitive.position;
+  }
+
+  const auto &material = _primitive.material;
+  const auto &dimensions = _primitive.dimensions;
+
+  switch(_primitive.type)
+  {
+    case ir::PrimitiveType::Sphere: append(_data, Opcode::Sphere, material, dimensions); break;
+    case ir::PrimitiveType::Box:    append(_data, Opcode::Box, material, dimensions); break;
+    case ir::PrimitiveType::Torus:  append(_data, Opcode::Torus, material, dimensions); break;
+    case ir::PrimitiveType::Mesh:
+    {
+      // scaled down to a 1-Lipschitz bound (see MeshSDF::getLipschitz, CodeGen::toBounded)
+      const auto &lipschitz = _primitive.volume ? _primitive.volume->lipschitz : 1.0f;
+
+      append(_data, Opcode::Mesh, material, { dimensions[0], 1.0f / lipschitz, 0.0f });
+      break;
+    }
+    case ir::PrimitiveType::Plane:
+    default:                        append(_data, Opcode::Plane, material); break;
+  }
+}
+
+/**
+ *
+ * @param[in] _data
+ * @param[in] _opcode
+ * @param[in] _material pushed along with the distance (primitives only)
+ * @param[in] _operand
+ */
+void Tape::append(
+  Data &_data,
+  Opcode _opcode,
+  float _material,
+  const ir::Vec3 &_operand
+)
+{
+  _data.insert(_data.end(), {
+    (uint32_t) _opcode,
+    toBits(_material),
+    0,
+    0,
+    toBits(_operand[0]),
+    toBits(_operand[1]),
+    toBits(_operand[2]),
+    0
+  });
+}
@@ -11,12 +11,25 @@
  *
  * Partials:
  * - compile_helpers.cpp
+ * - optimizer_helpers.cpp
  *****************************************************/
 
+#include <chrono>
+
 #include "SPIRVCompiler.hpp"
 
 using namespace sdfRay4d;
 
+SPIRVCompiler::Library::~Library()
+{
+  QMutexLocker locker(&m_compileMutex);
+
+  shader.reset();
+
+  // releases the reference taken by createLibrary
+  glslang::FinalizeProcess();
+}
+
 /**
  * @brief Compiles GLSL to SPIRV bytecode
  * @param[in]       _stage The Vulkan shader stage flag
@@ -36,87 +49,143 @@ bool SPIRVCompiler::compile(
   const std::string &_entryPoint
 ) noexcept
 {
-  glslang::InitializeProcess();
+  Options options;
+  options.entryPoint = _entryPoint;
 
-    auto messages = (EShMessages) (
-        EShMsgDefault
-      | EShMsgVulkanRules
-      | EShMsgSpvRules
-    );
-    auto language = getShaderLang(_stage);
-    auto source = std::string(_glslSource.begin(), _glslSource.end());
-    const char *fileNames[1]  = { "" };
-    const char *shaderSrc     = source.data();
-
-    glslang::TShader shader(language);
-
-    shader.setStringsWithLengthsAndNames(
-      &shaderSrc,
-      nullptr,
-      fileNames,
-      1
-    );
-    shader.setEntryPoint(_entryPoint.c_str());
-    shader.setSourceEntryPoint(_entryPoint.c_str());
-
-    if(
-      !shader.parse(
-        &glslang::DefaultTBuiltInResource, 100,
-        false, messages
-      )
-    )
-    {
-      _log =  std::string(shader.getInfoLog()) + "\n" +
-              std::string(shader.getInfoDebugLog());
+  return compile(_stage, _glslSource, options, _spvBytes, _log);
+}
 
-      return false;
-    }
+/**
+ * @brief Compiles GLSL to SPIRV bytecode, linked against the library
+ * (if any) and optimized (see Optimization)
+ *
+ * @note only the passed source is parsed, i.e. the compile time scales
+ * with it and not with the library. The library's declarations have to
+ * be part of the source (see Library::declarations).
+ *
+ * @note the optimizer runs outside of the compile lock, a failed
+ * optimization keeps the unoptimized module
+ *
+ * @param[in]       _stage The Vulkan shader stage flag
+ * @param[in]       _glslSource The GLSL source code to be compiled
+ * @param[in]       _options library (created for the same stage), optimization, entry point
+ * @param[in,out]   _spvBytes The generated SPIRV code
+ * @param[in,out]   _log Stores any log messages during the compilation process
+ * @param[out]      _stats (optional) compile/optimize times & instruction counts
+ * @return boolean
+ */
+bool SPIRVCompiler::compile(
+  const shader::StageFlagBits &_stage,
+  const QByteArray &_glslSource,
+  const Options &_options,
+  std::vector<std::uint32_t> &_spvBytes,
+  std::string &_log,
+  Stats *_stats
+) noexcept
+{
+  const auto &language = getShaderLang(_stage);
+  const auto &library = _options.library;
 
-    glslang::TProgram program;
+  if(library && library->language != language)
+  {
+    _log = "Library was created for a different shader stage.\n";
 
-    // Add shader to new program object.
-    program.addShader(&shader);
+    return false;
+  }
 
-    // Link program.
-    if (!program.link(messages))
-    {
-      _log =  std::string(program.getInfoLog()) + "\n" +
-              std::string(program.getInfoDebugLog());
+  const auto &startTime = std::chrono::steady_clock::now();
 
-      return false;
-    }
+  {
+    QMutexLocker locker(&m_compileMutex);
 
-    // Save any log that was generated.
-    if (shader.getInfoLog())
-    {
-      _log += std::string(shader.getInfoLog()) + "\n" +
-              std::string(shader.getInfoDebugLog()) + "\n";
-    }
+    glslang::InitializeProcess();
 
-    if (program.getInfoLog())
-    {
-      _log += std::string(program.getInfoLog()) + "\n" +
-              std::string(program.getInfoDebugLog());
-    }
+    const auto &isLinked = link(
+      language,
+      _glslSource,
+      library ? library->shader.get() : nullptr,
+      _spvBytes,
+      _log,
+      _options.entryPoint
+    );
 
-    // Translates to SPIRV
-    auto intermediate = program.getIntermediate(language);
+    // kill glslang process
+    glslang::FinalizeProcess();
 
-    if (!intermediate)
-    {
-      _log += "Failed to get shared intermediate code.\n";
+    if(!isLinked) return false;
+  }
 
-      return false;
-    }
+  const auto &optimizeTime = std::chrono::steady_clock::now();
+  const auto &instructionCount = getInstructionCount(_spvBytes);
 
-    spv::SpvBuildLogger logger;
+  optimize(_options, _spvBytes, _log);
 
-    glslang::GlslangToSpv(*intermediate, _spvBytes, &logger);
+  if(_stats)
+  {
+    const std::chrono::duration<double> &compileDuration = optimizeTime - startTime;
+    const std::chrono::duration<double> &optimizeDuration = std::chrono::steady_clock::now() - optimizeTime;
 
-    _log += logger.getAllMessages() + "\n";
+    Stats stats;
+    stats.compileSeconds            = compileDuration.count();
+    stats.optimizeSeconds           = optimizeDuration.count();
+    stats.instructionCount          = instructionCount;
+    stats.optimizedInstructionCount = getInstructionCount(_spvBytes);
 
-  // kill glslang process
-  glslang::FinalizeProcess();
+    *_stats = stats;
+  }
 
   return true;
 }
+
+/**
+ * @brief parses the library source (functions only) once, to be linked
+ * into the shaders compiled against it
+ *
+ * @param[in]       _stage The Vulkan shader stage flag
+ * @param[in]       _glslSource including its #version directive
+ * @param[in,out]   _log Stores any log messages during the parse
+ * @return library, nullptr if it failed to parse
+ */
+SPIRVCompiler::LibraryPtr SPIRVCompiler::createLibrary(
+  const shader::StageFlagBits &_stage,
+  const QByteArray &_glslSource,
+  std::string &_log
+) noexcept
+{
+  auto library = std::make_shared<Library>(); // outlives the locker (see ~Library)
+
+  QMutexLocker locker(&m_compileMutex);
+
+  // released by the library (keeps the built-in symbol tables alive)
+  glslang::InitializeProcess();
+
+  library->language     = getShaderLang(_stage);
+  library->source       = _glslSource.toStdString();
+  library->declarations = getDeclarations(library->source);
+  library->shader       = std::make_unique<glslang::TShader>(library->language);
+
+  const char *fileNames[1]  = { "library" };
+  const char *shaderSrc     = library->source.data();
+
+  library->shader->setStringsWithLengthsAndNames(
+    &shaderSrc,
+    nullptr,
+    fileNames,
+    1
+  );
+
+  if(
+    !library->shader->parse(
+      &glslang::DefaultTBuiltInResource, 100,
+      false, getMessages()
+    )
+  )
+  {
+    _log =  std::string(library->shader->getInfoLog()) + "\n" +
+            std::string(library->shader->getInfoDebugLog());
+
+    return nullptr;
+  }
+
+  return library;
+}
@@ -3,6 +3,9 @@
  * Members: Compile Helpers (Private)
  *****************************************************/
 
+#include <algorithm>
+#include <cctype>
+
 #include "SPIRVCompiler.hpp"
 
 using namespace sdfRay4d;
@@ -36,4 +39,196 @@ EShLanguage SPIRVCompiler::getShaderLang(
   }
 }
 
+/**
+ *
+ * @return EShMessages
+ */
+EShMessages SPIRVCompiler::getMessages() noexcept
+{
+  return (EShMessages) (
+      EShMsgDefault
+    | EShMsgVulkanRules
+    | EShMsgSpvRules
+  );
+}
+
+/**
+ * @brief prototypes of the functions defined (at global scope) in the source,
+ * skipping comments and preprocessor directives
+ *
+ * @param[in] _glslSource
+ * @returns declarations, e.g. "float sdSphere( vec3 p, vec3 s );"
+ */
+QByteArray SPIRVCompiler::getDeclarations(const std::string &_glslSource) noexcept
+{
+  QByteArray declarations;
+  std::string statement; // global scope text since the last statement/definition
+
+  auto depth = 0;
+  auto isLineStart = true;
+
+  for(size_t i = 0; i < _glslSource.size(); i++)
+  {
+    const auto &c = _glslSource[i];
+    const auto &next = i + 1 < _glslSource.size() ? _glslSource[i + 1] : '\0';
+
+    if(c == '/' && next == '/')
+    {
+      i = std::min(_glslSource.find('\n', i), _glslSource.size()) - 1;
+      continue;
+    }
+
+    if(c == '/' && next == '*')
+    {
+      i = std::min(_glslSource.find("*/", i + 2), _glslSource.size() - 2) + 1;
+      statement += ' ';
+      continue;
+    }
+
+    if(c == '#' && isLineStart)
+    {
+      i = std::min(_glslSource.find('\n', i), _glslSource.size()) - 1;
+      continue;
+    }
+
+    if(c == '\n') isLineStart = true;
+    else if(!std::isspace((unsigned char) c)) isLineStart = false;
+
+    if(c == '{' && depth++ == 0)
+    {
+      const auto &begin = statement.find_first_not_of(" \t\r\n");
+      const auto &end = statement.find_last_not_of(" \t\r\n");
+
+      // function definitions only (e.g. not struct definitions)
+      if(begin != std::string::npos && statement[end] == ')')
+      {
+        declarations += QByteArray::fromStdString(statement.substr(begin, end - begin + 1));
+        declarations += ";\n";
+      }
+
+      statement.clear();
+      continue;
+    }
+
+    if(c == '}' && depth > 0)
+    {
+      depth--;
+      continue;
+    }
+
+    if(depth > 0) continue;
+
+    if(c == ';') statement.clear();
+    else statement += c;
+  }
+
+  return declarations;
+}
+
+/**
+ * @brief parses the source and links it (and the library, if any) into SPIRV
+ *
+ * @note the (reused) library unit is shared with every link, which relies on
+ * glslang's linker internals rather than its API: TProgram::linkStage merges
+ * the units into a fresh TIntermediate, which adopts the first unit's tree
+ * and appends the following units' global nodes to it, after remapping
+ * their symbol ids in place (TIntermediate::mergeTrees). Added last, the
+ * library's own tree isn't restructured, only its nodes' ids are rewritten
+ * per link (never relied on afterwards), hence links are serialized
+ * (m_compileMutex). This has to be re-checked whenever glslang is updated
+ * (the externals/glslang submodule isn't pinned), otherwise the library
+ * has to be parsed per link (see createLibrary).
+ *
+ * @param[in]       _language
+ * @param[in]       _glslSource
+ * @param[in]       _library parsed library unit (optional)
+ * @param[in,out]   _spvBytes
+ * @param[in,out]   _log
+ * @param[in]       _entryPoint
+ * @return boolean
+ */
+bool SPIRVCompiler::link(
+  EShLanguage _language,
+  const QByteArray &_glslSource,
+  glslang::TShader *_library,
+  std::vector<std::uint32_t> &_spvBytes,
+  std::string &_log,
+  const std::string &_entryPoint
+) noexcept
+{
+  const auto &messages = getMessages();
+  const auto &source = std::string(_glslSource.begin(), _glslSource.end());
+  const char *fileNames[1]  = { "" };
+  const char *shaderSrc     = source.data();
+
+  glslang::TShader shader(_language);
+
+  shader.setStringsWithLengthsAndNames(
+    &shaderSrc,
+    nullptr,
+    fileNames,
+    1
+  );
+  shader.setEntryPoint(_entryPoint.c_str());
+  shader.setSourceEntryPoint(_entryPoint.c_str());
+
+  if(
+    !shader.parse(
+      &glslang::DefaultTBuiltInResource, 100,
+      false, messages
+    )
+  )
+  {
+    _log =  std::string(shader.getInfoLog()) + "\n" +
+            std::string(shader.getInfoDebugLog());
+
+    return false;
+  }
+
+  glslang::TProgram program;
+
+  // Add shader to new program object.
+  program.addShader(&shader);
+
+  if(_library) program.addShader(_library);
+
+  // Link program.
+  if (!program.link(messages))
+  {
+    _log =  std::string(program.getInfoLog()) + "\n" +
+            std::string(program.getInfoDebugLog());
+
+    return false;
+  }
 
+  // Save any log that was generated.
+  if (shader.getInfoLog())
+  {
+    _log += std::string(shader.getInfoLog()) + "\n" +
+            std::string(shader.getInfoDebugLog()) + "\n";
+  }
+
+  if (program.getInfoLog())
+  {
+    _log += std::string(program.getInfoLog()) + "\n" +
+            std::string(program.getInfoDebugLog());
+  }
+
+  // Translates to SPIRV
+  auto intermediate = program.getIntermediate(_language);
+
+  if (!intermediate)
+  {
+    _log += "Failed to get shared intermediate code.\n";
+
+    return false;
+  }
+
+  spv::SpvBuildLogger logger;
+
+  glslang::GlslangToSpv(*intermediate, _spvBytes, &logger);
+
+  _log += logger.getAllMessages() + "\n";
+
+  return true;
+}
@@ -0,0 +1,124 @@
+/*****************************************************
+ * Partial Class: SPIRVCompiler
+ * Members: Optimizer Helpers (Public/Private)
+ *****************************************************/
+
+#ifdef SPIRV_OPT_ENABLED
+#include <spirv-tools/optimizer.hpp>
+#endif
+
+#include "SPIRVCompiler.hpp"
+
+using namespace sdfRay4d;
+
+/**
+ * PUBLIC
+ *
+ * @brief whether spirv-opt is built in (SPIRV_OPT_ENABLED), otherwise
+ * every Optimization level compiles the same module as OFF
+ *
+ * @return bool
+ */
+bool SPIRVCompiler::isOptimizerAvailable() noexcept
+{
+#ifdef SPIRV_OPT_ENABLED
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief runs spirv-opt (SPIRV-Tools, built with glslang) over the module
+ *
+ * @note the fast passes only clean up what glslang emits (dead functions,
+ * trivial loads/stores, dead code/branches), the full ones (size or
+ * performance recipes) inline, unroll and eliminate across the module,
+ * which matters most on drivers with weak internal optimizers
+ * (e.g. software Vulkan)
+ *
+ * @param[in]       _options
+ * @param[in,out]   _spvBytes replaced by the optimized module on success
+ * @param[in,out]   _log
+ * @return false if the module isn't optimized (failed or unavailable)
+ */
+bool SPIRVCompiler::optimize(
+  const Options &_options,
+  std::vector<std::uint32_t> &_spvBytes,
+  std::string &_log
+) noexcept
+{
+  if(_options.optimization == Optimization::OFF) return false;
+
+#ifdef SPIRV_OPT_ENABLED
+  spvtools::Optimizer optimizer(SPV_ENV_VULKAN_1_0);
+
+  optimizer.SetMessageConsumer([&_log](
+    spv_message_level_t,
+    const char*,
+    const spv_position_t&,
+    const char *_message
+  )
+  {
+    _log += std::string(_message) + "\n";
+  });
+
+  if(_options.isFast)
+  {
+    optimizer
+      .RegisterPass(spvtools::CreateEliminateDeadFunctionsPass())
+      .RegisterPass(spvtools::CreateLocalSingleBlockLoadStoreElimPass())
+      .RegisterPass(spvtools::CreateLocalSingleStoreElimPass())
+      .RegisterPass(spvtools::CreateDeadBranchElimPass())
+      .RegisterPass(spvtools::CreateAggressiveDCEPass());
+  }
+  else if(_options.optimization == Optimization::SIZE)
+  {
+    optimizer.RegisterSizePasses();
+  }
+  else
+  {
+    optimizer.RegisterPerformancePasses();
+  }
+
+  std::vector<std::uint32_t> optimizedBytes;
+
+  if(!optimizer.Run(_spvBytes.data(), _spvBytes.size(), &optimizedBytes))
+  {
+    _log += "Failed to optimize SPIRV, the unoptimized module is used.\n";
+
+    return false;
+  }
+
+  _spvBytes = std::move(optimizedBytes);
+
+  return true;
+#else
+  _log += "SPIRV optimizer is not available (SPIRV_OPT_ENABLED), the unoptimized module is used.\n";
+
+  return false;
+#endif
+}
+
+/**
+ *
+ * @param[in] _spvBytes
+ * @return instructions following the (5 word) module header
+ */
+size_t SPIRVCompiler::getInstructionCount(
+  const std::vector<std::uint32_t> &_spvBytes
+) noexcept
+{
+  size_t count = 0;
+
+  for(size_t i = 5; i < _spvBytes.size(); count++)
+  {
+    const auto &wordCount = _spvBytes[i] >> 16; // high half of the opcode word
+
+    if(wordCount == 0) break;
+
+    i += wordCount;
+  }
+
+  return count;
+}
@@ -10,12 +10,11 @@
  * directory named as the class name
  *
  * Partials:
- * - load_helpers.cpp
+ * - assembler_helpers.cpp
  * - load_overloads.cpp
- * - serializers.cpp
  *****************************************************/
 
-#include <QFile>
+#include "AssetBundle.hpp"
 #include "Shader.hpp"
 
 using namespace sdfRay4d;
@@ -34,7 +33,6 @@ Shader::Shader(
   m_device(_device)
 , m_deviceFuncs(_deviceFuncs)
 , m_stage(_stage)
-, m_template(constants::shaderTmpl)
 {}
 
 /**
@@ -51,6 +49,18 @@ Shader::Data *Shader::getData()
   return &m_data;
 }
 
+/**
+ * @note waits for the pending load (if any)
+ *
+ * @return last loaded module's SPIR-V, empty if none
+ */
+const std::vector<uint32_t> &Shader::getSPIRV()
+{
+  getData();
+
+  return m_spvBytes;
+}
+
 bool Shader::isValid()
 {
   return m_data.isValid();
@@ -62,15 +72,21 @@ void Shader::reset()
   m_isLoading = false;
 }
 
+/**
+ * @note bundled shaders/partials are raw views into the (mapped) asset
+ * bundle, i.e. neither opened nor copied until they're modified
+ *
+ * @param[in] _filePath
+ * @return shader bytes, null if not found
+ */
 QByteArray Shader::getFileBytes(const QString &_filePath)
 {
-  QFile file(_filePath);
+  const auto &bytes = AssetBundle::read(_filePath);
 
-  if (!file.open(QIODevice::ReadOnly))
+  if (bytes.isNull())
   {
     qWarning("Failed to read shader %s", qPrintable(_filePath));
-    return {};
   }
 
-  return file.readAll();
+  return bytes;
 }
@@ -0,0 +1,522 @@
+/*****************************************************
+ * Partial Class: Shader
+ * Members: Source Assembler Helpers (Private)
+ *****************************************************/
+
+#include <chrono>
+#include <cctype>
+#include <cstring>
+
+#include <QHash>
+#include <QVector>
+
+#include "Shader.hpp"
+
+using namespace sdfRay4d;
+
+/**
+ * @brief splits the shader file at the placeholder (if any, the generated
+ * body is inserted there) and appends its fragments, stripped of their
+ * #version directives (only the assembled source declares one)
+ *
+ * @param[in,out] _source
+ * @param[in] _rawBytes shader file bytes
+ * @param[in] _isStrippable its functions are only assembled if used (see getUsedFragments)
+ */
+void Shader::appendFragments(
+  Source &_source,
+  const QByteArray &_rawBytes,
+  bool _isStrippable
+)
+{
+  const auto &placeholderIndex = _source.bodyIndex < 0
+    ? _rawBytes.indexOf(constants::shaderTmpl)
+    : -1;
+
+  if(placeholderIndex < 0)
+  {
+    appendFragment(_source, stripVersionDirectives(_rawBytes), _isStrippable);
+    return;
+  }
+
+  const auto &placeholderSize = (int) std::strlen(constants::shaderTmpl);
+
+  appendFragment(_source, stripVersionDirectives(_rawBytes.left(placeholderIndex)), _isStrippable);
+  _source.bodyIndex = _source.fragments.size();
+  appendFragment(_source, stripVersionDirectives(_rawBytes.mid(placeholderIndex + placeholderSize)), _isStrippable);
+}
+
+/**
+ * @brief appends the bytes as a single fragment, or if strippable, every
+ * global scope function definition/prototype as a separate (named) fragment
+ * and the text in between (declarations, #defines, comments) as is
+ *
+ * @note same global scope scan as SPIRVCompiler::getDeclarations, a statement
+ * followed by a body or ';' is a function if it ends with ')' (and isn't
+ * an initializer, e.g. "const float x = f(1.0);")
+ *
+ * @param[in,out] _source
+ * @param[in] _bytes
+ * @param[in] _isStrippable
+ */
+void Shader::appendFragment(
+  Source &_source,
+  const QByteArray &_bytes,
+  bool _isStrippable
+)
+{
+  if(!_isStrippable)
+  {
+    _source.fragments.append(_bytes);
+    _source.functionNames.append({});
+    return;
+  }
+
+  const auto &size = _bytes.size();
+
+  auto from = 0; // of the text not appended yet
+  auto statementBegin = -1;
+  auto statementLast = -1; // last character outside of comments
+  auto isFunction = false;
+  auto depth = 0;
+  auto isLineStart = true;
+
+  const auto &isFunctionStatement = [&]()
+  {
+    if(statementLast < statementBegin || _bytes[statementLast] != ')') return false;
+
+    const auto &statement = QByteArray::fromRawData(
+      _bytes.constData() + statementBegin,
+      statementLast - statementBegin
+    );
+
+    return !statement.contains('=');
+  };
+
+  const auto &appendFunction = [&](int _end)
+  {
+    // e.g. "float sdSphere( vec3 p, vec3 s )"
+    auto nameEnd = _bytes.indexOf('(', statementBegin);
+
+    while(nameEnd > statementBegin && std::isspace((unsigned char) _bytes[nameEnd - 1])) nameEnd--;
+
+    auto nameBegin = nameEnd;
+
+    while(
+      nameBegin > statementBegin &&
+      (std::isalnum((unsigned char) _bytes[nameBegin - 1]) || _bytes[nameBegin - 1] == '_')
+    ) nameBegin--;
+
+    if(statementBegin > from)
+    {
+      _source.fragments.append(_bytes.mid(from, statementBegin - from));
+      _source.functionNames.append({});
+    }
+
+    _source.fragments.append(_bytes.mid(statementBegin, _end - statementBegin));
+    _source.functionNames.append(_bytes.mid(nameBegin, nameEnd - nameBegin));
+
+    from = _end;
+  };
+
+  for(auto i = 0; i < size; i++)
+  {
+    const auto &c = _bytes[i];
+    const auto &next = i + 1 < size ? _bytes[i + 1] : '\0';
+
+    if(c == '/' && next == '/')
+    {
+      const auto &lineEnd = _bytes.indexOf('\n', i);
+      i = (lineEnd < 0 ? size : lineEnd) - 1;
+      continue;
+    }
+
+    if(c == '/' && next == '*')
+    {
+      const auto &commentEnd = _bytes.indexOf("*/", i + 2);
+      i = (commentEnd < 0 ? size : commentEnd + 2) - 1;
+      continue;
+    }
+
+    if(c == '#' && isLineStart)
+    {
+      const auto &lineEnd = _bytes.indexOf('\n', i);
+      i = (lineEnd < 0 ? size : lineEnd) - 1;
+      continue;
+    }
+
+    if(c == '\n') isLineStart = true;
+    else if(!std::isspace((unsigned char) c)) isLineStart = false;
+
+    if(depth > 0)
+    {
+      if(c == '{') depth++;
+      else if(c == '}' && --depth == 0)
+      {
+        if(isFunction) appendFunction(i + 1);
+
+        statementBegin = -1;
+      }
+
+      continue;
+    }
+
+    if(std::isspace((unsigned char) c)) continue;
+
+    if(statementBegin < 0) statementBegin = i;
+
+    if(c == '{')
+    {
+      isFunction = isFunctionStatement();
+      depth = 1;
+    }
+    else if(c == ';')
+    {
+      if(isFunctionStatement()) appendFunction(i + 1);
+
+      statementBegin = -1;
+    }
+
+    statementLast = i;
+  }
+
+  if(from < size)
+  {
+    _source.fragments.append(_bytes.mid(from));
+    _source.functionNames.append({});
+  }
+}
+
+/**
+ * @brief identifiers outside of comments (incl. in preprocessor
+ * directives, e.g. macros calling functions)
+ *
+ * @param[in] _bytes
+ * @param[in,out] _identifiers
+ */
+void Shader::appendIdentifiers(
+  const QByteArray &_bytes,
+  QSet<QByteArray> &_identifiers
+)
+{
+  const auto &size = _bytes.size();
+
+  for(auto i = 0; i < size; i++)
+  {
+    const auto &c = _bytes[i];
+    const auto &next = i + 1 < size ? _bytes[i + 1] : '\0';
+
+    if(c == '/' && next == '/')
+    {
+      const auto &lineEnd = _bytes.indexOf('\n', i);
+      i = (lineEnd < 0 ? size : lineEnd) - 1;
+      continue;
+    }
+
+    if(c == '/' && next == '*')
+    {
+      const auto &commentEnd = _bytes.indexOf("*/", i + 2);
+      i = (commentEnd < 0 ? size : commentEnd + 2) - 1;
+      continue;
+    }
+
+    // skips numbers' suffixes/exponents (e.g. 1.0e5, 2u)
+    if(std::isdigit((unsigned char) c))
+    {
+      while(i + 1 < size && std::isalnum((unsigned char) _bytes[i + 1])) i++;
+      continue;
+    }
+
+    if(!std::isalpha((unsigned char) c) && c != '_') continue;
+
+    auto end = i + 1;
+
+    while(end < size && (std::isalnum((unsigned char) _bytes[end]) || _bytes[end] == '_')) end++;
+
+    _identifiers.insert(QByteArray::fromRawData(_bytes.constData() + i, end - i));
+
+    i = end - 1;
+  }
+}
+
+/**
+ * @brief identifiers of the lines the preprocessor keeps, i.e. outside
+ * of the #ifdef/#ifndef blocks disabled by the macros defined so far
+ *
+ * @note #if/#elif expressions aren't evaluated, their branches are kept
+ *
+ * @param[in] _bytes
+ * @param[in,out] _preprocessor state, carried over to the next bytes
+ * @param[in,out] _identifiers (optional, e.g. only the state is updated)
+ */
+void Shader::appendEnabledIdentifiers(
+  const QByteArray &_bytes,
+  Preprocessor &_preprocessor,
+  QSet<QByteArray> *_identifiers
+)
+{
+  auto &branches = _preprocessor.branches;
+
+  const auto &isEnabled = [&]()
+  {
+    if(branches.isEmpty()) return true;
+
+    const auto &branch = branches.last();
+
+    return branch.isParentEnabled && (!branch.isEvaluated || branch.isTaken);
+  };
+
+  // e.g. "SDF_GRAPH_MAP" of "#ifndef SDF_GRAPH_MAP", "F" of "#define F(x) ..."
+  const auto &getMacroName = [](const QByteArray &_token)
+  {
+    auto size = 0;
+
+    while(
+      size < _token.size() &&
+      (std::isalnum((unsigned char) _token[size]) || _token[size] == '_')
+    ) size++;
+
+    return _token.left(size);
+  };
+
+  QByteArray enabledBytes;
+  enabledBytes.reserve(_bytes.size());
+
+  for(const auto &line : _bytes.split('\n'))
+  {
+    const auto trimmedLine = line.trimmed();
+
+    if(!trimmedLine.startsWith('#'))
+    {
+      if(isEnabled()) enabledBytes.append(line).append('\n');
+      continue;
+    }
+
+    const auto tokens = trimmedLine.mid(1).simplified().split(' ');
+    const auto directive = tokens.value(0);
+    const auto name = getMacroName(tokens.value(1));
+
+    if(directive == "ifdef" || directive == "ifndef")
+    {
+      const auto &isDefined = _preprocessor.macros.contains(name);
+
+      branches.append({ isEnabled(), true, directive == "ifdef" ? isDefined : !isDefined });
+    }
+    else if(directive == "if")
+    {
+      branches.append({ isEnabled(), false, true });
+    }
+    else if(directive == "elif" && !branches.isEmpty())
+    {
+      branches.last().isEvaluated = false;
+    }
+    else if(directive == "else" && !branches.isEmpty())
+    {
+      branches.last().isTaken = !branches.last().isTaken;
+    }
+    else if(directive == "endif" && !branches.isEmpty())
+    {
+      branches.removeLast();
+    }
+    else if(isEnabled())
+    {
+      if(directive == "define") _preprocessor.macros.insert(name);
+      else if(directive == "undef") _preprocessor.macros.remove(name);
+
+      // e.g. macros calling functions
+      enabledBytes.append(line).append('\n');
+    }
+  }
+
+  if(_identifiers) appendIdentifiers(enabledBytes, *_identifiers);
+}
+
+/**
+ * @brief dead code stripping: the strippable functions reachable
+ * from the body (e.g. the generated map()) and the rest of the source,
+ * i.e. only the primitives/operations the SDF Graph uses and their helpers
+ *
+ * @note functions are matched by name, so all overloads of a used one are kept
+ *
+ * @note the source is scanned in assembly order, so the blocks disabled by
+ * the macros defined so far don't keep the functions they call, e.g. the
+ * tape interpreter once the body defines SDF_GRAPH_MAP (see sdfr_pass.frag)
+ *
+ * @param[in] _source
+ * @param[in] _body
+ * @return per fragment, whether it's assembled
+ */
+std::vector<bool> Shader::getUsedFragments(
+  const Source &_source,
+  const QByteArray &_body
+)
+{
+  const auto &fragmentCount = _source.fragments.size();
+
+  QHash<QByteArray, QVector<int>> functions; // name, fragment indices
+
+  for(auto i = 0; i < fragmentCount; i++)
+  {
+    const auto &name = _source.functionNames[i];
+
+    if(!name.isEmpty()) functions[name].append(i);
+  }
+
+  std::vector<bool> isUsed(fragmentCount, functions.isEmpty());
+
+  if(functions.isEmpty()) return isUsed;
+
+  QSet<QByteArray> identifiers;
+  Preprocessor preprocessor;
+
+  for(auto i = 0; i < fragmentCount; i++)
+  {
+    if(i == _source.bodyIndex) appendEnabledIdentifiers(_body, preprocessor, &identifiers);
+
+    const auto &isFunction = !_source.functionNames[i].isEmpty();
+
+    if(!isFunction) isUsed[i] = true;
+
+    // only reachable functions contribute (see below)
+    appendEnabledIdentifiers(
+      _source.fragments[i],
+      preprocessor,
+      isFunction ? nullptr : &identifiers
+    );
+  }
+
+  if(_source.bodyIndex < 0 || _source.bodyIndex >= fragmentCount)
+  {
+    appendEnabledIdentifiers(_body, preprocessor, &identifiers);
+  }
+
+  QByteArrayList pending;
+
+  for(const auto &identifier : identifiers)
+  {
+    if(functions.contains(identifier)) pending.append(identifier);
+  }
+
+  QSet<QByteArray> usedFunctions;
+
+  while(!pending.isEmpty())
+  {
+    const auto name = pending.takeLast();
+
+    if(usedFunctions.contains(name)) continue;
+
+    usedFunctions.insert(name);
+
+    for(const auto &index : functions.value(name))
+    {
+      isUsed[index] = true;
+
+      QSet<QByteArray> callees;
+      appendIdentifiers(_source.fragments[index], callees);
+
+      for(const auto &callee : callees)
+      {
+        if(functions.contains(callee) && !usedFunctions.contains(callee)) pending.append(callee);
+      }
+    }
+  }
+
+  return isUsed;
+}
+
+/**
+ * @note the directive is removed up to the end of its line, the line
+ * itself is kept so the compiler's line numbers match the file's
+ *
+ * @param[in] _rawBytes
+ * @return bytes without #version directives (shared if there is none)
+ */
+QByteArray Shader::stripVersionDirectives(const QByteArray &_rawBytes)
+{
+  static const QByteArray directive("#version");
+
+  auto index = _rawBytes.indexOf(directive);
+
+  if(index < 0) return _rawBytes;
+
+  QByteArray strippedBytes;
+  strippedBytes.reserve(_rawBytes.size());
+
+  auto from = 0;
+
+  while(index >= 0)
+  {
+    strippedBytes.append(_rawBytes.constData() + from, index - from);
+
+    const auto &lineEnd = _rawBytes.indexOf('\n', index);
+
+    from  = lineEnd < 0 ? _rawBytes.size() : lineEnd;
+    index = _rawBytes.indexOf(directive, from);
+  }
+
+  strippedBytes.append(_rawBytes.constData() + from, _rawBytes.size() - from);
+
+  return strippedBytes;
+}
+
+/**
+ * @brief builds the final source in a single preallocated buffer:
+ * version directive, used fragments and the body at the placeholder
+ *
+ * @note the body is appended if the source has no placeholder
+ *
+ * @param[in] _source preloaded fragments
+ * @param[in] _body e.g. generated map() (see CodeGen::generate)
+ * @return assembled source
+ */
+QByteArray Shader::assemble(
+  const Source &_source,
+  const QByteArray &_body
+)
+{
+  const auto &startTime = std::chrono::steady_clock::now();
+
+  static const QByteArray versionDirective(
+    "#version " + QByteArray::number(constants::shaderVersion) + "\n"
+  );
+
+  const auto &isUsed = getUsedFragments(_source, _body);
+
+  auto byteCount = versionDirective.size() + _body.size();
+  auto functionCount = 0;
+  auto strippedFunctionCount = 0;
+
+  for(auto i = 0; i < _source.fragments.size(); i++)
+  {
+    if(!_source.functionNames[i].isEmpty())
+    {
+      functionCount++;
+      strippedFunctionCount += isUsed[i] ? 0 : 1;
+    }
+
+    if(isUsed[i]) byteCount += _source.fragments[i].size();
+  }
+
+  QByteArray sourceBytes;
+  sourceBytes.reserve(byteCount);
+  sourceBytes.append(versionDirective);
+
+  for(auto i = 0; i < _source.fragments.size(); i++)
+  {
+    if(i == _source.bodyIndex) sourceBytes.append(_body);
+
+    if(isUsed[i]) sourceBytes.append(_source.fragments[i]);
+  }
+
+  if(_source.bodyIndex < 0) sourceBytes.append(_body);
+
+  const std::chrono::duration<double> &duration = std::chrono::steady_clock::now() - startTime;
+
+  m_assemblyStats.seconds       = duration.count();
+  m_assemblyStats.byteCount     = sourceBytes.size();
+  m_assemblyStats.fragmentCount = _source.fragments.size();
+  m_assemblyStats.functionCount = functionCount;
+  m_assemblyStats.strippedFunctionCount = strippedFunctionCount;
+
+  return sourceBytes;
+}
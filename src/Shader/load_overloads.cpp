@@ -77,21 +77,35 @@ void Shader::load(
       qWarning("\nWARNING: Partial files cannot be merged back into precompiled SPIRV files. Therefore, they're ignored\n");
     }
 
+    if(isPrecompiled)
+    {
+      m_spvBytes.resize(rawBytes.size() / sizeof(uint32_t));
+      std::memcpy(m_spvBytes.data(), rawBytes.constData(), m_spvBytes.size() * sizeof(uint32_t));
+    }
+
     if(!isPrecompiled)
     {
       // only if there is any partial shader helper file
       if(!_partialFilePaths.isEmpty())
       {
-        serialize(_partialFilePaths, rawBytes);
+        Source source;
+
+        // partials are declared before the shader, the last one first
+        for(auto i = _partialFilePaths.size() - 1; i >= 0; i--)
+        {
+          appendFragments(source, getFileBytes(constants::shadersPath + _partialFilePaths[i]));
+        }
+
+        appendFragments(source, rawBytes);
+
+        rawBytes = assemble(source);
       }
 
       /**
-       * @todo make SPIRVCompiler::compile thread-safe with lock/unlock?
-       *
        * @note
        *
-       * SPV Compiler is not thread-safe and cannot synchronously compile
-       * multiple shaders. It should only be called once per process, not per thread.
+       * SPV Compiler cannot synchronously compile multiple shaders,
+       * concurrent compiles are serialized (see SPIRVCompiler::m_compileMutex).
        */
       if(
         !SPIRVCompiler::compile(
@@ -104,6 +118,8 @@ void Shader::load(
         qWarning("Failed to compile shader: %s", log.c_str());
         return Data();
       }
+
+      m_spvBytes = spvBytes;
     }
 
     return load(
@@ -129,21 +145,70 @@ void Shader::load(
 /**
  * PUBLIC
  *
- * @brief
+ * @brief loads and splits the shader files once, into the fragments
+ * every load(_shaderData) assembles its source from
+ *
+ * @note the library partials (functions only) are parsed once here and
+ * linked into every compiled shader, only their declarations are part of
+ * the assembled source. If they fail to parse on their own, they're
+ * assembled (and parsed) with every shader instead.
+ *
+ * @note the functions (declarations) of the partials but the last file
+ * are stripped from the assembled source unless used (see getUsedFragments)
+ *
  * @note this function may need rethinking since
  * currently the order of file paths determines the
  * success of the function
- * @param[in] _partialFilePaths
+ * @param[in] _partialFilePaths partials first, the file with the placeholder last
+ * @param[in] _libraryFilePaths shared function partials (optional)
  */
 void Shader::preload(
-  const QStringList &_partialFilePaths
+  const QStringList &_partialFilePaths,
+  const QStringList &_libraryFilePaths
 )
 {
-  for (auto i = 0; i < _partialFilePaths.size(); i++)
+  m_source = Source();
+  m_library = nullptr;
+
+  if(!_libraryFilePaths.isEmpty())
   {
-    auto filePath = _partialFilePaths[i];
+    Source librarySource;
+
+    for(const auto &filePath : _libraryFilePaths)
+    {
+      appendFragments(librarySource, getFileBytes(constants::shadersPath + filePath));
+    }
+
+    std::string log;
+
+    /**
+     * @note the library's unused functions are removed
+     * from the linked program (glslang's uncalled function removal)
+     */
+    m_library = SPIRVCompiler::createLibrary(m_stage, assemble(librarySource), log);
+
+    if(m_library)
+    {
+      appendFragments(m_source, m_library->declarations, true);
+    }
+    else
+    {
+      qWarning("Failed to parse shader library, compiling it per shader: %s", log.c_str());
 
-    m_rawBytes.append(getFileBytes(constants::shadersPath + filePath));
+      for(const auto &filePath : _libraryFilePaths)
+      {
+        appendFragments(m_source, getFileBytes(constants::shadersPath + filePath), true);
+      }
+    }
+  }
+
+  for(auto i = 0; i < _partialFilePaths.size(); i++)
+  {
+    appendFragments(
+      m_source,
+      getFileBytes(constants::shadersPath + _partialFilePaths[i]),
+      i < _partialFilePaths.size() - 1
+    );
   }
 }
 
@@ -152,9 +217,13 @@ void Shader::preload(
  *
  * @brief
  * @param[in] _shaderData
+ * @param[in] _optimization spirv-opt level
+ * @param[in] _isFastOptimization cheap passes only (e.g. interactive edits)
  */
 void Shader::load(
-  const std::string &_shaderData
+  const std::string &_shaderData,
+  SPIRVCompiler::Optimization _optimization,
+  bool _isFastOptimization
 )
 {
   reset();
@@ -163,22 +232,24 @@ void Shader::load(
 
   m_worker = QtConcurrent::run([=]()
   {
-    const auto &originalTemplate = constants::shaderTmpl;
-    const auto &shaderData = !_shaderData.empty() ? _shaderData : originalTemplate;
-    const auto &serializableData = shaderData.data();
-
-    serialize(QByteArray(serializableData));
-
     /**
-     * @note templates/placeholders should need to update per each
-     * shader re-compile/load to allow for updating the new
-     * shader instructions
+     * @note the preloaded fragments are left untouched, so every
+     * re-compile inserts the new shader instructions at the placeholder
+     * (an empty body keeps the shader's defaults)
      */
-    m_template = serializableData;
+    m_rawBytes = assemble(
+      m_source,
+      QByteArray::fromRawData(_shaderData.data(), (int) _shaderData.size())
+    );
 
     std::vector<uint32_t> spvBytes;
     std::string log;
 
+    SPIRVCompiler::Options options;
+    options.library       = m_library;
+    options.optimization  = _optimization;
+    options.isFast        = _isFastOptimization;
+
     /**
      * @note
      *
@@ -189,7 +260,9 @@ void Shader::load(
       !SPIRVCompiler::compile(
         m_stage,
         m_rawBytes,
-        spvBytes, log
+        options,
+        spvBytes, log,
+        &m_compileStats
         )
       )
     {
@@ -197,6 +270,8 @@ void Shader::load(
       return Data();
     }
 
+    m_spvBytes = spvBytes;
+
     return load(
       spvBytes // runtime compiled spirv bytes (if available, otherwise empty)
     );
@@ -214,6 +289,32 @@ void Shader::load(
 //  qDebug() << m_rawBytes.constData();
 }
 
+/**
+ * PUBLIC
+ *
+ * @brief creates a new shader module from previously loaded SPIR-V,
+ * i.e. nothing is assembled or compiled (e.g. recreating a pipeline with
+ * different specialization constants)
+ *
+ * @note the previous module (if any) has to be destroyed beforehand
+ * @param[in] _spvBytes see getSPIRV (of this or another shader of the same stage)
+ */
+void Shader::reload(const std::vector<uint32_t> &_spvBytes)
+{
+  if(_spvBytes.empty())
+  {
+    qWarning("Failed to reload shader: no SPIR-V loaded");
+    return;
+  }
+
+  auto spvBytes = _spvBytes; // may be this shader's own
+
+  reset();
+
+  m_spvBytes = spvBytes;
+  m_data = load(spvBytes);
+}
+
 /**
  * PRIVATE
  *
@@ -28,19 +28,23 @@ Texture::Texture(
  * @param[in] _width
  * @param[in] _height
  * @param[in] _usage
+ * @param[in] _format image (and image view) format
  */
 void Texture::createImage(
   uint32_t _width,
   uint32_t _height,
-  image::Usage _usage
+  image::Usage _usage,
+  const Format &_format
 )
 {
+  m_format = _format;
+
   image::Info imageInfo = {}; // memset
 
   imageInfo.sType = image::StructureType::IMAGE_INFO;
   imageInfo.pNext = nullptr;
   imageInfo.imageType = VK_IMAGE_TYPE_2D;
-  imageInfo.format = VK_FORMAT_D16_UNORM;
+  imageInfo.format = m_format;
 //  imageInfo.format = VK_FORMAT_R8G8B8A8_SRGB;
   imageInfo.extent.width = _width;
   imageInfo.extent.height = _height;
@@ -164,7 +168,7 @@ void Texture::createImageView(
   viewInfo.sType = image::StructureType::IMAGE_VIEW_INFO;
   viewInfo.pNext = nullptr;
   viewInfo.image = m_image;
-  viewInfo.format = VK_FORMAT_D16_UNORM;//VK_FORMAT_R8G8B8A8_SRGB;
+  viewInfo.format = m_format;//VK_FORMAT_R8G8B8A8_SRGB;
 
   viewInfo.components.r = VK_COMPONENT_SWIZZLE_R;
   viewInfo.components.g = VK_COMPONENT_SWIZZLE_G;
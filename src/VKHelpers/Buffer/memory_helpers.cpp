@@ -3,6 +3,8 @@
  * Members: Memory Helpers (Private)
  *****************************************************/
 
+#include <cstring>
+
 #include "VKHelpers/Buffer.hpp"
 
 using namespace sdfRay4d::vkHelpers;
@@ -60,38 +62,125 @@ void BufferHelper::bindBufferMemory(
 }
 
 /**
+ * @brief maps the whole (host visible and coherent) memory
+ * until it's freed
  *
- * @param[in] _byteSize
+ * @note memory must not be mapped more than once at a time, so
+ * persistently mapping it lets the frame worker (per-frame uniforms)
+ * and the swap worker (uploads) write their own ranges concurrently
  */
-void BufferHelper::mapMemory(
-  size_t _byteSize
-) noexcept
+void BufferHelper::mapMemory() noexcept
 {
-  // Copy vertex data.
-  quint8 *p;
+  if(!m_bufferMemory || m_mappedMemory) return;
+
   auto result = m_deviceFuncs->vkMapMemory(
     m_device,
     m_bufferMemory,
     0,
-    VK_WHOLE_SIZE/*m_actorMaterial->uniMemStartOffset*/,
+    VK_WHOLE_SIZE,
     0,
-    reinterpret_cast<void**>(&p)
+    reinterpret_cast<void**>(&m_mappedMemory)
   );
 
   if (result != VK_SUCCESS)
   {
     qFatal("Failed to map memory: %d", result);
   }
+}
 
-//  memcpy(p, , _byteSize);
-//  //  memcpy(p + m_sdfUniformStartOffset, m_sdfUniformBuffer, );
-  m_deviceFuncs->vkUnmapMemory(m_device, m_bufferMemory);
+/**
+ * @note the memory (host visible and coherent) must not be
+ * in use by the device in the given range
+ *
+ * @param[in] _memOffset
+ * @param[in] _data
+ * @param[in] _byteSize
+ */
+void BufferHelper::copyToMemory(
+  const device::Size &_memOffset,
+  const void *_data,
+  size_t _byteSize
+) noexcept
+{
+  if(!m_mappedMemory || !_byteSize) return;
+
+  memcpy(m_mappedMemory + _memOffset, _data, _byteSize);
+}
+
+/**
+ * @brief device local memory, not host visible, hence only
+ * written by transfer commands (see UploadHelper)
+ *
+ * @param[in] _size
+ * @param[in] _typeIndex
+ */
+void BufferHelper::allocateDeviceMemory(
+  const device::Size &_size,
+  uint32_t _typeIndex
+) noexcept
+{
+  memory::AllocInfo memAllocInfo = {
+    memory::StructureType::MEMORY_ALLOC_INFO, // sType
+    nullptr, // pNext
+    _size, // allocationSize
+    _typeIndex // memoryTypeIndex
+  };
+  auto result = m_deviceFuncs->vkAllocateMemory(
+    m_device,
+    &memAllocInfo,
+    nullptr,
+    &m_deviceMemory
+  );
+
+  if (result != VK_SUCCESS)
+  {
+    qFatal("Failed to allocate device memory: %d", result);
+  }
+}
+
+/**
+ *
+ * @param[in] _buffer
+ * @param[in] _memOffset
+ */
+void BufferHelper::bindBufferDeviceMemory(
+  const buffer::Buffer &_buffer,
+  const device::Size &_memOffset
+) noexcept
+{
+  auto result = m_deviceFuncs->vkBindBufferMemory(
+    m_device,
+    _buffer,
+    m_deviceMemory,
+    _memOffset
+  );
+
+  if (result != VK_SUCCESS)
+  {
+    qFatal("Failed to bind buffer device memory: %d", result);
+  }
 }
 
 void BufferHelper::freeMemory() noexcept
 {
+  if (m_deviceMemory)
+  {
+    m_deviceFuncs->vkFreeMemory(
+      m_device,
+      m_deviceMemory,
+      nullptr
+    );
+    m_deviceMemory = VK_NULL_HANDLE;
+  }
+
   if (!m_bufferMemory) return;
 
+  if (m_mappedMemory)
+  {
+    m_deviceFuncs->vkUnmapMemory(m_device, m_bufferMemory);
+    m_mappedMemory = nullptr;
+  }
+
   m_deviceFuncs->vkFreeMemory(
     m_device,
     m_bufferMemory,
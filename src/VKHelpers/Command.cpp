@@ -14,6 +14,8 @@
  * - draw_calls.cpp
  *****************************************************/
 
+#include <algorithm>
+
 #include "VKHelpers/Command.hpp"
 
 using namespace sdfRay4d::vkHelpers;
@@ -49,6 +51,14 @@ void CommandHelper::init(
 {
   m_cmdBuffer     = _cmdBuffer;
   m_frameId       = _frameId;
+  m_extentWidth   = _extentWidth;
+  m_extentHeight  = _extentHeight;
+
+  if(m_profilerHelper)
+  {
+    // reads back this frame slot's previous results & resets its queries
+    m_profilerHelper->beginFrame(m_cmdBuffer, m_frameId);
+  }
 
   m_renderPassHelper.setDefaultFramebuffer(_framebuffer);
   m_renderPassHelper.setFramebufferSize(
@@ -71,6 +81,17 @@ void CommandHelper::setRenderPassHelper(
   m_renderPassHelper = _renderPassHelper;
 }
 
+/**
+ *
+ * @param[in] _profilerHelper
+ */
+void CommandHelper::setProfilerHelper(
+  ProfilerHelper *_profilerHelper
+) noexcept
+{
+  m_profilerHelper = _profilerHelper;
+}
+
 void CommandHelper::executeCmdSetViewport(uint32_t _extentWidth, uint32_t _extentHeight) noexcept
 {
   Viewport viewport = {
@@ -111,13 +132,13 @@ void CommandHelper::executeCmdSetScissor(uint32_t _extentWidth, uint32_t _extent
 
 /**
  *
- * @param[in] _material
+ * @param[in] _pass
  */
 void CommandHelper::executeCmdPushConstants(
-  const MaterialPtr &_material
+  const Pass &_pass
 ) noexcept
 {
-  if(_material->pushConstantRangeCount <= 0) return;
+  if(_pass.material->pushConstantRangeCount <= 0) return;
 
   /**
    * @note this needs to be local and a copy
@@ -126,7 +147,7 @@ void CommandHelper::executeCmdPushConstants(
    *
    * @todo Fix dynamic data/mouse positions
    */
-  auto pushConstants = _material->pushConstants;
+  auto pushConstants = _pass.pushConstants;
 
   float perFrameData[3] = {
     1, // mouse position x
@@ -141,23 +162,31 @@ void CommandHelper::executeCmdPushConstants(
 
   m_deviceFuncs->vkCmdPushConstants(
     m_cmdBuffer,
-    _material->pipelineLayout,
-    shader::StageFlag::FRAGMENT,
+    _pass.pipelineLayout,
+    _pass.material->pushConstantRange.stageFlags,
     0/*sizeof(mvp) - 4*/,
-    sizeof(pushConstants.data()),
+    pushConstants.size() * sizeof(decltype(pushConstants)::value_type),
     pushConstants.data()
   );
 }
 
 /**
  *
- * @param[in] _materials
+ * @param[in] _passes materials with their snapshot pipeline state
  */
 void CommandHelper::executeRenderPass(
-  const std::vector<MaterialPtr> &_materials
+  const PassList &_passes
 ) noexcept
 {
-  m_renderPassHelper.createBeginInfo(_materials);
+  std::vector<MaterialPtr> materials;
+  materials.reserve(_passes.size());
+
+  for(const auto &pass : _passes)
+  {
+    materials.push_back(pass.material);
+  }
+
+  m_renderPassHelper.createBeginInfo(materials);
 
   m_deviceFuncs->vkCmdBeginRenderPass(
     m_cmdBuffer,
@@ -165,14 +194,63 @@ void CommandHelper::executeRenderPass(
     VK_SUBPASS_CONTENTS_INLINE
   );
 
-    for(const auto &material : _materials)
-    {
-      executeCmdBind(material);
-      executeCmdPushConstants(material);
-      executeCmdDraw(material);
-    }
+    executeCmdDraws(_passes);
+
+  m_deviceFuncs->vkCmdEndRenderPass(m_cmdBuffer);
+}
+
+/**
+ * @brief records the passes into the material's offscreen target
+ * at a (reduced) extent, e.g. half resolution SDFR lighting
+ *
+ * @note the whole target is cleared even without any pass, so its
+ * layout is always valid for the sampling (main) passes
+ *
+ * @param[in] _material owner of the offscreen renderPass/framebuffer
+ * @param[in] _passes
+ * @param[in] _targetWidth offscreen framebuffer width
+ * @param[in] _targetHeight offscreen framebuffer height
+ * @param[in] _extentWidth viewport/scissor width (<= target width)
+ * @param[in] _extentHeight viewport/scissor height (<= target height)
+ */
+void CommandHelper::executeOffscreenPass(
+  const MaterialPtr &_material,
+  const PassList &_passes,
+  uint32_t _targetWidth,
+  uint32_t _targetHeight,
+  uint32_t _extentWidth,
+  uint32_t _extentHeight
+) noexcept
+{
+  if(!_material->offscreenFramebuffer || _extentWidth == 0 || _extentHeight == 0) return;
+
+  Clear clearValue = {}; // memset
+
+  renderpass::BeginInfo beginInfo = {}; // memset
+  beginInfo.sType = renderpass::StructureType::RENDER_PASS_BEGIN_INFO;
+  beginInfo.renderPass = _material->offscreenRenderPass;
+  beginInfo.framebuffer = _material->offscreenFramebuffer;
+  beginInfo.renderArea.extent.width = _targetWidth;
+  beginInfo.renderArea.extent.height = _targetHeight;
+  beginInfo.clearValueCount = 1;
+  beginInfo.pClearValues = &clearValue;
+
+  m_deviceFuncs->vkCmdBeginRenderPass(
+    m_cmdBuffer,
+    &beginInfo,
+    VK_SUBPASS_CONTENTS_INLINE
+  );
+
+    executeCmdSetViewport(_extentWidth, _extentHeight);
+    executeCmdSetScissor(_extentWidth, _extentHeight);
+
+    executeCmdDraws(_passes);
 
   m_deviceFuncs->vkCmdEndRenderPass(m_cmdBuffer);
+
+  // back to the swapchain extent for the following passes
+  executeCmdSetViewport(m_extentWidth, m_extentHeight);
+  executeCmdSetScissor(m_extentWidth, m_extentHeight);
 }
 
 /**
@@ -198,4 +276,146 @@ void CommandHelper::executePipelineBarrier(
     1,
     &_material->texture.getImageMemoryBarrier() // image device memory
   );
+
+  if(m_profilerHelper)
+  {
+    m_profilerHelper->writeTimestamp(m_cmdBuffer, "Barrier");
+  }
+}
+
+/**
+ * @brief dispatches the compute passes in order (outside any render pass),
+ * e.g. SDFR tile binning: the node lists are cleared, each pass then sees
+ * the previous pass' writes, and the last one's are visible to the
+ * material's destination stages (e.g. the SDFR fragment shader)
+ *
+ * @param[in] _material owner of the storage buffer (cleared per frame)
+ * @param[in] _passes
+ * @param[in] _clearSize bytes cleared from the beginning of the storage
+ * buffer, i.e. only what the passes read (e.g. the binned tiles' lists)
+ */
+void CommandHelper::executeComputePasses(
+  const MaterialPtr &_material,
+  const PassList &_passes,
+  device::Size _clearSize
+) noexcept
+{
+  if(!_material || !_material->storageBuffer || _passes.empty() || !_clearSize) return;
+
+  // the previous frame's fragment shaders read the lists (write after read)
+  executeCmdBufferBarrier(
+    _material->storageBuffer,
+    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+    VK_PIPELINE_STAGE_TRANSFER_BIT,
+    0,
+    VK_ACCESS_TRANSFER_WRITE_BIT
+  );
+
+  m_deviceFuncs->vkCmdFillBuffer(
+    m_cmdBuffer,
+    _material->storageBuffer,
+    0,
+    std::min(_clearSize, _material->storageSize),
+    0
+  );
+
+  executeCmdBufferBarrier(
+    _material->storageBuffer,
+    VK_PIPELINE_STAGE_TRANSFER_BIT,
+    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+    VK_ACCESS_TRANSFER_WRITE_BIT,
+    VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+  );
+
+  for(const auto &pass : _passes)
+  {
+    executeCmdBindCompute(pass);
+    executeCmdPushConstants(pass);
+
+    m_deviceFuncs->vkCmdDispatch(m_cmdBuffer, pass.groupCount, 1, 1);
+
+    executeCmdBufferBarrier(
+      _material->storageBuffer,
+      _material->sourceStage,
+      _material->destinationStage,
+      VK_ACCESS_SHADER_WRITE_BIT,
+      VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+    );
+
+    if(m_profilerHelper)
+    {
+      m_profilerHelper->writeTimestamp(m_cmdBuffer, pass.name);
+    }
+  }
+}
+
+/**
+ * @brief zeroes a buffer range before any pass of the frame reads it
+ *
+ * @param[in] _buffer created with VK_BUFFER_USAGE_TRANSFER_DST_BIT
+ * @param[in] _offset
+ * @param[in] _size multiple of 4
+ */
+void CommandHelper::executeFillBuffer(
+  const buffer::Buffer &_buffer,
+  device::Size _offset,
+  device::Size _size
+) noexcept
+{
+  m_deviceFuncs->vkCmdFillBuffer(
+    m_cmdBuffer,
+    _buffer,
+    _offset,
+    _size,
+    0
+  );
+
+  executeCmdBufferBarrier(
+    _buffer,
+    VK_PIPELINE_STAGE_TRANSFER_BIT,
+    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+    VK_ACCESS_TRANSFER_WRITE_BIT,
+    VK_ACCESS_SHADER_READ_BIT
+  );
+}
+
+/**
+ * @brief GPU - GPU (device) sync of the whole buffer
+ *
+ * @param[in] _buffer
+ * @param[in] _sourceStage
+ * @param[in] _destinationStage
+ * @param[in] _sourceAccess
+ * @param[in] _destinationAccess
+ */
+void CommandHelper::executeCmdBufferBarrier(
+  const buffer::Buffer &_buffer,
+  pipeline::StageFlags _sourceStage,
+  pipeline::StageFlags _destinationStage,
+  memory::AccessFlags _sourceAccess,
+  memory::AccessFlags _destinationAccess
+) noexcept
+{
+  VkBufferMemoryBarrier barrier = {}; // memset
+  barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+  barrier.srcAccessMask       = _sourceAccess;
+  barrier.dstAccessMask       = _destinationAccess;
+  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.buffer              = _buffer;
+  barrier.offset              = 0;
+  barrier.size                = VK_WHOLE_SIZE;
+
+  m_deviceFuncs->vkCmdPipelineBarrier(
+    m_cmdBuffer,
+    _sourceStage,
+    _destinationStage,
+    0,
+    0,
+    nullptr, // global
+    1,
+    &barrier, // buffer device memory
+    0,
+    nullptr // image device memory
+  );
 }
@@ -9,46 +9,71 @@ using namespace sdfRay4d::vkHelpers;
 
 /**
  *
- * @param[in] _material
+ * @param[in] _pass
  */
 void CommandHelper::executeCmdBind(
-  const MaterialPtr &_material
+  const Pass &_pass
 ) noexcept
 {
+  const auto &material = _pass.material;
+
   m_deviceFuncs->vkCmdBindPipeline(
     m_cmdBuffer,
     VK_PIPELINE_BIND_POINT_GRAPHICS,
-    _material->pipeline
+    _pass.pipeline
   );
 
-  device::Size vbOffset = 0;
   m_deviceFuncs->vkCmdBindVertexBuffers(
     m_cmdBuffer,
     0, 1,
-    &_material->buffer,
-    &vbOffset
+    &_pass.vertexBuffer,
+    &_pass.vertexOffset
   );
 
-  const auto &descSets = _material->descSets;
+  if(_pass.indexCount > 0)
+  {
+    m_deviceFuncs->vkCmdBindIndexBuffer(
+      m_cmdBuffer,
+      _pass.vertexBuffer,
+      _pass.indexOffset,
+      VK_INDEX_TYPE_UINT32
+    );
+  }
+
+  const auto &descSets = material->descSets;
   const auto &descSetCount = descSets.size();
 
-  // the dynamic buffer points to the beginning of the vertex uniform data for the current frame.
-  const uint32_t frameDynamicOffset = m_frameId * vbOffset;
+  /**
+   * @note the dynamic uniform buffer holds the vertex and fragment
+   * uniform data of every concurrent frame, back to back (see createBuffers),
+   * so the dynamic offset points to the beginning of the current frame's data
+   */
+  const auto &frameStride = material->dynamicUniformBuffer
+    ? material->vertUniSize + material->fragUniSize
+    : 0;
+  const auto &frameDynamicOffset = (uint32_t) (m_frameId * frameStride);
   std::vector<uint32_t> frameDynamicOffsets = {}; // memset
 
   for(auto i = 0; i < descSetCount; i++)
   {
-    for (auto j = 0; j < _material->dynamicDescCount; j++)
+    for (auto j = 0; j < material->dynamicDescCount; j++)
     {
       frameDynamicOffsets.push_back(frameDynamicOffset);
     }
 
+    // e.g. the SDFR storage slots drawn by this snapshot
+    frameDynamicOffsets.insert(
+      frameDynamicOffsets.end(),
+      _pass.dynamicOffsets.begin(),
+      _pass.dynamicOffsets.end()
+    );
+
     const auto &dynamicOffsetCount = frameDynamicOffsets.size();
 
     m_deviceFuncs->vkCmdBindDescriptorSets(
       m_cmdBuffer,
       VK_PIPELINE_BIND_POINT_GRAPHICS,
-      _material->pipelineLayout,
+      _pass.pipelineLayout,
       i, descSetCount,
       &descSets[i],
       dynamicOffsetCount,
@@ -56,3 +81,35 @@ void CommandHelper::executeCmdBind(
     );
   }
 }
+
+/**
+ * @note compute materials have neither vertex input
+ * nor dynamic uniform buffers (see executeComputePasses),
+ * only the pass' dynamic offsets (e.g. SDFR storage slots)
+ *
+ * @param[in] _pass
+ */
+void CommandHelper::executeCmdBindCompute(
+  const Pass &_pass
+) noexcept
+{
+  const auto &descSets = _pass.material->descSets;
+
+  m_deviceFuncs->vkCmdBindPipeline(
+    m_cmdBuffer,
+    VK_PIPELINE_BIND_POINT_COMPUTE,
+    _pass.pipeline
+  );
+
+  if(descSets.empty()) return;
+
+  m_deviceFuncs->vkCmdBindDescriptorSets(
+    m_cmdBuffer,
+    VK_PIPELINE_BIND_POINT_COMPUTE,
+    _pass.pipelineLayout,
+    0, (uint32_t) descSets.size(),
+    descSets.data(),
+    (uint32_t) _pass.dynamicOffsets.size(),
+    _pass.dynamicOffsets.empty() ? nullptr : _pass.dynamicOffsets.data()
+  );
+}
@@ -9,16 +9,48 @@ using namespace sdfRay4d::vkHelpers;
 
 /**
  *
- * @param[in] _material
+ * @param[in] _pass
  */
 void CommandHelper::executeCmdDraw(
-  const MaterialPtr &_material
+  const Pass &_pass
 ) noexcept
 {
+  if(_pass.indexCount > 0)
+  {
+    m_deviceFuncs->vkCmdDrawIndexed(
+      m_cmdBuffer,
+      _pass.indexCount,
+      1,
+      0, 0, 0
+    );
+    return;
+  }
+
   m_deviceFuncs->vkCmdDraw(
     m_cmdBuffer,
-    _material->vertexCount,
+    _pass.vertexCount,
     1,
     0, 0
   );
 }
+
+/**
+ * @brief binds and draws each pass (within the current render pass)
+ * @param[in] _passes
+ */
+void CommandHelper::executeCmdDraws(
+  const PassList &_passes
+) noexcept
+{
+  for(const auto &pass : _passes)
+  {
+    executeCmdBind(pass);
+    executeCmdPushConstants(pass);
+    executeCmdDraw(pass);
+
+    if(m_profilerHelper)
+    {
+      m_profilerHelper->writeTimestamp(m_cmdBuffer, pass.name);
+    }
+  }
+}
@@ -31,6 +31,10 @@ DescriptorHelper::DescriptorHelper(
 , m_deviceFuncs(_deviceFuncs)
 {}
 
+/**
+ * @note the added write sets are consumed, i.e. a later update
+ * (e.g. a recreated image view) only writes its own descriptors
+ */
 void DescriptorHelper::updateDescriptorSets() noexcept
 {
   m_deviceFuncs->vkUpdateDescriptorSets(
@@ -40,4 +44,8 @@ void DescriptorHelper::updateDescriptorSets() noexcept
     0,
     nullptr
   );
+
+  m_descWriteList.clear();
+  m_bufferInfoPtrSet.clear();
+  m_imageInfoPtrSet.clear();
 }
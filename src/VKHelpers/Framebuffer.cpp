@@ -95,7 +95,34 @@ void FramebufferHelper::createFramebuffer(
   const renderpass::RenderPass &_renderPass
 ) noexcept
 {
-  if(m_extentWidth == 0 || m_extentHeight == 0)
+  createFramebuffer(
+    _renderPass,
+    m_attachments, // depth pass attachment image view is only 1
+    m_extentWidth,
+    m_extentHeight,
+    m_frameBuffer
+  );
+}
+
+/**
+ * @brief creates a custom (non Qt-Vulkan) framebuffer
+ * with the given attachments and extent
+ *
+ * @param[in] _renderPass
+ * @param[in] _attachments
+ * @param[in] _extentWidth
+ * @param[in] _extentHeight
+ * @param[out] _framebuffer
+ */
+void FramebufferHelper::createFramebuffer(
+  const renderpass::RenderPass &_renderPass,
+  const ImageViewList &_attachments,
+  uint32_t _extentWidth,
+  uint32_t _extentHeight,
+  framebuffer::Framebuffer &_framebuffer
+) noexcept
+{
+  if(_extentWidth == 0 || _extentHeight == 0)
   {
     qWarning("Framebuffer width or height is not set!");
 
@@ -106,17 +133,17 @@ void FramebufferHelper::createFramebuffer(
 
   framebufferInfo.sType = framebuffer::StructureType::FRAMEBUFFER_INFO;
   framebufferInfo.renderPass = _renderPass; // custom renderPass
-  framebufferInfo.attachmentCount = m_attachments.size(); // depth pass attachment image view is only 1
-  framebufferInfo.pAttachments = m_attachments.data();
-  framebufferInfo.width = m_extentWidth;
-  framebufferInfo.height = m_extentHeight;
+  framebufferInfo.attachmentCount = _attachments.size();
+  framebufferInfo.pAttachments = _attachments.data();
+  framebufferInfo.width = _extentWidth;
+  framebufferInfo.height = _extentHeight;
   framebufferInfo.layers = 1;
 
   auto result = m_deviceFuncs->vkCreateFramebuffer(
     m_device,
     &framebufferInfo,
     nullptr,
-    &m_frameBuffer
+    &_framebuffer
   );
 
   if (result != VK_SUCCESS)
@@ -81,6 +81,36 @@ renderpass::RenderPass &PipelineHelper::getRenderPass(bool _useDefault) noexcept
   return m_renderPassHelper.getRenderPass(_useDefault);
 }
 
+/**
+ * @return offscreen (single color attachment) RenderPass instance
+ */
+renderpass::RenderPass &PipelineHelper::getOffscreenRenderPass() noexcept
+{
+  return m_renderPassHelper.getOffscreenRenderPass();
+}
+
+/**
+ *
+ * @param[in] _material material with offscreenRenderPass set
+ * @param[in] _fbAttachments offscreen framebuffer attachments
+ * @param[in] _extentWidth
+ * @param[in] _extentHeight
+ */
+void PipelineHelper::createOffscreenFramebuffer(
+  const MaterialPtr &_material,
+  const ImageViewList &_fbAttachments,
+  uint32_t _extentWidth,
+  uint32_t _extentHeight
+) noexcept
+{
+  m_renderPassHelper.createOffscreenFramebuffer(
+    _material,
+    _fbAttachments,
+    _extentWidth,
+    _extentHeight
+  );
+}
+
 void PipelineHelper::waitForWorkersToFinish() noexcept
 {
   for (auto &worker : m_workers)
@@ -31,6 +31,56 @@ void PipelineHelper::createCache() noexcept
   }
 }
 
+/**
+ * @brief creates GPU timestamp/statistics query pools per concurrent frame
+ * and hooks the profiler into command recording
+ *
+ * @param[in] _frameCount
+ * @param[in] _timestampPeriod
+ * @param[in] _timestampValidBits
+ */
+void PipelineHelper::createProfiler(
+  uint32_t _frameCount,
+  float _timestampPeriod,
+  uint32_t _timestampValidBits
+) noexcept
+{
+  m_profilerHelper.init(
+    m_device,
+    m_deviceFuncs,
+    _frameCount,
+    _timestampPeriod,
+    _timestampValidBits
+  );
+
+  m_commandHelper.setProfilerHelper(
+    m_profilerHelper.isSupported() ? &m_profilerHelper : nullptr
+  );
+}
+
+/**
+ * @brief creates the staging ring and upload batches
+ * on the (dedicated, if any) transfer queue
+ *
+ * @param[in] _transferQueue
+ * @param[in] _graphicsFamilyIndex
+ * @param[in] _hostVisibleMemoryIndex
+ */
+void PipelineHelper::createUploader(
+  const UploadHelper::Queue &_transferQueue,
+  uint32_t _graphicsFamilyIndex,
+  uint32_t _hostVisibleMemoryIndex
+) noexcept
+{
+  m_uploadHelper.init(
+    m_device,
+    m_deviceFuncs,
+    _transferQueue,
+    _graphicsFamilyIndex,
+    _hostVisibleMemoryIndex
+  );
+}
+
 void PipelineHelper::createPipelines() noexcept
 {
   for(const auto &material : m_materials)
@@ -82,7 +132,16 @@ void PipelineHelper::createPipeline(
 
   m_descriptorHelper.createDescriptorSets(_material);
   createLayout(_material);
-  createGraphicsPipeline(_material);
+
+  // e.g. SDFR tile binning (waits for its shader to be loaded)
+  if(_material->computeShader.getData()->isValid())
+  {
+    createComputePipeline(_material);
+  }
+  else
+  {
+    createGraphicsPipeline(_material);
+  }
 
   /**
    * @todo Should I create buffers at this stage?
@@ -110,8 +169,9 @@ void PipelineHelper::swapSDFRPipelines(
    * @note When newly created pipeline is ready
    * swap the old with the new one
    */
-  _oldMaterial->pipelineLayout  = _newMaterial->pipelineLayout;
-  _oldMaterial->pipeline        = _newMaterial->pipeline;
+  _oldMaterial->pipelineLayout    = _newMaterial->pipelineLayout;
+  _oldMaterial->pipeline          = _newMaterial->pipeline;
+  _oldMaterial->offscreenPipeline = _newMaterial->offscreenPipeline;
 }
 
 /**
@@ -143,23 +203,21 @@ void PipelineHelper::createLayout(
 }
 
 /**
- * @todo implement compute pipeline with compute shaders
+ * @note no PSOs, the compute stage is the only shader stage
  *
  * per Material Pipeline
+ * @param[in] _material
  */
 void PipelineHelper::createComputePipeline(
   const MaterialPtr &_material
 ) noexcept
 {
-  //  initShaderStages();
-  //  initPSOs();
-
-  auto &pso = _material->pso;
+  initShaderStages(_material);
 
   pipeline::ComputePipelineInfo pipelineInfo = {}; // memset
 
   pipelineInfo.sType                = pipeline::StructureType::COMPUTE_PIPELINE_INFO;
-  //  pipelineInfo.stage                = m_actorMaterial->shaderStages.data();
+  pipelineInfo.stage                = _material->shaderStages.front();
   pipelineInfo.layout               = _material->pipelineLayout;
 
   auto result = m_deviceFuncs->vkCreateComputePipelines(
@@ -223,6 +281,30 @@ void PipelineHelper::createGraphicsPipeline(
     qFatal("Failed to create graphics pipeline: %d", result);
   }
 
+  /**
+   * @note the same shaders/layout/states are used for the material's
+   * offscreen pass, only the (compatible) renderPass and its sample count differ
+   */
+  if(_material->offscreenRenderPass)
+  {
+    pso.multisampleState.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+    pipelineInfo.renderPass = _material->offscreenRenderPass;
+
+    result = m_deviceFuncs->vkCreateGraphicsPipelines(
+      m_device,
+      m_pipelineCache,
+      1,
+      &pipelineInfo,
+      nullptr,
+      &_material->offscreenPipeline
+    );
+
+    if (result != VK_SUCCESS)
+    {
+      qFatal("Failed to create offscreen graphics pipeline: %d", result);
+    }
+  }
+
   /*
    * @note
    *
@@ -245,6 +327,32 @@ void PipelineHelper::initShaderStages(
 {
   const auto &structureType = pipeline::StructureType::SHADER_STAGE_INFO;
 
+  /**
+   * @note stored in the material, as it has to outlive
+   * this function until the pipeline is created
+   */
+  auto &specInfo = _material->specInfo;
+  specInfo.mapEntryCount  = (uint32_t) _material->specEntries.size();
+  specInfo.pMapEntries    = _material->specEntries.data();
+  specInfo.dataSize       = _material->specData.size();
+  specInfo.pData          = _material->specData.data();
+
+  if(_material->computeShader.getData()->isValid())
+  {
+    _material->shaderStages = {
+      {
+        structureType, // sType
+        nullptr, // pNext
+        0, // flags
+        shader::StageFlag::COMPUTE, // stage
+        _material->computeShader.getData()->shaderModule, // module
+        "main", // pName
+        specInfo.mapEntryCount > 0 ? &specInfo : nullptr // pSpecializationInfo
+      }
+    };
+    return;
+  }
+
   _material->shaderStages = {
     {
       structureType, // sType
@@ -262,7 +370,7 @@ void PipelineHelper::initShaderStages(
       shader::StageFlag::FRAGMENT, // stage
       _material->fragmentShader.getData()->shaderModule, // module
       "main", // pName
-      nullptr // pSpecializationInfo
+      specInfo.mapEntryCount > 0 ? &specInfo : nullptr // pSpecializationInfo
     }
   };
 }
@@ -52,6 +52,7 @@ void PipelineHelper::destroyPipeline(
 ) noexcept
 {
   destroyPipeline(_material->pipeline);
+  destroyPipeline(_material->offscreenPipeline);
 }
 
 /**
@@ -157,6 +158,7 @@ void PipelineHelper::destroyShaderModules() noexcept
   {
     destroyShaderModule(material->vertexShader);
     destroyShaderModule(material->fragmentShader);
+    destroyShaderModule(material->computeShader);
   }
 }
 
@@ -185,6 +187,19 @@ void PipelineHelper::destroyRenderPass() noexcept
   {
     auto &framebuffer = material->framebuffer;
     auto &renderPass = material->renderPass;
+    auto &offscreenRenderPass = material->offscreenRenderPass;
+
+    destroyOffscreenFramebuffer(material);
+
+    if(offscreenRenderPass)
+    {
+      m_deviceFuncs->vkDestroyRenderPass(
+        m_device,
+        offscreenRenderPass,
+        nullptr
+      );
+      offscreenRenderPass = VK_NULL_HANDLE;
+    }
 
     if(framebuffer && !material->isDefault)
     {
@@ -208,12 +223,35 @@ void PipelineHelper::destroyRenderPass() noexcept
   }
 }
 
+/**
+ * @note the offscreen renderPass is kept, e.g. the
+ * target is recreated at the new swapchain extent
+ *
+ * @param[in] _material
+ */
+void PipelineHelper::destroyOffscreenFramebuffer(
+  const MaterialPtr &_material
+) noexcept
+{
+  auto &offscreenFramebuffer = _material->offscreenFramebuffer;
+
+  if(!offscreenFramebuffer) return;
+
+  m_deviceFuncs->vkDestroyFramebuffer(
+    m_device,
+    offscreenFramebuffer,
+    nullptr
+  );
+  offscreenFramebuffer = VK_NULL_HANDLE;
+}
+
 void PipelineHelper::destroyBuffers() noexcept
 {
   for(auto &material : m_materials)
   {
     m_bufferHelper.destroyBuffer(material->buffer);
     m_bufferHelper.destroyBuffer(material->dynamicUniformBuffer);
+    m_bufferHelper.destroyBuffer(material->storageBuffer);
     m_bufferHelper.freeMemory();
   }
 }
@@ -227,3 +265,14 @@ void PipelineHelper::destroyMaterials() noexcept
 
   m_materials.clear();
 }
+
+void PipelineHelper::destroyProfiler() noexcept
+{
+  m_commandHelper.setProfilerHelper(nullptr);
+  m_profilerHelper.destroyQueryPools();
+}
+
+void PipelineHelper::destroyUploader() noexcept
+{
+  m_uploadHelper.destroy();
+}
@@ -58,28 +58,28 @@ void PipelineHelper::setVertexInputState(
   auto &vertexBindingDescs = pso.vertexBindingDescs = {
     {
       0, // binding
-      3 * sizeof(float), // stride
+      constants::mesh::packedVertexSize, // stride (see MeshOptimizer::Vertex)
       VK_VERTEX_INPUT_RATE_VERTEX // inputRate
     }
   };
   auto &vertexAttrDescs = pso.vertexAttrDescs = {
-    { // position
+    { // position (within the mesh bounds, dequantized by the model matrix)
       0, // location
       0, // binding
-      VK_FORMAT_R32G32B32_SFLOAT, // format
+      VK_FORMAT_R16G16B16A16_UNORM, // format
       0 // offset
     },
-    { // normal
+    { // normal (octahedral)
       1, // location
       0, // binding
-      VK_FORMAT_R32G32B32_SFLOAT, // format // VK_FORMAT_R8G8B8A8_UNORM
-      3 * sizeof(float) // offset (vec3)
+      VK_FORMAT_R16G16_SNORM, // format
+      4 * sizeof(uint16_t) // offset (u16vec4)
     },
     { // texCoord
       2, // location
       0, // binding
-      VK_FORMAT_R32G32B32_SFLOAT, // format
-      2 * sizeof(float) // offset (vec2)
+      VK_FORMAT_R16G16_SFLOAT, // format
+      6 * sizeof(uint16_t) // offset (u16vec4 + i16vec2)
     }
   };
 
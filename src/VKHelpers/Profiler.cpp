@@ -0,0 +1,148 @@
+/*****************************************************
+ * Partial Class: ProfilerHelper (General)
+ * Members: General Functions (Public/Private)
+ *
+ * This Class is split into partials to categorize
+ * and classify the functionality
+ * for the purpose of readability/maintainability
+ *
+ * The partials can be found in the respective
+ * directory named as the class name
+ *
+ * Partials:
+ * - export_helpers.cpp
+ * - query_helpers.cpp
+ *****************************************************/
+
+#include "VKHelpers/Profiler.hpp"
+
+using namespace sdfRay4d::vkHelpers;
+
+/**
+ * @brief initializes the ProfilerHelper members
+ *
+ * @note this replaces the constructor (similar to PipelineHelper::initHelpers)
+ * as the helper owns a mutex and cannot be re-assigned, and device/deviceFuncs
+ * are only available within QVulkanRenderer's initResources().
+ *
+ * @param[in] _device
+ * @param[in] _deviceFuncs
+ * @param[in] _frameCount concurrent frame count
+ * @param[in] _timestampPeriod nanoseconds per timestamp tick
+ * @param[in] _timestampValidBits graphics queue family timestamp valid bits
+ */
+void ProfilerHelper::init(
+  const device::Device &_device,
+  QVulkanDeviceFunctions *_deviceFuncs,
+  uint32_t _frameCount,
+  float _timestampPeriod,
+  uint32_t _timestampValidBits
+) noexcept
+{
+  m_device          = _device;
+  m_deviceFuncs     = _deviceFuncs;
+  m_frameCount      = _frameCount;
+  m_timestampPeriod = _timestampPeriod;
+  m_timestampMask   = _timestampValidBits >= 64
+    ? ~0ull
+    : (1ull << _timestampValidBits) - 1;
+
+  m_isSupported     = _timestampValidBits > 0 && _timestampPeriod > 0.0f;
+
+  if(!m_isSupported)
+  {
+    qWarning("GPU Profiler: timestamps are not supported on the graphics queue");
+    return;
+  }
+
+  m_frames.clear();
+  m_frames.resize(m_frameCount);
+
+  createQueryPools();
+}
+
+/**
+ * @brief copies the rolling window stats per label
+ * @return StatsList
+ */
+ProfilerHelper::StatsList ProfilerHelper::getStats() noexcept
+{
+  QMutexLocker locker(&m_statsMutex);
+
+  StatsList statsList;
+  statsList.reserve(m_samples.size());
+
+  for(const auto &samples : m_samples)
+  {
+    if(samples.durations.empty()) continue;
+
+    Stats stats;
+    stats.label       = samples.label;
+    stats.sampleCount = samples.durations.size();
+    stats.minMs       = samples.durations.front();
+    stats.maxMs       = samples.durations.front();
+
+    for(const auto &duration : samples.durations)
+    {
+      stats.minMs = std::min(stats.minMs, duration);
+      stats.maxMs = std::max(stats.maxMs, duration);
+      stats.avgMs += duration;
+    }
+    stats.avgMs /= (double) stats.sampleCount;
+
+    statsList.push_back(stats);
+  }
+
+  return statsList;
+}
+
+/**
+ * @brief one-line overlay summary: label avg (min - max) ms
+ * @return QString
+ */
+QString ProfilerHelper::getSummary() noexcept
+{
+  if(!m_isSupported) return QStringLiteral("GPU Profiler: timestamps not supported");
+
+  QStringList summary;
+
+  for(const auto &stats : getStats())
+  {
+    summary << QString("%1: %2 ms (%3 - %4)")
+      .arg(QString::fromStdString(stats.label))
+      .arg(stats.avgMs, 0, 'f', 3)
+      .arg(stats.minMs, 0, 'f', 3)
+      .arg(stats.maxMs, 0, 'f', 3);
+  }
+
+  return summary.join(QStringLiteral("  |  "));
+}
+
+/**
+ *
+ * @param[in] _label
+ * @param[in] _durationMs
+ */
+void ProfilerHelper::addSample(
+  const std::string &_label,
+  double _durationMs
+) noexcept
+{
+  QMutexLocker locker(&m_statsMutex);
+
+  auto samplesIt = std::find_if(
+    m_samples.begin(), m_samples.end(),
+    [&_label](const Samples &_samples) { return _samples.label == _label; }
+  );
+
+  if(samplesIt == m_samples.end())
+  {
+    m_samples.push_back({ _label });
+    samplesIt = std::prev(m_samples.end());
+  }
+
+  const auto &windowSize = (size_t) constants::profiler::windowSize;
+
+  samplesIt->durations.push_back(_durationMs);
+  if(samplesIt->durations.size() > windowSize) samplesIt->durations.pop_front();
+}
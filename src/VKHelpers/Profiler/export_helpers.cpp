@@ -0,0 +1,78 @@
+/*****************************************************
+ * Partial Class: ProfilerHelper
+ * Members: Export Helpers (Public)
+ *****************************************************/
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "VKHelpers/Profiler.hpp"
+
+using namespace sdfRay4d::vkHelpers;
+
+/**
+ * @brief exports the rolling stats per pass as json or csv
+ * (based on file extension, defaults to json)
+ *
+ * @param[in] _filePath
+ * @return boolean
+ */
+bool ProfilerHelper::exportStats(const QString &_filePath) noexcept
+{
+  QFile file(_filePath);
+
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+  {
+    qWarning("Failed to write GPU profile %s", qPrintable(_filePath));
+    return false;
+  }
+
+  const auto &statsList = getStats();
+  const auto &isCSV = QFileInfo(_filePath).suffix().compare("csv", Qt::CaseInsensitive) == 0;
+
+  if(isCSV)
+  {
+    QTextStream stream(&file);
+
+    stream << "label,min_ms,avg_ms,max_ms,samples\n";
+
+    for(const auto &stats : statsList)
+    {
+      stream
+        << QString::fromStdString(stats.label) << ","
+        << stats.minMs << ","
+        << stats.avgMs << ","
+        << stats.maxMs << ","
+        << stats.sampleCount << "\n";
+    }
+
+    return true;
+  }
+
+  QJsonArray passes;
+
+  for(const auto &stats : statsList)
+  {
+    passes.append(QJsonObject {
+      { "label",                QString::fromStdString(stats.label) },
+      { "minMs",                stats.minMs },
+      { "avgMs",                stats.avgMs },
+      { "maxMs",                stats.maxMs },
+      { "samples",              (qint64) stats.sampleCount }
+    });
+  }
+
+  const QJsonObject profile {
+    { "timestampPeriodNs",  (double) m_timestampPeriod },
+    { "windowSize",         constants::profiler::windowSize },
+    { "passes",             passes }
+  };
+
+  file.write(QJsonDocument(profile).toJson());
+
+  return true;
+}
@@ -0,0 +1,159 @@
+/*****************************************************
+ * Partial Class: ProfilerHelper
+ * Members: Query Pool/Command Helpers (Private)
+ *****************************************************/
+
+#include "VKHelpers/Profiler.hpp"
+
+using namespace sdfRay4d::vkHelpers;
+
+/**
+ * @note one range of maxScopes + 1 timestamps
+ * (frame start + one per scope), per concurrent frame
+ */
+void ProfilerHelper::createQueryPools() noexcept
+{
+  const auto &maxScopes = (uint32_t) constants::profiler::maxScopes;
+
+  query::PoolInfo timestampPoolInfo = {}; // memset
+  timestampPoolInfo.sType       = query::StructureType::POOL_INFO;
+  timestampPoolInfo.queryType   = VK_QUERY_TYPE_TIMESTAMP;
+  timestampPoolInfo.queryCount  = m_frameCount * (maxScopes + 1);
+
+  auto result = m_deviceFuncs->vkCreateQueryPool(
+    m_device,
+    &timestampPoolInfo,
+    nullptr,
+    &m_timestampPool
+  );
+
+  if (result != VK_SUCCESS)
+  {
+    qFatal("Failed to create timestamp query pool: %d", result);
+  }
+}
+
+void ProfilerHelper::destroyQueryPools() noexcept
+{
+  if(m_timestampPool)
+  {
+    m_deviceFuncs->vkDestroyQueryPool(m_device, m_timestampPool, nullptr);
+    m_timestampPool = VK_NULL_HANDLE;
+  }
+
+  m_frames.clear();
+}
+
+/**
+ * @brief reads back the previous results of the frame slot,
+ * resets its query range and writes the frame start timestamp
+ *
+ * @note this has to be recorded outside of any render pass
+ *
+ * @param[in] _cmdBuffer
+ * @param[in] _frameId current (concurrent) frame slot
+ */
+void ProfilerHelper::beginFrame(
+  const command::CmdBuffer &_cmdBuffer,
+  int _frameId
+) noexcept
+{
+  if(!m_isSupported || m_frames.empty()) return;
+
+  const auto &maxScopes = (uint32_t) constants::profiler::maxScopes;
+
+  m_frameSlot = (uint32_t) _frameId % m_frameCount;
+
+  readResults(m_frameSlot);
+
+  auto &frame = m_frames[m_frameSlot];
+  frame.labels.clear();
+  frame.isRecorded = true;
+
+  m_deviceFuncs->vkCmdResetQueryPool(
+    _cmdBuffer,
+    m_timestampPool,
+    m_frameSlot * (maxScopes + 1),
+    maxScopes + 1
+  );
+
+  m_deviceFuncs->vkCmdWriteTimestamp(
+    _cmdBuffer,
+    VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+    m_timestampPool,
+    m_frameSlot * (maxScopes + 1)
+  );
+}
+
+/**
+ * @brief closes the current scope (pass/barrier) with a timestamp
+ * once all previously recorded commands completed
+ *
+ * @param[in] _cmdBuffer
+ * @param[in] _label scope label e.g. material (pass) name
+ */
+void ProfilerHelper::writeTimestamp(
+  const command::CmdBuffer &_cmdBuffer,
+  const std::string &_label
+) noexcept
+{
+  if(!m_isSupported || m_frames.empty()) return;
+
+  const auto &maxScopes = (uint32_t) constants::profiler::maxScopes;
+  auto &frame = m_frames[m_frameSlot];
+
+  if(frame.labels.size() >= maxScopes) return;
+
+  frame.labels.push_back(_label);
+
+  m_deviceFuncs->vkCmdWriteTimestamp(
+    _cmdBuffer,
+    VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+    m_timestampPool,
+    m_frameSlot * (maxScopes + 1) + (uint32_t) frame.labels.size()
+  );
+}
+
+/**
+ * @note Qt Vulkan waits for the frame slot's fence before handing it out
+ * again, therefore results are expected to be available and no wait flag is
+ * used. If they're not (VK_NOT_READY), the samples are simply dropped.
+ *
+ * @param[in] _frameSlot
+ */
+void ProfilerHelper::readResults(uint32_t _frameSlot) noexcept
+{
+  auto &frame = m_frames[_frameSlot];
+
+  if(!frame.isRecorded || frame.labels.empty()) return;
+
+  const auto &maxScopes = (uint32_t) constants::profiler::maxScopes;
+  const auto &timestampCount = (uint32_t) frame.labels.size() + 1;
+
+  std::vector<uint64_t> timestamps(timestampCount, 0);
+
+  auto result = m_deviceFuncs->vkGetQueryPoolResults(
+    m_device,
+    m_timestampPool,
+    _frameSlot * (maxScopes + 1),
+    timestampCount,
+    timestamps.size() * sizeof(uint64_t),
+    timestamps.data(),
+    sizeof(uint64_t),
+    VK_QUERY_RESULT_64_BIT
+  );
+
+  if(result != VK_SUCCESS) return;
+
+  const auto &nsToMs = (double) m_timestampPeriod / 1e6;
+
+  for(auto i = 1u; i < timestampCount; i++)
+  {
+    const auto &ticks = (timestamps[i] - timestamps[i - 1]) & m_timestampMask;
+
+    addSample(frame.labels[i - 1], (double) ticks * nsToMs);
+  }
+
+  const auto &frameTicks = (timestamps[timestampCount - 1] - timestamps[0]) & m_timestampMask;
+  addSample("Frame", (double) frameTicks * nsToMs);
+}
@@ -10,7 +10,7 @@
  * directory named as the class name
  *
  * Partials:
- * - set_framebuffer_helpers.cpp
+ * - framebuffer_helpers.cpp
  *****************************************************/
 
 #include "VKHelpers/RenderPass.hpp"
@@ -98,6 +98,85 @@ void RenderPassHelper::createRenderPass(
   }
 }
 
+/**
+ * @brief creates a single color attachment offscreen renderPass
+ * whose attachment is sampled by later passes of the same frame
+ *
+ * @note always single sampled, as it's only sampled (texelFetch) by the
+ * main pass. The attachment stays in the GENERAL layout, as the pass'
+ * shaders may be shared with the sampling pass (same descriptor set, e.g.
+ * SDFR main and lighting pass), so it's statically referenced by both.
+ * The subpass dependencies replace an explicit pipeline barrier:
+ * - previous frame's fragment shader reads before this frame's writes
+ * - this frame's writes before the main pass' fragment shader reads
+ *
+ * @param[in] _colorFormat
+ * @param[out] m_offscreenRenderPass
+ */
+void RenderPassHelper::createOffscreenRenderPass(
+  const Format &_colorFormat
+) noexcept
+{
+  renderpass::AttachmentDesc attDesc[1] = {}; // memset
+
+  attDesc[0].format = _colorFormat;
+  attDesc[0].samples = VK_SAMPLE_COUNT_1_BIT;
+  attDesc[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+  attDesc[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+  attDesc[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+  attDesc[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+  attDesc[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  attDesc[0].finalLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+  renderpass::AttachmentRef colorRef = {
+    0,
+    VK_IMAGE_LAYOUT_GENERAL
+  };
+
+  renderpass::SubpassDesc subPassDesc = {}; // memset
+  subPassDesc.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+  subPassDesc.colorAttachmentCount = 1;
+  subPassDesc.pColorAttachments = &colorRef;
+  subPassDesc.pDepthStencilAttachment = nullptr;
+
+  renderpass::SubpassDep subPassDeps[2] = {}; // memset
+
+  subPassDeps[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+  subPassDeps[0].dstSubpass = 0;
+  subPassDeps[0].srcStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+  subPassDeps[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+  subPassDeps[0].srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+  subPassDeps[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+  subPassDeps[1].srcSubpass = 0;
+  subPassDeps[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+  subPassDeps[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+  subPassDeps[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+  subPassDeps[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+  subPassDeps[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+  renderpass::Info renderPassInfo = {}; // memset
+  renderPassInfo.sType = renderpass::StructureType::RENDER_PASS_INFO;
+  renderPassInfo.attachmentCount = 1;
+  renderPassInfo.pAttachments = attDesc;
+  renderPassInfo.subpassCount = 1;
+  renderPassInfo.pSubpasses = &subPassDesc;
+  renderPassInfo.dependencyCount = 2;
+  renderPassInfo.pDependencies = subPassDeps;
+
+  auto result = m_deviceFuncs->vkCreateRenderPass(
+    m_device,
+    &renderPassInfo,
+    nullptr,
+    &m_offscreenRenderPass
+  );
+
+  if (result != VK_SUCCESS)
+  {
+    qFatal("Failed to create offscreen RenderPass: %d", result);
+  }
+}
+
 /**
  * @brief creates renderPassBeginInfo for both default and custom renderPass
  * @param[in] _materials
@@ -159,3 +238,20 @@ renderpass::RenderPass &RenderPassHelper::getRenderPass(bool _useDefault) noexce
    */
   return _useDefault ? m_defaultRenderPass : m_renderPass;
 }
+
+/**
+ *
+ * @param[in] _colorFormat (only used on first call)
+ * @return offscreen RenderPass instance
+ */
+renderpass::RenderPass &RenderPassHelper::getOffscreenRenderPass(
+  const Format &_colorFormat
+) noexcept
+{
+  if(!m_offscreenRenderPass)
+  {
+    createOffscreenRenderPass(_colorFormat);
+  }
+
+  return m_offscreenRenderPass;
+}
@@ -47,3 +47,28 @@ void RenderPassHelper::setFramebufferSize(
     _extentHeight
   );
 }
+
+/**
+ * @brief creates the material's offscreen framebuffer
+ * (material->offscreenRenderPass has to be set)
+ *
+ * @param[in] _material
+ * @param[in] _attachments
+ * @param[in] _extentWidth
+ * @param[in] _extentHeight
+ */
+void RenderPassHelper::createOffscreenFramebuffer(
+  const MaterialPtr &_material,
+  const ImageViewList &_attachments,
+  uint32_t _extentWidth,
+  uint32_t _extentHeight
+) noexcept
+{
+  m_framebufferHelper.createFramebuffer(
+    _material->offscreenRenderPass,
+    _attachments,
+    _extentWidth,
+    _extentHeight,
+    _material->offscreenFramebuffer
+  );
+}
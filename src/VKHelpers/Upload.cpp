@@ -0,0 +1,326 @@
+/*****************************************************
+ * Partial Class: UploadHelper (General)
+ * Members: General Functions (Public/Private)
+ *
+ * This Class is split into partials to categorize
+ * and classify the functionality
+ * for the purpose of readability/maintainability
+ *
+ * The partials can be found in the respective
+ * directory named as the class name
+ *
+ * Partials:
+ * - batch_helpers.cpp
+ * - staging_ring_helpers.cpp
+ *****************************************************/
+
+#include <algorithm>
+#include <cstring>
+
+#include "VKHelpers/Upload.hpp"
+
+using namespace sdfRay4d::vkHelpers;
+
+/**
+ * @brief initializes the UploadHelper members
+ *
+ * @note this replaces the constructor (similar to ProfilerHelper::init)
+ * as the helper owns a mutex and cannot be re-assigned
+ *
+ * @param[in] _device
+ * @param[in] _deviceFuncs
+ * @param[in] _transferQueue used by this helper only, unless it's the graphics queue
+ * (Queue::guiContext set)
+ * @param[in] _graphicsFamilyIndex consumer of the uploaded buffers
+ * @param[in] _hostVisibleMemoryIndex staging ring memory (host visible and coherent)
+ */
+void UploadHelper::init(
+  const device::Device &_device,
+  QVulkanDeviceFunctions *_deviceFuncs,
+  const Queue &_transferQueue,
+  uint32_t _graphicsFamilyIndex,
+  uint32_t _hostVisibleMemoryIndex
+) noexcept
+{
+  m_device              = _device;
+  m_deviceFuncs         = _deviceFuncs;
+  m_transferQueue       = _transferQueue;
+  m_graphicsFamilyIndex = _graphicsFamilyIndex;
+
+  m_submittedToken  = 0;
+  m_completedToken  = 0;
+  m_queuedToken     = 0;
+  m_isClosed        = false;
+  m_ringHead        = 0;
+  m_ringTail        = 0;
+
+  createRing(_hostVisibleMemoryIndex);
+  createBatches();
+}
+
+/**
+ * @note the device has to be idle
+ */
+void UploadHelper::destroy() noexcept
+{
+  QMutexLocker locker(&m_uploadMutex);
+
+  destroyBatches();
+  destroyRing();
+
+  // not acquired by any frame, the buffers are being destroyed as well
+  VkBufferMemoryBarrier barrier;
+  while(m_acquireBarriers.pop(barrier)) {}
+}
+
+/**
+ * @brief copies the data into the staging ring and records its
+ * transfer into the open batch, one chunk at a time
+ *
+ * @note only blocks if the staging ring (or every batch) is in flight,
+ * the ring then drains as fast as the transfer queue copies
+ *
+ * @note the destination range must not be read by any frame in flight,
+ * e.g. write into a buffer (range) that's swapped in on completion
+ *
+ * @param[in] _dstBuffer created with VK_BUFFER_USAGE_TRANSFER_DST_BIT
+ * @param[in] _dstOffset
+ * @param[in] _data copied before this returns
+ * @param[in] _byteSize
+ * @return token of the batch that completes the upload (see flush)
+ */
+UploadHelper::Token UploadHelper::upload(
+  const buffer::Buffer &_dstBuffer,
+  device::Size _dstOffset,
+  const void *_data,
+  size_t _byteSize
+) noexcept
+{
+  QMutexLocker locker(&m_uploadMutex);
+
+  if(!m_mappedRing || !_byteSize) return 0;
+
+  const auto &chunkSize = (size_t) constants::upload::chunkSize;
+  const auto *bytes = static_cast<const quint8*>(_data);
+
+  for(size_t offset = 0; offset < _byteSize; offset += chunkSize)
+  {
+    const auto size = std::min(_byteSize - offset, chunkSize);
+    const auto ringOffset = reserve(size);
+
+    recordCopy(_dstBuffer, _dstOffset + offset, bytes + offset, size, ringOffset);
+  }
+
+  return m_submittedToken + 1;
+}
+
+/**
+ * @brief same as upload, without blocking: only the leading chunks
+ * that fit into the staging ring right away are recorded
+ *
+ * @note meant for threads that mustn't wait for the transfer queue
+ * (e.g. with m_guiMutex locked), the rest is retried later on.
+ * The uploaded bytes complete with the token of the next flush.
+ *
+ * @param[in] _dstBuffer created with VK_BUFFER_USAGE_TRANSFER_DST_BIT
+ * @param[in] _dstOffset
+ * @param[in] _data copied before this returns
+ * @param[in] _byteSize
+ * @return bytes uploaded (from the beginning of the data)
+ */
+size_t UploadHelper::tryUpload(
+  const buffer::Buffer &_dstBuffer,
+  device::Size _dstOffset,
+  const void *_data,
+  size_t _byteSize
+) noexcept
+{
+  QMutexLocker locker(&m_uploadMutex);
+
+  if(!m_mappedRing || !_byteSize) return 0;
+
+  retireBatches();
+
+  // every batch in flight, the open one can't begin yet
+  const auto &batch = m_batches[m_submittedToken % m_batches.size()];
+
+  if(!batch.isRecording && m_completedToken + m_batches.size() <= m_submittedToken)
+  {
+    return 0;
+  }
+
+  const auto &chunkSize = (size_t) constants::upload::chunkSize;
+  const auto *bytes = static_cast<const quint8*>(_data);
+
+  size_t offset = 0;
+
+  while(offset < _byteSize)
+  {
+    const auto size = std::min(_byteSize - offset, chunkSize);
+    device::Size ringOffset = 0;
+
+    if(!tryReserve(size, ringOffset)) break;
+
+    recordCopy(_dstBuffer, _dstOffset + offset, bytes + offset, size, ringOffset);
+    offset += size;
+  }
+
+  return offset;
+}
+
+/**
+ * @brief copies a chunk into its reserved ring range and records
+ * its transfer into the open batch
+ *
+ * @note m_uploadMutex has to be locked
+ *
+ * @param[in] _dstBuffer
+ * @param[in] _dstOffset
+ * @param[in] _data
+ * @param[in] _size at most constants::upload::chunkSize
+ * @param[in] _ringOffset see reserve
+ */
+void UploadHelper::recordCopy(
+  const buffer::Buffer &_dstBuffer,
+  device::Size _dstOffset,
+  const quint8 *_data,
+  size_t _size,
+  device::Size _ringOffset
+) noexcept
+{
+  std::memcpy(m_mappedRing + _ringOffset, _data, _size);
+
+  auto &batch = beginBatch();
+
+  const VkBufferCopy region = {
+    _ringOffset, // srcOffset
+    _dstOffset, // dstOffset
+    _size // size
+  };
+  m_deviceFuncs->vkCmdCopyBuffer(
+    batch.cmdBuffer,
+    m_ringBuffer,
+    _dstBuffer,
+    1,
+    &region
+  );
+
+  if(!isOwnershipTransferred()) return;
+
+  // release half, the acquire half is recorded by the frame worker
+  batch.barriers.push_back({
+    VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER, // sType
+    nullptr, // pNext
+    VK_ACCESS_TRANSFER_WRITE_BIT, // srcAccessMask
+    0, // dstAccessMask (ignored on release)
+    m_transferQueue.familyIndex, // srcQueueFamilyIndex
+    m_graphicsFamilyIndex, // dstQueueFamilyIndex
+    _dstBuffer, // buffer
+    region.dstOffset, // offset
+    region.size // size
+  });
+}
+
+/**
+ * @brief submits the open batch (if any)
+ * @return token of the last submitted batch
+ */
+UploadHelper::Token UploadHelper::flush() noexcept
+{
+  QMutexLocker locker(&m_uploadMutex);
+
+  return submitBatch();
+}
+
+/**
+ * @brief non-blocking, retires every finished batch
+ *
+ * @note an upload isn't complete until its batch is flushed
+ *
+ * @param[in] _token
+ * @return boolean
+ */
+bool UploadHelper::isComplete(Token _token) noexcept
+{
+  QMutexLocker locker(&m_uploadMutex);
+
+  retireBatches();
+
+  return _token <= m_completedToken;
+}
+
+/**
+ * @brief blocks until the token completed, flushing the open batch
+ * if the token belongs to it
+ *
+ * @note meant for one-off uploads, never while holding a lock the GUI
+ * thread takes (it may have to queue the batch, see submitBatch). The acquire
+ * barriers are only drained by the frame worker, i.e. a thread that waits
+ * for more than acquireCapacity ranges must not be the frame worker
+ *
+ * @param[in] _token
+ */
+void UploadHelper::wait(Token _token) noexcept
+{
+  QMutexLocker locker(&m_uploadMutex);
+
+  if(_token > m_submittedToken) submitBatch();
+
+  while(m_completedToken < std::min(_token, m_submittedToken))
+  {
+    waitForOldestBatch();
+  }
+}
+
+/**
+ * @brief queues what's pending and drops the batches flushed afterwards
+ * (if the queue is shared with Qt), so the threads that might wait for an
+ * upload can be joined by the GUI thread
+ *
+ * @note called before releasing the resources, the dropped uploads
+ * are never drawn from
+ */
+void UploadHelper::close() noexcept
+{
+  QMutexLocker locker(&m_uploadMutex);
+
+  submitPendingBatches();
+  m_isClosed = true;
+}
+
+/**
+ * @brief acquires the buffer ranges released by the completed batches,
+ * before any pass of the frame reads them
+ *
+ * @note the consumer side of the acquire barriers (lock-free)
+ *
+ * @param[in] _cmdBuffer current frame's command buffer
+ */
+void UploadHelper::recordAcquireBarriers(const command::CmdBuffer &_cmdBuffer) noexcept
+{
+  if(!isOwnershipTransferred()) return;
+
+  std::vector<VkBufferMemoryBarrier> barriers;
+  VkBufferMemoryBarrier barrier;
+
+  while(m_acquireBarriers.pop(barrier))
+  {
+    barriers.push_back(barrier);
+  }
+
+  if(barriers.empty()) return;
+
+  // the transfer already completed (host observed its fence)
+  m_deviceFuncs->vkCmdPipelineBarrier(
+    _cmdBuffer,
+    VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+    VK_PIPELINE_STAGE_VERTEX_INPUT_BIT
+    | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT
+    | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+    | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, // e.g. the scene tape (binning)
+    0,
+    0, nullptr,
+    (uint32_t) barriers.size(), barriers.data(),
+    0, nullptr
+  );
+}
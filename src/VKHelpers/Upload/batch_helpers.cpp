@@ -0,0 +1,361 @@
+/*****************************************************
+ * Partial Class: UploadHelper
+ * Members: Batch Helpers (Private)
+ *****************************************************/
+
+#include <QThread>
+
+#include "VKHelpers/Upload.hpp"
+
+using namespace sdfRay4d::vkHelpers;
+
+/**
+ * @note own pool on the transfer queue family, as Qt Vulkan's graphics
+ * command pool is used by the GUI thread for the per-frame command buffers
+ */
+void UploadHelper::createBatches() noexcept
+{
+  VkCommandPoolCreateInfo poolInfo = {
+    VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO, // sType
+    nullptr, // pNext
+    VK_COMMAND_POOL_CREATE_TRANSIENT_BIT
+    | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, // flags
+    m_transferQueue.familyIndex // queueFamilyIndex
+  };
+
+  auto result = m_deviceFuncs->vkCreateCommandPool(
+    m_device,
+    &poolInfo,
+    nullptr,
+    &m_cmdPool
+  );
+
+  if (result != VK_SUCCESS)
+  {
+    qFatal("Failed to create upload command pool: %d", result);
+  }
+
+  m_batches.clear();
+  m_batches.resize(constants::upload::batchCount);
+
+  for(auto &batch : m_batches)
+  {
+    VkCommandBufferAllocateInfo allocInfo = {
+      VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, // sType
+      nullptr, // pNext
+      m_cmdPool, // commandPool
+      VK_COMMAND_BUFFER_LEVEL_PRIMARY, // level
+      1 // commandBufferCount
+    };
+
+    result = m_deviceFuncs->vkAllocateCommandBuffers(
+      m_device,
+      &allocInfo,
+      &batch.cmdBuffer
+    );
+
+    if (result != VK_SUCCESS)
+    {
+      qFatal("Failed to allocate upload command buffer: %d", result);
+    }
+
+    VkFenceCreateInfo fenceInfo = {
+      VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, // sType
+      nullptr, // pNext
+      0 // flags
+    };
+
+    result = m_deviceFuncs->vkCreateFence(
+      m_device,
+      &fenceInfo,
+      nullptr,
+      &batch.fence
+    );
+
+    if (result != VK_SUCCESS)
+    {
+      qFatal("Failed to create upload fence: %d", result);
+    }
+  }
+}
+
+/**
+ * @note the device has to be idle, the command buffers
+ * are freed along with their pool
+ */
+void UploadHelper::destroyBatches() noexcept
+{
+  for(auto &batch : m_batches)
+  {
+    if(!batch.fence) continue;
+
+    m_deviceFuncs->vkDestroyFence(
+      m_device,
+      batch.fence,
+      nullptr
+    );
+  }
+
+  m_batches.clear();
+
+  if (!m_cmdPool) return;
+
+  m_deviceFuncs->vkDestroyCommandPool(
+    m_device,
+    m_cmdPool,
+    nullptr
+  );
+  m_cmdPool = VK_NULL_HANDLE;
+}
+
+/**
+ * @brief the open batch, which starts recording once its
+ * command buffer (submitted batchCount tokens ago) retired
+ *
+ * @note m_uploadMutex has to be locked
+ *
+ * @return Batch
+ */
+UploadHelper::Batch &UploadHelper::beginBatch() noexcept
+{
+  auto &batch = m_batches[m_submittedToken % m_batches.size()];
+
+  if(batch.isRecording) return batch;
+
+  while(m_completedToken + m_batches.size() <= m_submittedToken)
+  {
+    waitForOldestBatch();
+  }
+
+  VkCommandBufferBeginInfo beginInfo = {
+    VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, // sType
+    nullptr, // pNext
+    VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, // flags
+    nullptr // pInheritanceInfo
+  };
+  m_deviceFuncs->vkBeginCommandBuffer(batch.cmdBuffer, &beginInfo);
+
+  batch.isRecording = true;
+
+  return batch;
+}
+
+/**
+ * @brief submits the open batch with its fence, releasing the
+ * written ranges to the graphics queue family (if another one)
+ *
+ * @note on a worker, a batch for Qt's graphics queue is only ended here
+ * and queued to the GUI thread (see submitPendingBatches)
+ *
+ * @note m_uploadMutex has to be locked
+ *
+ * @return token of the last submitted batch
+ */
+UploadHelper::Token UploadHelper::submitBatch() noexcept
+{
+  auto &batch = m_batches[m_submittedToken % m_batches.size()];
+
+  if(!batch.isRecording) return m_submittedToken;
+
+  if(isOwnershipTransferred())
+  {
+    m_deviceFuncs->vkCmdPipelineBarrier(
+      batch.cmdBuffer,
+      VK_PIPELINE_STAGE_TRANSFER_BIT,
+      VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+      0,
+      0, nullptr,
+      (uint32_t) batch.barriers.size(), batch.barriers.data(),
+      0, nullptr
+    );
+  }
+  else
+  {
+    // same queue family, visible to the vertex input/shaders of later frames
+    VkMemoryBarrier memoryBarrier = {
+      VK_STRUCTURE_TYPE_MEMORY_BARRIER, // sType
+      nullptr, // pNext
+      VK_ACCESS_TRANSFER_WRITE_BIT, // srcAccessMask
+      VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT
+      | VK_ACCESS_INDEX_READ_BIT
+      | VK_ACCESS_SHADER_READ_BIT // dstAccessMask
+    };
+    m_deviceFuncs->vkCmdPipelineBarrier(
+      batch.cmdBuffer,
+      VK_PIPELINE_STAGE_TRANSFER_BIT,
+      VK_PIPELINE_STAGE_VERTEX_INPUT_BIT
+      | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT
+      | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+      | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+      0,
+      1, &memoryBarrier,
+      0, nullptr,
+      0, nullptr
+    );
+  }
+
+  m_deviceFuncs->vkEndCommandBuffer(batch.cmdBuffer);
+  m_deviceFuncs->vkResetFences(m_device, 1, &batch.fence);
+
+  batch.ringEnd     = m_ringHead;
+  batch.isRecording = false;
+
+  ++m_submittedToken;
+
+  if(isSubmittable())
+  {
+    submitPendingBatches();
+  }
+  else
+  {
+    QMetaObject::invokeMethod(
+      m_transferQueue.guiContext,
+      [this]()
+      {
+        QMutexLocker locker(&m_uploadMutex);
+        submitPendingBatches();
+      },
+      Qt::QueuedConnection
+    );
+  }
+
+  return m_submittedToken;
+}
+
+/**
+ * @brief hands the ended batches over to the transfer queue, in order
+ *
+ * @note on the GUI thread if the queue is shared with Qt (isSubmittable)
+ *
+ * @note m_uploadMutex has to be locked
+ */
+void UploadHelper::submitPendingBatches() noexcept
+{
+  if(m_isClosed) return;
+
+  for(; m_queuedToken < m_submittedToken; m_queuedToken++)
+  {
+    auto &batch = m_batches[m_queuedToken % m_batches.size()];
+
+    VkSubmitInfo submitInfo = {}; // memset
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &batch.cmdBuffer;
+
+    const auto &result = m_deviceFuncs->vkQueueSubmit(
+      m_transferQueue.queue,
+      1,
+      &submitInfo,
+      batch.fence
+    );
+
+    if (result != VK_SUCCESS)
+    {
+      qFatal("Failed to submit upload batch: %d", result);
+    }
+  }
+}
+
+/**
+ * @brief retires the oldest submitted batch if it finished: hands its
+ * acquire barriers over to the frame worker and frees its staging range
+ *
+ * @note batches finish in submission order (single queue)
+ *
+ * @note m_uploadMutex has to be locked
+ *
+ * @param[in] _isBlocking wait for its fence
+ * @return false if nothing was retired
+ */
+bool UploadHelper::retireBatch(bool _isBlocking) noexcept
+{
+  if(m_completedToken == m_submittedToken) return false;
+
+  auto &batch = m_batches[m_completedToken % m_batches.size()];
+
+  if(m_completedToken >= m_queuedToken)
+  {
+    // not on the queue yet (GUI thread), dropped once closed
+    if(!m_isClosed) return false;
+  }
+  else if(_isBlocking)
+  {
+    const auto &result = m_deviceFuncs->vkWaitForFences(
+      m_device,
+      1,
+      &batch.fence,
+      VK_TRUE,
+      UINT64_MAX
+    );
+
+    if (result != VK_SUCCESS)
+    {
+      qFatal("Failed to wait for upload batch: %d", result);
+    }
+  }
+  else if(m_deviceFuncs->vkGetFenceStatus(m_device, batch.fence) != VK_SUCCESS)
+  {
+    return false;
+  }
+
+  for(; batch.acquiredCount < batch.barriers.size(); batch.acquiredCount++)
+  {
+    auto barrier = batch.barriers[batch.acquiredCount];
+    barrier.srcAccessMask = 0; // ignored on acquire
+    barrier.dstAccessMask =
+        VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT
+      | VK_ACCESS_INDEX_READ_BIT
+      | VK_ACCESS_SHADER_READ_BIT;
+
+    // retried once the frame worker caught up
+    if(!m_acquireBarriers.push(barrier)) return false;
+  }
+
+  batch.barriers.clear();
+  batch.acquiredCount = 0;
+
+  m_ringTail = batch.ringEnd;
+  m_completedToken++;
+
+  return true;
+}
+
+/**
+ * @note m_uploadMutex has to be locked
+ */
+void UploadHelper::retireBatches() noexcept
+{
+  while(retireBatch(false)) {}
+}
+
+/**
+ * @brief blocks until the oldest submitted batch retired
+ *
+ * @note m_uploadMutex has to be locked, it's released while the
+ * batch waits for the GUI thread to queue it
+ */
+void UploadHelper::waitForOldestBatch() noexcept
+{
+  if(m_completedToken == m_submittedToken) return;
+
+  // only fails while the frame worker hasn't drained the acquire barriers,
+  // or the GUI thread hasn't queued the batch yet
+  while(!retireBatch(true))
+  {
+    if(m_completedToken >= m_queuedToken && !m_isClosed)
+    {
+      if(isSubmittable())
+      {
+        submitPendingBatches();
+        continue;
+      }
+
+      m_uploadMutex.unlock();
+      QThread::yieldCurrentThread();
+      m_uploadMutex.lock();
+      continue;
+    }
+
+    QThread::yieldCurrentThread();
+  }
+}
@@ -0,0 +1,173 @@
+/*****************************************************
+ * Partial Class: UploadHelper
+ * Members: Staging Ring Helpers (Private)
+ *****************************************************/
+
+#include "VKHelpers/Upload.hpp"
+
+using namespace sdfRay4d::vkHelpers;
+
+/**
+ * @brief host visible (and coherent) transfer source, mapped until destroyed
+ *
+ * @param[in] _hostVisibleMemoryIndex
+ */
+void UploadHelper::createRing(uint32_t _hostVisibleMemoryIndex) noexcept
+{
+  buffer::Info bufInfo = {}; // memset
+  bufInfo.sType = buffer::StructureType::BUFFER_INFO;
+  bufInfo.size = constants::upload::ringSize;
+  bufInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+  auto result = m_deviceFuncs->vkCreateBuffer(
+    m_device,
+    &bufInfo,
+    nullptr,
+    &m_ringBuffer
+  );
+
+  if (result != VK_SUCCESS)
+  {
+    qFatal("Failed to create staging ring buffer: %d", result);
+  }
+
+  memory::Reqs memReq = {};
+  m_deviceFuncs->vkGetBufferMemoryRequirements(
+    m_device,
+    m_ringBuffer,
+    &memReq
+  );
+
+  memory::AllocInfo memAllocInfo = {
+    memory::StructureType::MEMORY_ALLOC_INFO, // sType
+    nullptr, // pNext
+    memReq.size, // allocationSize
+    _hostVisibleMemoryIndex // memoryTypeIndex
+  };
+  result = m_deviceFuncs->vkAllocateMemory(
+    m_device,
+    &memAllocInfo,
+    nullptr,
+    &m_ringMemory
+  );
+
+  if (result != VK_SUCCESS)
+  {
+    qFatal("Failed to allocate staging ring memory: %d", result);
+  }
+
+  result = m_deviceFuncs->vkBindBufferMemory(
+    m_device,
+    m_ringBuffer,
+    m_ringMemory,
+    0
+  );
+
+  if (result != VK_SUCCESS)
+  {
+    qFatal("Failed to bind staging ring memory: %d", result);
+  }
+
+  result = m_deviceFuncs->vkMapMemory(
+    m_device,
+    m_ringMemory,
+    0,
+    VK_WHOLE_SIZE,
+    0,
+    reinterpret_cast<void**>(&m_mappedRing)
+  );
+
+  if (result != VK_SUCCESS)
+  {
+    qFatal("Failed to map staging ring memory: %d", result);
+  }
+}
+
+void UploadHelper::destroyRing() noexcept
+{
+  if (m_ringBuffer)
+  {
+    m_deviceFuncs->vkDestroyBuffer(
+      m_device,
+      m_ringBuffer,
+      nullptr
+    );
+    m_ringBuffer = VK_NULL_HANDLE;
+  }
+
+  if (!m_ringMemory) return;
+
+  if (m_mappedRing)
+  {
+    m_deviceFuncs->vkUnmapMemory(m_device, m_ringMemory);
+    m_mappedRing = nullptr;
+  }
+
+  m_deviceFuncs->vkFreeMemory(
+    m_device,
+    m_ringMemory,
+    nullptr
+  );
+  m_ringMemory = VK_NULL_HANDLE;
+}
+
+/**
+ * @brief reserves a contiguous range at the ring's head, a range that
+ * would wrap around starts over at the beginning of the ring instead
+ *
+ * @note head and tail only grow, the bytes between them are in flight
+ * (or recorded into the open batch) and freed as their batches retire.
+ * If the ring is full, the open batch is submitted and the oldest batch
+ * waited for.
+ *
+ * @note m_uploadMutex has to be locked
+ *
+ * @param[in] _byteSize at most constants::upload::chunkSize
+ * @return offset in the ring
+ */
+device::Size UploadHelper::reserve(device::Size _byteSize) noexcept
+{
+  device::Size ringOffset = 0;
+
+  while(!tryReserve(_byteSize, ringOffset))
+  {
+    // the open batch holds the rest of the ring
+    if(m_completedToken == m_submittedToken) submitBatch();
+
+    waitForOldestBatch();
+  }
+
+  return ringOffset;
+}
+
+/**
+ * @brief same as reserve, unless the range is still in flight
+ *
+ * @note m_uploadMutex has to be locked
+ *
+ * @param[in] _byteSize at most constants::upload::chunkSize
+ * @param[out] _ringOffset offset in the ring
+ * @return false if nothing was reserved
+ */
+bool UploadHelper::tryReserve(
+  device::Size _byteSize,
+  device::Size &_ringOffset
+) noexcept
+{
+  const auto &ringSize  = (uint64_t) constants::upload::ringSize;
+  const auto &alignment = (uint64_t) constants::upload::alignment;
+
+  const auto head = (m_ringHead + alignment - 1) & ~(alignment - 1);
+
+  const auto offset = head % ringSize;
+  const auto padding = offset + _byteSize > ringSize
+    ? ringSize - offset
+    : 0;
+
+  if(head + padding + _byteSize - m_ringTail > ringSize) return false;
+
+  _ringOffset = (head + padding) % ringSize;
+  m_ringHead = head + padding + _byteSize;
+
+  return true;
+}
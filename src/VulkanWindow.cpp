@@ -12,6 +12,8 @@
  * Partials:
  *****************************************************/
 
+#include <QTimer>
+
 #include "Window/VulkanWindow.hpp"
 
 using namespace sdfRay4d;
@@ -24,7 +26,82 @@ VulkanWindow::VulkanWindow(
   bool _isDebug
 ) :
   m_isDebug(_isDebug)
-{}
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+  setQueueCreateInfoModifier([this](
+    const VkQueueFamilyProperties *_properties,
+    uint32_t _queueFamilyCount,
+    QVector<VkDeviceQueueCreateInfo> &_createInfos
+  )
+  {
+    requestTransferQueue(_properties, _queueFamilyCount, _createInfos);
+  });
+#endif
+}
+
+/**
+ * @brief requests a queue for the uploads (see UploadHelper) along with
+ * Qt Vulkan's graphics/present queues, on device creation
+ *
+ * @note preferably from a transfer only family (usually DMA engines),
+ * copying alongside rendering, otherwise a second queue of the graphics
+ * family. If neither is available, uploads share the graphics queue.
+ *
+ * @param[in] _properties
+ * @param[in] _queueFamilyCount
+ * @param[in, out] _createInfos graphics family first
+ */
+void VulkanWindow::requestTransferQueue(
+  const VkQueueFamilyProperties *_properties,
+  uint32_t _queueFamilyCount,
+  QVector<VkDeviceQueueCreateInfo> &_createInfos
+)
+{
+  // read by vkCreateDevice, after this returns
+  static const float priorities[2] = { 1.0f, 1.0f };
+
+  m_transferQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+  m_transferQueueIndex        = 0;
+
+  for(uint32_t i = 0; i < _queueFamilyCount; i++)
+  {
+    const auto &flags = _properties[i].queueFlags;
+
+    if(
+      !(flags & VK_QUEUE_TRANSFER_BIT) ||
+      (flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) ||
+      _properties[i].queueCount == 0
+    ) continue;
+
+    VkDeviceQueueCreateInfo createInfo = {}; // memset
+    createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    createInfo.queueFamilyIndex = i;
+    createInfo.queueCount = 1;
+    createInfo.pQueuePriorities = priorities;
+
+    _createInfos.append(createInfo);
+    m_transferQueueFamilyIndex = i;
+
+    return;
+  }
+
+  if(_createInfos.isEmpty()) return;
+
+  auto &graphicsInfo = _createInfos.first();
+  const auto &graphicsFamily = _properties[graphicsInfo.queueFamilyIndex];
+
+  if(
+    !(graphicsFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) ||
+    graphicsFamily.queueCount < 2 ||
+    graphicsInfo.queueCount != 1
+  ) return;
+
+  graphicsInfo.queueCount = 2;
+  graphicsInfo.pQueuePriorities = priorities;
+
+  m_transferQueueFamilyIndex  = graphicsInfo.queueFamilyIndex;
+  m_transferQueueIndex        = 1;
+}
 
 QVulkanWindowRenderer *VulkanWindow::createRenderer()
 {
@@ -66,7 +143,130 @@ VulkanWindow::MaterialPtr &VulkanWindow::getSDFRMaterial(bool _isNew)
   return m_renderer->getSDFRMaterial(_isNew);
 }
 
-void VulkanWindow::createSDFRPipeline()
+/**
+ *
+ * @param[in] _graphKey see SDFGraph::getPipelineKey
+ * @param[in] _tape of the revision (node table)
+ */
+void VulkanWindow::createSDFRPipeline(
+  uint64_t _graphKey,
+  const sdfGraph::Tape::DataPtr &_tape
+)
 {
-  m_renderer->createSDFRPipeline();
+  m_renderer->createSDFRPipeline(_graphKey, _tape);
+}
+
+/**
+ *
+ * @param[in] _graphKey see SDFGraph::getPipelineKey
+ * @return false if not cached
+ */
+bool VulkanWindow::useCachedSDFRPipeline(uint64_t _graphKey)
+{
+  return m_renderer->useCachedSDFRPipeline(_graphKey);
+}
+
+/**
+ * @brief GPU profiler overlay summary (empty until the renderer exists)
+ * @return QString
+ */
+QString VulkanWindow::getProfilerSummary()
+{
+  if(!m_renderer) return {};
+
+  return m_renderer->getProfiler().getSummary();
+}
+
+/**
+ *
+ * @param[in] _filePath .json or .csv
+ * @return boolean
+ */
+bool VulkanWindow::exportProfilerStats(const QString &_filePath)
+{
+  if(!m_renderer) return false;
+
+  return m_renderer->getProfiler().exportStats(_filePath);
+}
+
+/**
+ * @brief SDFR soft shadows/AO resolution
+ * @param[in] _scale of the swapchain extent (1.0: full, 0.5: half, 0.25: quarter)
+ */
+void VulkanWindow::setLightingScale(float _scale)
+{
+  if(!m_renderer) return;
+
+  m_renderer->setLightingScale(_scale);
+}
+
+/**
+ * @brief SDFR raymarch quality (specialization constants), recreates
+ * the current SDFR pipeline without compiling its shader
+ * @param[in] _quality e.g. RaymarchQuality::get(preset)
+ */
+void VulkanWindow::setRaymarchQuality(const RaymarchQuality &_quality)
+{
+  if(!m_renderer) return;
+
+  if(!m_renderer->setRaymarchQuality(_quality))
+  {
+    QTimer::singleShot(constants::autoCompileInterval, this, &VulkanWindow::applyRaymarchQuality);
+  }
+}
+
+/**
+ * @note retried until a pending SDFR pipeline (e.g. SDF Graph compile)
+ * has been swapped in
+ */
+void VulkanWindow::applyRaymarchQuality()
+{
+  if(!m_renderer || m_renderer->applyRaymarchQuality()) return;
+
+  QTimer::singleShot(constants::autoCompileInterval, this, &VulkanWindow::applyRaymarchQuality);
+}
+
+/**
+ * @brief baked static SDF Graph primitives, uploaded with the next SDFR pipeline
+ * @param[in] _data
+ */
+void VulkanWindow::setBrickMap(const sdfGraph::BrickMap::DataPtr &_data)
+{
+  if(!m_renderer) return;
+
+  m_renderer->setBrickMap(_data);
+}
+
+/**
+ * @brief mesh node's signed distance volume, uploaded with the next SDFR pipeline
+ * @param[in] _data
+ */
+void VulkanWindow::setMeshVolume(const sdfGraph::MeshSDF::DataPtr &_data)
+{
+  if(!m_renderer) return;
+
+  m_renderer->setMeshVolume(_data);
+}
+
+/**
+ * @brief SDF Graph's scene bytecode, interpreted until its shader is compiled
+ * @param[in] _data
+ * @return false if it can't be interpreted (yet)
+ */
+bool VulkanWindow::setSceneTape(const sdfGraph::Tape::DataPtr &_data)
+{
+  if(!m_renderer) return false;
+
+  return m_renderer->setSceneTape(_data);
+}
+
+/**
+ * @brief replaces the actor mesh, uploaded by the renderer's swap worker
+ * @param[in] _data
+ */
+void VulkanWindow::setActorMesh(const Mesh::DataPtr &_data)
+{
+  if(!m_renderer) return;
+
+  m_renderer->setActorMesh(_data);
 }
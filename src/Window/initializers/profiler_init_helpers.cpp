@@ -0,0 +1,88 @@
+/*****************************************************
+ * Partial Class: MainWindow
+ * Members: GPU Profiler init helpers & slots (Private)
+ *****************************************************/
+
+#include "Window/MainWindow.hpp"
+
+using namespace sdfRay4d;
+
+/**
+ * @note the overlay is a status bar label, since widgets
+ * cannot be drawn on top of the (native) vulkan window surface
+ */
+void MainWindow::createProfilerActions()
+{
+  m_toggleProfilerAction = new QAction(tr("Show"), this);
+  m_toggleProfilerAction->setCheckable(true);
+  connect(
+    m_toggleProfilerAction, &QAction::toggled,
+    this, &MainWindow::toggleProfiler
+  );
+
+  m_exportProfilerAction = new QAction(tr("Export..."), this);
+  connect(
+    m_exportProfilerAction, &QAction::triggered,
+    this, &MainWindow::exportProfiler
+  );
+
+  m_profilerLabel = new QLabel(this);
+  m_profilerLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+  m_profilerTimer = new QTimer(this);
+  m_profilerTimer->setInterval(constants::profiler::overlayInterval);
+  connect(
+    m_profilerTimer, &QTimer::timeout,
+    this, &MainWindow::updateProfiler
+  );
+}
+
+/**
+ *
+ * @param[in] _isVisible
+ */
+void MainWindow::toggleProfiler(bool _isVisible)
+{
+  if(_isVisible)
+  {
+    statusBar()->addWidget(m_profilerLabel, 1);
+    m_profilerLabel->show();
+    m_profilerTimer->start();
+
+    updateProfiler();
+  }
+  else
+  {
+    m_profilerTimer->stop();
+    statusBar()->removeWidget(m_profilerLabel);
+  }
+
+  statusBar()->setVisible(_isVisible);
+  m_toggleProfilerAction->setText(_isVisible ? tr("Hide") : tr("Show"));
+}
+
+void MainWindow::updateProfiler()
+{
+  m_profilerLabel->setText(m_vkWindow->getProfilerSummary());
+}
+
+void MainWindow::exportProfiler()
+{
+  const auto &filePath = QFileDialog::getSaveFileName(
+    this,
+    tr("Export GPU Profile"),
+    QStringLiteral("gpu_profile.json"),
+    tr("JSON (*.json);;CSV (*.csv)")
+  );
+
+  if(filePath.isEmpty()) return;
+
+  if(!m_vkWindow->exportProfilerStats(filePath))
+  {
+    QMessageBox::warning(
+      this,
+      tr("GPU Profiler"),
+      tr("Failed to export the GPU profile to %1").arg(filePath)
+    );
+  }
+}
@@ -0,0 +1,133 @@
+/*****************************************************
+ * Partial Class: MainWindow
+ * Members: Render Settings init helpers & slots (Private)
+ *****************************************************/
+
+#include "Window/MainWindow.hpp"
+
+using namespace sdfRay4d;
+
+/**
+ * @note soft shadows/AO resolution (of the swapchain extent),
+ * full resolution computes them in the main SDFR pass
+ */
+void MainWindow::createRenderSettingsActions()
+{
+  m_lightingActions = new QActionGroup(this);
+  m_lightingActions->setExclusive(true);
+
+  const std::vector<std::pair<QString, float>> lightingQualities = {
+    { tr("Full"),     1.0f },
+    { tr("Half"),     0.5f },
+    { tr("Quarter"),  0.25f }
+  };
+
+  for(const auto &[label, scale] : lightingQualities)
+  {
+    auto *action = m_lightingActions->addAction(label);
+    action->setCheckable(true);
+    action->setData(scale);
+    action->setChecked(qFuzzyCompare(scale, constants::lighting::defaultScale));
+  }
+
+  connect(
+    m_lightingActions, &QActionGroup::triggered,
+    this, &MainWindow::setLightingQuality
+  );
+
+  using Optimization = SPIRVCompiler::Optimization;
+
+  m_optimizationActions = new QActionGroup(this);
+  m_optimizationActions->setExclusive(true);
+
+  const std::vector<std::pair<QString, Optimization>> optimizations = {
+    { tr("Off"),          Optimization::OFF },
+    { tr("Size"),         Optimization::SIZE },
+    { tr("Performance"),  Optimization::PERFORMANCE }
+  };
+
+  // the levels compile the same module as Off without spirv-opt
+  const auto &isOptimizerAvailable = SPIRVCompiler::isOptimizerAvailable();
+  const auto &defaultOptimization = isOptimizerAvailable
+    ? Optimization::PERFORMANCE
+    : Optimization::OFF;
+
+  for(const auto &[label, optimization] : optimizations)
+  {
+    auto *action = m_optimizationActions->addAction(label);
+    action->setCheckable(true);
+    action->setData((int) optimization);
+    action->setChecked(optimization == defaultOptimization);
+
+    if(!isOptimizerAvailable && optimization != Optimization::OFF)
+    {
+      action->setEnabled(false);
+      action->setToolTip(tr("Built without the SPIR-V optimizer (SPIRV_OPT_ENABLED)"));
+    }
+  }
+
+  connect(
+    m_optimizationActions, &QActionGroup::triggered,
+    this, &MainWindow::setShaderOptimization
+  );
+
+  using Preset = RaymarchQuality::Preset;
+
+  m_qualityActions = new QActionGroup(this);
+  m_qualityActions->setExclusive(true);
+
+  const std::vector<std::pair<QString, Preset>> qualityPresets = {
+    { tr("Low"),    Preset::LOW },
+    { tr("Medium"), Preset::MEDIUM },
+    { tr("High"),   Preset::HIGH },
+    { tr("Ultra"),  Preset::ULTRA }
+  };
+
+  for(const auto &[label, preset] : qualityPresets)
+  {
+    auto *action = m_qualityActions->addAction(label);
+    action->setCheckable(true);
+    action->setData((int) preset);
+    action->setChecked(preset == Preset::MEDIUM);
+  }
+
+  connect(
+    m_qualityActions, &QActionGroup::triggered,
+    this, &MainWindow::setRaymarchQuality
+  );
+}
+
+/**
+ *
+ * @param[in] _action
+ */
+void MainWindow::setLightingQuality(QAction *_action)
+{
+  m_vkWindow->setLightingScale(_action->data().toFloat());
+}
+
+/**
+ * @note march/shadow steps, AO taps, AA... (specialization constants),
+ * switching presets doesn't recompile the SDFR shader
+ *
+ * @param[in] _action
+ */
+void MainWindow::setRaymarchQuality(QAction *_action)
+{
+  m_vkWindow->setRaymarchQuality(
+    RaymarchQuality::get((RaymarchQuality::Preset) _action->data().toInt())
+  );
+}
+
+/**
+ * @note SDF Graph shader's spirv-opt level (fast passes per edit,
+ * full passes once the graph is idle)
+ *
+ * @param[in] _action
+ */
+void MainWindow::setShaderOptimization(QAction *_action)
+{
+  if(!m_sdfGraph) return;
+
+  m_sdfGraph->setOptimization((SPIRVCompiler::Optimization) _action->data().toInt());
+}
@@ -38,6 +38,13 @@ void MainWindow::createSDFGraphActions()
     this, &MainWindow::compileSDFGraph
   );
 
+  m_extractMeshAction = new QAction(tr("Extract Mesh"), this);
+  m_extractMeshAction->setToolTip(tr("Polygonize the graph into the actor mesh"));
+  connect(
+    m_extractMeshAction, &QAction::triggered,
+    this, &MainWindow::extractSDFGraphMesh
+  );
+
   m_saveAction = new QAction(tr("Save"), this);
 //  m_compileAction->setShortcuts(QKeySequence::Open);
   connect(
@@ -52,6 +59,11 @@ void MainWindow::compileSDFGraph()
   emit m_vkWindow->compileSDFGraph();
 }
 
+void MainWindow::extractSDFGraphMesh()
+{
+  m_sdfGraph->extractMesh();
+}
+
 void MainWindow::autoCompileSDFGraph()
 {
   const auto &isAutoCompile = m_autoCompileAction->isChecked();
@@ -73,6 +85,7 @@ void MainWindow::loadSDFGraph()
    * that are not needed to change
    */
   m_sdfGraph = new SDFGraph(m_vkWindow);
+  setShaderOptimization(m_optimizationActions->checkedAction());
   m_sdfGraphWidget = new QDockWidget(tr("SDF Graph Editor"), this);
   m_sdfGraphWidget->setAllowedAreas(
       Qt::TopDockWidgetArea
@@ -88,6 +101,7 @@ void MainWindow::loadSDFGraph()
   m_sdfGraphToolbar->addAction(m_autoCompileAction);
   m_sdfGraphToolbar->addSeparator();
   m_sdfGraphToolbar->addAction(m_compileAction);
+  m_sdfGraphToolbar->addAction(m_extractMeshAction);
   m_sdfGraphToolbar->addAction(m_saveAction);
 
   innerWidget->setWindowFlags(Qt::Widget);
@@ -50,6 +50,8 @@ void MainWindow::createActions()
   );
 
   createSDFGraphActions();
+  createProfilerActions();
+  createRenderSettingsActions();
 }
 
 void MainWindow::createMenus()
@@ -60,8 +62,23 @@ void MainWindow::createMenus()
   m_sdfGraphMenu->addAction(m_loadSDFGraphAction);
   m_sdfGraphMenu->addAction(m_toggleSDFGraphAction);
 
+  m_profilerMenu = m_windowMenu->addMenu(tr("GPU Profiler"));
+  m_profilerMenu->addAction(m_toggleProfilerAction);
+  m_profilerMenu->addAction(m_exportProfilerAction);
+
   m_windowMenu->addAction(m_quitAction);
 
+  m_renderMenu = menuBar()->addMenu(tr("Render"));
+
+  m_lightingMenu = m_renderMenu->addMenu(tr("Shadows/AO Resolution"));
+  m_lightingMenu->addActions(m_lightingActions->actions());
+
+  m_optimizationMenu = m_renderMenu->addMenu(tr("Shader Optimization"));
+  m_optimizationMenu->addActions(m_optimizationActions->actions());
+
+  m_qualityMenu = m_renderMenu->addMenu(tr("Raymarch Quality"));
+  m_qualityMenu->addActions(m_qualityActions->actions());
+
   m_helpMenu = menuBar()->addMenu(tr("Help"));
   m_helpMenu->addAction(m_aboutAction);
 }
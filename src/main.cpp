@@ -1,8 +1,97 @@
+#include <cstring>
+
+#include <QCommandLineParser>
 #include <QtWidgets/QStyleFactory>
 
+#include "AssetBundle.hpp"
 #include "Window/MainWindow.hpp"
+#include "SDFGraph/Raymarcher.hpp"
 
 using MainWindow = sdfRay4d::MainWindow;
+using Raymarcher = sdfRay4d::sdfGraph::Raymarcher;
+
+/**
+ * @brief headless CPU reference render of a scene file (see Raymarcher::loadScene)
+ * or the reference scene, i.e. sdf-ray4d --cpu-render[=]out.png [scene.json]
+ * [--size 1280x720] [--time 1] [--threads 0] [--relaxation 1.6] [--no-specialization]
+ *
+ * @note runs without a window/Vulkan instance (e.g. CI golden images)
+ *
+ * @param[in] _argc
+ * @param[in] _argv
+ * @return exit code
+ */
+int runCPURender(int _argc, char *_argv[])
+{
+  QCoreApplication app(_argc, _argv);
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("SDF Ray4D CPU reference renderer");
+  parser.addHelpOption();
+
+  const QCommandLineOption outputOption("cpu-render", "Output image file.", "file");
+  const QCommandLineOption sizeOption("size", "Image size (WxH).", "size", "1280x720");
+  const QCommandLineOption timeOption("time", "Scene time.", "time", "1");
+  const QCommandLineOption threadsOption("threads", "Thread count (0: ideal).", "threads", "0");
+  const QCommandLineOption relaxationOption("relaxation", "Over-relaxation (1: sphere tracing).", "factor", "1.6");
+  const QCommandLineOption noSpecializationOption("no-specialization", "March the whole scene in every tile.");
+
+  parser.addOptions({ outputOption, sizeOption, timeOption, threadsOption, relaxationOption, noSpecializationOption });
+  parser.addPositionalArgument("scene", "Scene file (.json), the reference scene otherwise.", "[scene]");
+  parser.process(app);
+
+  auto scene = Raymarcher::createReferenceScene();
+  const auto &arguments = parser.positionalArguments();
+
+  if(!arguments.isEmpty() && !Raymarcher::loadScene(arguments.first(), scene)) return 1;
+
+  Raymarcher::Settings settings;
+
+  const auto &size = parser.value(sizeOption).split('x');
+
+  if(size.size() == 2)
+  {
+    settings.width  = std::max(size[0].toInt(), 1);
+    settings.height = std::max(size[1].toInt(), 1);
+  }
+
+  settings.time         = parser.value(timeOption).toFloat();
+  settings.threadCount  = parser.value(threadsOption).toInt();
+  settings.relaxation   = parser.value(relaxationOption).toFloat();
+  settings.isSpecialized = !parser.isSet(noSpecializationOption);
+
+  Raymarcher::Stats stats;
+
+  const auto &image = Raymarcher::render(
+    scene,
+    settings,
+    &stats
+  );
+
+  if(image.isNull()) return 1;
+
+  const auto &filePath = parser.value(outputOption);
+
+  if(!image.save(filePath))
+  {
+    qWarning("Failed to write CPU render %s", qPrintable(filePath));
+    return 1;
+  }
+
+  qInfo(
+    "CPU render %dx%d: %.3f s, %.2f Mrays/s (%.2f Mrays/s per core, %d threads), %.2f march steps per ray, %.2f primitives per step",
+    settings.width,
+    settings.height,
+    stats.seconds,
+    stats.raysPerSecond() / 1e6,
+    stats.raysPerSecondPerCore() / 1e6,
+    stats.threadCount,
+    (double) stats.marchSteps / (double) std::max<uint64_t>(stats.primaryRays, 1),
+    (double) stats.termSteps / (double) std::max<uint64_t>(stats.marchSteps, 1)
+  );
+
+  return 0;
+}
 
 /**
  *
@@ -12,8 +101,19 @@ using MainWindow = sdfRay4d::MainWindow;
  */
 int main(int _argc, char *_argv[])
 {
+  // e.g. "--cpu-render out.png" or "--cpu-render=out.png"
+  for(auto i = 1; i < _argc; i++)
+  {
+    if(
+      std::strcmp(_argv[i], "--cpu-render") == 0 ||
+      std::strncmp(_argv[i], "--cpu-render=", std::strlen("--cpu-render=")) == 0
+    ) return runCPURender(_argc, _argv);
+  }
+
   QApplication app(_argc, _argv);
 
+  sdfRay4d::AssetBundle::open();
+
   QApplication::setStyle(QStyleFactory::create("fusion"));
   QApplication::setPalette(MainWindow::setPalette());
 